@@ -231,6 +231,10 @@
  * @defgroup libmeos_temporal_similarity Similarity functions
  * @ingroup libmeos_temporal
  * @brief Similarity functions for temporal types.
+ *
+ * @defgroup libmeos_temporal_stream Stream window functions
+ * @ingroup libmeos_temporal
+ * @brief Window operators over streams of temporal instants.
  */
 
 /*****************************************************************************/
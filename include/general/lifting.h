@@ -73,6 +73,9 @@ typedef struct
 
 /*****************************************************************************/
 
+extern Datum tfunc_base_base(Datum value1, Datum value2,
+  LiftedFunctionInfo *lfinfo);
+
 extern TInstant *tfunc_tinstant(const TInstant *inst,
   LiftedFunctionInfo *lfinfo);
 extern TInstantSet *tfunc_tinstantset(const TInstantSet *ti,
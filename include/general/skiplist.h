@@ -38,6 +38,8 @@
 /* PostgreSQL */
 #include <postgres.h>
 #include <catalog/pg_type.h>
+#include <lib/stringinfo.h>
+#include <storage/buffile.h>
 /* MobilityDB */
 #include "general/temporal.h"
 
@@ -71,6 +73,16 @@ typedef enum
   TEMPORAL
 } SkipListElemType;
 
+/**
+ * Position and number of values of a run of a skiplist spilled to disk
+ */
+typedef struct
+{
+  int fileno;           /**< Number of the segment of the temporary file */
+  off_t offset;         /**< Offset of the first value in the segment */
+  int count;            /**< Number of values of the run */
+} SkipListRun;
+
 /**
  * Structure to represent skiplists that keep the current state of an aggregation
  */
@@ -87,18 +99,30 @@ typedef struct
   void *extra;
   size_t extrasize;
   SkipListElem *elems;
+  size_t valsize;       /**< Memory size of the values */
+  datum_func2 func;     /**< Function used for merging the spilled runs */
+  bool crossings;       /**< Crossings used for merging the spilled runs */
+  BufFile *spill;       /**< Temporary file of spilled runs, NULL if none */
+  SkipListRun *runs;    /**< Spilled runs, NULL if none */
+  int nruns;            /**< Number of spilled runs */
 } SkipList;
 
 /*****************************************************************************/
 
+extern int aggregate_spill_mem;
+
+extern void skiplist_init(void);
 extern SkipList *skiplist_make(FunctionCallInfo fcinfo, void **values,
   int count, SkipListElemType elemtype);
 extern void *skiplist_headval(SkipList *list);
 extern void skiplist_splice(FunctionCallInfo fcinfo, SkipList *list,
   void **values, int count, datum_func2 func, bool crossings);
-extern void **skiplist_values(SkipList *list);
+extern void **skiplist_values(FunctionCallInfo fcinfo, SkipList *list);
 extern void aggstate_set_extra(FunctionCallInfo fcinfo, SkipList *state,
   void *data, size_t size);
+extern void aggstate_write(FunctionCallInfo fcinfo, SkipList *state,
+  StringInfo buf);
+extern SkipList *aggstate_read(FunctionCallInfo fcinfo, StringInfo buf);
 
 /*****************************************************************************/
 
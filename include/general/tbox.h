@@ -58,6 +58,33 @@ typedef struct
   int16       flags;  /**< flags */
 } TBOX;
 
+/**
+ * Enumeration for the predicates of the batch topological functions
+ */
+typedef enum
+{
+  BOX_OVERLAPS,          /**< the boxes overlap */
+  BOX_CONTAINS,          /**< the query box contains the box */
+  BOX_CONTAINED,         /**< the query box is contained in the box */
+} BoxPred;
+
+/** Number of boxes filtered at a time by the batch topological functions */
+#define BOX_FILTER_BLOCK 64
+
+/**
+ * Structure to represent a buffer of temporal boxes with the same dimensions
+ * as a structure of arrays
+ */
+typedef struct
+{
+  int         count;  /**< number of boxes */
+  int16       flags;  /**< flags shared by all the boxes */
+  double      *xmin;  /**< minimum number values */
+  double      *xmax;  /**< maximum number values */
+  TimestampTz *tmin;  /**< minimum timestamps */
+  TimestampTz *tmax;  /**< maximum timestamps */
+} TBoxBuffer;
+
 /* fmgr macros temporal types */
 
 #define DatumGetTboxP(X)    ((TBOX *) DatumGetPointer(X))
@@ -139,6 +166,23 @@ extern bool overlaps_tbox_tbox(const TBOX *box1, const TBOX *box2);
 extern bool same_tbox_tbox(const TBOX *box1, const TBOX *box2);
 extern bool adjacent_tbox_tbox(const TBOX *box1, const TBOX *box2);
 
+/* Batch topological functions */
+
+extern void boxfilter_double(BoxPred pred, double qlo, double qhi,
+  const double *lo, const double *hi, int count, uint8 *mask);
+extern void boxfilter_timestamp(BoxPred pred, TimestampTz qlo,
+  TimestampTz qhi, const TimestampTz *lo, const TimestampTz *hi, int count,
+  uint8 *mask);
+extern int boxfilter_bitmap(const uint8 *mask, int count, uint8 *bitmap);
+extern int boxfilter_selection(const uint8 *mask, int count, int start,
+  int *sel);
+extern TBoxBuffer *tboxbuf_make(const TBOX *boxes, int count);
+extern int tboxbuf_filter(const TBOX *box, const TBoxBuffer *buf,
+  BoxPred pred, uint8 *bitmap);
+extern int tboxarr_filter(const TBOX *box, const TBOX *boxes, int count,
+  BoxPred pred, int *sel);
+extern void tboxbuf_free(TBoxBuffer *buf);
+
 /* Relative position functions */
 
 extern bool left_tbox_tbox(const TBOX *box1, const TBOX *box2);
@@ -392,6 +392,18 @@ typedef Datum (*varfunc) (Datum, ...);
 typedef Datum (*datum_func2) (Datum, Datum);
 typedef Datum (*datum_func3) (Datum, Datum, Datum);
 
+/**
+ * Structure to represent the summary statistics of a temporal number
+ */
+typedef struct
+{
+  double    minvalue;     /**< minimum value */
+  double    maxvalue;     /**< maximum value */
+  double    twavg;        /**< time-weighted average */
+  double    integral;     /**< area under the curve */
+  Interval  duration;     /**< duration */
+} TNumberStats;
+
 /*****************************************************************************
  * Struct definitions for GisT indexes copied from PostgreSQL
  *****************************************************************************/
@@ -654,6 +666,7 @@ extern bool temporal_intersects_periodset(const Temporal *temp,
 
 extern double tnumber_integral(const Temporal *temp);
 extern double tnumber_twavg(const Temporal *temp);
+extern void tnumber_stats(const Temporal *temp, TNumberStats *stats);
 
 /* Comparison functions */
 
@@ -0,0 +1,85 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_batch.h
+ * Input of many temporal values stored in a single buffer.
+ */
+
+#ifndef __TEMPORAL_BATCH_H__
+#define __TEMPORAL_BATCH_H__
+
+/* PostgreSQL */
+#include <postgres.h>
+#include <utils/palloc.h>
+/* MobilityDB */
+#include "general/temporal.h"
+
+/*****************************************************************************/
+
+/**
+ * Enumeration for the formats of the values in a batch
+ */
+typedef enum
+{
+  BATCH_WKT,
+  BATCH_HEXWKB,
+  BATCH_MFJSON,
+} BatchFormat;
+
+/**
+ * Structure for reading the values of a batch one after the other
+ *
+ * The values are either separated by a delimiter, typically a newline, or
+ * each of them is preceded by its length as a 4-byte little-endian unsigned
+ * integer.
+ */
+typedef struct
+{
+  const char *buffer;      /**< buffer containing the values */
+  size_t size;             /**< size of the buffer in bytes */
+  size_t pos;              /**< current position in the buffer */
+  char delim;              /**< delimiter, '\0' for length-prefixed values */
+  char *scratch;           /**< null-terminated copy of the current value */
+  size_t scratchsize;      /**< allocated size of the scratch buffer */
+} BatchReader;
+
+/*****************************************************************************/
+
+extern void batchreader_init(BatchReader *reader, const char *buffer,
+  size_t size, char delim);
+extern bool batchreader_next(BatchReader *reader, const char **value,
+  size_t *len);
+extern Temporal **temporal_in_batch(const char *buffer, size_t size,
+  BatchFormat format, CachedType temptype, char delim, MemoryContext arena,
+  int *count);
+
+/*****************************************************************************/
+
+#endif /* __TEMPORAL_BATCH_H__ */
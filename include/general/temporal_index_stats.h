@@ -0,0 +1,98 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_index_stats.h
+ * Diagnostics of the quality of the GiST and SP-GiST indexes of temporal
+ * types.
+ */
+
+#ifndef __TEMPORAL_INDEX_STATS_H__
+#define __TEMPORAL_INDEX_STATS_H__
+
+/* PostgreSQL */
+#include <postgres.h>
+#include <fmgr.h>
+
+/*****************************************************************************/
+
+/**
+ * Enumeration for the dimensions of the keys of an index
+ */
+typedef enum
+{
+  IDX_DIM_X,
+  IDX_DIM_Y,
+  IDX_DIM_Z,
+  IDX_DIM_T,
+  IDX_DIM_VALUE,
+} IndexDim;
+
+#define IDX_NUMDIMS   5
+
+/**
+ * Enumeration for the types of the keys of an index
+ */
+typedef enum
+{
+  IDX_KEY_PERIOD,
+  IDX_KEY_PERIODSET,
+  IDX_KEY_TBOX,
+  IDX_KEY_STBOX,
+} IndexKeyType;
+
+/**
+ * Structure to represent the extent of a key of an index in each dimension
+ */
+typedef struct
+{
+  double lower[IDX_NUMDIMS]; /**< lower bound in each dimension */
+  double upper[IDX_NUMDIMS]; /**< upper bound in each dimension */
+  bool hasdim[IDX_NUMDIMS];  /**< true when the key has the dimension */
+} IndexKeyExtent;
+
+/**
+ * Structure to accumulate the statistics of the nodes of a level of an index
+ */
+typedef struct
+{
+  int nodes;                     /**< number of nodes */
+  int64 entries;                 /**< number of entries of the nodes */
+  double fill;                   /**< sum of the fill factor of the nodes */
+  bool hasdim[IDX_NUMDIMS];      /**< true when an entry has the dimension */
+  double extent[IDX_NUMDIMS];    /**< sum of the extent of the nodes */
+  double overlap[IDX_NUMDIMS];   /**< sum of the pairwise overlap of the
+                                      entries of the nodes */
+  double deadspace[IDX_NUMDIMS]; /**< sum of the extent of the nodes not
+                                      covered by their entries */
+} IndexLevelStats;
+
+/*****************************************************************************/
+
+#endif
@@ -0,0 +1,78 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_recurring.h
+ * Restriction of temporal values to recurring time patterns defined by a
+ * time of day range, a set of days of the week, and a time zone.
+ */
+
+#ifndef __TEMPORAL_RECURRING_H__
+#define __TEMPORAL_RECURRING_H__
+
+/* PostgreSQL */
+#include <postgres.h>
+#include <pgtime.h>
+#include <utils/date.h>
+/* MobilityDB */
+#include "general/temporal.h"
+
+/*****************************************************************************/
+
+/** Bit mask of all days of the week */
+#define ALL_DAYS_OF_WEEK 0x7F
+
+/**
+ * Structure to represent a recurring time pattern. The pattern covers the
+ * local times from `start` (inclusive) to `end` (exclusive) of each day of
+ * the week in `dowmask`, where bit 0 is Sunday. When `start` is greater
+ * than `end` the times wrap around midnight into the next day.
+ */
+typedef struct
+{
+  TimeADT start;        /**< start time of day */
+  TimeADT end;          /**< end time of day, up to 24:00 */
+  uint8 dowmask;        /**< days of the week, bit 0 is Sunday */
+  pg_tz *tz;            /**< time zone of the local times */
+} RecurringTime;
+
+/*****************************************************************************/
+
+extern void recurringtime_set(TimeADT start, TimeADT end, uint8 dowmask,
+  pg_tz *tz, RecurringTime *rt);
+extern Period *recurringtime_periods(const RecurringTime *rt, const Period *p,
+  bool atfunc, int *count);
+extern Temporal *temporal_restrict_recurring(const Temporal *temp,
+  const RecurringTime *rt, bool atfunc);
+extern bool temporal_intersects_recurring(const Temporal *temp,
+  const RecurringTime *rt);
+
+/*****************************************************************************/
+
+#endif /* __TEMPORAL_RECURRING_H__ */
@@ -44,6 +44,13 @@ typedef enum
   DYNTIMEWARP
 } SimFunc;
 
+typedef enum
+{
+  HAUSDORFF_DISCRETE,   /**< Compare the instants */
+  HAUSDORFF_VERTEX,     /**< Compare the instants with the segments */
+  HAUSDORFF_CONTINUOUS  /**< Compare the segments */
+} HausdorffKind;
+
 /**
  * Struct for storing a match
  */
@@ -71,6 +78,18 @@ extern double temporal_similarity(Temporal *temp1, Temporal *temp2,
   SimFunc simfunc);
 extern Match *temporal_similarity_path(Temporal *temp1, Temporal *temp2,
   int *count, SimFunc simfunc);
+extern double temporal_hausdorff_distance(const Temporal *temp1,
+  const Temporal *temp2, HausdorffKind kind);
+extern bool temporal_hausdorff_within(const Temporal *temp1,
+  const Temporal *temp2, double dist, HausdorffKind kind);
+extern double temporal_lcss_distance(const Temporal *temp1,
+  const Temporal *temp2, double eps, int64 window);
+extern bool temporal_lcss_within(const Temporal *temp1,
+  const Temporal *temp2, double eps, int64 window, double dist);
+extern int temporal_edr_distance(const Temporal *temp1,
+  const Temporal *temp2, double eps, int64 window);
+extern bool temporal_edr_within(const Temporal *temp1,
+  const Temporal *temp2, double eps, int64 window, int edits);
 
 /*****************************************************************************/
 
@@ -0,0 +1,173 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_stream.h
+ * Stateful window operators over streams of temporal instants.
+ */
+
+#ifndef __TEMPORAL_STREAM_H__
+#define __TEMPORAL_STREAM_H__
+
+/* PostgreSQL */
+#include <postgres.h>
+/* PostGIS */
+#include <liblwgeom.h>
+/* MobilityDB */
+#include "general/temporal.h"
+
+/*****************************************************************************/
+
+/**
+ * Enumeration for the kinds of stream windows
+ */
+typedef enum
+{
+  WINDOW_TUMBLING,
+  WINDOW_SLIDING,
+  WINDOW_SESSION,
+} WindowKind;
+
+/**
+ * Structure for the result of a stream window
+ *
+ * For temporal numbers the minimum, maximum, and time-weighted average refer
+ * to the values, for temporal points they refer to the speed.
+ */
+typedef struct
+{
+  int64 key;               /**< key of the moving object */
+  TimestampTz lower;       /**< lower bound of the window */
+  TimestampTz upper;       /**< upper bound of the window */
+  TimestampTz tmin;        /**< first timestamp with data in the window */
+  TimestampTz tmax;        /**< last timestamp with data in the window */
+  int count;               /**< number of instants received in the window */
+  double duration;         /**< time covered by data in seconds */
+  double length;           /**< length traversed by a temporal point */
+  double twavg;            /**< time-weighted average */
+  double min;              /**< minimum value */
+  double max;              /**< maximum value */
+  int events;              /**< number of entries within the distance */
+} WindowResult;
+
+/**
+ * Callback receiving the results of the windows as they are closed
+ */
+typedef void (*window_emit_fn)(const WindowResult *result, void *extra);
+
+/**
+ * Structure for the partial aggregate of a window or of a pane of a sliding
+ * window
+ */
+typedef struct
+{
+  TimestampTz tmin;        /**< first timestamp with data */
+  TimestampTz tmax;        /**< last timestamp with data */
+  int count;               /**< number of instants */
+  int events;              /**< number of entries within the distance */
+  double duration;         /**< time covered by data in seconds */
+  double integral;         /**< integral of the value or of the speed */
+  double length;           /**< length traversed by a temporal point */
+  double min;              /**< minimum value */
+  double max;              /**< maximum value */
+} WindowAcc;
+
+/**
+ * Structure for the value of a stream at a timestamp
+ */
+typedef struct
+{
+  TimestampTz t;           /**< timestamp */
+  double value;            /**< value of a temporal number */
+  POINT3DZ point;          /**< value of a temporal point */
+} WindowSample;
+
+/**
+ * Structure for the state of a key in a window operator
+ */
+typedef struct
+{
+  int64 key;               /**< key of the moving object */
+  bool used;               /**< true when the slot of the hash table is used */
+  bool haslast;            /**< true when an instant has been received */
+  bool inside;             /**< true when the last value is within distance */
+  int cur;                 /**< index of the current pane */
+  TimestampTz start;       /**< start of the current window or pane */
+  WindowSample last;       /**< last value received */
+  WindowAcc *panes;        /**< ring of panes, one pane except for sliding */
+} WindowKeyState;
+
+/**
+ * Structure for a window operator
+ *
+ * All the memory is allocated when the operator is created: the state of
+ * the keys is kept in an open-addressing hash table with room for the
+ * maximum number of keys, and the instants themselves are never buffered.
+ */
+typedef struct
+{
+  WindowKind kind;         /**< kind of window */
+  CachedType temptype;     /**< temporal type of the instants */
+  bool linear;             /**< true when values are linearly interpolated */
+  int64 size;              /**< size of the windows, gap for sessions */
+  int64 slide;             /**< slide of sliding windows */
+  TimestampTz origin;      /**< origin of the windows */
+  int npanes;              /**< number of panes per key */
+  double dist;             /**< distance for the events, negative if none */
+  double refvalue;         /**< reference value for the events */
+  POINT3DZ refpoint;       /**< reference point for the events */
+  int32 srid;              /**< SRID of the reference point */
+  int maxkeys;             /**< maximum number of keys */
+  int nkeys;               /**< current number of keys */
+  int capacity;            /**< number of slots of the hash table */
+  WindowKeyState *states;  /**< hash table of key states */
+  WindowAcc *panes;        /**< storage of the panes of all slots */
+} WindowOp;
+
+/*****************************************************************************/
+
+extern WindowOp *tumbling_window_make(CachedType temptype,
+  const Interval *size, TimestampTz origin, int maxkeys);
+extern WindowOp *sliding_window_make(CachedType temptype,
+  const Interval *size, const Interval *slide, TimestampTz origin,
+  int maxkeys);
+extern WindowOp *session_window_make(CachedType temptype, const Interval *gap,
+  int maxkeys);
+extern void window_op_set_dwithin(WindowOp *op, Datum value, double dist);
+extern bool window_op_consume(WindowOp *op, int64 key, const TInstant *inst,
+  window_emit_fn emit, void *extra);
+extern int window_op_expire(WindowOp *op, TimestampTz watermark,
+  window_emit_fn emit, void *extra);
+extern int window_op_flush(WindowOp *op, window_emit_fn emit, void *extra);
+extern size_t window_op_mem_size(const WindowOp *op);
+extern void window_op_free(WindowOp *op);
+
+/*****************************************************************************/
+
+#endif /* __TEMPORAL_STREAM_H__ */
@@ -119,6 +119,7 @@ extern Temporal **temporalarr_extract(ArrayType *array, int *count);
 
 extern ArrayType *datumarr_to_array(Datum *values, int count, CachedType type);
 extern ArrayType *timestamparr_to_array(const TimestampTz *times, int count);
+extern ArrayType *int64arr_to_array(const int64 *values, int count);
 extern ArrayType *periodarr_to_array(const Period **periods, int count);
 extern ArrayType *rangearr_to_array(RangeType **ranges, int count, CachedType type);
 extern ArrayType *strarr_to_textarray(char **strarr, int count);
@@ -0,0 +1,105 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_window.h
+ * Reductions of temporal values over time windows computed without
+ * restricting the temporal values to the windows.
+ */
+
+#ifndef __TEMPORAL_WINDOW_H__
+#define __TEMPORAL_WINDOW_H__
+
+/* PostgreSQL */
+#include <postgres.h>
+#include <fmgr.h>
+/* MobilityDB */
+#include "general/temporal.h"
+
+/*****************************************************************************/
+
+/**
+ * Number of instants of the blocks of the sparse tables
+ */
+#define TWINDOW_BLOCK_SIZE  32
+
+/**
+ * Structure to represent the per-value structures used for answering
+ * repeated window queries over a temporal sequence (set) value.
+ *
+ * The instants of all the sequences are numbered consecutively. The
+ * cumulative measure (integral or length) is continuous across the gaps
+ * between the sequences so that the measure of any range of instants is
+ * the difference of two entries. The durations and the values of the
+ * instantaneous sequences are accumulated per sequence. The minimum and
+ * maximum values are answered with sparse tables over blocks of
+ * `TWINDOW_BLOCK_SIZE` instants.
+ */
+typedef struct
+{
+  int numseqs;           /**< number of sequences */
+  int count;             /**< total number of instants */
+  int *offset;           /**< number of the first instant of each sequence */
+  double *measure;       /**< cumulative measure up to each instant */
+  int64 *days;           /**< cumulative days of the durations */
+  int64 *time;           /**< cumulative time of the durations */
+  double *instsum;       /**< cumulative values of instantaneous sequences */
+  int *instcount;        /**< cumulative number of instantaneous sequences */
+  double *values;        /**< values of the instants, NULL for points */
+  int numblocks;         /**< number of blocks of the sparse tables */
+  int levels;            /**< number of levels of the sparse tables */
+  double *mintable;      /**< minimum of 2^level consecutive blocks */
+  double *maxtable;      /**< maximum of 2^level consecutive blocks */
+} TWindowIndex;
+
+/**
+ * Struct for storing the state that persists across multiple calls
+ * computing the reductions of a temporal value over an array of windows
+ */
+typedef struct
+{
+  Temporal *temp;        /**< temporal value */
+  TWindowIndex *idx;     /**< per-value structures, NULL for a single window */
+  Period **periods;      /**< windows */
+  int count;             /**< number of windows */
+  int i;                 /**< number of the next window */
+} TWindowListState;
+
+/*****************************************************************************/
+
+extern TWindowIndex *temporal_window_index(const Temporal *temp);
+extern void twindow_index_free(TWindowIndex *idx);
+extern bool tnumber_window_stats(const Temporal *temp, const Period *p,
+  const TWindowIndex *idx, TNumberStats *stats);
+extern bool tpoint_window_length(const Temporal *temp, const Period *p,
+  const TWindowIndex *idx, double *result);
+
+/*****************************************************************************/
+
+#endif
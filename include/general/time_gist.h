@@ -43,6 +43,11 @@
 
 /*****************************************************************************/
 
+/* Maximum number of periods kept in the key of the multi-period opclasses */
+#define MULTIPERIOD_MAX_PERIODS 8
+
+/*****************************************************************************/
+
 extern int common_entry_cmp(const void *i1, const void *i2);
 
 extern bool period_index_consistent_leaf(const Period *key, const Period *query,
@@ -51,6 +56,10 @@ extern bool period_gist_consistent(const Period *key, const Period *query,
   StrategyNumber strategy);
 extern bool period_index_recheck(StrategyNumber strategy);
 
+extern PeriodSet *periodarr_multiperiod(const Period **periods, int count,
+  int maxcount);
+extern PeriodSet *periodset_multiperiod(const PeriodSet *ps);
+
 #endif
 
 /*****************************************************************************/
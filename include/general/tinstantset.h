@@ -57,6 +57,10 @@ extern TInstantSet *tinstantset_copy(const TInstantSet *ti);
 extern void *tinstantset_bbox_ptr(const TInstantSet *ti);
 extern void tinstantset_bbox(const TInstantSet *ti, void *box);
 extern TInstantSet *tinstantset_make1(const TInstant **instants, int count);
+extern TInstantSet *tinstantset_make_trusted(const TInstant **instants,
+  int count);
+extern TInstantSet *tinstantset_make_trusted_free(TInstant **instants,
+  int count);
 extern bool tinstantset_find_timestamp(const TInstantSet *ti, TimestampTz t,
   int *pos);
 
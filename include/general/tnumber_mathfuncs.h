@@ -56,6 +56,26 @@ typedef enum
   DIST,
 } TArithmetic;
 
+/** Function computing the delta between two consecutive instants */
+
+typedef Datum (*delta_func)(const TInstant *, const TInstant *);
+
+/**
+ * Structure accumulating the time integrals needed for computing the
+ * cross-correlation of two temporal numbers
+ */
+typedef struct
+{
+  double xref;      /**< Reference value subtracted from the first values */
+  double yref;      /**< Reference value subtracted from the second values */
+  double duration;  /**< Duration of the common time span in seconds */
+  double sx;        /**< Integral of x */
+  double sy;        /**< Integral of y */
+  double sxx;       /**< Integral of x * x */
+  double syy;       /**< Integral of y * y */
+  double sxy;       /**< Integral of x * y */
+} XCorrState;
+
 /*****************************************************************************/
 
 extern bool tnumber_mult_tp_at_timestamp(const TInstant *start1,
@@ -83,6 +103,17 @@ extern TSequence *tnumberseq_derivative(const TSequence *seq);
 extern TSequenceSet *tnumberseqset_derivative(const TSequenceSet *ts);
 extern Temporal *tnumber_derivative(const Temporal *temp);
 
+extern Temporal *temporal_delta(const Temporal *temp, int64 maxgap,
+  delta_func func, CachedType restype);
+extern Temporal *temporal_time_delta(const Temporal *temp, int64 maxgap);
+extern Temporal *tnumber_value_delta(const Temporal *temp, int64 maxgap);
+extern int64 delta_get_maxgap(FunctionCallInfo fcinfo);
+
+extern void tnumber_xcorr(const Temporal *temp1, const Temporal *temp2,
+  const int64 *lags, int count, double *values, bool *isnull);
+extern bool tnumber_best_lag(const Temporal *temp1, const Temporal *temp2,
+  const int64 *lags, int count, int64 *lag, double *corr);
+
 /*****************************************************************************/
 
 #endif
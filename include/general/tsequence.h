@@ -61,6 +61,10 @@ extern void tsequence_make_valid1(const TInstant **instants, int count,
   bool lower_inc, bool upper_inc, bool linear);
 extern TSequence *tsequence_make1(const TInstant **instants, int count,
   bool lower_inc, bool upper_inc, bool linear, bool normalize);
+extern TSequence *tsequence_make_trusted(const TInstant **instants, int count,
+  bool lower_inc, bool upper_inc, bool linear, bool normalize);
+extern TSequence *tsequence_make_trusted_free(TInstant **instants, int count,
+  bool lower_inc, bool upper_inc, bool linear, bool normalize);
 extern TSequence **tseqarr2_to_tseqarr(TSequence ***sequences,
   int *countseqs, int count, int totalseqs);
 
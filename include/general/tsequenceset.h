@@ -52,6 +52,10 @@ extern TSequenceSet *tsequenceset_make(const TSequence **sequences, int count,
   bool normalize);
 extern TSequenceSet * tsequenceset_make_free(TSequence **sequences, int count,
   bool normalize);
+extern TSequenceSet *tsequenceset_make_trusted(const TSequence **sequences,
+  int count, bool normalize);
+extern TSequenceSet *tsequenceset_make_trusted_free(TSequence **sequences,
+  int count, bool normalize);
 extern TSequenceSet *tsequenceset_make_gaps(const TInstant **instants,
   int count, bool linear, float maxdist, Interval *maxt);
 extern TSequenceSet *tsequenceset_copy(const TSequenceSet *ts);
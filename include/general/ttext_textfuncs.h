@@ -29,7 +29,8 @@
 
 /**
  * @file ttext_textfuncs.h
- * Temporal text functions: `textcat`, `lower`, `upper`.
+ * Temporal text functions: `textcat`, `lower`, `upper`, and pattern
+ * matching.
  */
 
 #ifndef __TTEXT_TEXTFUNCS_H__
@@ -44,6 +45,43 @@
 
 /*****************************************************************************/
 
+/**
+ * Kind of pattern matched against the values of a temporal text
+ */
+typedef enum
+{
+  PATTERN_LIKE,
+  PATTERN_ILIKE,
+  PATTERN_REGEX,
+} PatternKind;
+
+/** Number of entries of the cache of matched strings */
+#define PATTERN_CACHE_SIZE 64
+
+/**
+ * Entry of the cache of matched strings
+ */
+typedef struct
+{
+  uint32 hash;        /**< Hash value of the string */
+  text *value;        /**< Copy of the string, NULL if the entry is empty */
+  bool match;         /**< True if the string matches the pattern */
+} PatternMatch;
+
+/**
+ * Structure to represent a pattern matched against temporal text values
+ */
+typedef struct
+{
+  PatternKind kind;   /**< Kind of pattern */
+  text *pattern;      /**< Copy of the pattern */
+  Oid collation;      /**< Collation used for matching the pattern */
+  MemoryContext mcxt; /**< Memory context of the cached strings */
+  PatternMatch cache[PATTERN_CACHE_SIZE]; /**< Direct-mapped cache */
+} TextPattern;
+
+/*****************************************************************************/
+
 extern Datum datum_textcat(Datum l, Datum r);
 extern Datum datum_lower(Datum value);
 extern Datum datum_upper(Datum value);
@@ -55,6 +93,14 @@ extern Temporal *textfunc_ttext_text(const Temporal *temp, Datum value,
 extern Temporal *textfunc_ttext_ttext(const Temporal *temp1,
   const Temporal *temp2, datum_func2 func);
 
+extern TextPattern *textpattern_make(const text *pattern, PatternKind kind,
+  Oid collation);
+extern void textpattern_free(TextPattern *pat);
+extern bool textpattern_match(TextPattern *pat, Datum value);
+extern Temporal *ttext_match_pattern(const Temporal *temp, TextPattern *pat);
+extern Temporal *ttext_restrict_pattern(const Temporal *temp,
+  TextPattern *pat, bool atfunc);
+
 /*****************************************************************************/
 
 #endif
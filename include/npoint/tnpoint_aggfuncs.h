@@ -39,9 +39,52 @@
 #include <postgres.h>
 #include <catalog/pg_type.h>
 #include <fmgr.h>
+#include <utils/hsearch.h>
+#include <utils/timestamp.h>
 
 /*****************************************************************************/
 
+/**
+ * Key of the cells of edge statistics aggregation
+ */
+typedef struct
+{
+  int64 rid;            /**< route identifier */
+  TimestampTz bucket;   /**< initial timestamp of the time bucket */
+} EdgeStatsKey;
+
+/**
+ * Cell of edge statistics aggregation
+ */
+typedef struct
+{
+  EdgeStatsKey key;     /**< route identifier and time bucket, hash key */
+  int64 duration;       /**< traversal time in PostgreSQL time units */
+  double distance;      /**< traversed distance in units of the route length */
+  int64 entries;        /**< number of entries into the route */
+  int64 exits;          /**< number of exits from the route */
+} EdgeStatsEntry;
+
+/**
+ * Entry of the cache of route lengths of edge statistics aggregation
+ */
+typedef struct
+{
+  int64 rid;            /**< route identifier, hash key */
+  double length;        /**< route length */
+} RouteLengthEntry;
+
+/**
+ * State of edge statistics aggregation
+ */
+typedef struct
+{
+  int64 size;           /**< size of the time buckets */
+  TimestampTz origin;   /**< origin of the time buckets */
+  HTAB *cells;          /**< cells by route identifier and time bucket */
+  HTAB *lengths;        /**< lengths of the routes already read */
+} EdgeStatsState;
+
 /*****************************************************************************/
 
 #endif /* __TNPOINT_AGGFUNCS_H__ */
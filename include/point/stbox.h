@@ -43,6 +43,7 @@
 #include <liblwgeom.h>
 /* MobilityDB */
 #include "general/timetypes.h"
+#include "general/tbox.h"
 
 /*****************************************************************************
  * Struct definition
@@ -65,6 +66,25 @@ typedef struct
   int16       flags;  /**< flags */
 } STBOX;
 
+/**
+ * Structure to represent a buffer of spatiotemporal boxes with the same
+ * dimensions and SRID as a structure of arrays
+ */
+typedef struct
+{
+  int         count;  /**< number of boxes */
+  int32       srid;   /**< SRID shared by all the boxes */
+  int16       flags;  /**< flags shared by all the boxes */
+  double      *xmin;  /**< minimum x values */
+  double      *xmax;  /**< maximum x values */
+  double      *ymin;  /**< minimum y values */
+  double      *ymax;  /**< maximum y values */
+  double      *zmin;  /**< minimum z values */
+  double      *zmax;  /**< maximum z values */
+  TimestampTz *tmin;  /**< minimum timestamps */
+  TimestampTz *tmax;  /**< maximum timestamps */
+} STBoxBuffer;
+
 /*****************************************************************************
  * fmgr macros
  *****************************************************************************/
@@ -156,6 +176,15 @@ extern bool overlaps_stbox_stbox(const STBOX *box1, const STBOX *box2);
 extern bool same_stbox_stbox(const STBOX *box1, const STBOX *box2);
 extern bool adjacent_stbox_stbox(const STBOX *box1, const STBOX *box2);
 
+/* Batch topological operators */
+
+extern STBoxBuffer *stboxbuf_make(const STBOX *boxes, int count);
+extern int stboxbuf_filter(const STBOX *box, const STBoxBuffer *buf,
+  BoxPred pred, uint8 *bitmap);
+extern int stboxarr_filter(const STBOX *box, const STBOX *boxes, int count,
+  BoxPred pred, int *sel);
+extern void stboxbuf_free(STBoxBuffer *buf);
+
 /* Position operators */
 
 extern bool left_stbox_stbox(const STBOX *box1, const STBOX *box2);
@@ -102,6 +102,16 @@
 #define MOBDB_WKB_SRIDFLAG         0x40
 #define MOBDB_WKB_LINEAR_INTERP    0x80
 
+/*****************************************************************************
+ * Encoded polyline
+ *****************************************************************************/
+
+/* Offset of the characters of the polyline alphabet, which are '?' to '~' */
+#define POLYLINE_CHAR_OFFSET        63
+/* Number of decimal digits of the coordinates */
+#define POLYLINE_DEFAULT_PRECISION  5
+#define POLYLINE_MAX_PRECISION      15
+
 /*****************************************************************************/
 
 /* General functions */
@@ -39,6 +39,7 @@
 #include <postgres.h>
 #include <fmgr.h>
 #include <catalog/pg_type.h>
+#include <utils/hsearch.h>
 /* MobilityDB */
 #include "general/temporal.h"
 #include "general/skiplist.h"
@@ -60,7 +61,40 @@ extern void geoaggstate_check_temp(const SkipList *state, const Temporal *t);
 
 /*****************************************************************************/
 
+#define TCENTROID_INITIAL_CAPACITY 1024
+
+/**
+ * Entry of the temporal centroid state keeping the compensated sums of the
+ * coordinates and the number of points at a timestamp
+ */
+typedef struct
+{
+  TimestampTz t;     /**< timestamp, hash key */
+  double sum[3];     /**< sums of the x, y, and z coordinates */
+  double comp[3];    /**< compensations of the sums */
+  int64 count;       /**< number of points */
+} TCentroidEntry;
+
+/**
+ * State of temporal centroid aggregation. Only the values with instant or
+ * instant set subtype accumulate the raw coordinates by timestamp in a hash
+ * table. The values with sequence or sequence set subtype are still
+ * transformed into temporal double3/double4 values kept in a skiplist, which
+ * synchronizes their interpolated values.
+ */
+typedef struct
+{
+  int32 srid;          /**< SRID of the values */
+  bool hasz;           /**< the values have Z coordinates */
+  int16 subtype;       /**< INSTANT for instants and instant sets, SEQUENCE
+                            for sequences and sequence sets */
+  HTAB *hash;          /**< entries by timestamp for instantaneous values */
+  SkipList *seqstate;  /**< skiplist state for sequence values */
+} TCentroidState;
+
 extern Temporal **tpoint_transform_tcentroid(const Temporal *temp, int *count);
+extern TCentroidState *tpoint_tcentroid_transfn(FunctionCallInfo fcinfo,
+  TCentroidState *state, const Temporal *temp);
 
 /*****************************************************************************/
 
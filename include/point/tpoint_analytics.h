@@ -57,6 +57,14 @@ extern Temporal *tfloat_simplify(Temporal *temp, double eps_dist);
 extern Temporal *tpoint_simplify(Temporal *temp, double eps_dist,
   double eps_speed);
 
+/* Outlier removal and smoothing of temporal points */
+
+extern Temporal *tpoint_filter_speed(const Temporal *temp, double maxspeed,
+  double maxaccel);
+extern Temporal *tpoint_filter_median(const Temporal *temp, int size);
+extern Temporal *tpoint_filter_kalman(const Temporal *temp, double q,
+  double r);
+
 /* Transform the temporal point to Mapbox Vector Tile format */
 
 extern bool tpoint_AsMVTGeom(const Temporal *temp, const STBOX *bounds,
@@ -29,7 +29,7 @@
 
 /**
  * @file tpoint_in.h
- * Input of temporal points in WKT, EWKT and MF-JSON format
+ * Input of temporal points in WKT, EWKT, MF-JSON and encoded polyline format
  */
 
 #ifndef __TPOINT_IN_H__
@@ -54,11 +54,16 @@ extern TSequence *tpointseq_from_mfjson(json_object *mfjson, int srid,
   CachedType temptype, bool linear);
 extern TSequenceSet *tpointseqset_from_mfjson(json_object *mfjson, int srid,
   CachedType temptype, bool linear);
+extern char *tpoint_mfjson_srs(json_object *poObj);
+extern Temporal *tpoint_from_mfjson_obj(json_object *poObj, int srid,
+  CachedType temptype);
 extern Temporal *tpoint_from_mfjson_ext(FunctionCallInfo fcinfo,
   text *mfjson_input, CachedType temptype);
 extern Temporal *tpoint_from_ewkb(uint8_t *wkb, int size);
 extern Temporal *tpoint_from_hexewkb(const char *hexwkb);
 extern Temporal *tpoint_from_ewkt(const char *wkt, Oid temptypid);
+extern Temporal *tpoint_from_polyline(const char *polyline, size_t size,
+  bool binary, CachedType temptype);
 
 /*****************************************************************************/
 
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file tpoint_livestore.h
+ * Shared-memory store of the latest positions of moving objects.
+ */
+
+#ifndef __TPOINT_LIVESTORE_H__
+#define __TPOINT_LIVESTORE_H__
+
+/* PostgreSQL */
+#include <postgres.h>
+#include <fmgr.h>
+
+/*****************************************************************************/
+
+/* Default values of the configuration parameters */
+
+#define LIVESTORE_DEFAULT_CAPACITY  0
+#define LIVESTORE_MAX_CAPACITY      (1 << 26)
+#define LIVESTORE_DEFAULT_TAIL      8
+#define LIVESTORE_MAX_TAIL          256
+#define LIVESTORE_DEFAULT_CELLSIZE  1000.0
+
+/*****************************************************************************/
+
+extern void livestore_init(void);
+
+/*****************************************************************************/
+
+#endif
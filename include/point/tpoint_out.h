@@ -29,7 +29,7 @@
 
 /**
  * @file tpoint_out.h
- * Output of temporal points in WKT, EWKT and MF-JSON format
+ * Output of temporal points in WKT, EWKT, MF-JSON and encoded polyline format
  */
 
 #ifndef __TPOINT_OUT_H__
@@ -65,6 +65,8 @@ extern uint8_t *tpoint_to_wkb(const Temporal *temp, uint8_t variant,
   size_t *size_out);
 extern char *tpoint_as_hexewkb(const Temporal *temp, uint8_t variant,
   size_t *size);
+extern char *tpoint_as_polyline(const Temporal *temp, int precision,
+  bool binary, size_t *size);
 
 /*****************************************************************************/
 
@@ -41,6 +41,7 @@
 #include <liblwgeom.h>
 /* MobilityDB */
 #include "general/temporal.h"
+#include "point/stbox.h"
 #include "point/tpoint.h"
 
 /* Get the flags byte of a GSERIALIZED depending on the version */
@@ -50,6 +51,22 @@
 #define GS_FLAGS(gs) (gs->gflags)
 #endif
 
+/**
+ * Structure to represent the summary statistics of a trip
+ */
+typedef struct
+{
+  int       numinst;      /**< number of distinct instants */
+  Interval  duration;     /**< duration */
+  double    length;       /**< length traversed */
+  bool      hasspeed;     /**< the point has at least one linear segment */
+  double    maxspeed;     /**< maximum speed over the segments */
+  double    avgspeed;     /**< length divided by the duration */
+  Datum     startvalue;   /**< start position */
+  Datum     endvalue;     /**< end position */
+  STBOX     box;          /**< bounding box */
+} TPointStats;
+
 /** Symbolic constants for transforming tgeompoint <-> tgeogpoint */
 #define GEOM_TO_GEOG        true
 #define GEOG_TO_GEOM        false
@@ -238,6 +255,8 @@ extern Temporal *tpoint_cumulative_length(const Temporal *temp);
 extern TSequence *tpointseq_speed(const TSequence *seq);
 extern TSequenceSet *tpointseqset_speed(const TSequenceSet *ts);
 extern Temporal *tpoint_speed(const Temporal *temp);
+extern Temporal *tpoint_displacement(const Temporal *temp, int64 maxgap);
+extern void tpoint_stats(const Temporal *temp, TPointStats *stats);
 
 extern Datum tpointinstset_twcentroid(const TInstantSet *ti);
 extern Datum tpointseq_twcentroid(const TSequence *seq);
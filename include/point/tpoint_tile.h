@@ -73,8 +73,58 @@ typedef struct STboxGridState
   int coords[MAXDIMS]; /**< Coordinates of the current tile */
 } STboxGridState;
 
+/**
+ * Maximum number of cells covered by a box for which keys are generated
+ */
+#define MAX_CELL_KEYS 1048576
+
+/**
+ * Key standing for all the cells, which is the only key of a temporal point
+ * traversing more than MAX_CELL_KEYS cells and is a key of every box
+ */
+#define CELL_KEY_ALL PG_INT64_MIN
+
+/**
+ * Maximum depth when halving a segment for computing its cell cover
+ */
+#define MAX_CELL_DEPTH 32
+
+/**
+ * Maximum number of partition keys added by the planner to a query
+ */
+#define MAX_PARTITION_KEYS 10000
+
+/**
+ * Struct for collecting the keys of the cells of a spatial or spatiotemporal
+ * grid covered by a value
+ */
+typedef struct
+{
+  int numdims;           /**< Number of dimensions, 3 when there is time */
+  double size[3];        /**< Size of the cells in each dimension */
+  double origin[3];      /**< Origin of the cells in each dimension */
+  int count;             /**< Number of keys */
+  int maxcount;          /**< Number of allocated keys */
+  int64 *keys;           /**< Array of keys */
+  bool all;              /**< True when there are too many keys */
+} CellCover;
+
 /*****************************************************************************/
 
+/* Cell coverings */
+
+extern int64 *tpoint_cells(const Temporal *temp, double size, int64 tunits,
+  const POINT3DZ *sorigin, TimestampTz torigin, int *count);
+extern int64 *stbox_cells(const STBOX *box, double size, int64 tunits,
+  const POINT3DZ *sorigin, TimestampTz torigin, int *count);
+
+/* Partition keys */
+
+extern int64 tpoint_partition_key(const Temporal *temp, double size,
+  int64 tunits, const POINT3DZ *sorigin, TimestampTz torigin);
+extern int64 *stbox_partition_keys(const STBOX *box, double size,
+  int64 tunits, const POINT3DZ *sorigin, TimestampTz torigin, int maxcount,
+  int *count);
 
 /*****************************************************************************/
 
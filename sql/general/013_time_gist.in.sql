@@ -252,3 +252,174 @@ CREATE OPERATOR CLASS periodset_rtree_ops
   FUNCTION  7  period_gist_same(period, period, internal);
 
 /******************************************************************************/
+
+/******************************************************************************
+ * Multi-period GiST indexes
+ *
+ * These opclasses are not the default ones. They store in the index a
+ * bounded number of disjoint periods covering the value instead of its
+ * bounding period, which gives a better selectivity for sparse values, e.g.,
+ * CREATE INDEX ON tbl USING gist(ps periodset_multi_rtree_ops);
+ ******************************************************************************/
+
+CREATE FUNCTION timestampset_gist_multi_consistent(internal, timestampset,
+    smallint, oid, internal)
+  RETURNS bool
+  AS 'MODULE_PATHNAME', 'Periodset_gist_multi_consistent'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION periodset_gist_multi_consistent(internal, periodset,
+    smallint, oid, internal)
+  RETURNS bool
+  AS 'MODULE_PATHNAME', 'Periodset_gist_multi_consistent'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION periodset_gist_multi_union(internal, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Periodset_gist_multi_union'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION timestampset_gist_multi_compress(internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Timestampset_gist_multi_compress'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION periodset_gist_multi_compress(internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Periodset_gist_multi_compress'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION periodset_gist_multi_penalty(internal, internal, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Periodset_gist_multi_penalty'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION periodset_gist_multi_picksplit(internal, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Periodset_gist_multi_picksplit'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION periodset_gist_multi_same(periodset, periodset, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Periodset_gist_multi_same'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION timestampset_gist_multi_distance(internal, timestampset,
+    smallint, oid, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Periodset_gist_multi_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION periodset_gist_multi_distance(internal, periodset,
+    smallint, oid, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Periodset_gist_multi_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE OPERATOR CLASS timestampset_multi_rtree_ops
+  FOR TYPE timestampset USING gist AS
+  STORAGE periodset,
+  -- overlaps
+  OPERATOR  3    && (timestampset, timestampset),
+  OPERATOR  3    && (timestampset, period),
+  OPERATOR  3    && (timestampset, periodset),
+  -- contains
+  OPERATOR  7    @> (timestampset, timestamptz),
+  OPERATOR  7    @> (timestampset, timestampset),
+  -- contained by
+  OPERATOR  8    <@ (timestampset, timestampset),
+  OPERATOR  8    <@ (timestampset, period),
+  OPERATOR  8    <@ (timestampset, periodset),
+  -- adjacent
+  OPERATOR  17    -|- (timestampset, period),
+  OPERATOR  17    -|- (timestampset, periodset),
+  -- equals
+  OPERATOR  18    = (timestampset, timestampset),
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  -- nearest approach distance
+  OPERATOR  25    |=| (timestampset, timestamptz) FOR ORDER BY pg_catalog.float_ops,
+  OPERATOR  25    |=| (timestampset, timestampset) FOR ORDER BY pg_catalog.float_ops,
+  OPERATOR  25    |=| (timestampset, period) FOR ORDER BY pg_catalog.float_ops,
+  OPERATOR  25    |=| (timestampset, periodset) FOR ORDER BY pg_catalog.float_ops,
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
+  -- overlaps or before
+  OPERATOR  28    &<# (timestampset, timestamptz),
+  OPERATOR  28    &<# (timestampset, timestampset),
+  OPERATOR  28    &<# (timestampset, period),
+  OPERATOR  28    &<# (timestampset, periodset),
+  -- strictly before
+  OPERATOR  29    <<# (timestampset, timestamptz),
+  OPERATOR  29    <<# (timestampset, timestampset),
+  OPERATOR  29    <<# (timestampset, period),
+  OPERATOR  29    <<# (timestampset, periodset),
+  -- strictly after
+  OPERATOR  30    #>> (timestampset, timestamptz),
+  OPERATOR  30    #>> (timestampset, timestampset),
+  OPERATOR  30    #>> (timestampset, period),
+  OPERATOR  30    #>> (timestampset, periodset),
+  -- overlaps or after
+  OPERATOR  31    #&> (timestampset, timestamptz),
+  OPERATOR  31    #&> (timestampset, timestampset),
+  OPERATOR  31    #&> (timestampset, period),
+  OPERATOR  31    #&> (timestampset, periodset),
+  -- functions
+  FUNCTION  1  timestampset_gist_multi_consistent(internal, timestampset,
+    smallint, oid, internal),
+  FUNCTION  2  periodset_gist_multi_union(internal, internal),
+  FUNCTION  3  timestampset_gist_multi_compress(internal),
+  FUNCTION  5  periodset_gist_multi_penalty(internal, internal, internal),
+  FUNCTION  6  periodset_gist_multi_picksplit(internal, internal),
+  FUNCTION  7  periodset_gist_multi_same(periodset, periodset, internal),
+  FUNCTION  8  timestampset_gist_multi_distance(internal, timestampset,
+    smallint, oid, internal);
+
+CREATE OPERATOR CLASS periodset_multi_rtree_ops
+  FOR TYPE periodset USING gist AS
+  STORAGE periodset,
+  -- overlaps
+  OPERATOR  3    && (periodset, timestampset),
+  OPERATOR  3    && (periodset, period),
+  OPERATOR  3    && (periodset, periodset),
+  -- contains
+  OPERATOR  7    @> (periodset, timestamptz),
+  OPERATOR  7    @> (periodset, timestampset),
+  OPERATOR  7    @> (periodset, period),
+  OPERATOR  7    @> (periodset, periodset),
+  -- contained by
+  OPERATOR  8    <@ (periodset, period),
+  OPERATOR  8    <@ (periodset, periodset),
+  -- adjacent
+  OPERATOR  17    -|- (periodset, period),
+  OPERATOR  17    -|- (periodset, periodset),
+  -- equals
+  OPERATOR  18    = (periodset, periodset),
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  -- nearest approach distance
+  OPERATOR  25    |=| (periodset, timestamptz) FOR ORDER BY pg_catalog.float_ops,
+  OPERATOR  25    |=| (periodset, timestampset) FOR ORDER BY pg_catalog.float_ops,
+  OPERATOR  25    |=| (periodset, period) FOR ORDER BY pg_catalog.float_ops,
+  OPERATOR  25    |=| (periodset, periodset) FOR ORDER BY pg_catalog.float_ops,
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
+  -- overlaps or before
+  OPERATOR  28    &<# (periodset, timestamptz),
+  OPERATOR  28    &<# (periodset, timestampset),
+  OPERATOR  28    &<# (periodset, period),
+  OPERATOR  28    &<# (periodset, periodset),
+  -- strictly before
+  OPERATOR  29    <<# (periodset, timestamptz),
+  OPERATOR  29    <<# (periodset, timestampset),
+  OPERATOR  29    <<# (periodset, period),
+  OPERATOR  29    <<# (periodset, periodset),
+  -- strictly after
+  OPERATOR  30    #>> (periodset, timestamptz),
+  OPERATOR  30    #>> (periodset, timestampset),
+  OPERATOR  30    #>> (periodset, period),
+  OPERATOR  30    #>> (periodset, periodset),
+  -- overlaps or after
+  OPERATOR  31    #&> (periodset, timestamptz),
+  OPERATOR  31    #&> (periodset, timestampset),
+  OPERATOR  31    #&> (periodset, period),
+  OPERATOR  31    #&> (periodset, periodset),
+  -- functions
+  FUNCTION  1  periodset_gist_multi_consistent(internal, periodset, smallint,
+    oid, internal),
+  FUNCTION  2  periodset_gist_multi_union(internal, internal),
+  FUNCTION  3  periodset_gist_multi_compress(internal),
+  FUNCTION  5  periodset_gist_multi_penalty(internal, internal, internal),
+  FUNCTION  6  periodset_gist_multi_picksplit(internal, internal),
+  FUNCTION  7  periodset_gist_multi_same(periodset, periodset, internal),
+  FUNCTION  8  periodset_gist_multi_distance(internal, periodset, smallint,
+    oid, internal);
+
+/******************************************************************************/
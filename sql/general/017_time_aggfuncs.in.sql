@@ -44,6 +44,16 @@ CREATE FUNCTION tagg_deserialize(bytea, internal)
   AS 'MODULE_PATHNAME', 'Tagg_deserialize'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE TYPE aggspill_stats AS (
+  runs bigint,
+  bytes bigint
+);
+
+CREATE FUNCTION aggregateSpillStats()
+  RETURNS aggspill_stats
+  AS 'MODULE_PATHNAME', 'Aggregate_spill_stats'
+  LANGUAGE C VOLATILE STRICT PARALLEL SAFE;
+
 /*****************************************************************************/
 
 CREATE FUNCTION timestampset_extent_transfn(period, timestampset)
@@ -269,6 +269,20 @@ CREATE FUNCTION tbox_adjacent(tbox, tbox)
   AS 'MODULE_PATHNAME', 'Adjacent_tbox_tbox'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+-- Positions of the boxes of the array that satisfy the predicate
+CREATE FUNCTION tbox_contains(tbox, tbox[])
+  RETURNS integer[]
+  AS 'MODULE_PATHNAME', 'Contains_tbox_tboxarr'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tbox_contained(tbox, tbox[])
+  RETURNS integer[]
+  AS 'MODULE_PATHNAME', 'Contained_tbox_tboxarr'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tbox_overlaps(tbox, tbox[])
+  RETURNS integer[]
+  AS 'MODULE_PATHNAME', 'Overlaps_tbox_tboxarr'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 CREATE OPERATOR @> (
   PROCEDURE = tbox_contains,
   LEFTARG = tbox, RIGHTARG = tbox,
@@ -553,6 +553,12 @@ CREATE FUNCTION merge(ttext[])
   AS 'MODULE_PATHNAME', 'Temporal_merge_array'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION compactTable(regclass, idcol text, tcol text,
+    maxgap interval DEFAULT '0 seconds')
+  RETURNS integer
+  AS 'MODULE_PATHNAME', 'Compact_table'
+  LANGUAGE C VOLATILE STRICT;
+
 /******************************************************************************
  * Accessor functions
  ******************************************************************************/
@@ -1926,6 +1932,56 @@ CREATE FUNCTION minusPeriodSet(ttext, periodset)
   AS 'MODULE_PATHNAME', 'Temporal_minus_periodset'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION atTimeOfDay(temp tbool, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS tbool
+  AS 'MODULE_PATHNAME', 'Temporal_at_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION atTimeOfDay(temp tint, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS tint
+  AS 'MODULE_PATHNAME', 'Temporal_at_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION atTimeOfDay(temp tfloat, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Temporal_at_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION atTimeOfDay(temp ttext, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS ttext
+  AS 'MODULE_PATHNAME', 'Temporal_at_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION minusTimeOfDay(temp tbool, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS tbool
+  AS 'MODULE_PATHNAME', 'Temporal_minus_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION minusTimeOfDay(temp tint, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS tint
+  AS 'MODULE_PATHNAME', 'Temporal_minus_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION minusTimeOfDay(temp tfloat, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Temporal_minus_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION minusTimeOfDay(temp ttext, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS ttext
+  AS 'MODULE_PATHNAME', 'Temporal_minus_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 /*****************************************************************************
  * Intersection Functions
  *****************************************************************************/
@@ -2046,6 +2102,72 @@ CREATE FUNCTION intersectsPeriodSet(ttext, periodset)
 #endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION intersectsTimeOfDay(temp tbool, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_intersects_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION intersectsTimeOfDay(temp tint, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_intersects_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION intersectsTimeOfDay(temp tfloat, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_intersects_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION intersectsTimeOfDay(temp ttext, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_intersects_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION intersectsTimeOfDay(temp tbool, p period,
+  starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_intersects_period_recurring'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT temporal_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION intersectsTimeOfDay(temp tint, p period,
+  starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_intersects_period_recurring'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tnumber_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION intersectsTimeOfDay(temp tfloat, p period,
+  starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_intersects_period_recurring'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tnumber_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION intersectsTimeOfDay(temp ttext, p period,
+  starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_intersects_period_recurring'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT temporal_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 /*****************************************************************************
  * Value Aggregate Functions
  *****************************************************************************/
@@ -2068,6 +2190,40 @@ CREATE FUNCTION twAvg(tfloat)
   AS 'MODULE_PATHNAME', 'Tnumber_twavg'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE TYPE tnumber_stats AS (
+  minValue float,
+  maxValue float,
+  twAvg float,
+  integral float,
+  duration interval
+);
+
+CREATE FUNCTION summaryStats(tint)
+  RETURNS tnumber_stats
+  AS 'MODULE_PATHNAME', 'Tnumber_stats'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION summaryStats(tfloat)
+  RETURNS tnumber_stats
+  AS 'MODULE_PATHNAME', 'Tnumber_stats'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION summaryStats(tint, period)
+  RETURNS tnumber_stats
+  AS 'MODULE_PATHNAME', 'Tnumber_window_stats'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION summaryStats(tfloat, period)
+  RETURNS tnumber_stats
+  AS 'MODULE_PATHNAME', 'Tnumber_window_stats'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION summaryStats(tint, period[])
+  RETURNS SETOF tnumber_stats
+  AS 'MODULE_PATHNAME', 'Tnumber_window_stats_array'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION summaryStats(tfloat, period[])
+  RETURNS SETOF tnumber_stats
+  AS 'MODULE_PATHNAME', 'Tnumber_window_stats_array'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 /*****************************************************************************
  * Selectivity functions for operators
  *****************************************************************************/
@@ -486,4 +486,60 @@ CREATE FUNCTION derivative(tfloat)
   AS 'MODULE_PATHNAME', 'Tnumber_derivative'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION timeDelta(tint)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Temporal_time_delta'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION timeDelta(tint, maxGap interval)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Temporal_time_delta'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION timeDelta(tfloat)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Temporal_time_delta'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION timeDelta(tfloat, maxGap interval)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Temporal_time_delta'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION valueDelta(tint)
+  RETURNS tint
+  AS 'MODULE_PATHNAME', 'Tnumber_value_delta'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION valueDelta(tint, maxGap interval)
+  RETURNS tint
+  AS 'MODULE_PATHNAME', 'Tnumber_value_delta'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION valueDelta(tfloat)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Tnumber_value_delta'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION valueDelta(tfloat, maxGap interval)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Tnumber_value_delta'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+/******************************************************************************
+ * Cross-correlation
+ ******************************************************************************/
+
+CREATE FUNCTION crossCorrelation(tint, tint, lags interval[])
+  RETURNS float[]
+  AS 'MODULE_PATHNAME', 'Tnumber_xcorr'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION crossCorrelation(tfloat, tfloat, lags interval[])
+  RETURNS float[]
+  AS 'MODULE_PATHNAME', 'Tnumber_xcorr'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION bestLag(tint, tint, lags interval[])
+  RETURNS interval
+  AS 'MODULE_PATHNAME', 'Tnumber_best_lag'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION bestLag(tfloat, tfloat, lags interval[])
+  RETURNS interval
+  AS 'MODULE_PATHNAME', 'Tnumber_best_lag'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 /******************************************************************************/
@@ -80,4 +80,41 @@ CREATE FUNCTION lower(ttext)
   AS 'MODULE_PATHNAME', 'Ttext_lower'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+/******************************************************************************
+ * Temporal pattern matching
+ *****************************************************************************/
+
+CREATE FUNCTION like(ttext, text)
+  RETURNS tbool
+  AS 'MODULE_PATHNAME', 'Ttext_like'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION ilike(ttext, text)
+  RETURNS tbool
+  AS 'MODULE_PATHNAME', 'Ttext_ilike'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION regexp_like(ttext, text)
+  RETURNS tbool
+  AS 'MODULE_PATHNAME', 'Ttext_regexp_like'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION atPattern(ttext, text)
+  RETURNS ttext
+  AS 'MODULE_PATHNAME', 'Ttext_at_pattern'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION atPattern(ttext, text, regex boolean)
+  RETURNS ttext
+  AS 'MODULE_PATHNAME', 'Ttext_at_pattern'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION minusPattern(ttext, text)
+  RETURNS ttext
+  AS 'MODULE_PATHNAME', 'Ttext_minus_pattern'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION minusPattern(ttext, text, regex boolean)
+  RETURNS ttext
+  AS 'MODULE_PATHNAME', 'Ttext_minus_pattern'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 /******************************************************************************/
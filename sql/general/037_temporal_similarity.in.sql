@@ -30,7 +30,9 @@
 /*
  * temporal_similarity.sql
  * Similarity distance for temporal values. Currently, the discrete Frechet
- * distance and the Dynamic Time Warping (DTW) distance are implemented.
+ * distance, the Dynamic Time Warping (DTW) distance, the Longest Common
+ * Subsequence (LCSS) distance, and the Edit Distance on Real sequences (EDR)
+ * are implemented.
  */
 
 CREATE FUNCTION frechetDistance(tint, tint)
@@ -109,3 +111,73 @@ CREATE FUNCTION dynamicTimeWarpPath(tfloat, tfloat)
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
 /*****************************************************************************/
+
+CREATE FUNCTION lcssDistance(tint, tint, eps float)
+  RETURNS float
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION lcssDistance(tint, tint, eps float, timeWindow interval)
+  RETURNS float
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION lcssDistance(tfloat, tfloat, eps float)
+  RETURNS float
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION lcssDistance(tfloat, tfloat, eps float, timeWindow interval)
+  RETURNS float
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION lcssWithin(tint, tint, eps float, maxDist float)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION lcssWithin(tint, tint, eps float, maxDist float, timeWindow interval)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION lcssWithin(tfloat, tfloat, eps float, maxDist float)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION lcssWithin(tfloat, tfloat, eps float, maxDist float, timeWindow interval)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION edrDistance(tint, tint, eps float)
+  RETURNS integer
+  AS 'MODULE_PATHNAME', 'Temporal_edr_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION edrDistance(tint, tint, eps float, timeWindow interval)
+  RETURNS integer
+  AS 'MODULE_PATHNAME', 'Temporal_edr_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION edrDistance(tfloat, tfloat, eps float)
+  RETURNS integer
+  AS 'MODULE_PATHNAME', 'Temporal_edr_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION edrDistance(tfloat, tfloat, eps float, timeWindow interval)
+  RETURNS integer
+  AS 'MODULE_PATHNAME', 'Temporal_edr_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION edrWithin(tint, tint, eps float, maxEdits integer)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_edr_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION edrWithin(tint, tint, eps float, maxEdits integer, timeWindow interval)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_edr_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION edrWithin(tfloat, tfloat, eps float, maxEdits integer)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_edr_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION edrWithin(tfloat, tfloat, eps float, maxEdits integer, timeWindow interval)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_edr_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+/*****************************************************************************/
@@ -557,3 +557,15 @@ CREATE OPERATOR CLASS ttext_rtree_ops
   FUNCTION  7  period_gist_same(period, period, internal);
 
 /******************************************************************************/
+
+/******************************************************************************
+ * Index quality diagnostics
+ ******************************************************************************/
+
+CREATE FUNCTION gistIndexStats(index regclass)
+  RETURNS TABLE(level integer, dimension text, nodes integer, entries bigint,
+    fillfactor float, extent float, overlap float, deadspace float)
+  AS 'MODULE_PATHNAME', 'Temporal_gist_index_stats'
+  LANGUAGE C STRICT PARALLEL SAFE;
+
+/******************************************************************************/
@@ -514,3 +514,15 @@ CREATE OPERATOR CLASS ttext_quadtree_ops
   FUNCTION  6  temporal_spgist_compress(internal);
 
 /******************************************************************************/
+
+/******************************************************************************
+ * Index quality diagnostics
+ ******************************************************************************/
+
+CREATE FUNCTION spgistIndexStats(index regclass)
+  RETURNS TABLE(level integer, dimension text, nodes integer, entries bigint,
+    fillfactor float, extent float, overlap float, deadspace float)
+  AS 'MODULE_PATHNAME', 'Temporal_spgist_index_stats'
+  LANGUAGE C STRICT PARALLEL SAFE;
+
+/******************************************************************************/
@@ -503,6 +503,20 @@ CREATE FUNCTION minusPeriodSet(tnpoint, periodset)
   AS 'MODULE_PATHNAME', 'Temporal_minus_periodset'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION atTimeOfDay(temp tnpoint, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS tnpoint
+  AS 'MODULE_PATHNAME', 'Temporal_at_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION minusTimeOfDay(temp tnpoint, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS tnpoint
+  AS 'MODULE_PATHNAME', 'Temporal_minus_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 CREATE FUNCTION intersectsTimestamp(tnpoint, timestamptz)
   RETURNS boolean
   AS 'MODULE_PATHNAME', 'Temporal_intersects_timestamp'
@@ -535,6 +549,24 @@ CREATE FUNCTION intersectsPeriodSet(tnpoint, periodset)
 #endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION intersectsTimeOfDay(temp tnpoint, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_intersects_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION intersectsTimeOfDay(temp tnpoint, p period,
+  starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_intersects_period_recurring'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tnpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 /******************************************************************************
  * Multidimensional tiling
  ******************************************************************************/
@@ -72,8 +72,8 @@ CREATE AGGREGATE tcentroid(tnpoint) (
   STYPE = internal,
   COMBINEFUNC = tcentroid_combinefn,
   FINALFUNC = tcentroid_finalfn,
-  SERIALFUNC = tagg_serialize,
-  DESERIALFUNC = tagg_deserialize,
+  SERIALFUNC = tcentroid_serialize,
+  DESERIALFUNC = tcentroid_deserialize,
   PARALLEL = SAFE
 );
 
@@ -99,3 +99,59 @@ CREATE AGGREGATE merge(tnpoint) (
 );
 
 /*****************************************************************************/
+
+CREATE TYPE edge_stats AS (
+  rid bigint,
+  bucket timestamptz,
+  duration interval,
+  distance float,
+  speed float,
+  entries bigint,
+  exits bigint
+);
+
+CREATE FUNCTION edgeStats_transfn(internal, tnpoint, interval)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tnpoint_edgestats_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION edgeStats_transfn(internal, tnpoint, interval, timestamptz)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tnpoint_edgestats_transfn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION edgeStats_combinefn(internal, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tnpoint_edgestats_combinefn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION edgeStats_finalfn(internal)
+  RETURNS edge_stats[]
+  AS 'MODULE_PATHNAME', 'Tnpoint_edgestats_finalfn'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION edgeStats_serialize(internal)
+  RETURNS bytea
+  AS 'MODULE_PATHNAME', 'Tnpoint_edgestats_serialize'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION edgeStats_deserialize(bytea, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tnpoint_edgestats_deserialize'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE AGGREGATE edgeStats(tnpoint, interval) (
+  SFUNC = edgeStats_transfn,
+  STYPE = internal,
+  COMBINEFUNC = edgeStats_combinefn,
+  FINALFUNC = edgeStats_finalfn,
+  SERIALFUNC = edgeStats_serialize,
+  DESERIALFUNC = edgeStats_deserialize,
+  PARALLEL = SAFE
+);
+CREATE AGGREGATE edgeStats(tnpoint, interval, timestamptz) (
+  SFUNC = edgeStats_transfn,
+  STYPE = internal,
+  COMBINEFUNC = edgeStats_combinefn,
+  FINALFUNC = edgeStats_finalfn,
+  SERIALFUNC = edgeStats_serialize,
+  DESERIALFUNC = edgeStats_deserialize,
+  PARALLEL = SAFE
+);
+
+/*****************************************************************************/
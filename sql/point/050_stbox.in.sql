@@ -328,6 +328,20 @@ CREATE FUNCTION stbox_adjacent(stbox, stbox)
   AS 'MODULE_PATHNAME', 'Adjacent_stbox_stbox'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+-- Positions of the boxes of the array that satisfy the predicate
+CREATE FUNCTION stbox_contains(stbox, stbox[])
+  RETURNS integer[]
+  AS 'MODULE_PATHNAME', 'Contains_stbox_stboxarr'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION stbox_contained(stbox, stbox[])
+  RETURNS integer[]
+  AS 'MODULE_PATHNAME', 'Contained_stbox_stboxarr'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION stbox_overlaps(stbox, stbox[])
+  RETURNS integer[]
+  AS 'MODULE_PATHNAME', 'Overlaps_stbox_stboxarr'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 CREATE OPERATOR @> (
   PROCEDURE = stbox_contains,
   LEFTARG = stbox, RIGHTARG = stbox,
@@ -822,6 +822,32 @@ CREATE FUNCTION minusPeriodSet(tgeogpoint, periodset)
   AS 'MODULE_PATHNAME', 'Temporal_minus_periodset'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION atTimeOfDay(temp tgeompoint, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS tgeompoint
+  AS 'MODULE_PATHNAME', 'Temporal_at_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION atTimeOfDay(temp tgeogpoint, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS tgeogpoint
+  AS 'MODULE_PATHNAME', 'Temporal_at_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION minusTimeOfDay(temp tgeompoint, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS tgeompoint
+  AS 'MODULE_PATHNAME', 'Temporal_minus_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION minusTimeOfDay(temp tgeogpoint, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS tgeogpoint
+  AS 'MODULE_PATHNAME', 'Temporal_minus_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 /*****************************************************************************
  * Intersection Functions
  *****************************************************************************/
@@ -886,6 +912,40 @@ CREATE FUNCTION intersectsPeriodSet(tgeogpoint, periodset)
 #endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION intersectsTimeOfDay(temp tgeompoint, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_intersects_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION intersectsTimeOfDay(temp tgeogpoint, starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_intersects_recurring'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION intersectsTimeOfDay(temp tgeompoint, p period,
+  starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_intersects_period_recurring'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION intersectsTimeOfDay(temp tgeogpoint, p period,
+  starttime time, endtime time,
+  dow integer[] DEFAULT '{0,1,2,3,4,5,6}',
+  tz text DEFAULT current_setting('TimeZone'))
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_intersects_period_recurring'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 /******************************************************************************
  * Multidimensional tiling
  ******************************************************************************/
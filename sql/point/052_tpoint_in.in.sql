@@ -29,7 +29,8 @@
 
 /*
  * tpoint_in.sql
- * Input of temporal points in WKT, EWKT, EWKB, and MF-JSON format
+ * Input of temporal points in WKT, EWKT, EWKB, MF-JSON, and encoded polyline
+ * format
  */
 
 CREATE FUNCTION tgeompointFromText(text)
@@ -86,4 +87,22 @@ CREATE FUNCTION tgeogpointFromHexEWKB(text)
   AS 'MODULE_PATHNAME', 'Tpoint_from_hexewkb'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION tgeompointFromPolyline(text)
+  RETURNS tgeompoint
+  AS 'MODULE_PATHNAME', 'Tpoint_from_polyline'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tgeogpointFromPolyline(text)
+  RETURNS tgeogpoint
+  AS 'MODULE_PATHNAME', 'Tpoint_from_polyline'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION tgeompointFromPolylineBinary(bytea)
+  RETURNS tgeompoint
+  AS 'MODULE_PATHNAME', 'Tpoint_from_polyline_binary'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tgeogpointFromPolylineBinary(bytea)
+  RETURNS tgeogpoint
+  AS 'MODULE_PATHNAME', 'Tpoint_from_polyline_binary'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 /*****************************************************************************/
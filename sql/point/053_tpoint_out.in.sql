@@ -29,7 +29,7 @@
 
 /*
  * tpoint_out.sql
- * Output of temporal points in WKT, EWKT, and MF-JSON format
+ * Output of temporal points in WKT, EWKT, MF-JSON, and encoded polyline format
  */
 
 CREATE FUNCTION asText(tgeompoint)
@@ -148,4 +148,22 @@ CREATE FUNCTION asHexEWKB(tgeogpoint, endianenconding text)
   AS 'MODULE_PATHNAME', 'Tpoint_as_hexewkb'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION asPolyline(point tgeompoint, maxdecimaldigits int4 DEFAULT 5)
+  RETURNS text
+  AS 'MODULE_PATHNAME', 'Tpoint_as_polyline'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION asPolyline(point tgeogpoint, maxdecimaldigits int4 DEFAULT 5)
+  RETURNS text
+  AS 'MODULE_PATHNAME', 'Tpoint_as_polyline'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION asPolylineBinary(point tgeompoint, maxdecimaldigits int4 DEFAULT 5)
+  RETURNS bytea
+  AS 'MODULE_PATHNAME', 'Tpoint_as_polyline_binary'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION asPolylineBinary(point tgeogpoint, maxdecimaldigits int4 DEFAULT 5)
+  RETURNS bytea
+  AS 'MODULE_PATHNAME', 'Tpoint_as_polyline_binary'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 /*****************************************************************************/
@@ -162,6 +162,22 @@ CREATE FUNCTION length(tgeogpoint)
   RETURNS float
   AS 'MODULE_PATHNAME', 'Tpoint_length'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION length(tgeompoint, period)
+  RETURNS float
+  AS 'MODULE_PATHNAME', 'Tpoint_window_length'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION length(tgeogpoint, period)
+  RETURNS float
+  AS 'MODULE_PATHNAME', 'Tpoint_window_length'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION length(tgeompoint, period[])
+  RETURNS SETOF float
+  AS 'MODULE_PATHNAME', 'Tpoint_window_length_array'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION length(tgeogpoint, period[])
+  RETURNS SETOF float
+  AS 'MODULE_PATHNAME', 'Tpoint_window_length_array'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
 CREATE FUNCTION cumulativeLength(tgeompoint)
   RETURNS tfloat
@@ -181,6 +197,70 @@ CREATE FUNCTION speed(tgeogpoint)
   AS 'MODULE_PATHNAME', 'Tpoint_speed'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+CREATE FUNCTION timeDelta(tgeompoint)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Temporal_time_delta'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION timeDelta(tgeompoint, maxGap interval)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Temporal_time_delta'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION timeDelta(tgeogpoint)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Temporal_time_delta'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION timeDelta(tgeogpoint, maxGap interval)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Temporal_time_delta'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION displacement(tgeompoint)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Tpoint_displacement'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION displacement(tgeompoint, maxGap interval)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Tpoint_displacement'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION displacement(tgeogpoint)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Tpoint_displacement'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION displacement(tgeogpoint, maxGap interval)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Tpoint_displacement'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE TYPE tgeompoint_stats AS (
+  numInstants integer,
+  duration interval,
+  length float,
+  maxSpeed float,
+  avgSpeed float,
+  startValue geometry,
+  endValue geometry,
+  extent stbox
+);
+CREATE TYPE tgeogpoint_stats AS (
+  numInstants integer,
+  duration interval,
+  length float,
+  maxSpeed float,
+  avgSpeed float,
+  startValue geography,
+  endValue geography,
+  extent stbox
+);
+
+CREATE FUNCTION summaryStats(tgeompoint)
+  RETURNS tgeompoint_stats
+  AS 'MODULE_PATHNAME', 'Tpoint_stats'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION summaryStats(tgeogpoint)
+  RETURNS tgeogpoint_stats
+  AS 'MODULE_PATHNAME', 'Tpoint_stats'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 CREATE FUNCTION twcentroid(tgeompoint)
   RETURNS geometry
   AS 'MODULE_PATHNAME', 'Tpoint_twcentroid'
@@ -92,3 +92,94 @@ CREATE FUNCTION spaceTimeSplit(tgeompoint, float, interval,
   LANGUAGE C IMMUTABLE PARALLEL SAFE STRICT;
 
 /*****************************************************************************/
+
+/******************************************************************************
+ * Cell coverings
+ ******************************************************************************/
+
+CREATE FUNCTION spaceCells(tgeompoint, float,
+    sorigin geometry DEFAULT 'Point(0 0 0)')
+  RETURNS bigint[]
+  AS 'MODULE_PATHNAME', 'Tpoint_cells'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION spaceTimeCells(tgeompoint, float, interval,
+    sorigin geometry DEFAULT 'Point(0 0 0)',
+    torigin timestamptz DEFAULT '2000-01-03')
+  RETURNS bigint[]
+  AS 'MODULE_PATHNAME', 'Tpoint_cells'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION spaceCells(stbox, float,
+    sorigin geometry DEFAULT 'Point(0 0 0)')
+  RETURNS bigint[]
+  AS 'MODULE_PATHNAME', 'Stbox_cells'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION spaceTimeCells(stbox, float, interval,
+    sorigin geometry DEFAULT 'Point(0 0 0)',
+    torigin timestamptz DEFAULT '2000-01-03')
+  RETURNS bigint[]
+  AS 'MODULE_PATHNAME', 'Stbox_cells'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+/*
+ * The following functions are inlined by the planner so that a GIN index
+ * on the expression spaceCells(tpoint, size) or spaceTimeCells(tpoint, size,
+ * duration), with the same grid parameters, can be used for filtering the
+ * temporal points before testing the bounding box overlap. When the box
+ * covers too many cells its keys are NULL, the planner then folds the key
+ * test to true and only the bounding box overlap remains.
+ */
+
+CREATE FUNCTION overlapsSpaceCells(tgeompoint, stbox, float,
+    sorigin geometry DEFAULT 'Point(0 0 0)')
+  RETURNS boolean
+  AS 'SELECT (spaceCells($2, $3, $4) IS NULL OR
+    spaceCells($1, $3, $4) && spaceCells($2, $3, $4)) AND $1 && $2'
+  LANGUAGE SQL IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION overlapsSpaceTimeCells(tgeompoint, stbox, float, interval,
+    sorigin geometry DEFAULT 'Point(0 0 0)',
+    torigin timestamptz DEFAULT '2000-01-03')
+  RETURNS boolean
+  AS 'SELECT (spaceTimeCells($2, $3, $4, $5, $6) IS NULL OR
+    spaceTimeCells($1, $3, $4, $5, $6) &&
+    spaceTimeCells($2, $3, $4, $5, $6)) AND $1 && $2'
+  LANGUAGE SQL IMMUTABLE PARALLEL SAFE;
+
+/*****************************************************************************
+ * Partition keys
+ *****************************************************************************/
+
+/*
+ * A table partitioned on the expression spacePartitionKey(tpoint, size) or
+ * spaceTimePartitionKey(tpoint, size, duration) is pruned by the planner for
+ * the &&, @> and <@ operators between the temporal point and a constant box or
+ * geometry. The rows of the table must be the fragments of the temporal
+ * points in the cells of the grid, for example, as given by spaceSplit or
+ * spaceTimeSplit with the same grid parameters.
+ */
+
+CREATE FUNCTION spacePartitionKey(tgeompoint, float,
+    sorigin geometry DEFAULT 'Point(0 0 0)')
+  RETURNS bigint
+  AS 'MODULE_PATHNAME', 'Tpoint_partition_key'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION spaceTimePartitionKey(tgeompoint, float, interval,
+    sorigin geometry DEFAULT 'Point(0 0 0)',
+    torigin timestamptz DEFAULT '2000-01-03')
+  RETURNS bigint
+  AS 'MODULE_PATHNAME', 'Tpoint_partition_key'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION spacePartitionKeys(stbox, float,
+    sorigin geometry DEFAULT 'Point(0 0 0)')
+  RETURNS bigint[]
+  AS 'MODULE_PATHNAME', 'Stbox_partition_keys'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION spaceTimePartitionKeys(stbox, float, interval,
+    sorigin geometry DEFAULT 'Point(0 0 0)',
+    torigin timestamptz DEFAULT '2000-01-03')
+  RETURNS bigint[]
+  AS 'MODULE_PATHNAME', 'Stbox_partition_keys'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+/*****************************************************************************/
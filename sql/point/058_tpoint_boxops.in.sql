@@ -250,18 +250,30 @@ CREATE OPERATOR @> (
 CREATE FUNCTION contains_bbox(geometry, tgeompoint)
   RETURNS boolean
   AS 'MODULE_PATHNAME', 'Contains_bbox_geo_tpoint'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 CREATE FUNCTION contains_bbox(stbox, tgeompoint)
   RETURNS boolean
   AS 'MODULE_PATHNAME', 'Contains_stbox_tpoint'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 CREATE FUNCTION contains_bbox(tgeompoint, geometry)
   RETURNS boolean
   AS 'MODULE_PATHNAME', 'Contains_tpoint_geo'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 CREATE FUNCTION contains_bbox(tgeompoint, stbox)
   RETURNS boolean
   AS 'MODULE_PATHNAME', 'Contains_tpoint_stbox'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 CREATE FUNCTION contains_bbox(tgeompoint, tgeompoint)
   RETURNS boolean
@@ -444,18 +456,30 @@ CREATE OPERATOR <@ (
 CREATE FUNCTION contained_bbox(geometry, tgeompoint)
   RETURNS boolean
   AS 'MODULE_PATHNAME', 'Contained_geo_tpoint'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 CREATE FUNCTION contained_bbox(stbox, tgeompoint)
   RETURNS boolean
   AS 'MODULE_PATHNAME', 'Contained_stbox_tpoint'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 CREATE FUNCTION contained_bbox(tgeompoint, geometry)
   RETURNS boolean
   AS 'MODULE_PATHNAME', 'Contained_tpoint_geo'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 CREATE FUNCTION contained_bbox(tgeompoint, stbox)
   RETURNS boolean
   AS 'MODULE_PATHNAME', 'Contained_tpoint_stbox'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 CREATE FUNCTION contained_bbox(tgeompoint, tgeompoint)
   RETURNS boolean
@@ -722,18 +746,30 @@ CREATE OPERATOR && (
 CREATE FUNCTION overlaps_bbox(geometry, tgeompoint)
   RETURNS boolean
   AS 'MODULE_PATHNAME', 'Overlaps_geo_tpoint'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 CREATE FUNCTION overlaps_bbox(stbox, tgeompoint)
   RETURNS boolean
   AS 'MODULE_PATHNAME', 'Overlaps_stbox_tpoint'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 CREATE FUNCTION overlaps_bbox(tgeompoint, geometry)
   RETURNS boolean
   AS 'MODULE_PATHNAME', 'Overlaps_tpoint_geo'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 CREATE FUNCTION overlaps_bbox(tgeompoint, stbox)
   RETURNS boolean
   AS 'MODULE_PATHNAME', 'Overlaps_tpoint_stbox'
+#if POSTGRESQL_VERSION_NUMBER >= 120000
+  SUPPORT tpoint_supportfn
+#endif //POSTGRESQL_VERSION_NUMBER >= 120000
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 CREATE FUNCTION overlaps_bbox(tgeompoint, tgeompoint)
   RETURNS boolean
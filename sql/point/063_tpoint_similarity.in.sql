@@ -30,7 +30,9 @@
 /*
  * tpoint_similarity.sql
  * Similarity distance for temporal values. Currently, the discrete Frechet
- * distance and the Dynamic Time Warping (DTW) distance are implemented.
+ * distance, the Dynamic Time Warping (DTW) distance, the Hausdorff distance,
+ * the Longest Common Subsequence (LCSS) distance, and the Edit Distance on
+ * Real sequences (EDR) are implemented.
  */
 
 CREATE FUNCTION frechetDistance(tgeompoint, tgeompoint)
@@ -73,3 +75,91 @@ CREATE FUNCTION dynamicTimeWarpPath(tgeogpoint, tgeogpoint)
 
 /*****************************************************************************/
 
+CREATE FUNCTION hausdorffDistance(tgeompoint, tgeompoint)
+  RETURNS float
+  AS 'MODULE_PATHNAME', 'Temporal_hausdorff_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION vertexHausdorffDistance(tgeompoint, tgeompoint)
+  RETURNS float
+  AS 'MODULE_PATHNAME', 'Temporal_vertex_hausdorff_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION discreteHausdorffDistance(tgeompoint, tgeompoint)
+  RETURNS float
+  AS 'MODULE_PATHNAME', 'Temporal_discrete_hausdorff_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION hausdorffWithin(tgeompoint, tgeompoint, float)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_hausdorff_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+/*****************************************************************************/
+
+CREATE FUNCTION lcssDistance(tgeompoint, tgeompoint, eps float)
+  RETURNS float
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION lcssDistance(tgeompoint, tgeompoint, eps float, timeWindow interval)
+  RETURNS float
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION lcssDistance(tgeogpoint, tgeogpoint, eps float)
+  RETURNS float
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION lcssDistance(tgeogpoint, tgeogpoint, eps float, timeWindow interval)
+  RETURNS float
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION lcssWithin(tgeompoint, tgeompoint, eps float, maxDist float)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION lcssWithin(tgeompoint, tgeompoint, eps float, maxDist float, timeWindow interval)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION lcssWithin(tgeogpoint, tgeogpoint, eps float, maxDist float)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION lcssWithin(tgeogpoint, tgeogpoint, eps float, maxDist float, timeWindow interval)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_lcss_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION edrDistance(tgeompoint, tgeompoint, eps float)
+  RETURNS integer
+  AS 'MODULE_PATHNAME', 'Temporal_edr_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION edrDistance(tgeompoint, tgeompoint, eps float, timeWindow interval)
+  RETURNS integer
+  AS 'MODULE_PATHNAME', 'Temporal_edr_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION edrDistance(tgeogpoint, tgeogpoint, eps float)
+  RETURNS integer
+  AS 'MODULE_PATHNAME', 'Temporal_edr_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION edrDistance(tgeogpoint, tgeogpoint, eps float, timeWindow interval)
+  RETURNS integer
+  AS 'MODULE_PATHNAME', 'Temporal_edr_distance'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION edrWithin(tgeompoint, tgeompoint, eps float, maxEdits integer)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_edr_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION edrWithin(tgeompoint, tgeompoint, eps float, maxEdits integer, timeWindow interval)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_edr_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION edrWithin(tgeogpoint, tgeogpoint, eps float, maxEdits integer)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_edr_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION edrWithin(tgeogpoint, tgeogpoint, eps float, maxEdits integer, timeWindow interval)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Temporal_edr_within'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+/*****************************************************************************/
@@ -128,14 +128,22 @@ CREATE FUNCTION tcentroid_finalfn(internal)
   RETURNS tgeompoint
   AS 'MODULE_PATHNAME', 'Tpoint_tcentroid_finalfn'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tcentroid_serialize(internal)
+  RETURNS bytea
+  AS 'MODULE_PATHNAME', 'Tpoint_tcentroid_serialize'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tcentroid_deserialize(bytea, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Tpoint_tcentroid_deserialize'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
 CREATE AGGREGATE tcentroid(tgeompoint) (
   SFUNC = tcentroid_transfn,
   STYPE = internal,
   COMBINEFUNC = tcentroid_combinefn,
   FINALFUNC = tcentroid_finalfn,
-  SERIALFUNC = tagg_serialize,
-  DESERIALFUNC = tagg_deserialize,
+  SERIALFUNC = tcentroid_serialize,
+  DESERIALFUNC = tcentroid_deserialize,
   PARALLEL = SAFE
 );
 
@@ -96,6 +96,43 @@ RETURNS tgeompoint
 AS 'MODULE_PATHNAME', 'Tpoint_simplify'
 LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+/*****************************************************************************
+ * Outlier removal and smoothing
+ *****************************************************************************/
+
+CREATE FUNCTION filterSpeed(tgeompoint, maxSpeed float8,
+  maxAccel float8 DEFAULT -1.0)
+RETURNS tgeompoint
+AS 'MODULE_PATHNAME', 'Tpoint_filter_speed'
+LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION filterSpeed(tgeogpoint, maxSpeed float8,
+  maxAccel float8 DEFAULT -1.0)
+RETURNS tgeogpoint
+AS 'MODULE_PATHNAME', 'Tpoint_filter_speed'
+LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION medianFilter(tgeompoint, windowSize integer)
+RETURNS tgeompoint
+AS 'MODULE_PATHNAME', 'Tpoint_filter_median'
+LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION medianFilter(tgeogpoint, windowSize integer)
+RETURNS tgeogpoint
+AS 'MODULE_PATHNAME', 'Tpoint_filter_median'
+LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION kalmanSmooth(tgeompoint, processNoise float8,
+  measurementNoise float8)
+RETURNS tgeompoint
+AS 'MODULE_PATHNAME', 'Tpoint_filter_kalman'
+LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION kalmanSmooth(tgeogpoint, processNoise float8,
+  measurementNoise float8)
+RETURNS tgeogpoint
+AS 'MODULE_PATHNAME', 'Tpoint_filter_kalman'
+LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+/*****************************************************************************/
+
 CREATE TYPE geom_times AS (
   geom geometry,
   times integer[]
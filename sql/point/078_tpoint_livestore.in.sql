@@ -0,0 +1,82 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/*
+ * tpoint_livestore.sql
+ * Shared-memory store of the latest positions of moving objects.
+ *
+ * The store is only available when MobilityDB is loaded through the
+ * shared_preload_libraries parameter and mobilitydb.live_capacity is
+ * positive. The functions are volatile since the store is updated
+ * concurrently.
+ */
+
+/*****************************************************************************/
+
+CREATE TYPE live_position AS (
+  id bigint,
+  inst tgeompoint
+);
+CREATE TYPE live_neighbor AS (
+  id bigint,
+  inst tgeompoint,
+  dist float
+);
+
+CREATE FUNCTION liveUpdate(id bigint, tgeompoint)
+  RETURNS integer
+  AS 'MODULE_PATHNAME', 'Live_update'
+  LANGUAGE C VOLATILE STRICT;
+CREATE FUNCTION liveRemove(id bigint)
+  RETURNS boolean
+  AS 'MODULE_PATHNAME', 'Live_remove'
+  LANGUAGE C VOLATILE STRICT;
+CREATE FUNCTION liveCount()
+  RETURNS integer
+  AS 'MODULE_PATHNAME', 'Live_count'
+  LANGUAGE C VOLATILE STRICT PARALLEL SAFE;
+CREATE FUNCTION liveTail(id bigint)
+  RETURNS tgeompoint
+  AS 'MODULE_PATHNAME', 'Live_tail'
+  LANGUAGE C VOLATILE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION liveWindow(stbox)
+  RETURNS SETOF live_position
+  AS 'MODULE_PATHNAME', 'Live_window'
+  LANGUAGE C VOLATILE STRICT PARALLEL SAFE;
+CREATE FUNCTION liveDWithin(geometry, dist float)
+  RETURNS SETOF live_neighbor
+  AS 'MODULE_PATHNAME', 'Live_dwithin'
+  LANGUAGE C VOLATILE STRICT PARALLEL SAFE;
+CREATE FUNCTION liveKnn(geometry, k integer)
+  RETURNS SETOF live_neighbor
+  AS 'MODULE_PATHNAME', 'Live_knn'
+  LANGUAGE C VOLATILE STRICT PARALLEL SAFE;
+
+/*****************************************************************************/
@@ -214,7 +214,7 @@ tfunc_tinstantset(const TInstantSet *ti, LiftedFunctionInfo *lfinfo)
     const TInstant *inst = tinstantset_inst_n(ti, i);
     instants[i] = tfunc_tinstant(inst, lfinfo);
   }
-  return tinstantset_make_free(instants, ti->count, MERGE_NO);
+  return tinstantset_make_trusted_free(instants, ti->count);
 }
 
 /**
@@ -234,8 +234,8 @@ tfunc_tsequence(const TSequence *seq, LiftedFunctionInfo *lfinfo)
   }
   bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags) &&
     temptype_continuous(lfinfo->restype);
-  return tsequence_make_free(instants, seq->count, seq->period.lower_inc,
-    seq->period.upper_inc, linear, NORMALIZE);
+  return tsequence_make_trusted_free(instants, seq->count,
+    seq->period.lower_inc, seq->period.upper_inc, linear, NORMALIZE);
 }
 
 /**
@@ -253,7 +253,7 @@ tfunc_tsequenceset(const TSequenceSet *ts, LiftedFunctionInfo *lfinfo)
     const TSequence *seq = tsequenceset_seq_n(ts, i);
     sequences[i] = tfunc_tsequence(seq, lfinfo);
   }
-  return tsequenceset_make_free(sequences, ts->count, NORMALIZE);
+  return tsequenceset_make_trusted_free(sequences, ts->count, NORMALIZE);
 }
 
 /**
@@ -287,7 +287,7 @@ tfunc_temporal(const Temporal *temp, LiftedFunctionInfo *lfinfo)
  * Apply the variadic function with the optional arguments to the base values
  * taking into account that their type may be different
  */
-static Datum
+Datum
 tfunc_base_base(Datum value1, Datum value2, LiftedFunctionInfo *lfinfo)
 {
   /* Lifted functions may have from 0 to MAX_PARAMS parameters */
@@ -351,7 +351,7 @@ tfunc_tinstantset_base(const TInstantSet *ti, Datum value,
     const TInstant *inst = tinstantset_inst_n(ti, i);
     instants[i] = tfunc_tinstant_base(inst, value, lfinfo);
   }
-  return tinstantset_make_free(instants, ti->count, MERGE_NO);
+  return tinstantset_make_trusted_free(instants, ti->count);
 }
 
 /**
@@ -377,8 +377,8 @@ tfunc_tsequence_base_scan(const TSequence *seq, Datum value,
   }
   bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags) &&
     temptype_continuous(lfinfo->restype);
-  result[0] = tsequence_make_free(instants, seq->count, seq->period.lower_inc,
-    seq->period.upper_inc, linear, NORMALIZE);
+  result[0] = tsequence_make_trusted_free(instants, seq->count,
+    seq->period.lower_inc, seq->period.upper_inc, linear, NORMALIZE);
   return 1;
 }
 
@@ -423,7 +423,7 @@ tfunc_tsequence_base_turnpt(const TSequence *seq, Datum value,
     inst1 = inst2; value1 = value2;
   }
   instants[k++] = tfunc_tinstant_base(inst1, value, lfinfo);
-  result[0] = tsequence_make_free(instants, k, seq->period.lower_inc,
+  result[0] = tsequence_make_trusted_free(instants, k, seq->period.lower_inc,
     seq->period.upper_inc, linear, NORMALIZE);
   return 1;
 }
@@ -489,7 +489,7 @@ tfunc_tsequence_base_discont(const TSequence *seq, Datum value,
     {
       tinstant_set(instants[0], startresult, start->t);
       tinstant_set(instants[1], startresult, end->t);
-      result[k++] = tsequence_make((const TInstant **) instants, 2,
+      result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
         lower_inc, upper_inc, STEP, NORMALIZE_NO);
     }
     /* If either the start or the end value is equal to the value compute
@@ -510,7 +510,7 @@ tfunc_tsequence_base_discont(const TSequence *seq, Datum value,
       }
       tinstant_set(instants[0], intresult, start->t);
       tinstant_set(instants[1], intresult, end->t);
-      result[k++] = tsequence_make((const TInstant **) instants, 2,
+      result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
         lower_eq, upper_eq, lfinfo->reslinear, NORMALIZE_NO);
       if (upper_inc && ! upper_eq)
       {
@@ -539,7 +539,7 @@ tfunc_tsequence_base_discont(const TSequence *seq, Datum value,
         /* Compute the function at the start and end instants */
         tinstant_set(instants[0], startresult, start->t);
         tinstant_set(instants[1], startresult, end->t);
-        result[k++] = tsequence_make((const TInstant **) instants, 2,
+        result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
           lower_inc, hascross ? upper_eq : false, lfinfo->reslinear, NORMALIZE_NO);
         if (! hascross && upper_inc)
         {
@@ -554,7 +554,7 @@ tfunc_tsequence_base_discont(const TSequence *seq, Datum value,
          * at the crossing, and at the end instant */
         tinstant_set(instants[0], startresult, start->t);
         tinstant_set(instants[1], startresult, inttime);
-        result[k++] = tsequence_make((const TInstant **) instants, 2,
+        result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
           lower_inc, lower_eq, lfinfo->reslinear, NORMALIZE_NO);
         /* Second sequence if any */
         if (! lower_eq && ! upper_eq)
@@ -565,7 +565,7 @@ tfunc_tsequence_base_discont(const TSequence *seq, Datum value,
         /* Third sequence */
         tinstant_set(instants[0], endresult, inttime);
         tinstant_set(instants[1], endresult, end->t);
-        result[k++] = tsequence_make((const TInstant **) instants, 2,
+        result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
           upper_eq, upper_inc, lfinfo->reslinear, NORMALIZE_NO);
         DATUM_FREE(intvalue, basetype);
         DATUM_FREE(intresult, resbasetype);
@@ -598,7 +598,7 @@ tfunc_tsequence_base(const TSequence *seq, Datum value,
   if (lfinfo->discont)
   {
     int k = tfunc_tsequence_base_discont(seq, value, lfinfo, sequences);
-    return (Temporal *) tsequenceset_make_free(sequences, k, NORMALIZE);
+    return (Temporal *) tsequenceset_make_trusted_free(sequences, k, NORMALIZE);
   }
   else
   {
@@ -639,7 +639,7 @@ tfunc_tsequenceset_base(const TSequenceSet *ts, Datum value,
     else
       k += tfunc_tsequence_base_scan(seq, value, lfinfo, &sequences[k]);
   }
-  return tsequenceset_make_free(sequences, k, NORMALIZE);
+  return tsequenceset_make_trusted_free(sequences, k, NORMALIZE);
 }
 
 /**
@@ -861,7 +861,7 @@ tfunc_tinstantset_tinstantset(const TInstantSet *ti1, const TInstantSet *ti2,
     else
       inst2 = tinstantset_inst_n(ti2, ++j);
   }
-  return tinstantset_make_free(instants, k, MERGE_NO);
+  return tinstantset_make_trusted_free(instants, k);
 }
 
 /**
@@ -894,7 +894,7 @@ tfunc_tsequence_tinstantset(const TSequence *seq, const TInstantSet *ti,
     if (seq->period.upper < inst->t)
       break;
   }
-  return tinstantset_make_free(instants, k, MERGE_NO);
+  return tinstantset_make_trusted_free(instants, k);
 }
 
 /**
@@ -950,7 +950,7 @@ tfunc_tsequenceset_tinstantset(const TSequenceSet *ts, const TInstantSet *ti,
     else
       j++;
   }
-  return tinstantset_make_free(instants, k, MERGE_NO);
+  return tinstantset_make_trusted_free(instants, k);
 }
 
 /**
@@ -1065,7 +1065,7 @@ tfunc_tsequence_tsequence_lineareq(const TSequence *seq1, const TSequence *seq2,
     /* We cannot DATUM_FREE(value, lfinfo->restype); */
   }
   pfree_array((void **) tofree, l);
-  result[0] = tsequence_make_free(instants, k, inter->lower_inc,
+  result[0] = tsequence_make_trusted_free(instants, k, inter->lower_inc,
     inter->upper_inc, lfinfo->reslinear, NORMALIZE);
   return 1;
 }
@@ -1145,7 +1145,7 @@ tfunc_tsequence_tsequence_linearstep(const TSequence *seq1,
     Datum endresult = tfunc_base_base(endvalue1, endvalue2, lfinfo);
     instants[0] = tinstant_make(startresult, start1->t, lfinfo->restype);
     instants[1] = tinstant_make(endresult, end1->t, lfinfo->restype);
-    result[k++] = tsequence_make((const TInstant **) instants, 2, lower_inc, false,
+    result[k++] = tsequence_make_trusted((const TInstant **) instants, 2, lower_inc, false,
       lfinfo->reslinear, NORMALIZE_NO);
     pfree(instants[0]); pfree(instants[1]);
     DATUM_FREE(startresult, resbasetype);
@@ -1253,7 +1253,7 @@ tfunc_tsequence_tsequence_discont(const TSequence *seq1, const TSequence *seq2,
     {
       instants[0] = tinstant_make(startresult, start1->t, lfinfo->restype);
       instants[1] = tinstant_make(startresult, end1->t, lfinfo->restype);
-      result[k++] = tsequence_make((const TInstant **) instants, 2,
+      result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
         lower_inc, false, lfinfo->reslinear, NORMALIZE_NO);
       pfree(instants[0]); pfree(instants[1]);
     }
@@ -1279,7 +1279,7 @@ tfunc_tsequence_tsequence_discont(const TSequence *seq1, const TSequence *seq2,
       }
       instants[0] = tinstant_make(intresult, start1->t, lfinfo->restype);
       instants[1] = tinstant_make(intresult, end1->t, lfinfo->restype);
-      result[k++] = tsequence_make((const TInstant **) instants, 2,
+      result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
         lower_eq, false, lfinfo->reslinear, NORMALIZE_NO);
       pfree(instants[0]); pfree(instants[1]);
       DATUM_FREE(intvalue1, basetype1);
@@ -1304,7 +1304,7 @@ tfunc_tsequence_tsequence_discont(const TSequence *seq1, const TSequence *seq2,
       {
         instants[0] = tinstant_make(startresult, start1->t, lfinfo->restype);
         instants[1] = tinstant_make(startresult, end1->t, lfinfo->restype);
-        result[k++] = tsequence_make((const TInstant **) instants, 2,
+        result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
           lower_inc, false, lfinfo->reslinear, NORMALIZE_NO);
         pfree(instants[0]); pfree(instants[1]);
       }
@@ -1313,7 +1313,7 @@ tfunc_tsequence_tsequence_discont(const TSequence *seq1, const TSequence *seq2,
         /* First sequence */
         instants[0] = tinstant_make(startresult, start1->t, lfinfo->restype);
         instants[1] = tinstant_make(startresult, inttime, lfinfo->restype);
-        result[k++] = tsequence_make((const TInstant **) instants, 2,
+        result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
           lower_inc, lower_eq, lfinfo->reslinear, NORMALIZE_NO);
         pfree(instants[0]); pfree(instants[1]);
         /* Second sequence if any */
@@ -1326,7 +1326,7 @@ tfunc_tsequence_tsequence_discont(const TSequence *seq1, const TSequence *seq2,
         /* Third sequence */
         instants[0] = tinstant_make(endresult, inttime, lfinfo->restype);
         instants[1] = tinstant_make(endresult, end1->t, lfinfo->restype);
-        result[k++] = tsequence_make((const TInstant **) instants, 2,
+        result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
           upper_eq, false, lfinfo->reslinear, NORMALIZE_NO);
         pfree(instants[0]); pfree(instants[1]);
         DATUM_FREE(intvalue1, basetype1);
@@ -1424,7 +1424,8 @@ tfunc_tsequence_tsequence(const TSequence *seq1, const TSequence *seq2,
   }
   else
   {
-    TSequenceSet *result = tsequenceset_make_free(sequences, k, NORMALIZE);
+    TSequenceSet *result = tsequenceset_make_trusted_free(sequences, k,
+      NORMALIZE);
     if (result->count == 1)
     {
       Temporal *resultseq = (Temporal *) tsequenceset_tsequence(result);
@@ -1474,7 +1475,7 @@ tfunc_tsequenceset_tsequence(const TSequenceSet *ts, const TSequence *seq,
       break;
   }
   /* We need to normalize when discont is true */
-  return tsequenceset_make_free(sequences, k, NORMALIZE);
+  return tsequenceset_make_trusted_free(sequences, k, NORMALIZE);
 }
 
 /**
@@ -1534,7 +1535,7 @@ tfunc_tsequenceset_tsequenceset(const TSequenceSet *ts1,
       j++;
   }
   /* We need to normalize if the function has instantaneous discontinuities */
-  return tsequenceset_make_free(sequences, k, NORMALIZE);
+  return tsequenceset_make_trusted_free(sequences, k, NORMALIZE);
 }
 
 /*****************************************************************************/
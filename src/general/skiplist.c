@@ -36,8 +36,12 @@
 
 /* PostgreSQL */
 #include <assert.h>
+#include <funcapi.h>
+#include <access/htup_details.h>
 #include <executor/spi.h>
+#include <lib/binaryheap.h>
 #include <libpq/pqformat.h>
+#include <utils/guc.h>
 #include <utils/memutils.h>
 #include <utils/timestamp.h>
 /* GSL */
@@ -60,6 +64,34 @@
 
 gsl_rng *_aggregation_rng = NULL;
 
+/* Memory size in kilobytes of the state of an aggregate before spilling it
+ * to disk, 0 if the state is never spilled */
+
+int aggregate_spill_mem = 0;
+
+/* Statistics on the spilled runs of the current backend */
+
+static int64 aggregate_spill_runs = 0;
+static int64 aggregate_spill_bytes = 0;
+
+/**
+ * Define the configuration parameters of the aggregates
+ *
+ * @note Called from the initialization function of the extension
+ */
+void
+skiplist_init(void)
+{
+  DefineCustomIntVariable("mobilitydb.aggregate_spill_mem",
+    "Memory used by the state of a temporal aggregate before spilling it "
+    "to disk.",
+    "Zero disables spilling. The spilled runs are merged by the final "
+    "function.",
+    &aggregate_spill_mem, 0, 0, MAX_KILOBYTES, PGC_USERSET, GUC_UNIT_KB,
+    NULL, NULL, NULL);
+  return;
+}
+
 /**
  * Switch to the memory context for aggregation
  */
@@ -179,6 +211,32 @@ skiplist_free(FunctionCallInfo fcinfo, SkipList *list, int cur)
   return;
 }
 
+static void skiplist_spill(FunctionCallInfo fcinfo, SkipList *list);
+
+/**
+ * Return the memory size of a value of the skiplist
+ */
+static size_t
+skiplist_value_size(const SkipList *list, const void *value)
+{
+  if (list->elemtype == TIMESTAMPTZ)
+    return 0;
+  if (list->elemtype == PERIOD)
+    return sizeof(Period);
+  /* list->elemtype == TEMPORAL */
+  return VARSIZE(value);
+}
+
+/**
+ * Return the memory size of the skiplist
+ */
+static size_t
+skiplist_mem_size(const SkipList *list)
+{
+  return sizeof(SkipListElem) * list->capacity +
+    sizeof(int) * list->freecap + list->valsize;
+}
+
 /**
  * Comparison function used for skiplists
  */
@@ -263,54 +321,53 @@ skiplist_print(const SkipList *list)
 #endif
 
 /**
- * Constructs a skiplist from the array of values values
+ * Fill an empty skiplist with the array of values, which are copied
  *
- * @param[in] fcinfo Catalog information about the external function
+ * @param[inout] list Skiplist
  * @param[in] values Array of values
- * @param[in] elemtype Type of the elements
  * @param[in] count Number of elements in the array
+ * @note Must be called in the memory context of the aggregation
  */
-SkipList *
-skiplist_make(FunctionCallInfo fcinfo, void **values, int count,
-  SkipListElemType elemtype)
+static void
+skiplist_fill(SkipList *list, void **values, int count)
 {
   assert(count > 0);
   //FIXME: tail should be a constant (e.g. 1) but is not, for ease of construction
 
-  MemoryContext oldctx = set_aggregation_context(fcinfo);
   int capacity = SKIPLIST_INITIAL_CAPACITY;
   count += 2; /* Account for head and tail */
   while (capacity <= count)
     capacity <<= 1;
-  SkipList *result = palloc0(sizeof(SkipList));
-  result->elems = palloc0(sizeof(SkipListElem) * capacity);
+  list->elems = palloc0(sizeof(SkipListElem) * capacity);
   int height = (int) ceil(log2(count - 1));
-  result->elemtype = elemtype;
-  result->capacity = capacity;
-  result->next = count;
-  result->length = count - 2;
-  result->extra = NULL;
-  result->extrasize = 0;
+  list->capacity = capacity;
+  list->next = count;
+  list->length = count - 2;
+  list->freed = NULL;
+  list->freecount = list->freecap = 0;
 
   /* Fill values first */
-  result->elems[0].value = NULL;
-  if (elemtype == TIMESTAMPTZ)
+  list->elems[0].value = NULL;
+  if (list->elemtype == TIMESTAMPTZ)
   {
     for (int i = 0; i < count - 2; i ++)
-      result->elems[i + 1].value = values[i];
+      list->elems[i + 1].value = values[i];
   }
-  else if (elemtype == PERIOD)
+  else if (list->elemtype == PERIOD)
   {
     for (int i = 0; i < count - 2; i ++)
-      result->elems[i + 1].value = period_copy((Period *) values[i]);
+      list->elems[i + 1].value = period_copy((Period *) values[i]);
   }
-  else /* state->elemtype == TEMPORAL */
+  else /* list->elemtype == TEMPORAL */
   {
     for (int i = 0; i < count - 2; i ++)
-      result->elems[i + 1].value = temporal_copy(values[i]);
+      list->elems[i + 1].value = temporal_copy(values[i]);
   }
-  result->elems[count - 1].value = NULL;
-  result->tail = count - 1;
+  list->valsize = 0;
+  for (int i = 0; i < count - 2; i ++)
+    list->valsize += skiplist_value_size(list, list->elems[i + 1].value);
+  list->elems[count - 1].value = NULL;
+  list->tail = count - 1;
 
   /* Link the list in a balanced fashion */
   for (int level = 0; level < height; level ++)
@@ -321,16 +378,37 @@ skiplist_make(FunctionCallInfo fcinfo, void **values, int count,
       int next = i + step < count ? i + step : count - 1;
       if (i != count - 1)
       {
-        result->elems[i].next[level] = next;
-        result->elems[i].height = level + 1;
+        list->elems[i].next[level] = next;
+        list->elems[i].height = level + 1;
       }
       else
       {
-        result->elems[i].next[level] = - 1;
-        result->elems[i].height = height;
+        list->elems[i].next[level] = - 1;
+        list->elems[i].height = height;
       }
     }
   }
+  return;
+}
+
+/**
+ * Constructs a skiplist from the array of values values
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[in] values Array of values
+ * @param[in] elemtype Type of the elements
+ * @param[in] count Number of elements in the array
+ */
+SkipList *
+skiplist_make(FunctionCallInfo fcinfo, void **values, int count,
+  SkipListElemType elemtype)
+{
+  MemoryContext oldctx = set_aggregation_context(fcinfo);
+  SkipList *result = palloc0(sizeof(SkipList));
+  result->elemtype = elemtype;
+  result->extra = NULL;
+  result->extrasize = 0;
+  skiplist_fill(result, values, count);
   unset_aggregation_context(oldctx);
   return result;
 }
@@ -380,6 +458,9 @@ skiplist_splice(FunctionCallInfo fcinfo, SkipList *list, void **values,
    * everything has to be deleted)
    */
   assert(list->length > 0);
+  /* Keep the function for merging the runs that may be spilled */
+  list->func = func;
+  list->crossings = crossings;
   Period p;
   uint8 subtype = 0;
   if (list->elemtype == TIMESTAMPTZ)
@@ -458,6 +539,7 @@ skiplist_splice(FunctionCallInfo fcinfo, SkipList *list, void **values,
         prev->next[level] = list->elems[cur].next[level];
       }
       spliced[spliced_count++] = list->elems[cur].value;
+      list->valsize -= skiplist_value_size(list, list->elems[cur].value);
       skiplist_free(fcinfo, list, cur);
       cur = list->elems[cur].next[0];
     }
@@ -532,6 +614,7 @@ skiplist_splice(FunctionCallInfo fcinfo, SkipList *list, void **values,
     else /* list->elemtype == TEMPORAL */
       newelm->value = temporal_copy(values[i]);
     unset_aggregation_context(ctx);
+    list->valsize += skiplist_value_size(list, newelm->value);
     newelm->height = rheight;
 
     for (int level = 0; level < rheight; level ++)
@@ -555,14 +638,19 @@ skiplist_splice(FunctionCallInfo fcinfo, SkipList *list, void **values,
     else
       pfree_array(values, count);
   }
+
+  /* Spill the skiplist if it exceeds the memory allowed */
+  if (aggregate_spill_mem > 0 && list->length > 1 &&
+      skiplist_mem_size(list) > (size_t) aggregate_spill_mem * 1024)
+    skiplist_spill(fcinfo, list);
   return;
 }
 
 /**
- * Return the values contained in the skiplist
+ * Return the values contained in memory in the skiplist
  */
-void **
-skiplist_values(SkipList *list)
+static void **
+skiplist_values1(SkipList *list)
 {
   void **result = palloc(sizeof(void *) * list->length);
   int cur = list->elems[0].next[0];
@@ -576,46 +664,503 @@ skiplist_values(SkipList *list)
 }
 
 /*****************************************************************************
- * Generic binary aggregate functions needed for parallelization
+ * Functions spilling skip lists to disk
  *****************************************************************************/
 
 /**
- * Writes the state value into the buffer
+ * Write a value of a skiplist into the buffer
+ */
+static void
+skiplist_write_value(SkipListElemType elemtype, void *value, StringInfo buf)
+{
+  if (elemtype == TIMESTAMPTZ)
+  {
+    bytea *time = call_send(TIMESTAMPTZOID, TimestampTzGetDatum((TimestampTz) value));
+    pq_sendbytes(buf, VARDATA(time), VARSIZE(time) - VARHDRSZ);
+    pfree(time);
+  }
+  else if (elemtype == PERIOD)
+    period_write((const Period *) value, buf);
+  else /* elemtype == TEMPORAL */
+  {
+    SPI_connect();
+    temporal_write((Temporal *) value, buf);
+    SPI_finish();
+  }
+  return;
+}
+
+/**
+ * Read a value of a skiplist from the buffer
  *
- * @param[in] state State
  * @param[in] buf Buffer
+ * @param[in] elemtype Type of the elements
+ * @param[in] temptype Temporal type of the elements, if any
+ */
+static void *
+skiplist_read_value(StringInfo buf, SkipListElemType elemtype,
+  CachedType temptype)
+{
+  if (elemtype == TIMESTAMPTZ)
+    return (void *) DatumGetTimestampTz(call_recv(TIMESTAMPTZOID, buf));
+  else if (elemtype == PERIOD)
+    return period_read(buf);
+  else /* elemtype == TEMPORAL */
+    return temporal_read(buf, temptype);
+}
+
+/**
+ * Write an array of values of a skiplist into the buffer
  */
 static void
-aggstate_write(SkipList *state, StringInfo buf)
+skiplist_write_values(SkipListElemType elemtype, void **values, int count,
+  StringInfo buf)
 {
-  int i;
-  void **values = skiplist_values(state);
-  pq_sendint32(buf, (uint32) state->elemtype);
-  pq_sendint32(buf, (uint32) state->length);
-  if (state->elemtype == TIMESTAMPTZ)
+  pq_sendint32(buf, (uint32) elemtype);
+  pq_sendint32(buf, (uint32) count);
+  if (elemtype == TEMPORAL && count > 0)
+    pq_sendint32(buf, ((Temporal *) values[0])->temptype);
+  for (int i = 0; i < count; i ++)
+    skiplist_write_value(elemtype, values[i], buf);
+  return;
+}
+
+/**
+ * Read an array of values of a skiplist from the buffer
+ *
+ * @param[in] buf Buffer
+ * @param[out] elemtype Type of the elements
+ * @param[out] count Number of elements in the array
+ */
+static void **
+skiplist_read_values(StringInfo buf, SkipListElemType *elemtype, int *count)
+{
+  *elemtype = (SkipListElemType) pq_getmsgint(buf, 4);
+  *count = pq_getmsgint(buf, 4);
+  void **result = palloc0(sizeof(void *) * Max(*count, 1));
+  CachedType temptype = 0;
+  if (*elemtype == TEMPORAL && *count > 0)
+    temptype = pq_getmsgint(buf, 4);
+  for (int i = 0; i < *count; i ++)
+    result[i] = skiplist_read_value(buf, *elemtype, temptype);
+  return result;
+}
+
+/**
+ * Free an array of values read from a buffer
+ */
+static void
+skiplist_free_values(SkipListElemType elemtype, void **values, int count)
+{
+  if (elemtype == TIMESTAMPTZ)
+    pfree(values);
+  else
+    pfree_array(values, count);
+  return;
+}
+
+/**
+ * Write all the values of the skiplist but the last one as a sorted run in
+ * a temporary file and keep only the last value in memory, since a skiplist
+ * cannot be empty
+ *
+ * Each value of the run is preceded by its length so that the runs can be
+ * read one value at a time when they are merged.
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[inout] list Skiplist
+ */
+static void
+skiplist_spill(FunctionCallInfo fcinfo, SkipList *list)
+{
+  void **values = skiplist_values1(list);
+  int count = list->length - 1;
+
+  MemoryContext ctx = set_aggregation_context(fcinfo);
+  if (! list->spill)
+    list->spill = BufFileCreateTemp(false);
+  list->runs = list->runs ?
+    repalloc(list->runs, sizeof(SkipListRun) * (list->nruns + 1)) :
+    palloc(sizeof(SkipListRun));
+  SkipListRun *run = &list->runs[list->nruns++];
+  BufFileTell(list->spill, &run->fileno, &run->offset);
+  run->count = count;
+  unset_aggregation_context(ctx);
+
+  StringInfoData buf;
+  initStringInfo(&buf);
+  for (int i = 0; i < count; i++)
   {
-    for (i = 0; i < state->length; i ++)
-    {
-      bytea *time = call_send(TIMESTAMPTZOID, TimestampTzGetDatum((TimestampTz) values[i]));
-      pq_sendbytes(buf, VARDATA(time), VARSIZE(time) - VARHDRSZ);
-      pfree(time);
-    }
+    resetStringInfo(&buf);
+    skiplist_write_value(list->elemtype, values[i], &buf);
+    BufFileWrite(list->spill, &buf.len, sizeof(int));
+    BufFileWrite(list->spill, buf.data, buf.len);
+    aggregate_spill_bytes += sizeof(int) + buf.len;
   }
-  else if (state->elemtype == PERIOD)
+  aggregate_spill_runs++;
+  pfree(buf.data);
+
+  /* Rebuild the skiplist with the last value */
+  ctx = set_aggregation_context(fcinfo);
+  void *last = values[count];
+  if (list->elemtype != TIMESTAMPTZ)
   {
-    for (i = 0; i < state->length; i ++)
-      period_write((const Period *) values[i], buf);
+    for (int i = 0; i < count; i ++)
+      pfree(values[i]);
   }
-  else /* state->elemtype == TEMPORAL */
+  pfree(list->elems);
+  if (list->freed)
+    pfree(list->freed);
+  skiplist_fill(list, &last, 1);
+  if (list->elemtype != TIMESTAMPTZ)
+    pfree(last);
+  unset_aggregation_context(ctx);
+  pfree(values);
+  return;
+}
+
+/**
+ * Read exactly the given number of bytes from the temporary file of the
+ * spilled runs
+ */
+static void
+skiplist_read_spill(BufFile *file, void *ptr, size_t size)
+{
+  if (BufFileRead(file, ptr, size) != size)
+    ereport(ERROR, (errcode_for_file_access(),
+      errmsg("could not read from temporary file of aggregate: %m")));
+  return;
+}
+
+/**
+ * Cursor over a sorted run of values merged by the final function, which is
+ * either a spilled run or the values kept in memory
+ */
+typedef struct
+{
+  SkipListRun pos;     /**< Position and number of the values left to read
+                            from the temporary file */
+  void **values;       /**< Values kept in memory, NULL for a spilled run */
+  int next;            /**< Position of the next value kept in memory */
+  void *head;          /**< Current value of the run */
+  TimestampTz lower;   /**< Start timestamp of the current value */
+} SkipListCursor;
+
+/**
+ * Return the bounds of the time span of a value of the skiplist
+ */
+static void
+skiplist_value_bounds(SkipListElemType elemtype, const void *value,
+  TimestampTz *lower, TimestampTz *upper)
+{
+  if (elemtype == TIMESTAMPTZ)
+    *lower = *upper = (TimestampTz) value;
+  else if (elemtype == PERIOD)
+  {
+    *lower = ((const Period *) value)->lower;
+    *upper = ((const Period *) value)->upper;
+  }
+  else /* elemtype == TEMPORAL */
   {
-    if (state->length > 0)
-      pq_sendint32(buf, ((Temporal *) values[0])->temptype);
-    for (i = 0; i < state->length; i ++)
+    const Temporal *temp = (const Temporal *) value;
+    if (temp->subtype == INSTANT)
+      *lower = *upper = ((const TInstant *) temp)->t;
+    else
     {
-      SPI_connect();
-      temporal_write((Temporal *) values[i], buf);
-      SPI_finish();
+      *lower = ((const TSequence *) temp)->period.lower;
+      *upper = ((const TSequence *) temp)->period.upper;
     }
+  }
+  return;
+}
+
+/**
+ * Advance the cursor to the next value of its run and return false when the
+ * run is exhausted. The values of a spilled run are read one at a time.
+ *
+ * @param[in] list Skiplist
+ * @param[inout] cursor Cursor
+ * @param[in] temptype Temporal type of the values, if any
+ * @param[inout] buf Buffer reused for reading the values
+ */
+static bool
+skiplist_cursor_next(const SkipList *list, SkipListCursor *cursor,
+  CachedType temptype, StringInfo buf)
+{
+  TimestampTz upper;
+  if (cursor->values)
+  {
+    if (cursor->next == cursor->pos.count)
+      return false;
+    void *value = cursor->values[cursor->next++];
+    /* The values kept in memory are copied since the merge frees them */
+    if (list->elemtype == TIMESTAMPTZ)
+      cursor->head = value;
+    else if (list->elemtype == PERIOD)
+      cursor->head = period_copy(value);
+    else /* list->elemtype == TEMPORAL */
+      cursor->head = temporal_copy(value);
+  }
+  else
+  {
+    if (cursor->pos.count == 0)
+      return false;
+    int len;
+    if (BufFileSeek(list->spill, cursor->pos.fileno, cursor->pos.offset,
+        SEEK_SET) != 0)
+      ereport(ERROR, (errcode_for_file_access(),
+        errmsg("could not seek in temporary file of aggregate: %m")));
+    skiplist_read_spill(list->spill, &len, sizeof(int));
+    resetStringInfo(buf);
+    enlargeStringInfo(buf, len);
+    skiplist_read_spill(list->spill, buf->data, len);
+    buf->len = len;
+    buf->data[len] = '\0';
+    BufFileTell(list->spill, &cursor->pos.fileno, &cursor->pos.offset);
+    cursor->pos.count--;
+    cursor->head = skiplist_read_value(buf, list->elemtype, temptype);
+  }
+  skiplist_value_bounds(list->elemtype, cursor->head, &cursor->lower, &upper);
+  return true;
+}
+
+/**
+ * Comparator of the cursors in the heap of the merge, which returns first
+ * the cursor whose current value starts first
+ */
+static int
+skiplist_cursor_cmp(Datum a, Datum b, void *arg)
+{
+  const SkipListCursor *cursors = (const SkipListCursor *) arg;
+  TimestampTz ta = cursors[DatumGetInt32(a)].lower;
+  TimestampTz tb = cursors[DatumGetInt32(b)].lower;
+  /* The binary heap of PostgreSQL returns the greatest element first */
+  return (ta < tb) ? 1 : ((ta > tb) ? -1 : 0);
+}
+
+/**
+ * Merge two sorted arrays of values of the skiplist and free them
+ *
+ * @param[in] list Skiplist
+ * @param[in] values1,values2 Arrays of values
+ * @param[in] count1,count2 Number of elements in the arrays
+ * @param[out] newcount Number of elements in the result
+ */
+static void **
+skiplist_merge_values(const SkipList *list, void **values1, int count1,
+  void **values2, int count2, int *newcount)
+{
+  void **result;
+  if (list->elemtype == TIMESTAMPTZ)
+    result = (void **) timestamp_agg((TimestampTz *) values1, count1,
+      (TimestampTz *) values2, count2, newcount);
+  else if (list->elemtype == PERIOD)
+    result = (void **) period_agg((Period **) values1, count1,
+      (Period **) values2, count2, newcount);
+  else /* list->elemtype == TEMPORAL */
+  {
+    if (((Temporal *) values1[0])->subtype == INSTANT)
+      result = (void **) tinstant_tagg((TInstant **) values1, count1,
+        (TInstant **) values2, count2, list->func, newcount);
+    else
+      result = (void **) tsequence_tagg((TSequence **) values1, count1,
+        (TSequence **) values2, count2, list->func, list->crossings,
+        newcount);
+  }
+  skiplist_free_values(list->elemtype, values1, count1);
+  skiplist_free_values(list->elemtype, values2, count2);
+  return result;
+}
+
+/**
+ * Add a value to the sorted array of the merged values, where the values
+ * are added in the order of their start timestamp. Only the values at the
+ * end of the array that overlap or touch the new value are merged with it.
+ *
+ * @param[in] list Skiplist
+ * @param[inout] result Array of merged values
+ * @param[inout] count Number of elements in the array
+ * @param[inout] maxcount Capacity of the array
+ * @param[in] value Value added, which is freed
+ */
+static void **
+skiplist_merge_add(const SkipList *list, void **result, int *count,
+  int *maxcount, void *value)
+{
+  TimestampTz lower, upper, vlower, vupper;
+  skiplist_value_bounds(list->elemtype, value, &vlower, &vupper);
+  int first = *count;
+  while (first > 0)
+  {
+    skiplist_value_bounds(list->elemtype, result[first - 1], &lower, &upper);
+    if (upper < vlower)
+      break;
+    first--;
+  }
+  void **merged;
+  int nmerged;
+  if (first == *count)
+  {
+    merged = NULL;
+    nmerged = 1;
+  }
+  else
+  {
+    void **tail = palloc(sizeof(void *) * (*count - first));
+    memcpy(tail, &result[first], sizeof(void *) * (*count - first));
+    void **single = palloc(sizeof(void *));
+    single[0] = value;
+    merged = skiplist_merge_values(list, tail, *count - first, single, 1,
+      &nmerged);
+  }
+  if (first + nmerged > *maxcount)
+  {
+    *maxcount = Max(*maxcount * 2, first + nmerged);
+    result = repalloc(result, sizeof(void *) * *maxcount);
+  }
+  if (merged)
+  {
+    memcpy(&result[first], merged, sizeof(void *) * nmerged);
+    pfree(merged);
+  }
+  else
+    result[first] = value;
+  *count = first + nmerged;
+  return result;
+}
+
+/**
+ * Merge the spilled runs of the skiplist with the values kept in memory
+ *
+ * The runs are merged by a k-way merge that keeps a single value per run in
+ * memory, the runs being read one value at a time from the temporary file.
+ * The values are taken in the order of their start timestamp from a binary
+ * heap of the runs, and are merged with the end of the result.
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[inout] list Skiplist
+ */
+static void
+skiplist_merge_runs(FunctionCallInfo fcinfo, SkipList *list)
+{
+  if (list->nruns == 0)
+    return;
+
+  void **values = skiplist_values1(list);
+  int count = list->length;
+  CachedType temptype = (list->elemtype == TEMPORAL) ?
+    ((Temporal *) values[0])->temptype : 0;
+
+  /* One cursor per spilled run and one for the values kept in memory */
+  int ncursors = list->nruns + 1;
+  SkipListCursor *cursors = palloc0(sizeof(SkipListCursor) * ncursors);
+  for (int i = 0; i < list->nruns; i++)
+    cursors[i].pos = list->runs[i];
+  cursors[list->nruns].values = values;
+  cursors[list->nruns].pos.count = count;
+  StringInfoData buf;
+  initStringInfo(&buf);
+  binaryheap *heap = binaryheap_allocate(ncursors, skiplist_cursor_cmp,
+    cursors);
+  for (int i = 0; i < ncursors; i++)
+  {
+    if (skiplist_cursor_next(list, &cursors[i], temptype, &buf))
+      binaryheap_add_unordered(heap, Int32GetDatum(i));
+  }
+  binaryheap_build(heap);
+
+  int maxcount = count, newcount = 0;
+  void **result = palloc(sizeof(void *) * maxcount);
+  while (! binaryheap_empty(heap))
+  {
+    int i = DatumGetInt32(binaryheap_first(heap));
+    result = skiplist_merge_add(list, result, &newcount, &maxcount,
+      cursors[i].head);
+    if (skiplist_cursor_next(list, &cursors[i], temptype, &buf))
+      binaryheap_replace_first(heap, Int32GetDatum(i));
+    else
+      binaryheap_remove_first(heap);
+  }
+  binaryheap_free(heap);
+  pfree(buf.data);
+  pfree(cursors);
+
+  /* Rebuild the skiplist with the merged values */
+  MemoryContext ctx = set_aggregation_context(fcinfo);
+  BufFileClose(list->spill);
+  list->spill = NULL;
+  pfree(list->runs);
+  list->runs = NULL;
+  list->nruns = 0;
+  if (list->elemtype != TIMESTAMPTZ)
+  {
+    for (int i = 0; i < count; i ++)
+      pfree(values[i]);
+  }
+  pfree(list->elems);
+  if (list->freed)
+    pfree(list->freed);
+  skiplist_fill(list, result, newcount);
+  unset_aggregation_context(ctx);
+  skiplist_free_values(list->elemtype, result, newcount);
+  pfree(values);
+  return;
+}
+
+/**
+ * Return the values contained in the skiplist after merging the spilled
+ * runs, if any
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[inout] list Skiplist
+ */
+void **
+skiplist_values(FunctionCallInfo fcinfo, SkipList *list)
+{
+  skiplist_merge_runs(fcinfo, list);
+  return skiplist_values1(list);
+}
+
+PG_FUNCTION_INFO_V1(Aggregate_spill_stats);
+/**
+ * Return the number of runs and of bytes spilled to disk by the temporal
+ * aggregates of the current backend
+ */
+PGDLLEXPORT Datum
+Aggregate_spill_stats(PG_FUNCTION_ARGS)
+{
+  TupleDesc tupdesc;
+  if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+      errmsg("function returning record called in context "
+        "that cannot accept type record")));
+  BlessTupleDesc(tupdesc);
+  Datum values[2];
+  bool isnull[2] = {0, 0};
+  values[0] = Int64GetDatum(aggregate_spill_runs);
+  values[1] = Int64GetDatum(aggregate_spill_bytes);
+  HeapTuple tuple = heap_form_tuple(tupdesc, values, isnull);
+  PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
+}
+
+/*****************************************************************************
+ * Generic binary aggregate functions needed for parallelization
+ *****************************************************************************/
+
+/**
+ * Writes the state value into the buffer
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[in] state State
+ * @param[in] buf Buffer
+ */
+void
+aggstate_write(FunctionCallInfo fcinfo, SkipList *state, StringInfo buf)
+{
+  void **values = skiplist_values(fcinfo, state);
+  skiplist_write_values(state->elemtype, values, state->length, buf);
+  if (state->elemtype == TEMPORAL)
+  {
     pq_sendint64(buf, state->extrasize);
     if (state->extra)
       pq_sendbytes(buf, state->extra, (int) state->extrasize);
@@ -630,41 +1175,23 @@ aggstate_write(SkipList *state, StringInfo buf)
  * @param[in] fcinfo Catalog information about the external function
  * @param[in] buf Buffer
  */
-static SkipList *
+SkipList *
 aggstate_read(FunctionCallInfo fcinfo, StringInfo buf)
 {
-  SkipListElemType elemtype = (SkipListElemType) pq_getmsgint(buf, 4);
-  int length = pq_getmsgint(buf, 4);
-  void **values = palloc0(sizeof(void *) * length);
-  SkipList *result = NULL; /* make compiler quiet */
-  if (elemtype == TIMESTAMPTZ)
-  {
-    for (int i = 0; i < length; i ++)
-      values[i] = (void **) DatumGetTimestampTz(call_recv(TIMESTAMPTZOID, buf));
-    result = skiplist_make(fcinfo, values, length, TIMESTAMPTZ);
-    pfree(values);
-  }
-  else if (elemtype == PERIOD)
-  {
-    for (int i = 0; i < length; i ++)
-      values[i] = period_read(buf);
-    result = skiplist_make(fcinfo, values, length, PERIOD);
-    pfree_array(values, length);
-  }
-  else /* elemtype == TEMPORAL */
+  SkipListElemType elemtype;
+  int length;
+  void **values = skiplist_read_values(buf, &elemtype, &length);
+  SkipList *result = skiplist_make(fcinfo, values, length, elemtype);
+  if (elemtype == TEMPORAL)
   {
-    CachedType temptype = pq_getmsgint(buf, 4);
-    for (int i = 0; i < length; i ++)
-      values[i] = temporal_read(buf, temptype);
     size_t extrasize = (size_t) pq_getmsgint64(buf);
-    result = skiplist_make(fcinfo, values, length, TEMPORAL);
     if (extrasize)
     {
       const char *extra = pq_getmsgbytes(buf, (int) extrasize);
       aggstate_set_extra(fcinfo, result, (void *) extra, extrasize);
     }
-    pfree_array(values, length);
   }
+  skiplist_free_values(elemtype, values, length);
   return result;
 }
 
@@ -699,7 +1226,7 @@ Tagg_serialize(PG_FUNCTION_ARGS)
   SkipList *state = (SkipList *) PG_GETARG_POINTER(0);
   StringInfoData buf;
   pq_begintypsend(&buf);
-  aggstate_write(state, &buf);
+  aggstate_write(fcinfo, state, &buf);
   PG_RETURN_BYTEA_P(pq_endtypsend(&buf));
 }
 
@@ -37,6 +37,7 @@
 /* PostgreSQL */
 #include <assert.h>
 #include <utils/builtins.h>
+#include <utils/lsyscache.h>
 /* MobilityDB */
 #include "general/tempcache.h"
 #include "general/timestampset.h"
@@ -774,6 +775,295 @@ adjacent_tbox_tbox(const TBOX *box1, const TBOX *box2)
   return result;
 }
 
+/*****************************************************************************
+ * Batch topological functions
+ *
+ * The batch functions filter an array of boxes by blocks. Each block is
+ * stored as a structure of arrays so that the comparisons of a dimension are
+ * computed by a branch-free loop over contiguous values, which the compiler
+ * vectorizes with the SIMD instructions of the target architecture. The
+ * flags of the boxes are verified once per block instead of once per pair.
+ *****************************************************************************/
+
+/**
+ * Filter a block of boxes on one dimension of type double
+ *
+ * @param[in] pred Predicate
+ * @param[in] qlo,qhi Bounds of the query box
+ * @param[in] lo,hi Arrays of bounds of the boxes
+ * @param[in] count Number of boxes
+ * @param[in,out] mask Array of matches, set to 0 for the boxes that
+ * do not satisfy the predicate
+ */
+void
+boxfilter_double(BoxPred pred, double qlo, double qhi, const double *lo,
+  const double *hi, int count, uint8 *mask)
+{
+  if (pred == BOX_CONTAINS)
+  {
+    for (int i = 0; i < count; i++)
+      mask[i] &= (lo[i] >= qlo) & (hi[i] <= qhi);
+  }
+  else
+  {
+    /* Overlaps: lo <= qhi and hi >= qlo, contained: lo <= qlo and hi >= qhi */
+    double a = (pred == BOX_OVERLAPS) ? qhi : qlo;
+    double b = (pred == BOX_OVERLAPS) ? qlo : qhi;
+    for (int i = 0; i < count; i++)
+      mask[i] &= (lo[i] <= a) & (hi[i] >= b);
+  }
+  return;
+}
+
+/**
+ * Filter a block of boxes on the time dimension
+ *
+ * @param[in] pred Predicate
+ * @param[in] qlo,qhi Bounds of the query box
+ * @param[in] lo,hi Arrays of bounds of the boxes
+ * @param[in] count Number of boxes
+ * @param[in,out] mask Array of matches, set to 0 for the boxes that
+ * do not satisfy the predicate
+ */
+void
+boxfilter_timestamp(BoxPred pred, TimestampTz qlo, TimestampTz qhi,
+  const TimestampTz *lo, const TimestampTz *hi, int count, uint8 *mask)
+{
+  if (pred == BOX_CONTAINS)
+  {
+    for (int i = 0; i < count; i++)
+      mask[i] &= (lo[i] >= qlo) & (hi[i] <= qhi);
+  }
+  else
+  {
+    TimestampTz a = (pred == BOX_OVERLAPS) ? qhi : qlo;
+    TimestampTz b = (pred == BOX_OVERLAPS) ? qlo : qhi;
+    for (int i = 0; i < count; i++)
+      mask[i] &= (lo[i] <= a) & (hi[i] >= b);
+  }
+  return;
+}
+
+/**
+ * Pack a block of matches into a bitmap and return the number of matches
+ *
+ * @param[in] mask Array of matches
+ * @param[in] count Number of elements in the array
+ * @param[out] bitmap Bitmap where bit j of byte i is set when the element
+ * 8 * i + j is a match
+ */
+int
+boxfilter_bitmap(const uint8 *mask, int count, uint8 *bitmap)
+{
+  int result = 0;
+  for (int i = 0; i < count; i += 8)
+  {
+    uint8 byte = 0;
+    for (int j = 0; j < 8 && i + j < count; j++)
+    {
+      byte |= (uint8) (mask[i + j] << j);
+      result += mask[i + j];
+    }
+    bitmap[i / 8] = byte;
+  }
+  return result;
+}
+
+/**
+ * Append the positions of a block of matches to a selection vector and
+ * return the number of matches
+ *
+ * @param[in] mask Array of matches
+ * @param[in] count Number of elements in the array
+ * @param[in] start Position of the first element of the block
+ * @param[out] sel Selection vector
+ */
+int
+boxfilter_selection(const uint8 *mask, int count, int start, int *sel)
+{
+  int result = 0;
+  for (int i = 0; i < count; i++)
+  {
+    /* Always write the position to avoid a branch */
+    sel[result] = start + i;
+    result += mask[i];
+  }
+  return result;
+}
+
+/**
+ * Return true if the temporal boxes satisfy the predicate
+ */
+static bool
+tbox_pred(BoxPred pred, const TBOX *box1, const TBOX *box2)
+{
+  if (pred == BOX_OVERLAPS)
+    return overlaps_tbox_tbox(box1, box2);
+  if (pred == BOX_CONTAINS)
+    return contains_tbox_tbox(box1, box2);
+  return contained_tbox_tbox(box1, box2);
+}
+
+/**
+ * Filter a block of temporal boxes with the same flags
+ */
+static void
+tbox_filter_block(const TBOX *box, BoxPred pred, bool hasx, bool hast,
+  const double *xmin, const double *xmax, const TimestampTz *tmin,
+  const TimestampTz *tmax, int count, uint8 *mask)
+{
+  memset(mask, 1, count);
+  if (hasx)
+    boxfilter_double(pred, box->xmin, box->xmax, xmin, xmax, count, mask);
+  if (hast)
+    boxfilter_timestamp(pred, box->tmin, box->tmax, tmin, tmax, count,
+      mask);
+  return;
+}
+
+/**
+ * @ingroup libmeos_box_topo
+ * @brief Construct a buffer storing the temporal boxes as a structure of
+ * arrays for the batch topological functions.
+ *
+ * @param[in] boxes Array of boxes
+ * @param[in] count Number of elements in the array
+ * @note All the boxes must have the same dimensions
+ */
+TBoxBuffer *
+tboxbuf_make(const TBOX *boxes, int count)
+{
+  assert(count > 0);
+  for (int i = 1; i < count; i++)
+  {
+    if (boxes[i].flags != boxes[0].flags)
+      ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+        errmsg("The boxes of the buffer must have the same dimensions")));
+  }
+  /* Allocate the structure and the arrays in a single chunk */
+  size_t size = double_pad(sizeof(TBoxBuffer)) +
+    (sizeof(double) * 2 + sizeof(TimestampTz) * 2) * count;
+  TBoxBuffer *result = palloc(size);
+  char *ptr = (char *) result + double_pad(sizeof(TBoxBuffer));
+  result->count = count;
+  result->flags = boxes[0].flags;
+  result->xmin = (double *) ptr;
+  result->xmax = result->xmin + count;
+  result->tmin = (TimestampTz *) (result->xmax + count);
+  result->tmax = result->tmin + count;
+  for (int i = 0; i < count; i++)
+  {
+    result->xmin[i] = boxes[i].xmin;
+    result->xmax[i] = boxes[i].xmax;
+    result->tmin[i] = boxes[i].tmin;
+    result->tmax[i] = boxes[i].tmax;
+  }
+  return result;
+}
+
+/**
+ * @ingroup libmeos_box_topo
+ * @brief Set the bitmap of the temporal boxes of the buffer that satisfy
+ * the predicate with respect to the box and return the number of matches.
+ *
+ * @param[in] box Query box
+ * @param[in] buf Buffer of boxes
+ * @param[in] pred Predicate
+ * @param[out] bitmap Bitmap of (count + 7) / 8 bytes where bit j of byte i
+ * is set when box 8 * i + j is a match
+ */
+int
+tboxbuf_filter(const TBOX *box, const TBoxBuffer *buf, BoxPred pred,
+  uint8 *bitmap)
+{
+  /* Verify the dimensions once for all the boxes of the buffer */
+  TBOX tmpl;
+  memset(&tmpl, 0, sizeof(TBOX));
+  tmpl.flags = buf->flags;
+  bool hasx, hast;
+  topo_tbox_tbox_init(box, &tmpl, &hasx, &hast);
+  uint8 mask[BOX_FILTER_BLOCK];
+  int result = 0;
+  for (int i = 0; i < buf->count; i += BOX_FILTER_BLOCK)
+  {
+    int n = Min(BOX_FILTER_BLOCK, buf->count - i);
+    tbox_filter_block(box, pred, hasx, hast, &buf->xmin[i], &buf->xmax[i],
+      &buf->tmin[i], &buf->tmax[i], n, mask);
+    result += boxfilter_bitmap(mask, n, &bitmap[i / 8]);
+  }
+  return result;
+}
+
+/**
+ * @ingroup libmeos_box_topo
+ * @brief Set the selection vector of the temporal boxes of the array that
+ * satisfy the predicate with respect to the box and return the number of
+ * matches.
+ *
+ * @param[in] box Query box
+ * @param[in] boxes Array of boxes
+ * @param[in] count Number of elements in the array
+ * @param[in] pred Predicate
+ * @param[out] sel Selection vector of count elements receiving the
+ * positions of the matches
+ */
+int
+tboxarr_filter(const TBOX *box, const TBOX *boxes, int count, BoxPred pred,
+  int *sel)
+{
+  double xmin[BOX_FILTER_BLOCK], xmax[BOX_FILTER_BLOCK];
+  TimestampTz tmin[BOX_FILTER_BLOCK], tmax[BOX_FILTER_BLOCK];
+  uint8 mask[BOX_FILTER_BLOCK];
+  bool hasx = false, hast = false, init = false;
+  int16 flags = 0;
+  int result = 0;
+  for (int i = 0; i < count; i += BOX_FILTER_BLOCK)
+  {
+    int n = Min(BOX_FILTER_BLOCK, count - i);
+    const TBOX *block = &boxes[i];
+    /* Transpose the block and verify that the boxes have the same flags */
+    bool same = true;
+    for (int j = 0; j < n; j++)
+    {
+      xmin[j] = block[j].xmin;
+      xmax[j] = block[j].xmax;
+      tmin[j] = block[j].tmin;
+      tmax[j] = block[j].tmax;
+      same &= (block[j].flags == block[0].flags);
+    }
+    if (! same)
+    {
+      /* Boxes with different dimensions are verified pair by pair */
+      for (int j = 0; j < n; j++)
+        mask[j] = tbox_pred(pred, box, &block[j]);
+    }
+    else
+    {
+      if (! init || block[0].flags != flags)
+      {
+        topo_tbox_tbox_init(box, &block[0], &hasx, &hast);
+        flags = block[0].flags;
+        init = true;
+      }
+      tbox_filter_block(box, pred, hasx, hast, xmin, xmax, tmin, tmax, n,
+        mask);
+    }
+    result += boxfilter_selection(mask, n, i, &sel[result]);
+  }
+  return result;
+}
+
+/**
+ * @ingroup libmeos_box_topo
+ * @brief Free the buffer of temporal boxes.
+ */
+void
+tboxbuf_free(TBoxBuffer *buf)
+{
+  pfree(buf);
+  return;
+}
+
 /*****************************************************************************
  * Relative position operators
  *****************************************************************************/
@@ -1659,6 +1949,93 @@ Adjacent_tbox_tbox(PG_FUNCTION_ARGS)
   PG_RETURN_BOOL(adjacent_tbox_tbox(box1, box2));
 }
 
+/*****************************************************************************/
+
+/**
+ * Return the positions of the temporal boxes of the array that satisfy
+ * the predicate with respect to the box
+ *
+ * @note The NULL elements of the array are skipped. The result is an empty
+ * array when the array is empty or no box satisfies the predicate.
+ */
+static Datum
+tboxarr_filter_ext(FunctionCallInfo fcinfo, BoxPred pred)
+{
+  TBOX *box = PG_GETARG_TBOX_P(0);
+  ArrayType *array = PG_GETARG_ARRAYTYPE_P(1);
+  Datum *values;
+  bool *nulls, byval;
+  int16 typlen;
+  char align;
+  int count;
+  get_typlenbyvalalign(ARR_ELEMTYPE(array), &typlen, &byval, &align);
+  deconstruct_array(array, ARR_ELEMTYPE(array), typlen, byval, align,
+    &values, &nulls, &count);
+  /* Copy the non-null boxes into a contiguous array keeping their position */
+  TBOX *boxes = palloc(sizeof(TBOX) * Max(count, 1));
+  int *pos = palloc(sizeof(int) * Max(count, 1));
+  int nboxes = 0;
+  for (int i = 0; i < count; i++)
+  {
+    if (nulls[i])
+      continue;
+    boxes[nboxes] = *DatumGetTboxP(values[i]);
+    pos[nboxes++] = i;
+  }
+  int *sel = palloc(sizeof(int) * Max(nboxes, 1));
+  int nsel = (nboxes == 0) ? 0 :
+    tboxarr_filter(box, boxes, nboxes, pred, sel);
+  pfree(values); pfree(nulls); pfree(boxes);
+  PG_FREE_IF_COPY(array, 1);
+  ArrayType *result;
+  if (nsel == 0)
+    result = construct_empty_array(INT4OID);
+  else
+  {
+    /* The positions of the SQL array start at 1 */
+    Datum *positions = palloc(sizeof(Datum) * nsel);
+    for (int i = 0; i < nsel; i++)
+      positions[i] = Int32GetDatum(pos[sel[i]] + 1);
+    result = construct_array(positions, nsel, INT4OID, 4, true, 'i');
+    pfree(positions);
+  }
+  pfree(pos); pfree(sel);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Contains_tbox_tboxarr);
+/**
+ * Return the positions of the temporal boxes of the array that are
+ * contained by the temporal box
+ */
+PGDLLEXPORT Datum
+Contains_tbox_tboxarr(PG_FUNCTION_ARGS)
+{
+  return tboxarr_filter_ext(fcinfo, BOX_CONTAINS);
+}
+
+PG_FUNCTION_INFO_V1(Contained_tbox_tboxarr);
+/**
+ * Return the positions of the temporal boxes of the array that contain the
+ * temporal box
+ */
+PGDLLEXPORT Datum
+Contained_tbox_tboxarr(PG_FUNCTION_ARGS)
+{
+  return tboxarr_filter_ext(fcinfo, BOX_CONTAINED);
+}
+
+PG_FUNCTION_INFO_V1(Overlaps_tbox_tboxarr);
+/**
+ * Return the positions of the temporal boxes of the array that overlap the
+ * temporal box
+ */
+PGDLLEXPORT Datum
+Overlaps_tbox_tboxarr(PG_FUNCTION_ARGS)
+{
+  return tboxarr_filter_ext(fcinfo, BOX_OVERLAPS);
+}
+
 /*****************************************************************************
  * Relative position operators
  *****************************************************************************/
@@ -45,6 +45,7 @@
 #include <access/detoast.h>
 #endif
 #include <catalog/namespace.h>
+#include <funcapi.h>
 #include <libpq/pqformat.h>
 #include <utils/builtins.h>
 #include <utils/fmgroids.h>
@@ -59,9 +60,12 @@
 #include "general/tempcache.h"
 #include "general/temporal_util.h"
 #include "general/temporal_boxops.h"
+#include "general/temporal_compact.h"
 #include "general/temporal_parser.h"
 #include "general/rangetypes_ext.h"
+#include "general/skiplist.h"
 #include "general/tnumber_distance.h"
+#include "point/tpoint_livestore.h"
 #include "point/tpoint_spatialfuncs.h"
 #include "npoint/tnpoint_static.h"
 #include "npoint/tnpoint_spatialfuncs.h"
@@ -2897,6 +2901,45 @@ tnumber_twavg(const Temporal *temp)
   return result;
 }
 
+/**
+ * @ingroup libmeos_temporal_agg
+ * @brief Compute the summary statistics of the temporal number.
+ *
+ * @param[in] temp Temporal number
+ * @param[out] stats Statistics
+ * @note The minimum and maximum values are taken from the bounding box and
+ * the integral is computed in a single pass from which the time-weighted
+ * average is derived, except for instantaneous values
+ */
+void
+tnumber_stats(const Temporal *temp, TNumberStats *stats)
+{
+  TBOX box;
+  temporal_bbox(temp, &box);
+  stats->minvalue = box.xmin;
+  stats->maxvalue = box.xmax;
+  stats->integral = tnumber_integral(temp);
+  Interval *duration = temporal_duration(temp);
+  memcpy(&stats->duration, duration, sizeof(Interval));
+  pfree(duration);
+  double secs = 0.0;
+  if (temp->subtype == SEQUENCE)
+    secs = (double) (((TSequence *) temp)->period.upper -
+      ((TSequence *) temp)->period.lower);
+  else if (temp->subtype == SEQUENCESET)
+  {
+    const TSequenceSet *ts = (const TSequenceSet *) temp;
+    for (int i = 0; i < ts->count; i++)
+    {
+      const TSequence *seq = tsequenceset_seq_n(ts, i);
+      secs += (double) (seq->period.upper - seq->period.lower);
+    }
+  }
+  stats->twavg = (secs == 0.0) ? tnumber_twavg(temp) :
+    stats->integral / secs;
+  return;
+}
+
 /*****************************************************************************
  * Functions for defining B-tree index
  *****************************************************************************/
@@ -3190,6 +3233,9 @@ _PG_init(void)
 {
   /* elog(WARNING, "This is MobilityDB."); */
   temporalgeom_init();
+  livestore_init();
+  compact_init();
+  skiplist_init();
 }
 
 /*****************************************************************************
@@ -5159,6 +5205,37 @@ Tnumber_twavg(PG_FUNCTION_ARGS)
   PG_RETURN_FLOAT8(result);
 }
 
+PG_FUNCTION_INFO_V1(Tnumber_stats);
+/**
+ * Return the summary statistics of the temporal number
+ */
+PGDLLEXPORT Datum
+Tnumber_stats(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  TNumberStats stats;
+  tnumber_stats(temp, &stats);
+  PG_FREE_IF_COPY(temp, 0);
+
+  TupleDesc tupdesc;
+  if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+      errmsg("function returning record called in context "
+        "that cannot accept type record")));
+  BlessTupleDesc(tupdesc);
+  Datum values[5];
+  bool isnull[5] = {0, 0, 0, 0, 0};
+  Interval *duration = palloc(sizeof(Interval));
+  memcpy(duration, &stats.duration, sizeof(Interval));
+  values[0] = Float8GetDatum(stats.minvalue);
+  values[1] = Float8GetDatum(stats.maxvalue);
+  values[2] = Float8GetDatum(stats.twavg);
+  values[3] = Float8GetDatum(stats.integral);
+  values[4] = PointerGetDatum(duration);
+  HeapTuple tuple = heap_form_tuple(tupdesc, values, isnull);
+  PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
+}
+
 /*****************************************************************************
  * Functions for defining B-tree index
  *****************************************************************************/
@@ -192,9 +192,10 @@ tinstant_tagg(TInstant **instants1, int count1, TInstant **instants2,
       j++;
     }
   }
-  /* We finished to aggregate state1 */
-  assert (i == count1);
-  /* Copy the instants from state2 that are after the end of state1 */
+  /* Copy the instants from state1 or state2 that are after the end of the
+     other state */
+  while (i < count1)
+    result[count++] = tinstant_copy(instants1[i++]);
   while (j < count2)
     result[count++] = tinstant_copy(instants2[j++]);
   *newcount = count;
@@ -614,8 +615,8 @@ temporal_tagg_combinefn1(FunctionCallInfo fcinfo, SkipList *state1,
 
   Temporal *head2 = (Temporal *) skiplist_headval(state2);
   ensure_same_tempsubtype_skiplist(state1, head2);
+  void **values2 = skiplist_values(fcinfo, state2);
   int count2 = state2->length;
-  void **values2 = skiplist_values(state2);
   skiplist_splice(fcinfo, state1, values2, count2, func, crossings);
   pfree_array(values2, count2);
   return state1;
@@ -656,7 +657,7 @@ Temporal_tagg_finalfn(PG_FUNCTION_ARGS)
   if (state->length == 0)
     PG_RETURN_NULL();
 
-  Temporal **values = (Temporal **) skiplist_values(state);
+  Temporal **values = (Temporal **) skiplist_values(fcinfo, state);
   Temporal *result = NULL;
   assert(values[0]->subtype == INSTANT || values[0]->subtype == SEQUENCE);
   if (values[0]->subtype == INSTANT)
@@ -1384,7 +1385,7 @@ Tnumber_tavg_finalfn(PG_FUNCTION_ARGS)
   if (state->length == 0)
     PG_RETURN_NULL();
 
-  Temporal **values = (Temporal **) skiplist_values(state);
+  Temporal **values = (Temporal **) skiplist_values(fcinfo, state);
   assert(values[0]->subtype == INSTANT || values[0]->subtype == SEQUENCE);
   Temporal *result = (values[0]->subtype == INSTANT) ?
     (Temporal *) tinstant_tavg_finalfn((TInstant **)values, state->length) :
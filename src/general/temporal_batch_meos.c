@@ -0,0 +1,315 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_batch_meos.c
+ * @brief Input of many temporal values stored in a single buffer.
+ *
+ * Bulk loaders read many small values from a large file buffer. Parsing
+ * them one at a time with the input functions allocates and copies each
+ * value several times and leaves the intermediate structures of the parser
+ * behind. The batch functions read the values in place, share the state of
+ * the parser among the values, allocate the intermediate structures of a
+ * value in a scratch context that is reset after each value, and copy only
+ * the resulting temporal values into a memory context given by the caller.
+ */
+
+#include "general/temporal_batch.h"
+
+/* PostgreSQL */
+#include <utils/memutils.h>
+/* JSON-C */
+#include <json-c/json.h>
+/* MobilityDB */
+#include "general/doxygen_libmeos_api.h"
+#include "general/temporal_parser.h"
+#include "general/temporal_util.h"
+#include "point/postgis.h"
+#include "point/tpoint_in.h"
+#include "point/tpoint_parser.h"
+
+/*****************************************************************************
+ * Batch reader
+ *****************************************************************************/
+
+/**
+ * Initialize the reader of a batch
+ *
+ * @param[out] reader Reader
+ * @param[in] buffer Buffer containing the values
+ * @param[in] size Size of the buffer in bytes
+ * @param[in] delim Delimiter of the values, '\0' for values preceded by
+ * their length
+ */
+void
+batchreader_init(BatchReader *reader, const char *buffer, size_t size,
+  char delim)
+{
+  reader->buffer = buffer;
+  reader->size = size;
+  reader->pos = 0;
+  reader->delim = delim;
+  reader->scratch = NULL;
+  reader->scratchsize = 0;
+  return;
+}
+
+/**
+ * Get the next value of the batch, skipping empty values
+ *
+ * @param[in,out] reader Reader
+ * @param[out] value Start of the value in the buffer, which is not
+ * null-terminated
+ * @param[out] len Length of the value
+ * @result False when there are no more values
+ */
+bool
+batchreader_next(BatchReader *reader, const char **value, size_t *len)
+{
+  while (reader->pos < reader->size)
+  {
+    const char *start = reader->buffer + reader->pos;
+    size_t avail = reader->size - reader->pos;
+    size_t n;
+    if (reader->delim == '\0')
+    {
+      if (avail < 4)
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+          errmsg("Incomplete length of value at offset %zu of batch input",
+            reader->pos)));
+      const uint8 *bytes = (const uint8 *) start;
+      n = (size_t) bytes[0] | ((size_t) bytes[1] << 8) |
+        ((size_t) bytes[2] << 16) | ((size_t) bytes[3] << 24);
+      if (n > avail - 4)
+        ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+          errmsg("Invalid length %zu of value at offset %zu of batch input",
+            n, reader->pos)));
+      start += 4;
+      reader->pos += 4 + n;
+    }
+    else
+    {
+      const char *end = memchr(start, reader->delim, avail);
+      n = end ? (size_t) (end - start) : avail;
+      reader->pos += end ? n + 1 : n;
+      /* Tolerate Windows line endings */
+      if (reader->delim == '\n' && n > 0 && start[n - 1] == '\r')
+        n--;
+    }
+    if (n > 0)
+    {
+      *value = start;
+      *len = n;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Return a null-terminated copy of the value in the scratch buffer of the
+ * reader, which is only enlarged when a value longer than all previous ones
+ * is found
+ */
+static char *
+batchreader_cstring(BatchReader *reader, const char *value, size_t len)
+{
+  if (len + 1 > reader->scratchsize)
+  {
+    size_t size = Max(len + 1, reader->scratchsize * 2);
+    reader->scratch = reader->scratch ? repalloc(reader->scratch, size) :
+      palloc(size);
+    reader->scratchsize = size;
+  }
+  memcpy(reader->scratch, value, len);
+  reader->scratch[len] = '\0';
+  return reader->scratch;
+}
+
+/*****************************************************************************
+ * Parsing of the values
+ *****************************************************************************/
+
+/**
+ * Return the SRID of a coordinate reference system given by its EPSG code,
+ * such as "EPSG:4326" or "urn:ogc:def:crs:EPSG::4326", since the spatial
+ * reference system table cannot be queried outside the database
+ */
+static int
+batch_srs_srid(const char *srs)
+{
+  const char *code = strrchr(srs, ':');
+  if (strncasecmp(srs, "EPSG:", 5) != 0 &&
+      strncasecmp(srs, "urn:ogc:def:crs:EPSG:", 21) != 0)
+    code = NULL;
+  if (code == NULL || code[1] == '\0' ||
+      strspn(code + 1, "0123456789") != strlen(code + 1))
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("Unable to find SRID of the coordinate reference system %s", srs)));
+  return atoi(code + 1);
+}
+
+/**
+ * Return a temporal point from its MF-JSON representation, reusing the
+ * tokenizer of the batch
+ */
+static Temporal *
+batch_parse_mfjson(json_tokener *jstok, const char *value, size_t len,
+  CachedType temptype)
+{
+  json_tokener_reset(jstok);
+  json_object *poObj = json_tokener_parse_ex(jstok, value, (int) len);
+  if (jstok->err != json_tokener_success)
+  {
+    json_object_put(poObj);
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("Error while processing MFJSON string")));
+  }
+  Temporal *result = NULL;
+  /* The parsed object is allocated by json-c and must be released on error */
+  PG_TRY();
+  {
+    int srid = 0;
+    char *srs = tpoint_mfjson_srs(poObj);
+    if (srs)
+      srid = batch_srs_srid(srs);
+    result = tpoint_from_mfjson_obj(poObj, srid, temptype);
+    if (result == NULL)
+      ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+        errmsg("Error while processing MFJSON string")));
+  }
+  PG_CATCH();
+  {
+    json_object_put(poObj);
+    PG_RE_THROW();
+  }
+  PG_END_TRY();
+  json_object_put(poObj);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_input_output
+ * @brief Return the temporal values stored in a buffer.
+ *
+ * The values are in WKT format, or in HexWKB or MF-JSON format for temporal
+ * points, and are either separated by a delimiter, typically a newline, or
+ * preceded by their length as a 4-byte little-endian unsigned integer.
+ * Empty values are skipped.
+ *
+ * @param[in] buffer Buffer containing the values
+ * @param[in] size Size of the buffer in bytes
+ * @param[in] format Format of the values
+ * @param[in] temptype Temporal type of the values, ignored for HexWKB where
+ * the type is read from the value
+ * @param[in] delim Delimiter of the values, '\0' for values preceded by
+ * their length
+ * @param[in] arena Memory context in which the result is allocated, the
+ * current one when NULL
+ * @param[out] count Number of values
+ * @result Array of temporal values, NULL when the buffer has no value
+ * @note The memory used for parsing a value is released before parsing the
+ * next one, so that the memory used by the call is proportional to the size
+ * of the result. Parsing stops at the first invalid value, with an error.
+ */
+Temporal **
+temporal_in_batch(const char *buffer, size_t size, BatchFormat format,
+  CachedType temptype, char delim, MemoryContext arena, int *count)
+{
+  if (format != BATCH_HEXWKB)
+    ensure_temporal_type(temptype);
+  if (format == BATCH_MFJSON)
+    ensure_tgeo_type(temptype);
+  bool tgeo = (format != BATCH_HEXWKB) && tgeo_type(temptype);
+  MemoryContext resultcxt = arena ? arena : CurrentMemoryContext;
+  MemoryContext scratchcxt = AllocSetContextCreate(CurrentMemoryContext,
+    "Temporal batch input", ALLOCSET_DEFAULT_SIZES);
+  json_tokener *jstok = (format == BATCH_MFJSON) ? json_tokener_new() : NULL;
+
+  BatchReader reader;
+  batchreader_init(&reader, buffer, size, delim);
+  int maxcount = 64, k = 0;
+  Temporal **result = MemoryContextAlloc(resultcxt,
+    sizeof(Temporal *) * maxcount);
+  const char *value;
+  size_t len;
+  /* The tokenizer is allocated by json-c and must be released on error */
+  PG_TRY();
+  {
+    while (batchreader_next(&reader, &value, &len))
+    {
+      char *str = (format == BATCH_WKT) ?
+        batchreader_cstring(&reader, value, len) : NULL;
+      MemoryContext oldcxt = MemoryContextSwitchTo(scratchcxt);
+      Temporal *temp;
+      if (format == BATCH_WKT)
+        temp = tgeo ? tpoint_parse(&str, temptype) :
+          temporal_parse(&str, temptype);
+      else if (format == BATCH_HEXWKB)
+      {
+        uint8_t *wkb = bytes_from_hexbytes(value, len);
+        temp = tpoint_from_ewkb(wkb, (int) (len / 2));
+      }
+      else /* format == BATCH_MFJSON */
+        temp = batch_parse_mfjson(jstok, value, len, temptype);
+      /* Copy the value into the arena and release the memory of the parser */
+      MemoryContextSwitchTo(resultcxt);
+      if (k == maxcount)
+      {
+        maxcount *= 2;
+        result = repalloc(result, sizeof(Temporal *) * maxcount);
+      }
+      result[k++] = temporal_copy(temp);
+      MemoryContextSwitchTo(oldcxt);
+      MemoryContextReset(scratchcxt);
+    }
+  }
+  PG_CATCH();
+  {
+    if (jstok)
+      json_tokener_free(jstok);
+    PG_RE_THROW();
+  }
+  PG_END_TRY();
+
+  if (jstok)
+    json_tokener_free(jstok);
+  if (reader.scratch)
+    pfree(reader.scratch);
+  MemoryContextDelete(scratchcxt);
+  *count = k;
+  if (k == 0)
+  {
+    pfree(result);
+    return NULL;
+  }
+  return result;
+}
+
+/*****************************************************************************/
@@ -0,0 +1,632 @@
+/***********************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_compact.c
+ * @brief Background worker compacting the fragments of temporal values.
+ *
+ * Streaming ingestion typically stores the trip of a moving object as many
+ * short fragments, each one in its own row. The worker periodically looks,
+ * in the tables given by the `mobilitydb.compact_tables` parameter, for
+ * fragments of the same object that are adjacent in time, and replaces each
+ * group of such fragments by a single row whose temporal value is obtained
+ * with the `merge` function. The other columns of the first row of the group
+ * are kept. Each group is rewritten in its own subtransaction, at most
+ * `mobilitydb.compact_batch` groups are rewritten per transaction, and the
+ * worker sleeps `mobilitydb.compact_delay` milliseconds between transactions.
+ *
+ * The worker is only started when MobilityDB is loaded through the
+ * `shared_preload_libraries` parameter and `mobilitydb.compact_database` is
+ * set. The `compactTable` function compacts a table on demand in the current
+ * transaction.
+ */
+
+#include "general/temporal_compact.h"
+
+/* PostgreSQL */
+#include <assert.h>
+#include <ctype.h>
+#include <access/xact.h>
+#include <catalog/namespace.h>
+#include <catalog/pg_type.h>
+#include <executor/spi.h>
+#include <lib/stringinfo.h>
+#include <miscadmin.h>
+#include <pgstat.h>
+#include <postmaster/bgworker.h>
+#include <storage/ipc.h>
+#include <storage/latch.h>
+#include <utils/builtins.h>
+#include <utils/datum.h>
+#include <utils/guc.h>
+#include <utils/lsyscache.h>
+#include <utils/memutils.h>
+#include <utils/regproc.h>
+#include <utils/resowner.h>
+#include <utils/snapmgr.h>
+
+/*****************************************************************************
+ * Configuration parameters
+ *****************************************************************************/
+
+/** Database the worker connects to, the worker is not started if not set */
+static char *compact_database = NULL;
+/** Comma-separated list of `table:idcolumn:tcolumn` entries to compact */
+static char *compact_tables = NULL;
+/** Time between two compaction rounds in seconds */
+static int compact_naptime = COMPACT_DEFAULT_NAPTIME;
+/** Maximum number of groups of fragments rewritten per transaction */
+static int compact_batch = COMPACT_DEFAULT_BATCH;
+/** Time between two transactions of a round in milliseconds */
+static int compact_delay = COMPACT_DEFAULT_DELAY;
+/** Maximum gap in seconds between two fragments merged together */
+static int compact_maxgap = COMPACT_DEFAULT_MAXGAP;
+
+/*****************************************************************************
+ * Worker state
+ *****************************************************************************/
+
+/**
+ * Table to compact
+ */
+typedef struct
+{
+  char *table;       /**< possibly qualified table name */
+  char *idcol;       /**< column identifying the moving objects */
+  char *tcol;        /**< temporal column */
+} CompactTarget;
+
+/**
+ * Position of the last group of fragments found by the previous batch, so
+ * that the groups that could not be merged are not found again
+ */
+typedef struct
+{
+  bool valid;          /**< false before the first batch */
+  Oid idtype;          /**< type of the identifier column */
+  Datum id;            /**< identifier of the last group */
+  int64 grp;           /**< number of the last group of the object */
+  MemoryContext mcxt;  /**< memory context of the identifier */
+} CompactCursor;
+
+/* Memory context of the parsed configuration, reset at each round */
+static MemoryContext compact_context = NULL;
+
+/* Flags set by the signal handlers */
+static volatile sig_atomic_t got_sighup = false;
+static volatile sig_atomic_t got_sigterm = false;
+
+/**
+ * Signal handler for SIGTERM
+ */
+static void
+compact_sigterm(SIGNAL_ARGS)
+{
+  int save_errno = errno;
+  got_sigterm = true;
+  SetLatch(MyLatch);
+  errno = save_errno;
+}
+
+/**
+ * Signal handler for SIGHUP
+ */
+static void
+compact_sighup(SIGNAL_ARGS)
+{
+  int save_errno = errno;
+  got_sighup = true;
+  SetLatch(MyLatch);
+  errno = save_errno;
+}
+
+/*****************************************************************************
+ * Initialization
+ *****************************************************************************/
+
+/**
+ * Define the configuration parameters of the compaction worker and, when
+ * MobilityDB is loaded through `shared_preload_libraries`, register it
+ *
+ * @note Called from the initialization function of the extension
+ */
+void
+compact_init(void)
+{
+  BackgroundWorker worker;
+
+  DefineCustomStringVariable("mobilitydb.compact_database",
+    "Database in which the compaction worker runs.",
+    "The worker is not started if not set. Requires loading MobilityDB "
+    "through shared_preload_libraries.",
+    &compact_database, NULL, PGC_POSTMASTER, 0, NULL, NULL, NULL);
+  DefineCustomStringVariable("mobilitydb.compact_tables",
+    "Tables compacted by the compaction worker.",
+    "Comma-separated list of table:idcolumn:tcolumn entries.",
+    &compact_tables, "", PGC_SIGHUP, 0, NULL, NULL, NULL);
+  DefineCustomIntVariable("mobilitydb.compact_naptime",
+    "Time to sleep between two compaction rounds.", NULL,
+    &compact_naptime, COMPACT_DEFAULT_NAPTIME, 1, INT_MAX / 1000,
+    PGC_SIGHUP, GUC_UNIT_S, NULL, NULL, NULL);
+  DefineCustomIntVariable("mobilitydb.compact_batch",
+    "Maximum number of groups of fragments rewritten per transaction.", NULL,
+    &compact_batch, COMPACT_DEFAULT_BATCH, 1, INT_MAX,
+    PGC_SUSET, 0, NULL, NULL, NULL);
+  DefineCustomIntVariable("mobilitydb.compact_delay",
+    "Time to sleep between two compaction transactions.", NULL,
+    &compact_delay, COMPACT_DEFAULT_DELAY, 0, INT_MAX,
+    PGC_SIGHUP, GUC_UNIT_MS, NULL, NULL, NULL);
+  DefineCustomIntVariable("mobilitydb.compact_maxgap",
+    "Maximum time gap between two fragments merged together.", NULL,
+    &compact_maxgap, COMPACT_DEFAULT_MAXGAP, 0, INT_MAX,
+    PGC_SIGHUP, GUC_UNIT_S, NULL, NULL, NULL);
+
+  if (! process_shared_preload_libraries_in_progress ||
+      compact_database == NULL || compact_database[0] == '\0')
+    return;
+
+  memset(&worker, 0, sizeof(worker));
+  worker.bgw_flags = BGWORKER_SHMEM_ACCESS |
+    BGWORKER_BACKEND_DATABASE_CONNECTION;
+  worker.bgw_start_time = BgWorkerStart_RecoveryFinished;
+  worker.bgw_restart_time = COMPACT_DEFAULT_NAPTIME;
+  snprintf(worker.bgw_library_name, BGW_MAXLEN, "lib%s", MOBILITYDB_LIB_NAME);
+  snprintf(worker.bgw_function_name, BGW_MAXLEN, "Compact_worker_main");
+  snprintf(worker.bgw_name, BGW_MAXLEN, "MobilityDB compaction worker");
+  snprintf(worker.bgw_type, BGW_MAXLEN, "MobilityDB compaction worker");
+  worker.bgw_main_arg = (Datum) 0;
+  worker.bgw_notify_pid = 0;
+  RegisterBackgroundWorker(&worker);
+  return;
+}
+
+/*****************************************************************************
+ * Compaction functions
+ *****************************************************************************/
+
+/**
+ * Remove the leading and trailing whitespace of a string in place
+ */
+static char *
+compact_trim(char *str)
+{
+  char *end;
+  while (isspace((unsigned char) *str))
+    str++;
+  end = str + strlen(str);
+  while (end > str && isspace((unsigned char) end[-1]))
+    end--;
+  *end = '\0';
+  return str;
+}
+
+/**
+ * Parse the `mobilitydb.compact_tables` parameter. Invalid entries are
+ * reported and ignored.
+ */
+static CompactTarget *
+compact_targets(int *count)
+{
+  char *list = pstrdup(compact_tables ? compact_tables : "");
+  char *saveptr1, *entry;
+  int maxcount = 4;
+  CompactTarget *result = palloc(sizeof(CompactTarget) * maxcount);
+  *count = 0;
+  for (entry = strtok_r(list, ",", &saveptr1); entry;
+       entry = strtok_r(NULL, ",", &saveptr1))
+  {
+    char *saveptr2;
+    char *table = strtok_r(entry, ":", &saveptr2);
+    char *idcol = strtok_r(NULL, ":", &saveptr2);
+    char *tcol = strtok_r(NULL, ":", &saveptr2);
+    if (! table || ! idcol || ! tcol || strtok_r(NULL, ":", &saveptr2))
+    {
+      ereport(WARNING, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+        errmsg("invalid entry \"%s\" in mobilitydb.compact_tables", entry),
+        errhint("Entries must have the form table:idcolumn:tcolumn.")));
+      continue;
+    }
+    if (*count == maxcount)
+    {
+      maxcount *= 2;
+      result = repalloc(result, sizeof(CompactTarget) * maxcount);
+    }
+    result[*count].table = compact_trim(table);
+    result[*count].idcol = compact_trim(idcol);
+    result[*count].tcol = compact_trim(tcol);
+    (*count)++;
+  }
+  return result;
+}
+
+/**
+ * Return the quoted qualified name of a table
+ *
+ * @note Must be called within a transaction
+ */
+static char *
+compact_relid_name(Oid relid)
+{
+  return quote_qualified_identifier(
+    get_namespace_name(get_rel_namespace(relid)), get_rel_name(relid));
+}
+
+/**
+ * Return the quoted qualified name of a table, or NULL if the table does not
+ * exist
+ *
+ * @note Must be called within a transaction
+ */
+static char *
+compact_table_name(const char *table)
+{
+  List *names = stringToQualifiedNameList(table);
+  Oid relid = RangeVarGetRelid(makeRangeVarFromNameList(names), NoLock, true);
+  if (! OidIsValid(relid))
+    return NULL;
+  return compact_relid_name(relid);
+}
+
+/**
+ * Rewrite a group of fragments, given by the array of their tuple
+ * identifiers, as a single row and return true if the group was rewritten.
+ * The group is skipped if some of its rows were concurrently modified.
+ *
+ * @note Must be called within a subtransaction
+ */
+static bool
+compact_group(const char *table, const char *tcol, Datum tids, Oid tidstype,
+  int count)
+{
+  StringInfoData sql;
+  Oid argtypes[1] = {tidstype};
+  Datum values[1] = {tids};
+  bool isnull;
+
+  /* Lock the rows of the group and check that none of them has moved */
+  initStringInfo(&sql);
+  appendStringInfo(&sql,
+    "SELECT count(*) FROM (SELECT 1 FROM %s WHERE ctid = ANY($1) "
+    "FOR UPDATE) AS t", table);
+  if (SPI_execute_with_args(sql.data, 1, argtypes, values, NULL, false, 1)
+      != SPI_OK_SELECT ||
+      DatumGetInt64(SPI_getbinval(SPI_tuptable->vals[0],
+        SPI_tuptable->tupdesc, 1, &isnull)) != count)
+    return false;
+
+  /* Merge the fragments into the first row and delete the other ones */
+  resetStringInfo(&sql);
+  appendStringInfo(&sql,
+    "WITH m AS ("
+    "SELECT merge(array_agg(%2$s ORDER BY startTimestamp(%2$s))) AS t "
+    "FROM %1$s WHERE ctid = ANY($1)), "
+    "u AS (UPDATE %1$s SET %2$s = m.t FROM m WHERE %1$s.ctid = $1[1] "
+    "RETURNING 1) "
+    "DELETE FROM %1$s WHERE ctid = ANY($1[2:])", table, tcol);
+  if (SPI_execute_with_args(sql.data, 1, argtypes, values, NULL, false, 0)
+      != SPI_OK_DELETE)
+    return false;
+  pfree(sql.data);
+  return true;
+}
+
+/**
+ * Initialize the cursor of the groups of fragments of a table
+ */
+static void
+compact_cursor_init(CompactCursor *cursor, MemoryContext mcxt)
+{
+  memset(cursor, 0, sizeof(CompactCursor));
+  cursor->mcxt = mcxt;
+  return;
+}
+
+/**
+ * Advance the cursor of the groups of fragments to the last group found
+ */
+static void
+compact_cursor_set(CompactCursor *cursor, SPITupleTable *groups, int count)
+{
+  bool isnull, typbyval;
+  int16 typlen;
+  HeapTuple last = groups->vals[count - 1];
+  Datum id = SPI_getbinval(last, groups->tupdesc, 3, &isnull);
+  Oid idtype = SPI_gettypeid(groups->tupdesc, 3);
+  get_typlenbyval(idtype, &typlen, &typbyval);
+  if (cursor->valid && ! typbyval)
+    pfree(DatumGetPointer(cursor->id));
+  MemoryContext oldcontext = MemoryContextSwitchTo(cursor->mcxt);
+  cursor->id = datumCopy(id, typbyval, typlen);
+  MemoryContextSwitchTo(oldcontext);
+  cursor->idtype = idtype;
+  cursor->grp = DatumGetInt64(SPI_getbinval(last, groups->tupdesc, 4,
+    &isnull));
+  cursor->valid = true;
+  return;
+}
+
+/**
+ * Rewrite at most `batch` groups of fragments of a table in the current
+ * transaction and return the number of groups merged
+ *
+ * The groups are found in the order of the object identifier and of their
+ * number within the object, starting after the last group found by the
+ * previous batch. The groups that cannot be merged are thus skipped by the
+ * next batches. Fragments with a null identifier are not compacted.
+ *
+ * @param[in] table Quoted qualified name of the table
+ * @param[in] idcol,tcol Quoted names of the identifier and temporal columns
+ * @param[in] maxgap Maximum gap between two fragments merged together, as
+ * an interval literal
+ * @param[in] batch Maximum number of groups rewritten
+ * @param[in,out] cursor Position of the last group found by the previous
+ * batch, advanced to the last group found by this batch
+ * @param[out] found Number of groups found, which includes the groups that
+ * could not be merged
+ * @note Must be called after connecting to SPI
+ */
+static int
+compact_table_batch(const char *table, const char *idcol, const char *tcol,
+  const char *maxgap, int batch, CompactCursor *cursor, int *found)
+{
+  MemoryContext oldcontext = CurrentMemoryContext;
+  ResourceOwner oldowner = CurrentResourceOwner;
+  SPITupleTable *groups;
+  StringInfoData sql;
+  Oid argtypes[2];
+  Datum values[2];
+  int count;
+  volatile int merged = 0;
+
+  /* Find the groups of fragments of the same object that are adjacent in
+   * time, that is, whose gap with the previous fragments is at most
+   * maxgap. The tuple identifiers of each group are sorted by start
+   * timestamp. */
+  initStringInfo(&sql);
+  appendStringInfo(&sql,
+    "SELECT array_agg(tid ORDER BY s), count(*), id, grp FROM ("
+      "SELECT tid, id, s, sum(CASE WHEN pe IS NULL OR "
+        "s - pe > %4$s::interval THEN 1 ELSE 0 END) OVER "
+        "(PARTITION BY id ORDER BY s ROWS UNBOUNDED PRECEDING)::bigint "
+        "AS grp "
+      "FROM (SELECT ctid AS tid, %2$s AS id, startTimestamp(%3$s) AS s, "
+        "max(endTimestamp(%3$s)) OVER (PARTITION BY %2$s "
+        "ORDER BY startTimestamp(%3$s) ROWS BETWEEN UNBOUNDED PRECEDING "
+        "AND 1 PRECEDING) AS pe "
+        "FROM %1$s WHERE %2$s IS NOT NULL AND %3$s IS NOT NULL) AS f) AS g "
+    "%6$s"
+    "GROUP BY id, grp HAVING count(*) > 1 ORDER BY id, grp LIMIT %5$d",
+    table, idcol, tcol, quote_literal_cstr(maxgap), batch,
+    cursor->valid ? "WHERE (id, grp) > ($1, $2) " : "");
+  argtypes[0] = cursor->idtype;
+  argtypes[1] = INT8OID;
+  values[0] = cursor->id;
+  values[1] = Int64GetDatum(cursor->grp);
+  if (IsBackgroundWorker)
+    pgstat_report_activity(STATE_RUNNING, sql.data);
+  if (SPI_execute_with_args(sql.data, cursor->valid ? 2 : 0, argtypes,
+      values, NULL, true, 0) != SPI_OK_SELECT)
+    elog(ERROR, "cannot find the fragments of table %s", table);
+  groups = SPI_tuptable;
+  count = (int) SPI_processed;
+  if (count > 0)
+    compact_cursor_set(cursor, groups, count);
+
+  for (int i = 0; i < count; i++)
+  {
+    bool isnull;
+    Datum tids = SPI_getbinval(groups->vals[i], groups->tupdesc, 1, &isnull);
+    int64 n = DatumGetInt64(SPI_getbinval(groups->vals[i], groups->tupdesc,
+      2, &isnull));
+
+    BeginInternalSubTransaction(NULL);
+    MemoryContextSwitchTo(oldcontext);
+    PG_TRY();
+    {
+      if (compact_group(table, tcol, tids, SPI_gettypeid(groups->tupdesc, 1),
+          (int) n))
+        merged++;
+      ReleaseCurrentSubTransaction();
+      MemoryContextSwitchTo(oldcontext);
+      CurrentResourceOwner = oldowner;
+    }
+    PG_CATCH();
+    {
+      ErrorData *edata;
+      MemoryContextSwitchTo(oldcontext);
+      edata = CopyErrorData();
+      FlushErrorState();
+      RollbackAndReleaseCurrentSubTransaction();
+      MemoryContextSwitchTo(oldcontext);
+      CurrentResourceOwner = oldowner;
+      ereport(WARNING,
+        (errmsg("cannot compact %d fragments of table %s: %s", (int) n,
+          table, edata->message)));
+      FreeErrorData(edata);
+    }
+    PG_END_TRY();
+  }
+  if (merged > 0)
+    elog(DEBUG1, "compacted %d groups of fragments of table %s", merged,
+      table);
+  *found = count;
+  return merged;
+}
+
+/**
+ * Compact the fragments of a table in transactions of at most
+ * `compact_batch` groups until no group is left.
+ */
+static void
+compact_table(const CompactTarget *target)
+{
+  CompactCursor cursor;
+  volatile int found;
+  compact_cursor_init(&cursor, compact_context);
+  do
+  {
+    SetCurrentStatementStartTimestamp();
+    StartTransactionCommand();
+    PG_TRY();
+    {
+      const char *table;
+      char maxgap[32];
+      int nfound = 0;
+      SPI_connect();
+      PushActiveSnapshot(GetTransactionSnapshot());
+      table = compact_table_name(target->table);
+      if (table)
+      {
+        snprintf(maxgap, sizeof(maxgap), "%d seconds", compact_maxgap);
+        compact_table_batch(table, quote_identifier(target->idcol),
+          quote_identifier(target->tcol), maxgap, compact_batch, &cursor,
+          &nfound);
+      }
+      else
+        ereport(WARNING, (errcode(ERRCODE_UNDEFINED_TABLE),
+          errmsg("table \"%s\" in mobilitydb.compact_tables does not exist",
+            target->table)));
+      SPI_finish();
+      PopActiveSnapshot();
+      CommitTransactionCommand();
+      found = nfound;
+    }
+    PG_CATCH();
+    {
+      /* Report the error and skip the table until the next round */
+      MemoryContextSwitchTo(compact_context);
+      EmitErrorReport();
+      FlushErrorState();
+      AbortCurrentTransaction();
+      found = 0;
+    }
+    PG_END_TRY();
+    pgstat_report_stat(false);
+    pgstat_report_activity(STATE_IDLE, NULL);
+
+    /* Throttle between two transactions */
+    if (found == compact_batch && compact_delay > 0)
+    {
+      int rc = WaitLatch(MyLatch,
+        WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH, compact_delay,
+        PG_WAIT_EXTENSION);
+      ResetLatch(MyLatch);
+      if (rc & WL_POSTMASTER_DEATH)
+        proc_exit(1);
+      CHECK_FOR_INTERRUPTS();
+    }
+  } while (found == compact_batch && ! got_sigterm);
+  return;
+}
+
+/*****************************************************************************
+ * SQL function
+ *****************************************************************************/
+
+PG_FUNCTION_INFO_V1(Compact_table);
+/**
+ * Compact the fragments of a table in the current transaction, in batches
+ * of at most `compact_batch` groups, and return the number of groups merged
+ */
+PGDLLEXPORT Datum
+Compact_table(PG_FUNCTION_ARGS)
+{
+  Oid relid = PG_GETARG_OID(0);
+  char *idcol = text_to_cstring(PG_GETARG_TEXT_PP(1));
+  char *tcol = text_to_cstring(PG_GETARG_TEXT_PP(2));
+  char *maxgap = DatumGetCString(DirectFunctionCall1(interval_out,
+    PG_GETARG_DATUM(3)));
+  const char *table;
+  CompactCursor cursor;
+  int found, result = 0;
+
+  compact_cursor_init(&cursor, CurrentMemoryContext);
+  SPI_connect();
+  table = compact_relid_name(relid);
+  do
+  {
+    result += compact_table_batch(table, quote_identifier(idcol),
+      quote_identifier(tcol), maxgap, compact_batch, &cursor, &found);
+  } while (found == compact_batch);
+  SPI_finish();
+  PG_RETURN_INT32(result);
+}
+
+/*****************************************************************************
+ * Worker main function
+ *****************************************************************************/
+
+/**
+ * Main function of the compaction worker
+ */
+void
+Compact_worker_main(Datum main_arg __attribute__((unused)))
+{
+  pqsignal(SIGHUP, compact_sighup);
+  pqsignal(SIGTERM, compact_sigterm);
+  BackgroundWorkerUnblockSignals();
+  BackgroundWorkerInitializeConnection(compact_database, NULL, 0);
+  compact_context = AllocSetContextCreate(TopMemoryContext,
+    "MobilityDB compaction", ALLOCSET_DEFAULT_SIZES);
+
+  while (! got_sigterm)
+  {
+    MemoryContext oldcontext;
+    CompactTarget *targets;
+    int count;
+
+    if (got_sighup)
+    {
+      got_sighup = false;
+      ProcessConfigFile(PGC_SIGHUP);
+    }
+
+    /* The targets are parsed at each round since the parameter may change */
+    MemoryContextReset(compact_context);
+    oldcontext = MemoryContextSwitchTo(compact_context);
+    targets = compact_targets(&count);
+    MemoryContextSwitchTo(oldcontext);
+    for (int i = 0; i < count && ! got_sigterm; i++)
+      compact_table(&targets[i]);
+
+    if (! got_sigterm)
+    {
+      int rc = WaitLatch(MyLatch,
+        WL_LATCH_SET | WL_TIMEOUT | WL_POSTMASTER_DEATH,
+        compact_naptime * 1000L, PG_WAIT_EXTENSION);
+      ResetLatch(MyLatch);
+      if (rc & WL_POSTMASTER_DEATH)
+        proc_exit(1);
+      CHECK_FOR_INTERRUPTS();
+    }
+  }
+  proc_exit(0);
+}
+
+/*****************************************************************************/
@@ -40,8 +40,470 @@
 #include "general/temporaltypes.h"
 #include "general/temporal_util.h"
 #include "general/lifting.h"
+#include "general/time_ops.h"
 #include "point/tpoint_spatialfuncs.h"
 
+/*****************************************************************************
+ * Comparison of temporal numbers with linear interpolation
+ *
+ * The generic lifting of the comparisons for temporal numbers with linear
+ * interpolation creates a sequence for each part of a segment before and
+ * after the crossings and then normalizes the resulting array of sequences.
+ * The functions below scan the segments once, and append the result of each
+ * part to the Boolean runs under construction, merging them on the fly so
+ * that the resulting sequences are already normalized.
+ *****************************************************************************/
+
+/**
+ * Structure to keep the Boolean runs of a temporal comparison under
+ * construction. The instants of the current sequence only keep the
+ * timestamps at which the value changes.
+ */
+typedef struct
+{
+  bool *values;            /**< Values of the instants of the current sequence */
+  TimestampTz *times;      /**< Timestamps of the instants of the current sequence */
+  int count;               /**< Number of instants of the current sequence */
+  int maxcount;            /**< Size of the arrays of instants */
+  bool lower_inc;          /**< Lower bound of the current sequence */
+  TimestampTz upper;       /**< Upper bound of the current sequence */
+  bool upper_inc;          /**< Upper bound of the current sequence */
+  TSequence **sequences;   /**< Sequences already constructed */
+  int nseqs;               /**< Number of sequences already constructed */
+  int maxseqs;             /**< Size of the array of sequences */
+} TBoolRuns;
+
+/**
+ * Initialize the Boolean runs
+ */
+static void
+tboolruns_init(TBoolRuns *runs)
+{
+  runs->maxcount = 16;
+  runs->values = palloc(sizeof(bool) * runs->maxcount);
+  runs->times = palloc(sizeof(TimestampTz) * runs->maxcount);
+  runs->count = 0;
+  runs->maxseqs = 16;
+  runs->sequences = palloc(sizeof(TSequence *) * runs->maxseqs);
+  runs->nseqs = 0;
+  return;
+}
+
+/**
+ * Append an instant to the current sequence of the Boolean runs
+ */
+static void
+tboolruns_append(TBoolRuns *runs, bool value, TimestampTz t)
+{
+  if (runs->count == runs->maxcount)
+  {
+    runs->maxcount *= 2;
+    runs->values = repalloc(runs->values, sizeof(bool) * runs->maxcount);
+    runs->times = repalloc(runs->times, sizeof(TimestampTz) * runs->maxcount);
+  }
+  runs->values[runs->count] = value;
+  runs->times[runs->count++] = t;
+  return;
+}
+
+/**
+ * Construct the current sequence of the Boolean runs, if any
+ */
+static void
+tboolruns_flush(TBoolRuns *runs)
+{
+  if (runs->count == 0)
+    return;
+  /* Add the instant of the upper bound if it is not a change point */
+  if (runs->times[runs->count - 1] < runs->upper)
+    tboolruns_append(runs, runs->values[runs->count - 1], runs->upper);
+  TInstant **instants = palloc(sizeof(TInstant *) * runs->count);
+  for (int i = 0; i < runs->count; i++)
+    instants[i] = tinstant_make(BoolGetDatum(runs->values[i]), runs->times[i],
+      T_TBOOL);
+  if (runs->nseqs == runs->maxseqs)
+  {
+    runs->maxseqs *= 2;
+    runs->sequences = repalloc(runs->sequences,
+      sizeof(TSequence *) * runs->maxseqs);
+  }
+  runs->sequences[runs->nseqs++] = tsequence_make_trusted_free(instants,
+    runs->count, runs->lower_inc, runs->upper_inc, STEP, NORMALIZE_NO);
+  runs->count = 0;
+  return;
+}
+
+/**
+ * Add a constant part of the result to the Boolean runs. The parts are added
+ * in time order and do not overlap.
+ *
+ * @param[in,out] runs Boolean runs
+ * @param[in] value Value of the part
+ * @param[in] lower,upper Bounds of the part
+ * @param[in] lower_inc,upper_inc True when the bounds are inclusive
+ */
+static void
+tboolruns_add(TBoolRuns *runs, bool value, TimestampTz lower,
+  TimestampTz upper, bool lower_inc, bool upper_inc)
+{
+  if (runs->count > 0 && runs->upper == lower &&
+    (runs->upper_inc || lower_inc))
+  {
+    bool last = runs->values[runs->count - 1];
+    /* If the current sequence has an exclusive upper bound, the value
+     * at the lower bound of the part is the one of the part, otherwise it is
+     * the one of the current sequence, so the part can only be merged when
+     * the values are equal */
+    if (! runs->upper_inc || last == value)
+    {
+      if (last != value)
+        tboolruns_append(runs, value, lower);
+      runs->upper = upper;
+      runs->upper_inc = upper_inc;
+      return;
+    }
+  }
+  tboolruns_flush(runs);
+  tboolruns_append(runs, value, lower);
+  runs->lower_inc = lower_inc;
+  runs->upper = upper;
+  runs->upper_inc = upper_inc;
+  return;
+}
+
+/**
+ * Return the sequences of the Boolean runs
+ */
+static TSequence **
+tboolruns_sequences(TBoolRuns *runs, int *count)
+{
+  tboolruns_flush(runs);
+  pfree(runs->values); pfree(runs->times);
+  *count = runs->nseqs;
+  return runs->sequences;
+}
+
+/**
+ * Add to the Boolean runs the comparison of a temporal number with linear
+ * interpolation and a base value
+ *
+ * @note The result of the parts of the segments before, at, and after the
+ * crossings are computed as in the function tfunc_tsequence_base_discont
+ */
+static void
+tcomp_tlinearseq_base(const TSequence *seq, Datum value,
+  LiftedFunctionInfo *lfinfo, TBoolRuns *runs)
+{
+  const TInstant *start = tsequence_inst_n(seq, 0);
+  Datum startvalue = tinstant_value(start);
+  bool startresult = DatumGetBool(tfunc_base_base(startvalue, value, lfinfo));
+  if (seq->count == 1)
+  {
+    tboolruns_add(runs, startresult, start->t, start->t, true, true);
+    return;
+  }
+
+  CachedType basetype = temptype_basetype(seq->temptype);
+  bool lower_inc = seq->period.lower_inc;
+  for (int i = 1; i < seq->count; i++)
+  {
+    const TInstant *end = tsequence_inst_n(seq, i);
+    Datum endvalue = tinstant_value(end);
+    bool endresult = DatumGetBool(tfunc_base_base(endvalue, value, lfinfo));
+    bool upper_inc = (i == seq->count - 1) ? seq->period.upper_inc : false;
+    bool intresult, lower_eq, upper_eq;
+    Datum intvalue;
+    TimestampTz inttime;
+
+    /* Constant segment */
+    if (datum_eq(startvalue, endvalue, basetype))
+      tboolruns_add(runs, startresult, start->t, end->t, lower_inc,
+        upper_inc);
+    /* Segment starting or ending at the value: the result in the middle of
+     * the segment holds for all the interior of the segment */
+    else if (datum_eq2(startvalue, value, basetype, lfinfo->argtype[1]) ||
+      datum_eq2(endvalue, value, basetype, lfinfo->argtype[1]))
+    {
+      inttime = start->t + ((end->t - start->t) / 2);
+      intvalue = tsegment_value_at_timestamp(start, end, LINEAR, inttime);
+      intresult = DatumGetBool(tfunc_base_base(intvalue, value, lfinfo));
+      lower_eq = lower_inc && startresult == intresult;
+      upper_eq = upper_inc && intresult == endresult;
+      if (lower_inc && ! lower_eq)
+        tboolruns_add(runs, startresult, start->t, start->t, true, true);
+      tboolruns_add(runs, intresult, start->t, end->t, lower_eq, upper_eq);
+      if (upper_inc && ! upper_eq)
+        tboolruns_add(runs, endresult, end->t, end->t, true, true);
+    }
+    /* Segment that may cross the value */
+    else if (tlinearsegm_intersection_value(start, end, value,
+      lfinfo->argtype[1], &intvalue, &inttime))
+    {
+      intresult = DatumGetBool(tfunc_base_base(intvalue, value, lfinfo));
+      lower_eq = startresult == intresult;
+      upper_eq = upper_inc && intresult == endresult;
+      if (lower_eq && upper_eq)
+        tboolruns_add(runs, startresult, start->t, end->t, lower_inc, true);
+      else
+      {
+        tboolruns_add(runs, startresult, start->t, inttime, lower_inc,
+          lower_eq);
+        if (! lower_eq && ! upper_eq)
+          tboolruns_add(runs, intresult, inttime, inttime, true, true);
+        tboolruns_add(runs, endresult, inttime, end->t, upper_eq, upper_inc);
+      }
+    }
+    else
+    {
+      tboolruns_add(runs, startresult, start->t, end->t, lower_inc, false);
+      if (upper_inc)
+        tboolruns_add(runs, endresult, end->t, end->t, true, true);
+    }
+    start = end;
+    startvalue = endvalue;
+    startresult = endresult;
+    lower_inc = true;
+  }
+  return;
+}
+
+/**
+ * Return an instant of a temporal number at a timestamp of a synchronized
+ * segment, reusing the buffer instant that is not the start of the segment
+ */
+static const TInstant *
+tnumberseq_sync_inst(TInstant **buffer, const TInstant *start,
+  const TInstant *end, bool linear, TimestampTz t)
+{
+  TInstant *result = (start == buffer[0]) ? buffer[1] : buffer[0];
+  tinstant_set(result, tsegment_value_at_timestamp(start, end, linear, t), t);
+  return result;
+}
+
+/**
+ * Add to the Boolean runs the comparison of two temporal numbers, at least
+ * one of them with linear interpolation
+ *
+ * @note The result of the parts of the segments before, at, and after the
+ * crossings are computed as in the function tfunc_tsequence_tsequence_discont.
+ * The instants used for synchronizing the segments are kept in two buffers
+ * for each sequence instead of being created for each segment.
+ */
+static void
+tcomp_tnumberseq_tnumberseq(const TSequence *seq1, const TSequence *seq2,
+  LiftedFunctionInfo *lfinfo, TBoolRuns *runs)
+{
+  Period inter;
+  if (! inter_period_period(&seq1->period, &seq2->period, &inter))
+    return;
+
+  /* If the two sequences intersect at an instant */
+  if (inter.lower == inter.upper)
+  {
+    Datum value1, value2;
+    tsequence_value_at_timestamp(seq1, inter.lower, &value1);
+    tsequence_value_at_timestamp(seq2, inter.lower, &value2);
+    bool result = DatumGetBool(tfunc_base_base(value1, value2, lfinfo));
+    tboolruns_add(runs, result, inter.lower, inter.lower, true, true);
+    return;
+  }
+
+  bool linear1 = MOBDB_FLAGS_GET_LINEAR(seq1->flags);
+  bool linear2 = MOBDB_FLAGS_GET_LINEAR(seq2->flags);
+  const TInstant *start1 = tsequence_inst_n(seq1, 0);
+  const TInstant *start2 = tsequence_inst_n(seq2, 0);
+  TInstant *buffer1[2], *buffer2[2];
+  buffer1[0] = tinstant_copy(start1); buffer1[1] = tinstant_copy(start1);
+  buffer2[0] = tinstant_copy(start2); buffer2[1] = tinstant_copy(start2);
+  int i = 1, j = 1;
+  /* Synchronize the start instant */
+  if (start1->t < inter.lower)
+  {
+    i = tsequence_find_timestamp(seq1, inter.lower) + 1;
+    start1 = tnumberseq_sync_inst(buffer1, tsequence_inst_n(seq1, i - 1),
+      tsequence_inst_n(seq1, i), linear1, inter.lower);
+  }
+  else if (start2->t < inter.lower)
+  {
+    j = tsequence_find_timestamp(seq2, inter.lower) + 1;
+    start2 = tnumberseq_sync_inst(buffer2, tsequence_inst_n(seq2, j - 1),
+      tsequence_inst_n(seq2, j), linear2, inter.lower);
+  }
+  CachedType basetype1 = temptype_basetype(seq1->temptype);
+  CachedType basetype2 = temptype_basetype(seq2->temptype);
+  bool lower_inc = inter.lower_inc;
+  while (i < seq1->count && j < seq2->count)
+  {
+    Datum startvalue1 = tinstant_value(start1);
+    Datum startvalue2 = tinstant_value(start2);
+    bool startresult = DatumGetBool(tfunc_base_base(startvalue1, startvalue2,
+      lfinfo));
+    /* Synchronize the end instants */
+    const TInstant *end1 = tsequence_inst_n(seq1, i);
+    const TInstant *end2 = tsequence_inst_n(seq2, j);
+    int cmp = timestamp_cmp_internal(end1->t, end2->t);
+    if (cmp == 0)
+    {
+      i++; j++;
+    }
+    else if (cmp < 0)
+    {
+      i++;
+      end2 = tnumberseq_sync_inst(buffer2, start2, end2, linear2, end1->t);
+    }
+    else
+    {
+      j++;
+      end1 = tnumberseq_sync_inst(buffer1, start1, end1, linear1, end2->t);
+    }
+    Datum endvalue1 = linear1 ? tinstant_value(end1) : startvalue1;
+    Datum endvalue2 = linear2 ? tinstant_value(end2) : startvalue2;
+    bool endresult = DatumGetBool(tfunc_base_base(endvalue1, endvalue2,
+      lfinfo));
+    Datum intvalue1, intvalue2;
+    bool intresult, lower_eq, upper_eq;
+    TimestampTz inttime;
+
+    /* Both segments are constant */
+    if (datum_eq(startvalue1, endvalue1, basetype1) &&
+      datum_eq(startvalue2, endvalue2, basetype2))
+      tboolruns_add(runs, startresult, start1->t, end1->t, lower_inc, false);
+    /* The segments start or end at the same value: the result in the middle
+     * of the segments holds for all the interior of the segments */
+    else if (datum_eq2(startvalue1, startvalue2, basetype1, basetype2) ||
+      (linear1 && linear2 &&
+        datum_eq2(endvalue1, endvalue2, basetype1, basetype2)))
+    {
+      inttime = start1->t + ((end1->t - start1->t) / 2);
+      intvalue1 = tsegment_value_at_timestamp(start1, end1, linear1, inttime);
+      intvalue2 = tsegment_value_at_timestamp(start2, end2, linear2, inttime);
+      intresult = DatumGetBool(tfunc_base_base(intvalue1, intvalue2, lfinfo));
+      lower_eq = lower_inc && startresult == intresult;
+      if (lower_inc && ! lower_eq)
+        tboolruns_add(runs, startresult, start1->t, start1->t, true, true);
+      tboolruns_add(runs, intresult, start1->t, end1->t, lower_eq, false);
+    }
+    /* Segments that may cross each other */
+    else if (tsegment_intersection(start1, end1, linear1, start2, end2,
+      linear2, &intvalue1, &intvalue2, &inttime))
+    {
+      intresult = DatumGetBool(tfunc_base_base(intvalue1, intvalue2, lfinfo));
+      lower_eq = startresult == intresult;
+      upper_eq = intresult == endresult;
+      if (lower_eq && upper_eq)
+        tboolruns_add(runs, startresult, start1->t, end1->t, lower_inc, false);
+      else
+      {
+        tboolruns_add(runs, startresult, start1->t, inttime, lower_inc,
+          lower_eq);
+        if (! lower_eq && ! upper_eq)
+          tboolruns_add(runs, intresult, inttime, inttime, true, true);
+        tboolruns_add(runs, endresult, inttime, end1->t, upper_eq, false);
+      }
+    }
+    else
+      tboolruns_add(runs, startresult, start1->t, end1->t, lower_inc, false);
+    start1 = end1; start2 = end2;
+    lower_inc = true;
+  }
+  /* Add a final instant if any */
+  if (inter.upper_inc)
+  {
+    bool result = DatumGetBool(tfunc_base_base(tinstant_value(start1),
+      tinstant_value(start2), lfinfo));
+    tboolruns_add(runs, result, start1->t, start1->t, true, true);
+  }
+  pfree(buffer1[0]); pfree(buffer1[1]);
+  pfree(buffer2[0]); pfree(buffer2[1]);
+  return;
+}
+
+/**
+ * Return the sequences composing a temporal sequence or sequence set
+ */
+static const TSequence **
+tnumber_sequences(const Temporal *temp, int *count)
+{
+  if (temp->subtype == SEQUENCE)
+  {
+    const TSequence **result = palloc(sizeof(TSequence *));
+    result[0] = (const TSequence *) temp;
+    *count = 1;
+    return result;
+  }
+  *count = ((TSequenceSet *) temp)->count;
+  return tsequenceset_sequences_p((TSequenceSet *) temp);
+}
+
+/**
+ * Return the temporal comparison of a temporal number with linear
+ * interpolation and a base value
+ */
+static TSequenceSet *
+tcomp_tlinear_base(const Temporal *temp, Datum value,
+  LiftedFunctionInfo *lfinfo)
+{
+  int count, newcount;
+  const TSequence **sequences = tnumber_sequences(temp, &count);
+  TBoolRuns runs;
+  tboolruns_init(&runs);
+  for (int i = 0; i < count; i++)
+    tcomp_tlinearseq_base(sequences[i], value, lfinfo, &runs);
+  pfree(sequences);
+  TSequence **result = tboolruns_sequences(&runs, &newcount);
+  return tsequenceset_make_trusted_free(result, newcount, NORMALIZE_NO);
+}
+
+/**
+ * Return the temporal comparison of two temporal numbers, at least one of
+ * them with linear interpolation
+ */
+static Temporal *
+tcomp_tlinear_tlinear(const Temporal *temp1, const Temporal *temp2,
+  LiftedFunctionInfo *lfinfo)
+{
+  int count1, count2, newcount;
+  const TSequence **sequences1 = tnumber_sequences(temp1, &count1);
+  const TSequence **sequences2 = tnumber_sequences(temp2, &count2);
+  TBoolRuns runs;
+  tboolruns_init(&runs);
+  int i = 0, j = 0;
+  while (i < count1 && j < count2)
+  {
+    const TSequence *seq1 = sequences1[i];
+    const TSequence *seq2 = sequences2[j];
+    tcomp_tnumberseq_tnumberseq(seq1, seq2, lfinfo, &runs);
+    int cmp = timestamp_cmp_internal(seq1->period.upper, seq2->period.upper);
+    if (cmp == 0)
+    {
+      if (! seq1->period.upper_inc && seq2->period.upper_inc)
+        cmp = -1;
+      else if (seq1->period.upper_inc && !seq2->period.upper_inc)
+        cmp = 1;
+    }
+    if (cmp == 0)
+    {
+      i++; j++;
+    }
+    else if (cmp < 0)
+      i++;
+    else
+      j++;
+  }
+  pfree(sequences1); pfree(sequences2);
+  TSequence **result = tboolruns_sequences(&runs, &newcount);
+  /* The comparison of two sequences results in a sequence when possible */
+  if (newcount == 1 && temp1->subtype == SEQUENCE &&
+    temp2->subtype == SEQUENCE)
+  {
+    Temporal *resultseq = (Temporal *) result[0];
+    pfree(result);
+    return resultseq;
+  }
+  return (Temporal *) tsequenceset_make_trusted_free(result, newcount,
+    NORMALIZE_NO);
+}
+
 /*****************************************************************************
  * Generic functions
  *****************************************************************************/
@@ -66,6 +528,9 @@ tcomp_temporal_base(const Temporal *temp, Datum value, CachedType basetype,
   lfinfo.discont = MOBDB_FLAGS_GET_LINEAR(temp->flags);
   lfinfo.tpfunc_base = NULL;
   lfinfo.tpfunc = NULL;
+  if (lfinfo.discont && tnumber_type(temp->temptype) &&
+    temp->subtype >= SEQUENCE)
+    return (Temporal *) tcomp_tlinear_base(temp, value, &lfinfo);
   return tfunc_temporal_base(temp, value, &lfinfo);
 }
 
@@ -95,6 +560,17 @@ tcomp_temporal_temporal(const Temporal *temp1, const Temporal *temp2,
     MOBDB_FLAGS_GET_LINEAR(temp2->flags);
   lfinfo.tpfunc_base = NULL;
   lfinfo.tpfunc = NULL;
+  if (lfinfo.discont && tnumber_type(temp1->temptype) &&
+    temp1->subtype >= SEQUENCE && temp2->subtype >= SEQUENCE)
+  {
+    /* Bounding box test */
+    Period p1, p2;
+    temporal_period(temp1, &p1);
+    temporal_period(temp2, &p2);
+    if (! overlaps_period_period(&p1, &p2))
+      return NULL;
+    return tcomp_tlinear_tlinear(temp1, temp2, &lfinfo);
+  }
   Temporal *result = tfunc_temporal_temporal(temp1, temp2, &lfinfo);
   return result;
 }
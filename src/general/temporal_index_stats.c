@@ -0,0 +1,643 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_index_stats.c
+ * @brief Diagnostics of the quality of the GiST and SP-GiST indexes of
+ * temporal types.
+ *
+ * The functions walk an index from its root and report for each level of the
+ * tree and each dimension of the keys the number of nodes and entries, the
+ * fill factor of the nodes, the extent of the nodes, the pairwise overlap of
+ * their entries, and the dead space of the nodes, that is, the part of their
+ * extent that is not covered by any of their entries. These figures allow
+ * evaluating the choices made by the penalty and picksplit methods.
+ *
+ * The index is read with an access share lock and each page is only locked
+ * in share mode while its entries are copied, so that the functions can be
+ * run on a production database. As a consequence, the statistics may miss
+ * or count twice the entries moved by concurrent page splits.
+ */
+
+#include "general/temporal_index_stats.h"
+
+/* PostgreSQL */
+#include <access/genam.h>
+#include <access/gist_private.h>
+#include <access/spgist_private.h>
+#include <catalog/index.h>
+#include <catalog/pg_am.h>
+#include <catalog/pg_authid.h>
+#include <catalog/pg_class.h>
+#include <funcapi.h>
+#include <miscadmin.h>
+#include <storage/bufmgr.h>
+#include <utils/acl.h>
+#include <utils/builtins.h>
+#include <utils/lsyscache.h>
+#include <utils/rel.h>
+/* MobilityDB */
+#include "general/timetypes.h"
+#include "general/periodset.h"
+#include "general/tempcache.h"
+#include "general/temporal_util.h"
+#include "general/tbox.h"
+#include "point/stbox.h"
+
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  #define SPGIST_LEAF_NEXT(lt) SGLT_GET_NEXTOFFSET(lt)
+  #define ROLE_STAT_SCAN_TABLES ROLE_PG_STAT_SCAN_TABLES
+#else
+  #define SPGIST_LEAF_NEXT(lt) ((lt)->nextOffset)
+  #define ROLE_STAT_SCAN_TABLES DEFAULT_ROLE_STAT_SCAN_TABLES
+#endif
+
+/**
+ * Names of the dimensions of the keys of an index
+ */
+static const char *_index_dim_names[] = {"x", "y", "z", "t", "value"};
+
+/**
+ * Structure to represent the state of the walk of an index and of the
+ * set-returning function that outputs its statistics
+ */
+typedef struct
+{
+  Relation index;               /**< index that is walked */
+  IndexKeyType keytype;         /**< type of the keys of the index */
+  BufferAccessStrategy bstrategy; /**< strategy for reading the pages */
+  IndexLevelStats *levels;      /**< statistics of each level */
+  int nlevels;                  /**< number of levels */
+  int maxlevels;                /**< size of the array of levels */
+  int level;                    /**< current level of the output */
+  int dim;                      /**< current dimension of the output */
+} IndexStatsState;
+
+/**
+ * Structure to represent the extent of a key in one dimension
+ */
+typedef struct
+{
+  double lower;
+  double upper;
+} IndexInterval;
+
+/*****************************************************************************
+ * Keys of the nodes
+ *****************************************************************************/
+
+/**
+ * Set the extent of a key in a dimension
+ */
+static void
+indexkey_set_dim(IndexKeyExtent *ext, IndexDim dim, double lower,
+  double upper)
+{
+  ext->lower[dim] = lower;
+  ext->upper[dim] = upper;
+  ext->hasdim[dim] = true;
+  return;
+}
+
+/**
+ * Return the extent of a key of an index in each dimension. The extent in
+ * the time dimension is expressed in seconds.
+ *
+ * @note The extent of the period set keys of the multi-period opclasses is
+ * their bounding period, so that the gaps between their periods are not
+ * counted in the dead space
+ */
+static void
+indexkey_extent(Datum key, IndexKeyType keytype, IndexKeyExtent *result)
+{
+  memset(result, 0, sizeof(IndexKeyExtent));
+  if (keytype == IDX_KEY_PERIOD)
+  {
+    const Period *p = DatumGetPeriodP(key);
+    indexkey_set_dim(result, IDX_DIM_T, (double) p->lower / USECS_PER_SEC,
+      (double) p->upper / USECS_PER_SEC);
+  }
+  else if (keytype == IDX_KEY_PERIODSET)
+  {
+    PeriodSet *ps = DatumGetPeriodSetP(key);
+    const Period *p = periodset_bbox_ptr(ps);
+    indexkey_set_dim(result, IDX_DIM_T, (double) p->lower / USECS_PER_SEC,
+      (double) p->upper / USECS_PER_SEC);
+    if ((Pointer) ps != DatumGetPointer(key))
+      pfree(ps);
+  }
+  else if (keytype == IDX_KEY_TBOX)
+  {
+    const TBOX *box = DatumGetTboxP(key);
+    if (MOBDB_FLAGS_GET_X(box->flags))
+      indexkey_set_dim(result, IDX_DIM_VALUE, box->xmin, box->xmax);
+    if (MOBDB_FLAGS_GET_T(box->flags))
+      indexkey_set_dim(result, IDX_DIM_T, (double) box->tmin / USECS_PER_SEC,
+        (double) box->tmax / USECS_PER_SEC);
+  }
+  else /* keytype == IDX_KEY_STBOX */
+  {
+    const STBOX *box = DatumGetSTboxP(key);
+    if (MOBDB_FLAGS_GET_X(box->flags))
+    {
+      indexkey_set_dim(result, IDX_DIM_X, box->xmin, box->xmax);
+      indexkey_set_dim(result, IDX_DIM_Y, box->ymin, box->ymax);
+    }
+    if (MOBDB_FLAGS_GET_Z(box->flags) || MOBDB_FLAGS_GET_GEODETIC(box->flags))
+      indexkey_set_dim(result, IDX_DIM_Z, box->zmin, box->zmax);
+    if (MOBDB_FLAGS_GET_T(box->flags))
+      indexkey_set_dim(result, IDX_DIM_T, (double) box->tmin / USECS_PER_SEC,
+        (double) box->tmax / USECS_PER_SEC);
+  }
+  return;
+}
+
+/**
+ * Return the union of the extents of the keys
+ */
+static void
+indexkey_union(const IndexKeyExtent *keys, int count, IndexKeyExtent *result)
+{
+  memset(result, 0, sizeof(IndexKeyExtent));
+  for (int i = 0; i < count; i++)
+  {
+    for (int d = 0; d < IDX_NUMDIMS; d++)
+    {
+      if (! keys[i].hasdim[d])
+        continue;
+      if (! result->hasdim[d])
+        indexkey_set_dim(result, d, keys[i].lower[d], keys[i].upper[d]);
+      else
+      {
+        result->lower[d] = Min(result->lower[d], keys[i].lower[d]);
+        result->upper[d] = Max(result->upper[d], keys[i].upper[d]);
+      }
+    }
+  }
+  return;
+}
+
+/**
+ * Return the type of the keys of an index given the type of the keys
+ * stored in the index or the type indexed
+ *
+ * @param[in] index Index
+ * @param[in] typid Type
+ * @param[in] stored True when the type is the one of the keys stored in the
+ * index, that is, the period sets of the multi-period opclasses
+ */
+static IndexKeyType
+index_keytype(Relation index, Oid typid, bool stored)
+{
+  if (stored && typid == type_oid(T_PERIODSET))
+    return IDX_KEY_PERIODSET;
+  if (typid == type_oid(T_PERIOD) || typid == type_oid(T_TIMESTAMPSET) ||
+      typid == type_oid(T_PERIODSET) || typid == type_oid(T_TBOOL) ||
+      typid == type_oid(T_TTEXT))
+    return IDX_KEY_PERIOD;
+  if (typid == type_oid(T_TBOX) || typid == type_oid(T_TINT) ||
+      typid == type_oid(T_TFLOAT))
+    return IDX_KEY_TBOX;
+  if (typid == type_oid(T_STBOX) || typid == type_oid(T_TGEOMPOINT) ||
+      typid == type_oid(T_TGEOGPOINT) || typid == type_oid(T_TNPOINT))
+    return IDX_KEY_STBOX;
+  ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+    errmsg("The keys of index \"%s\" are not supported",
+      RelationGetRelationName(index))));
+}
+
+/*****************************************************************************
+ * Statistics of the nodes
+ *****************************************************************************/
+
+/**
+ * Comparator of intervals on their lower bound
+ */
+static int
+index_interval_cmp(const void *a, const void *b)
+{
+  const IndexInterval *i1 = (const IndexInterval *) a;
+  const IndexInterval *i2 = (const IndexInterval *) b;
+  if (i1->lower == i2->lower)
+    return 0;
+  return (i1->lower < i2->lower) ? -1 : 1;
+}
+
+/**
+ * Return the statistics of a level, enlarging the array of levels if needed
+ */
+static IndexLevelStats *
+indexstats_level(IndexStatsState *state, int level)
+{
+  if (level >= state->maxlevels)
+  {
+    int maxlevels = Max(level + 1, state->maxlevels * 2);
+    state->levels = repalloc(state->levels,
+      sizeof(IndexLevelStats) * maxlevels);
+    memset(&state->levels[state->maxlevels], 0,
+      sizeof(IndexLevelStats) * (maxlevels - state->maxlevels));
+    state->maxlevels = maxlevels;
+  }
+  state->nlevels = Max(state->nlevels, level + 1);
+  return &state->levels[level];
+}
+
+/**
+ * Add the statistics of a node to the ones of its level
+ *
+ * @param[in,out] state State of the walk
+ * @param[in] level Level of the node
+ * @param[in] fill Fill factor of the node
+ * @param[in] entries Extents of the entries of the node
+ * @param[in] count Number of entries
+ */
+static void
+indexnode_stats(IndexStatsState *state, int level, double fill,
+  const IndexKeyExtent *entries, int count)
+{
+  IndexLevelStats *stats = indexstats_level(state, level);
+  stats->nodes++;
+  stats->entries += count;
+  stats->fill += fill;
+  if (count == 0)
+    return;
+  IndexInterval *intervals = palloc(sizeof(IndexInterval) * count);
+  for (int d = 0; d < IDX_NUMDIMS; d++)
+  {
+    int n = 0;
+    for (int i = 0; i < count; i++)
+    {
+      if (entries[i].hasdim[d])
+      {
+        intervals[n].lower = entries[i].lower[d];
+        intervals[n++].upper = entries[i].upper[d];
+      }
+    }
+    if (n == 0)
+      continue;
+    stats->hasdim[d] = true;
+    /* Sweep the intervals in the order of their lower bound */
+    qsort(intervals, n, sizeof(IndexInterval), index_interval_cmp);
+    double lower = intervals[0].lower, upper = intervals[0].upper;
+    double maxupper = upper, covered = 0, overlap = 0;
+    for (int i = 0; i < n; i++)
+    {
+      for (int j = i + 1; j < n && intervals[j].lower < intervals[i].upper;
+          j++)
+        overlap += Min(intervals[i].upper, intervals[j].upper) -
+          intervals[j].lower;
+      if (intervals[i].lower > upper)
+      {
+        covered += upper - lower;
+        lower = intervals[i].lower;
+        upper = intervals[i].upper;
+      }
+      else
+        upper = Max(upper, intervals[i].upper);
+      maxupper = Max(maxupper, intervals[i].upper);
+    }
+    covered += upper - lower;
+    double extent = maxupper - intervals[0].lower;
+    stats->extent[d] += extent;
+    stats->overlap[d] += overlap;
+    stats->deadspace[d] += extent - covered;
+  }
+  pfree(intervals);
+  return;
+}
+
+/**
+ * Return the fraction of the page that is used
+ */
+static double
+index_page_fill(Page page)
+{
+  Size size = BLCKSZ - SizeOfPageHeaderData - PageGetSpecialSize(page);
+  return 1.0 - (double) PageGetExactFreeSpace(page) / size;
+}
+
+/*****************************************************************************
+ * Walk of the indexes
+ *****************************************************************************/
+
+/**
+ * Add the statistics of a page of a GiST index and of its descendants
+ */
+static void
+gist_stats_walk(IndexStatsState *state, BlockNumber blkno, int level)
+{
+  check_stack_depth();
+  CHECK_FOR_INTERRUPTS();
+  Buffer buffer = ReadBufferExtended(state->index, MAIN_FORKNUM, blkno,
+    RBM_NORMAL, state->bstrategy);
+  LockBuffer(buffer, GIST_SHARE);
+  Page page = BufferGetPage(buffer);
+  if (GistPageIsDeleted(page))
+  {
+    UnlockReleaseBuffer(buffer);
+    return;
+  }
+  bool leaf = GistPageIsLeaf(page);
+  double fill = index_page_fill(page);
+  /* The right sibling of an incomplete split is not yet in the parent */
+  BlockNumber rightlink = GistFollowRight(page) ?
+    GistPageGetOpaque(page)->rightlink : InvalidBlockNumber;
+  OffsetNumber maxoff = PageGetMaxOffsetNumber(page);
+  IndexKeyExtent *entries = palloc(sizeof(IndexKeyExtent) * (maxoff + 1));
+  BlockNumber *children = leaf ? NULL :
+    palloc(sizeof(BlockNumber) * (maxoff + 1));
+  int count = 0, nchildren = 0;
+  TupleDesc tupdesc = RelationGetDescr(state->index);
+  for (OffsetNumber off = FirstOffsetNumber; off <= maxoff;
+       off = OffsetNumberNext(off))
+  {
+    ItemId itemid = PageGetItemId(page, off);
+    if (! ItemIdIsUsed(itemid) || ItemIdIsDead(itemid))
+      continue;
+    IndexTuple itup = (IndexTuple) PageGetItem(page, itemid);
+    if (! leaf)
+      children[nchildren++] = ItemPointerGetBlockNumber(&itup->t_tid);
+    bool isnull;
+    Datum key = index_getattr(itup, 1, tupdesc, &isnull);
+    if (! isnull)
+      indexkey_extent(key, state->keytype, &entries[count++]);
+  }
+  UnlockReleaseBuffer(buffer);
+
+  indexnode_stats(state, level, fill, entries, count);
+  pfree(entries);
+  for (int i = 0; i < nchildren; i++)
+    gist_stats_walk(state, children[i], level + 1);
+  if (children)
+    pfree(children);
+  if (rightlink != InvalidBlockNumber)
+    gist_stats_walk(state, rightlink, level);
+  return;
+}
+
+/**
+ * Add the statistics of a tuple of an SP-GiST index and of its descendants.
+ * The nodes of an SP-GiST index are the inner tuples, whose entries are their
+ * non-empty child nodes, and the chains of leaf tuples. Since the extent of
+ * the child nodes of inner tuples is not stored in the index, the union of
+ * the extents of the descendants is returned to the parent.
+ *
+ * @param[in,out] state State of the walk
+ * @param[in] tid Location of the tuple
+ * @param[in] level Level of the tuple
+ * @param[out] result Union of the extents of the keys of the descendants
+ * @result False when there are no keys in the descendants
+ */
+static bool
+spgist_stats_walk(IndexStatsState *state, ItemPointer tid, int level,
+  IndexKeyExtent *result)
+{
+  check_stack_depth();
+  CHECK_FOR_INTERRUPTS();
+  BlockNumber blkno = ItemPointerGetBlockNumber(tid);
+  OffsetNumber offnum = ItemPointerGetOffsetNumber(tid);
+  Buffer buffer = ReadBufferExtended(state->index, MAIN_FORKNUM, blkno,
+    RBM_NORMAL, state->bstrategy);
+  LockBuffer(buffer, BUFFER_LOCK_SHARE);
+  Page page = BufferGetPage(buffer);
+  OffsetNumber maxoff = PageGetMaxOffsetNumber(page);
+  if (SpGistPageIsDeleted(page) || offnum > maxoff)
+  {
+    UnlockReleaseBuffer(buffer);
+    return false;
+  }
+
+  if (SpGistPageIsLeaf(page))
+  {
+    /* The leaf tuples of a root page are not chained */
+    bool chain = (blkno != SPGIST_ROOT_BLKNO);
+    SpGistLeafTuple lt = (SpGistLeafTuple) PageGetItem(page,
+      PageGetItemId(page, offnum));
+    if (chain && lt->tupstate == SPGIST_REDIRECT)
+    {
+      ItemPointerData next = ((SpGistDeadTuple) lt)->pointer;
+      UnlockReleaseBuffer(buffer);
+      return spgist_stats_walk(state, &next, level, result);
+    }
+    double fill = index_page_fill(page);
+    IndexKeyExtent *keys = palloc(sizeof(IndexKeyExtent) * maxoff);
+    int count = 0, nvisited = 0;
+    OffsetNumber off = offnum;
+    /* The number of visited tuples is bounded to protect against a
+     * corrupted chain */
+    while (off != InvalidOffsetNumber && off <= maxoff && nvisited++ < maxoff)
+    {
+      lt = (SpGistLeafTuple) PageGetItem(page, PageGetItemId(page, off));
+      if (lt->tupstate == SPGIST_LIVE)
+        indexkey_extent(PointerGetDatum(SGLTDATAPTR(lt)), state->keytype,
+          &keys[count++]);
+      off = chain ? SPGIST_LEAF_NEXT(lt) : OffsetNumberNext(off);
+    }
+    UnlockReleaseBuffer(buffer);
+    indexnode_stats(state, level, fill, keys, count);
+    indexkey_union(keys, count, result);
+    pfree(keys);
+    return count > 0;
+  }
+
+  SpGistInnerTuple it = (SpGistInnerTuple) PageGetItem(page,
+    PageGetItemId(page, offnum));
+  if (it->tupstate == SPGIST_REDIRECT)
+  {
+    ItemPointerData next = ((SpGistDeadTuple) it)->pointer;
+    UnlockReleaseBuffer(buffer);
+    return spgist_stats_walk(state, &next, level, result);
+  }
+  if (it->tupstate != SPGIST_LIVE)
+  {
+    UnlockReleaseBuffer(buffer);
+    return false;
+  }
+  int nnodes = it->nNodes, nchildren = 0, i;
+  ItemPointerData *children = palloc(sizeof(ItemPointerData) * nnodes);
+  SpGistNodeTuple node;
+  SGITITERATE(it, i, node)
+  {
+    if (ItemPointerIsValid(&node->t_tid))
+      children[nchildren++] = node->t_tid;
+  }
+  UnlockReleaseBuffer(buffer);
+
+  IndexKeyExtent *entries = palloc(sizeof(IndexKeyExtent) * nchildren);
+  int count = 0;
+  for (i = 0; i < nchildren; i++)
+  {
+    if (spgist_stats_walk(state, &children[i], level + 1, &entries[count]))
+      count++;
+  }
+  /* The fill factor of an inner tuple is the fraction of non-empty nodes */
+  indexnode_stats(state, level, (double) nchildren / nnodes, entries, count);
+  indexkey_union(entries, count, result);
+  pfree(entries); pfree(children);
+  return count > 0;
+}
+
+/**
+ * Walk the index and return its statistics
+ *
+ * @param[in] indexid Oid of the index
+ * @param[in] amoid Oid of the access method of the index
+ */
+static IndexStatsState *
+index_stats(Oid indexid, Oid amoid)
+{
+  /* As for pgstatindex, the statistics reveal the distribution of the
+   * values of the table */
+  Oid heapid = IndexGetRelation(indexid, true);
+  if (OidIsValid(heapid) &&
+      ! is_member_of_role(GetUserId(), ROLE_STAT_SCAN_TABLES) &&
+      pg_class_aclcheck(heapid, GetUserId(), ACL_SELECT) != ACLCHECK_OK)
+    aclcheck_error(ACLCHECK_NO_PRIV, OBJECT_INDEX, get_rel_name(indexid));
+
+  Relation index = index_open(indexid, AccessShareLock);
+  if (index->rd_rel->relkind != RELKIND_INDEX || index->rd_rel->relam != amoid)
+    ereport(ERROR, (errcode(ERRCODE_WRONG_OBJECT_TYPE),
+      errmsg("Index \"%s\" is not %s index", RelationGetRelationName(index),
+        amoid == GIST_AM_OID ? "a GiST" : "an SP-GiST")));
+  if (RELATION_IS_OTHER_TEMP(index))
+    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+      errmsg("Cannot access temporary indexes of other sessions")));
+
+  IndexStatsState *state = palloc0(sizeof(IndexStatsState));
+  state->index = index;
+  /* GiST indexes store the keys while SP-GiST indexes store the leaf
+   * values, which are the bounding boxes of the indexed values */
+  state->keytype = (amoid == GIST_AM_OID) ?
+    index_keytype(index, TupleDescAttr(RelationGetDescr(index), 0)->atttypid,
+      true) :
+    index_keytype(index, index->rd_opcintype[0], false);
+  state->bstrategy = GetAccessStrategy(BAS_BULKREAD);
+  state->maxlevels = 8;
+  state->levels = palloc0(sizeof(IndexLevelStats) * state->maxlevels);
+  if (amoid == GIST_AM_OID)
+    gist_stats_walk(state, GIST_ROOT_BLKNO, 0);
+  else
+  {
+    ItemPointerData root;
+    IndexKeyExtent ext;
+    ItemPointerSet(&root, SPGIST_ROOT_BLKNO, FirstOffsetNumber);
+    spgist_stats_walk(state, &root, 0, &ext);
+  }
+  FreeAccessStrategy(state->bstrategy);
+  index_close(index, AccessShareLock);
+  state->index = NULL;
+  return state;
+}
+
+/*****************************************************************************
+ * Output of the statistics
+ *****************************************************************************/
+
+/**
+ * Output the statistics of a GiST or an SP-GiST index
+ */
+static Datum
+index_stats_ext(FunctionCallInfo fcinfo, Oid amoid)
+{
+  FuncCallContext *funcctx;
+  IndexStatsState *state;
+
+  /* If the function is being called for the first time */
+  if (SRF_IS_FIRSTCALL())
+  {
+    Oid indexid = PG_GETARG_OID(0);
+    /* Initialize the FuncCallContext */
+    funcctx = SRF_FIRSTCALL_INIT();
+    /* Switch to memory context appropriate for multiple function calls */
+    MemoryContext oldcontext =
+      MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+    /* Walk the index and create function state */
+    funcctx->user_fctx = index_stats(indexid, amoid);
+    /* Build a tuple description for the function output */
+    get_call_result_type(fcinfo, 0, &funcctx->tuple_desc);
+    BlessTupleDesc(funcctx->tuple_desc);
+    MemoryContextSwitchTo(oldcontext);
+  }
+
+  /* Stuff done on every call of the function */
+  funcctx = SRF_PERCALL_SETUP();
+  /* Get state */
+  state = funcctx->user_fctx;
+  /* Output the dimensions of each level that have statistics */
+  while (state->level < state->nlevels)
+  {
+    int level = state->level, dim = state->dim;
+    IndexLevelStats *stats = &state->levels[level];
+    /* Advance state */
+    if (++state->dim == IDX_NUMDIMS)
+    {
+      state->dim = 0;
+      state->level++;
+    }
+    if (! stats->hasdim[dim])
+      continue;
+    Datum values[8];
+    bool isnull[8] = {0};
+    values[0] = Int32GetDatum(level);
+    values[1] = PointerGetDatum(cstring_to_text(_index_dim_names[dim]));
+    values[2] = Int32GetDatum(stats->nodes);
+    values[3] = Int64GetDatum(stats->entries);
+    values[4] = Float8GetDatum(stats->fill / stats->nodes);
+    values[5] = Float8GetDatum(stats->extent[dim]);
+    values[6] = Float8GetDatum(stats->overlap[dim]);
+    values[7] = Float8GetDatum(stats->deadspace[dim]);
+    HeapTuple tuple = heap_form_tuple(funcctx->tuple_desc, values, isnull);
+    SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+  }
+  SRF_RETURN_DONE(funcctx);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_gist_index_stats);
+/**
+ * Return the statistics of each level and dimension of a GiST index of a
+ * temporal type
+ */
+PGDLLEXPORT Datum
+Temporal_gist_index_stats(PG_FUNCTION_ARGS)
+{
+  return index_stats_ext(fcinfo, GIST_AM_OID);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_spgist_index_stats);
+/**
+ * Return the statistics of each level and dimension of an SP-GiST index of a
+ * temporal type
+ */
+PGDLLEXPORT Datum
+Temporal_spgist_index_stats(PG_FUNCTION_ARGS)
+{
+  return index_stats_ext(fcinfo, SPGIST_AM_OID);
+}
+
+/*****************************************************************************/
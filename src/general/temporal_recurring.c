@@ -0,0 +1,581 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_recurring.c
+ * @brief Restriction of temporal values to recurring time patterns defined by
+ * a time of day range, a set of days of the week, and a time zone.
+ *
+ * The periods of the pattern are never materialized beyond the temporal
+ * extent of the value restricted. They are computed on the fly for the days
+ * spanned by the value and the instants of the value are then traversed in a
+ * single forward walk.
+ */
+
+#include "general/temporal_recurring.h"
+
+/* PostgreSQL */
+#include <assert.h>
+#include <utils/array.h>
+#include <utils/builtins.h>
+#include <utils/datetime.h>
+#include <utils/timestamp.h>
+/* MobilityDB */
+#include "general/period.h"
+#include "general/time_ops.h"
+#include "general/temporaltypes.h"
+#include "general/temporal_util.h"
+
+/*****************************************************************************
+ * Recurring time patterns
+ *****************************************************************************/
+
+/**
+ * Set a recurring time pattern from its components
+ */
+void
+recurringtime_set(TimeADT start, TimeADT end, uint8 dowmask, pg_tz *tz,
+  RecurringTime *rt)
+{
+  if (start < 0 || start >= USECS_PER_DAY || end < 0 || end > USECS_PER_DAY)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The start time must be before 24:00 and the end time at most 24:00")));
+  if (start == end)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The start and end times of a recurring time pattern must be different")));
+  rt->start = start;
+  rt->end = end;
+  rt->dowmask = dowmask;
+  rt->tz = tz;
+  return;
+}
+
+/**
+ * Return the timestamp of the local time of day of the Julian day in the
+ * time zone of the pattern
+ */
+static TimestampTz
+recurringtime_timestamp(const RecurringTime *rt, int julian, TimeADT time)
+{
+  struct pg_tm tt, *tm = &tt;
+  if (time == USECS_PER_DAY)
+  {
+    julian++;
+    time = 0;
+  }
+  j2date(julian, &tm->tm_year, &tm->tm_mon, &tm->tm_mday);
+  tm->tm_hour = (int) (time / USECS_PER_HOUR);
+  time -= tm->tm_hour * USECS_PER_HOUR;
+  tm->tm_min = (int) (time / USECS_PER_MINUTE);
+  time -= tm->tm_min * USECS_PER_MINUTE;
+  tm->tm_sec = (int) (time / USECS_PER_SEC);
+  fsec_t fsec = (fsec_t) (time - tm->tm_sec * USECS_PER_SEC);
+  tm->tm_isdst = -1;
+  int tz = DetermineTimeZoneOffset(tm, rt->tz);
+  TimestampTz result;
+  if (tm2timestamp(tm, fsec, &tz, &result) != 0)
+    ereport(ERROR, (errcode(ERRCODE_DATETIME_VALUE_OUT_OF_RANGE),
+      errmsg("timestamp out of range")));
+  return result;
+}
+
+/**
+ * Append the period to the array if it is not empty, merging it with the
+ * last period of the array when they are adjacent
+ */
+static void
+periodarr_append(Period *periods, int *count, TimestampTz lower,
+  TimestampTz upper, bool lower_inc, bool upper_inc)
+{
+  if (lower > upper || (lower == upper && (! lower_inc || ! upper_inc)))
+    return;
+  if (*count > 0)
+  {
+    Period *last = &periods[*count - 1];
+    if (last->upper == lower && (last->upper_inc || lower_inc))
+    {
+      last->upper = upper;
+      last->upper_inc = upper_inc;
+      return;
+    }
+  }
+  period_set(lower, upper, lower_inc, upper_inc, &periods[(*count)++]);
+  return;
+}
+
+/**
+ * Return the periods of the recurring time pattern, or of its complement,
+ * clipped to the period.
+ *
+ * @param[in] rt Recurring time pattern
+ * @param[in] p Period
+ * @param[in] atfunc True for the periods of the pattern, false for those of
+ * its complement
+ * @param[out] count Number of elements of the resulting array
+ * @result Array of disjoint periods in increasing order, NULL if empty
+ */
+Period *
+recurringtime_periods(const RecurringTime *rt, const Period *p, bool atfunc,
+  int *count)
+{
+  /* Local date of the lower bound, the pattern of the previous day may
+   * wrap around midnight into it */
+  struct pg_tm tt, *tm = &tt;
+  fsec_t fsec;
+  int tz;
+  if (timestamp2tm(p->lower, &tz, tm, &fsec, NULL, rt->tz) != 0)
+    ereport(ERROR, (errcode(ERRCODE_DATETIME_VALUE_OUT_OF_RANGE),
+      errmsg("timestamp out of range")));
+  int julian = date2j(tm->tm_year, tm->tm_mon, tm->tm_mday) - 1;
+  bool wrap = rt->start > rt->end;
+  int maxcount = (int) ((p->upper - p->lower) / USECS_PER_DAY) + 4;
+  Period *periods = palloc(sizeof(Period) * maxcount);
+  int k = 0;
+  while (true)
+  {
+    TimestampTz lower = recurringtime_timestamp(rt, julian, rt->start);
+    if (lower > p->upper)
+      break;
+    if (rt->dowmask & (1 << j2day(julian)))
+    {
+      TimestampTz upper = recurringtime_timestamp(rt,
+        wrap ? julian + 1 : julian, rt->end);
+      /* Clip the period of the day to the period */
+      bool lower_inc = true, upper_inc = false;
+      if (lower <= p->lower)
+      {
+        lower = p->lower;
+        lower_inc = p->lower_inc;
+      }
+      if (upper >= p->upper)
+      {
+        upper = p->upper;
+        upper_inc = p->upper_inc;
+      }
+      periodarr_append(periods, &k, lower, upper, lower_inc, upper_inc);
+    }
+    julian++;
+  }
+
+  if (! atfunc)
+  {
+    /* Compute the gaps between the periods of the pattern */
+    Period *gaps = palloc(sizeof(Period) * (k + 1));
+    TimestampTz lower = p->lower;
+    bool lower_inc = p->lower_inc;
+    int k1 = 0;
+    for (int i = 0; i < k; i++)
+    {
+      periodarr_append(gaps, &k1, lower, periods[i].lower, lower_inc,
+        ! periods[i].lower_inc);
+      lower = periods[i].upper;
+      lower_inc = ! periods[i].upper_inc;
+    }
+    periodarr_append(gaps, &k1, lower, p->upper, lower_inc, p->upper_inc);
+    pfree(periods);
+    periods = gaps;
+    k = k1;
+  }
+
+  *count = k;
+  if (k == 0)
+  {
+    pfree(periods);
+    return NULL;
+  }
+  return periods;
+}
+
+/*****************************************************************************
+ * Restriction functions
+ *****************************************************************************/
+
+/**
+ * Restrict the temporal instants to the periods, which are traversed
+ * together with the instants in a single forward walk
+ *
+ * @param[in] instants Instants in increasing order of timestamp
+ * @param[in] count Number of instants
+ * @param[in] periods Array of disjoint periods in increasing order
+ * @param[in] pcount Number of periods
+ * @param[out] result Array of the instants contained in the periods
+ * @return Number of instants in the result
+ */
+static int
+tinstarr_at_periods(const TInstant **instants, int count,
+  const Period *periods, int pcount, const TInstant **result)
+{
+  int i = 0, j = 0, k = 0;
+  while (i < count && j < pcount)
+  {
+    const TInstant *inst = instants[i];
+    if (inst->t > periods[j].upper ||
+        (inst->t == periods[j].upper && ! periods[j].upper_inc))
+      j++;
+    else
+    {
+      if (contains_period_timestamp(&periods[j], inst->t))
+        result[k++] = inst;
+      i++;
+    }
+  }
+  return k;
+}
+
+/**
+ * Restrict the temporal sequence to the periods in a single forward walk
+ *
+ * @param[in] seq Temporal sequence
+ * @param[in] periods Array of disjoint periods in increasing order
+ * @param[in] count Number of periods
+ * @param[in,out] from Index of the first period that may intersect the
+ * sequence, which is advanced for the next sequence of a sequence set
+ * @param[out] result Array on which the pointers of the newly constructed
+ * sequences are stored
+ * @return Number of resulting sequences returned
+ * @note Contrary to tsequence_at_period, the segment containing the lower
+ * bound of each period is found by advancing from the segment of the
+ * previous period instead of with a binary search
+ */
+static int
+tsequence_at_periods(const TSequence *seq, const Period *periods, int count,
+  int *from, TSequence **result)
+{
+  int i = *from;
+  while (i < count && periods[i].upper < seq->period.lower)
+    i++;
+  *from = i;
+
+  bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags);
+  const TInstant **instants = palloc(sizeof(TInstant *) * (seq->count + 1));
+  int n = 0, k = 0;
+  for (; i < count; i++)
+  {
+    if (periods[i].lower > seq->period.upper)
+      break;
+    Period inter;
+    if (! inter_period_period(&seq->period, &periods[i], &inter))
+      continue;
+
+    /* Instantaneous sequence */
+    if (seq->count == 1)
+    {
+      result[k++] = tsequence_copy(seq);
+      break;
+    }
+    /* Intersecting period is instantaneous */
+    if (inter.lower == inter.upper)
+    {
+      TInstant *inst = tsequence_at_timestamp(seq, inter.lower);
+      result[k++] = tinstant_tsequence(inst, linear);
+      pfree(inst);
+      continue;
+    }
+
+    /* Advance to the segment containing the lower bound */
+    while (n < seq->count - 2 && tsequence_inst_n(seq, n + 1)->t <= inter.lower)
+      n++;
+    const TInstant *inst1 = tsequence_inst_n(seq, n);
+    const TInstant *inst2 = tsequence_inst_n(seq, n + 1);
+    TInstant *start = tsegment_at_timestamp(inst1, inst2, linear, inter.lower);
+    instants[0] = start;
+    int ninsts = 1;
+    /* Keep the instants strictly inside the intersecting period */
+    int j = n + 1;
+    while (j < seq->count - 1 && tsequence_inst_n(seq, j)->t < inter.upper)
+      instants[ninsts++] = tsequence_inst_n(seq, j++);
+    inst1 = tsequence_inst_n(seq, j - 1);
+    inst2 = tsequence_inst_n(seq, j);
+    /* The last two values of sequences with step interpolation and
+     * exclusive upper bound must be equal */
+    TInstant *end;
+    if (linear || inter.upper_inc)
+      end = (inst2->t == inter.upper) ? tinstant_copy(inst2) :
+        tsegment_at_timestamp(inst1, inst2, linear, inter.upper);
+    else
+      end = tinstant_make(tinstant_value(instants[ninsts - 1]), inter.upper,
+        seq->temptype);
+    instants[ninsts++] = end;
+    result[k++] = tsequence_make_trusted(instants, ninsts, inter.lower_inc,
+      inter.upper_inc, linear, NORMALIZE_NO);
+    pfree(start); pfree(end);
+    n = j - 1;
+  }
+  pfree(instants);
+  return k;
+}
+
+/**
+ * Restrict the temporal value to (the complement of) the recurring time
+ * pattern
+ *
+ * @param[in] temp Temporal value
+ * @param[in] rt Recurring time pattern
+ * @param[in] atfunc True when the restriction is at, false for minus
+ */
+Temporal *
+temporal_restrict_recurring(const Temporal *temp, const RecurringTime *rt,
+  bool atfunc)
+{
+  Period p;
+  temporal_period(temp, &p);
+  int count;
+  Period *periods = recurringtime_periods(rt, &p, atfunc, &count);
+  if (periods == NULL)
+    return NULL;
+
+  Temporal *result;
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT)
+    result = (Temporal *) tinstant_copy((TInstant *) temp);
+  else if (temp->subtype == INSTANTSET)
+  {
+    const TInstantSet *ti = (const TInstantSet *) temp;
+    const TInstant **instants = tinstantset_instants(ti);
+    const TInstant **insts = palloc(sizeof(TInstant *) * ti->count);
+    int k = tinstarr_at_periods(instants, ti->count, periods, count, insts);
+    result = (k == 0) ? NULL :
+      (Temporal *) tinstantset_make_trusted(insts, k);
+    pfree(instants); pfree(insts);
+  }
+  else if (temp->subtype == SEQUENCE)
+  {
+    const TSequence *seq = (const TSequence *) temp;
+    TSequence **sequences = palloc(sizeof(TSequence *) * count);
+    int from = 0;
+    int k = tsequence_at_periods(seq, periods, count, &from, sequences);
+    result = (Temporal *) tsequenceset_make_trusted_free(sequences, k,
+      NORMALIZE_NO);
+  }
+  else /* temp->subtype == SEQUENCESET */
+  {
+    const TSequenceSet *ts = (const TSequenceSet *) temp;
+    TSequence **sequences = palloc(sizeof(TSequence *) * (ts->count + count));
+    int from = 0, k = 0;
+    for (int i = 0; i < ts->count; i++)
+      k += tsequence_at_periods(tsequenceset_seq_n(ts, i), periods, count,
+        &from, &sequences[k]);
+    result = (Temporal *) tsequenceset_make_trusted_free(sequences, k,
+      NORMALIZE_NO);
+  }
+  pfree(periods);
+  return result;
+}
+
+/**
+ * Return true if the temporal value intersects the recurring time pattern
+ */
+bool
+temporal_intersects_recurring(const Temporal *temp, const RecurringTime *rt)
+{
+  Period p;
+  temporal_period(temp, &p);
+  int count;
+  Period *periods = recurringtime_periods(rt, &p, REST_AT, &count);
+  if (periods == NULL)
+    return false;
+
+  bool result = false;
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT || temp->subtype == SEQUENCE)
+    /* The periods are clipped to the extent of the value */
+    result = true;
+  else if (temp->subtype == INSTANTSET)
+  {
+    const TInstantSet *ti = (const TInstantSet *) temp;
+    int j = 0;
+    for (int i = 0; i < ti->count && j < count && ! result; i++)
+    {
+      TimestampTz t = tinstantset_inst_n(ti, i)->t;
+      while (j < count && (t > periods[j].upper ||
+          (t == periods[j].upper && ! periods[j].upper_inc)))
+        j++;
+      if (j < count && contains_period_timestamp(&periods[j], t))
+        result = true;
+    }
+  }
+  else /* temp->subtype == SEQUENCESET */
+  {
+    const TSequenceSet *ts = (const TSequenceSet *) temp;
+    int i = 0, j = 0;
+    while (i < ts->count && j < count && ! result)
+    {
+      const TSequence *seq = tsequenceset_seq_n(ts, i);
+      if (overlaps_period_period(&seq->period, &periods[j]))
+        result = true;
+      else if (seq->period.upper < periods[j].upper)
+        i++;
+      else
+        j++;
+    }
+  }
+  pfree(periods);
+  return result;
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                        MobilityDB - PostgreSQL                            */
+/*****************************************************************************/
+/*****************************************************************************/
+
+#ifndef MEOS
+
+/*****************************************************************************
+ * Recurring time patterns
+ *****************************************************************************/
+
+/**
+ * Read the recurring time pattern from the arguments of the function
+ * starting at the given argument number, which are the start and end times
+ * of day, the array of days of the week, and the name of the time zone
+ */
+static void
+recurringtime_getargs(FunctionCallInfo fcinfo, int argno, RecurringTime *rt)
+{
+  TimeADT start = PG_GETARG_TIMEADT(argno);
+  TimeADT end = PG_GETARG_TIMEADT(argno + 1);
+  ArrayType *array = PG_GETARG_ARRAYTYPE_P(argno + 2);
+  text *tzname = PG_GETARG_TEXT_PP(argno + 3);
+
+  /* Days of the week */
+  Datum *elems;
+  bool *nulls;
+  int count;
+  deconstruct_array(array, INT4OID, 4, true, 'i', &elems, &nulls, &count);
+  uint8 dowmask = 0;
+  for (int i = 0; i < count; i++)
+  {
+    int dow = nulls[i] ? -1 : DatumGetInt32(elems[i]);
+    if (dow < 0 || dow > 6)
+      ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+        errmsg("The days of the week must be between 0 (Sunday) and 6 (Saturday)")));
+    dowmask |= (uint8) (1 << dow);
+  }
+  pfree(elems); pfree(nulls);
+
+  /* Time zone */
+  char *name = text_to_cstring(tzname);
+  pg_tz *tz = pg_tzset(name);
+  if (! tz)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("Time zone \"%s\" not recognized", name)));
+  pfree(name);
+
+  recurringtime_set(start, end, dowmask, tz, rt);
+  return;
+}
+
+/*****************************************************************************
+ * Restriction functions
+ *****************************************************************************/
+
+/**
+ * Restrict the temporal value to (the complement of) the recurring time
+ * pattern
+ */
+static Datum
+temporal_restrict_recurring_ext(FunctionCallInfo fcinfo, bool atfunc)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  RecurringTime rt;
+  recurringtime_getargs(fcinfo, 1, &rt);
+  Temporal *result = temporal_restrict_recurring(temp, &rt, atfunc);
+  PG_FREE_IF_COPY(temp, 0);
+  if (! result)
+    PG_RETURN_NULL();
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_at_recurring);
+/**
+ * Restrict the temporal value to the recurring time pattern
+ */
+PGDLLEXPORT Datum
+Temporal_at_recurring(PG_FUNCTION_ARGS)
+{
+  return temporal_restrict_recurring_ext(fcinfo, REST_AT);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_minus_recurring);
+/**
+ * Restrict the temporal value to the complement of the recurring time pattern
+ */
+PGDLLEXPORT Datum
+Temporal_minus_recurring(PG_FUNCTION_ARGS)
+{
+  return temporal_restrict_recurring_ext(fcinfo, REST_MINUS);
+}
+
+/*****************************************************************************
+ * Intersects functions
+ *****************************************************************************/
+
+PG_FUNCTION_INFO_V1(Temporal_intersects_recurring);
+/**
+ * Return true if the temporal value intersects the recurring time pattern
+ */
+PGDLLEXPORT Datum
+Temporal_intersects_recurring(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  RecurringTime rt;
+  recurringtime_getargs(fcinfo, 1, &rt);
+  bool result = temporal_intersects_recurring(temp, &rt);
+  PG_FREE_IF_COPY(temp, 0);
+  PG_RETURN_BOOL(result);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_intersects_period_recurring);
+/**
+ * Return true if the temporal value intersects the recurring time pattern
+ * during the period. The support function of the SQL function uses the
+ * period for an index search.
+ */
+PGDLLEXPORT Datum
+Temporal_intersects_period_recurring(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Period *p = PG_GETARG_PERIOD_P(1);
+  RecurringTime rt;
+  recurringtime_getargs(fcinfo, 2, &rt);
+  Temporal *temp1 = temporal_restrict_period(temp, p, REST_AT);
+  bool result = false;
+  if (temp1)
+  {
+    result = temporal_intersects_recurring(temp1, &rt);
+    pfree(temp1);
+  }
+  PG_FREE_IF_COPY(temp, 0);
+  PG_RETURN_BOOL(result);
+}
+
+#endif /* #ifndef MEOS */
+
+/*****************************************************************************/
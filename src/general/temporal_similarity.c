@@ -30,7 +30,9 @@
 /**
  * @file temporal_similarity.c
  * @brief Similarity distance for temporal values. Currently, discrete Frechet
- * distance and Dynamic Time Warping (DTW) distance are implemented.
+ * distance, Dynamic Time Warping (DTW) distance, Hausdorff distance, Longest
+ * Common Subsequence (LCSS) distance, and Edit Distance on Real sequences
+ * (EDR) are implemented.
  */
 
 #include "general/temporal_similarity.h"
@@ -38,6 +40,7 @@
 /* PostgreSQL */
 #include <postgres.h>
 #include <assert.h>
+#include <float.h>
 #include <funcapi.h>
 #include <math.h>
 #if POSTGRESQL_VERSION_NUMBER < 120000
@@ -48,7 +51,9 @@
 /* MobilityDB */
 #include "general/tempcache.h"
 #include "general/temporaltypes.h"
+#include "general/temporal_tile.h"
 #include "general/temporal_util.h"
+#include "point/stbox.h"
 #include "point/tpoint.h"
 #include "point/tpoint_spatialfuncs.h"
 
@@ -433,6 +438,708 @@ temporal_similarity_path(Temporal *temp1, Temporal *temp2, int *count,
   return result;
 }
 
+/*****************************************************************************
+ * Hausdorff distance
+ *****************************************************************************/
+
+/** Relative tolerance of the continuous Hausdorff distance */
+#define HAUSDORFF_TOLERANCE 1e-9
+/** Maximum number of subdivisions of a segment */
+#define HAUSDORFF_MAX_DEPTH 48
+
+/**
+ * Return the coordinates of the instants of a temporal geometric point
+ *
+ * @param[in] temp Temporal point
+ * @param[out] linked Array stating for each point whether it is linked to
+ * the next one by a segment, may be NULL
+ * @param[out] count Number of points
+ * @note The z coordinate is set to 0 for 2D points
+ */
+static POINT3DZ *
+tpoint_coords(const Temporal *temp, bool **linked, int *count)
+{
+  /* Instants shared by consecutive sequences are counted twice */
+  int totalcount = (temp->subtype == SEQUENCESET) ?
+    ((TSequenceSet *) temp)->totalcount : temporal_num_instants(temp);
+  POINT3DZ *result = palloc(sizeof(POINT3DZ) * totalcount);
+  if (linked)
+    *linked = palloc0(sizeof(bool) * totalcount);
+  bool hasz = MOBDB_FLAGS_GET_Z(temp->flags);
+  bool linear = MOBDB_FLAGS_GET_LINEAR(temp->flags);
+  int nseqs = 1;
+  if (temp->subtype == SEQUENCESET)
+    nseqs = ((TSequenceSet *) temp)->count;
+  int k = 0;
+  for (int i = 0; i < nseqs; i++)
+  {
+    const TInstant **instants;
+    int ninsts;
+    if (temp->subtype == SEQUENCESET)
+    {
+      const TSequence *seq = tsequenceset_seq_n((TSequenceSet *) temp, i);
+      instants = tsequence_instants(seq);
+      ninsts = seq->count;
+    }
+    else
+      instants = temporal_instants(temp, &ninsts);
+    for (int j = 0; j < ninsts; j++)
+    {
+      Datum value = tinstant_value(instants[j]);
+      if (hasz)
+        result[k] = *datum_point3dz_p(value);
+      else
+      {
+        const POINT2D *pt = datum_point2d_p(value);
+        result[k].x = pt->x;
+        result[k].y = pt->y;
+        result[k].z = 0.0;
+      }
+      if (linked)
+        (*linked)[k] = linear && temp->subtype >= SEQUENCE && j < ninsts - 1;
+      k++;
+    }
+    pfree(instants);
+  }
+  *count = k;
+  return result;
+}
+
+/**
+ * Return a random permutation of the integers in [0, count)
+ *
+ * @note The random order avoids the worst case of the early break, which
+ * happens when the points are processed in the order of the trajectory.
+ * A fixed seed makes the computation deterministic.
+ */
+static int *
+hausdorff_order(int count)
+{
+  int *result = palloc(sizeof(int) * count);
+  for (int i = 0; i < count; i++)
+    result[i] = i;
+  uint64 seed = 0x9E3779B97F4A7C15 ^ (uint64) count;
+  for (int i = count - 1; i > 0; i--)
+  {
+    /* xorshift64 */
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    int j = (int) (seed % (uint64) (i + 1));
+    int tmp = result[i];
+    result[i] = result[j];
+    result[j] = tmp;
+  }
+  return result;
+}
+
+/**
+ * Return the distance between a point and a segment
+ */
+static double
+hausdorff_point_segm_dist(const POINT3DZ *p, const POINT3DZ *a,
+  const POINT3DZ *b)
+{
+  double dx = b->x - a->x, dy = b->y - a->y, dz = b->z - a->z;
+  double len2 = dx * dx + dy * dy + dz * dz;
+  double fraction = 0.0;
+  if (len2 > 0.0)
+  {
+    fraction = ((p->x - a->x) * dx + (p->y - a->y) * dy +
+      (p->z - a->z) * dz) / len2;
+    fraction = Max(0.0, Min(1.0, fraction));
+  }
+  double x = a->x + dx * fraction - p->x;
+  double y = a->y + dy * fraction - p->y;
+  double z = a->z + dz * fraction - p->z;
+  return sqrt(x * x + y * y + z * z);
+}
+
+/**
+ * Return the distance from a point to the k-th point of an array, or to the
+ * segment starting at it if the point is linked to the next one
+ */
+static double
+hausdorff_point_elem_dist(const POINT3DZ *p, const POINT3DZ *pts,
+  const bool *linked, int k)
+{
+  return linked[k] ? hausdorff_point_segm_dist(p, &pts[k], &pts[k + 1]) :
+    hausdorff_point_segm_dist(p, &pts[k], &pts[k]);
+}
+
+/**
+ * Return the distance from a point to the points and segments of an array,
+ * or a value less than the lower bound as soon as one is found
+ */
+static double
+hausdorff_point_dist(const POINT3DZ *p, const POINT3DZ *pts,
+  const int *order, int count, const bool *linked, double cmax)
+{
+  double result = DBL_MAX;
+  for (int j = 0; j < count; j++)
+  {
+    double d = hausdorff_point_elem_dist(p, pts, linked, order[j]);
+    /* The point cannot increase the maximum */
+    if (d < cmax)
+      return d;
+    if (d < result)
+      result = d;
+  }
+  return result;
+}
+
+/**
+ * Return an upper bound of the distance from the points of a segment to the
+ * points and segments of an array, and set the distances from the end points
+ * of the segment to the array
+ *
+ * @note The distance from a point moving along a segment to a convex set is a
+ * convex function and is thus bounded by its values at the end points of the
+ * segment. The computation stops as soon as the upper bound is at most the
+ * lower bound, in which case the distances from the end points are not exact
+ * but are also at most the lower bound.
+ */
+static double
+hausdorff_segm_bounds(const POINT3DZ *a, const POINT3DZ *b,
+  const POINT3DZ *pts, const int *order, int count, const bool *linked,
+  double cmax, double *dista, double *distb)
+{
+  double result = DBL_MAX;
+  *dista = *distb = DBL_MAX;
+  for (int j = 0; j < count; j++)
+  {
+    int k = order[j];
+    double d1 = hausdorff_point_elem_dist(a, pts, linked, k);
+    double d2 = hausdorff_point_elem_dist(b, pts, linked, k);
+    *dista = Min(*dista, d1);
+    *distb = Min(*distb, d2);
+    result = Min(result, Max(d1, d2));
+    /* The segment cannot increase the maximum */
+    if (result <= cmax)
+      break;
+  }
+  return result;
+}
+
+/**
+ * Return the point at a fraction of a segment
+ */
+static POINT3DZ
+hausdorff_segm_point(const POINT3DZ *a, const POINT3DZ *b, double fraction)
+{
+  POINT3DZ result;
+  result.x = a->x + (b->x - a->x) * fraction;
+  result.y = a->y + (b->y - a->y) * fraction;
+  result.z = a->z + (b->z - a->z) * fraction;
+  return result;
+}
+
+/**
+ * Return the directed Hausdorff distance from a segment to the points and
+ * segments of an array using a branch and bound subdivision of the segment
+ *
+ * @param[in] a,b End points of the segment
+ * @param[in] pts,order,count,linked Points of the second trajectory
+ * @param[in] cmax Lower bound of the distance
+ * @param[in] bound Value from which the computation stops
+ * @param[in] target Value below which the upper bound of a subsegment is
+ * precise enough
+ * @param[in,out] upper Maximum of the upper bounds of the subsegments that
+ * are not subdivided further
+ * @note A subsegment is subdivided while its upper bound exceeds the lower
+ * bound by more than the tolerance, so that the distance is exact up to the
+ * tolerance. The subsegments are visited in depth-first order so that the
+ * stack is bounded by the maximum depth.
+ */
+static double
+hausdorff_directed_segm(const POINT3DZ *a, const POINT3DZ *b,
+  const POINT3DZ *pts, const int *order, int count, const bool *linked,
+  double cmax, double bound, double target, double *upper)
+{
+  double lower[HAUSDORFF_MAX_DEPTH + 1], higher[HAUSDORFF_MAX_DEPTH + 1];
+  int depth[HAUSDORFF_MAX_DEPTH + 1];
+  lower[0] = 0.0; higher[0] = 1.0; depth[0] = 0;
+  int n = 1;
+  while (n > 0)
+  {
+    n--;
+    double f1 = lower[n], f2 = higher[n];
+    POINT3DZ p1 = hausdorff_segm_point(a, b, f1);
+    POINT3DZ p2 = hausdorff_segm_point(a, b, f2);
+    double d1, d2;
+    double ub = hausdorff_segm_bounds(&p1, &p2, pts, order, count, linked,
+      cmax, &d1, &d2);
+    cmax = Max(cmax, Max(d1, d2));
+    if (cmax >= bound)
+      return cmax;
+    if (ub <= cmax)
+      continue;
+    if (ub < target || depth[n] == HAUSDORFF_MAX_DEPTH ||
+        ub - cmax <= HAUSDORFF_TOLERANCE * Max(1.0, ub))
+    {
+      *upper = Max(*upper, ub);
+      continue;
+    }
+    double mid = (f1 + f2) / 2.0;
+    int d = depth[n] + 1;
+    lower[n] = mid; higher[n] = f2; depth[n] = d;
+    lower[n + 1] = f1; higher[n + 1] = mid; depth[n + 1] = d;
+    n += 2;
+  }
+  return cmax;
+}
+
+/**
+ * Return the directed Hausdorff distance from the points of the first array
+ * to the second one using the early break algorithm of Taha and Hanbury
+ *
+ * @param[in] pts1,pts2 Arrays of points
+ * @param[in] order1,order2 Order in which the points are visited
+ * @param[in] count1,count2 Number of points
+ * @param[in] linked1,linked2 Arrays stating whether a point is linked to the
+ * next one by a segment
+ * @param[in] kind Kind of Hausdorff distance
+ * @param[in] cmax Lower bound of the distance
+ * @param[in] bound Value from which the computation stops since the
+ * distance is known to be greater than or equal to it
+ * @param[in] target Value below which the upper bound of a subsegment is
+ * precise enough
+ * @param[in,out] upper Maximum of the upper bounds of the subsegments that
+ * are not subdivided further
+ */
+static double
+hausdorff_directed(const POINT3DZ *pts1, const int *order1, int count1,
+  const bool *linked1, const POINT3DZ *pts2, const int *order2, int count2,
+  const bool *linked2, HausdorffKind kind, double cmax, double bound,
+  double target, double *upper)
+{
+  for (int i = 0; i < count1; i++)
+  {
+    int k = order1[i];
+    if (kind == HAUSDORFF_CONTINUOUS && linked1[k])
+      cmax = hausdorff_directed_segm(&pts1[k], &pts1[k + 1], pts2, order2,
+        count2, linked2, cmax, bound, target, upper);
+    else
+      cmax = Max(cmax, hausdorff_point_dist(&pts1[k], pts2, order2, count2,
+        linked2, cmax));
+    if (cmax >= bound)
+      break;
+  }
+  return cmax;
+}
+
+/**
+ * Return a lower bound of the Hausdorff distance between two temporal
+ * points from their bounding boxes
+ *
+ * @note The point of a trajectory reaching the minimum or the maximum of an
+ * axis is at least at the difference of the corresponding bounds from
+ * every point of the other trajectory
+ */
+static double
+hausdorff_bbox_lower_bound(const Temporal *temp1, const Temporal *temp2)
+{
+  STBOX box1, box2;
+  temporal_bbox(temp1, &box1);
+  temporal_bbox(temp2, &box2);
+  double result = Max(fabs(box1.xmin - box2.xmin),
+    fabs(box1.xmax - box2.xmax));
+  result = Max(result, Max(fabs(box1.ymin - box2.ymin),
+    fabs(box1.ymax - box2.ymax)));
+  if (MOBDB_FLAGS_GET_Z(box1.flags))
+    result = Max(result, Max(fabs(box1.zmin - box2.zmin),
+      fabs(box1.zmax - box2.zmax)));
+  return result;
+}
+
+/**
+ * Return the Hausdorff distance between two temporal geometric points or
+ * a value greater than or equal to the bound if the distance is known to be
+ * greater than or equal to it
+ *
+ * @param[in] temp1,temp2 Temporal points
+ * @param[in] kind Kind of Hausdorff distance
+ * @param[in] bound Value from which the computation stops, DBL_MAX when the
+ * distance is computed
+ * @note The continuous distance is an upper bound of the Hausdorff distance
+ * between the trajectories that is exact up to the tolerance, so that it can
+ * be compared with the bound for filtering. The vertex and discrete distances
+ * are lower bounds of it. Temporal geographic points are not supported.
+ */
+static double
+tpoint_hausdorff(const Temporal *temp1, const Temporal *temp2,
+  HausdorffKind kind, double bound)
+{
+  ensure_not_geodetic(temp1->flags);
+  ensure_same_srid(tpoint_srid(temp1), tpoint_srid(temp2));
+  ensure_same_dimensionality(temp1->flags, temp2->flags);
+  double result = hausdorff_bbox_lower_bound(temp1, temp2);
+  if (result >= bound)
+    return result;
+
+  int count1, count2;
+  bool *linked1, *linked2;
+  POINT3DZ *pts1 = tpoint_coords(temp1, &linked1, &count1);
+  POINT3DZ *pts2 = tpoint_coords(temp2, &linked2, &count2);
+  if (kind == HAUSDORFF_DISCRETE)
+  {
+    memset(linked1, 0, sizeof(bool) * count1);
+    memset(linked2, 0, sizeof(bool) * count2);
+  }
+  int *order1 = hausdorff_order(count1);
+  int *order2 = hausdorff_order(count2);
+  /* When filtering, the subsegments whose upper bound is less than the
+   * bound need not be subdivided */
+  double target = (bound < DBL_MAX) ? bound : 0.0;
+  double upper = 0.0;
+  result = hausdorff_directed(pts1, order1, count1, linked1, pts2, order2,
+    count2, linked2, kind, result, bound, target, &upper);
+  if (result < bound)
+    result = hausdorff_directed(pts2, order2, count2, linked2, pts1, order1,
+      count1, linked1, kind, result, bound, target, &upper);
+  pfree(pts1); pfree(pts2); pfree(linked1); pfree(linked2);
+  pfree(order1); pfree(order2);
+  return Max(result, upper);
+}
+
+/**
+ * @ingroup libmeos_temporal_similarity
+ * @brief Return the Hausdorff distance between two temporal geometric points.
+ *
+ * @param[in] temp1,temp2 Temporal points
+ * @param[in] kind Kind of Hausdorff distance. The continuous distance is the
+ * Hausdorff distance between the trajectories. The vertex distance compares
+ * the instants of a trajectory with the segments of the other one when it
+ * has linear interpolation, as in ST_HausdorffDistance. The discrete distance
+ * only compares the instants.
+ * @note The vertex and discrete distances are lower bounds of the continuous
+ * distance since the points inside the segments are not considered
+ */
+double
+temporal_hausdorff_distance(const Temporal *temp1, const Temporal *temp2,
+  HausdorffKind kind)
+{
+  return tpoint_hausdorff(temp1, temp2, kind, DBL_MAX);
+}
+
+/**
+ * @ingroup libmeos_temporal_similarity
+ * @brief Return true if the Hausdorff distance between two temporal geometric
+ * points is less than the distance.
+ *
+ * @note The computation stops as soon as the distance is reached. The
+ * continuous distance never yields true when the Hausdorff distance between
+ * the trajectories is greater than or equal to the distance.
+ */
+bool
+temporal_hausdorff_within(const Temporal *temp1, const Temporal *temp2,
+  double dist, HausdorffKind kind)
+{
+  return tpoint_hausdorff(temp1, temp2, kind, dist) < dist;
+}
+
+/*****************************************************************************
+ * LCSS and EDR distances
+ *****************************************************************************/
+
+/**
+ * Compute for each instant of the first array the range of instants of the
+ * second array whose timestamps are within the window
+ *
+ * @param[in] instants1,instants2 Arrays of temporal instants
+ * @param[in] count1,count2 Number of instants in the arrays
+ * @param[in] window Temporal matching window, negative if there is none
+ * @param[out] lower,upper Arrays keeping the inclusive bounds of the ranges,
+ * the range is empty when the lower bound is greater than the upper bound
+ * @note Since the instants are ordered by time the ranges form a band
+ * around the diagonal that is obtained in a single pass
+ */
+static void
+tinstarr_window_band(const TInstant **instants1, int count1,
+  const TInstant **instants2, int count2, int64 window, int *lower,
+  int *upper)
+{
+  int lo = 0, hi = -1;
+  for (int i = 0; i < count1; i++)
+  {
+    if (window < 0)
+    {
+      lower[i] = 0;
+      upper[i] = count2 - 1;
+      continue;
+    }
+    TimestampTz t = instants1[i]->t;
+    while (lo < count2 && instants2[lo]->t < t - window)
+      lo++;
+    if (hi < lo - 1)
+      hi = lo - 1;
+    while (hi + 1 < count2 && instants2[hi + 1]->t <= t + window)
+      hi++;
+    lower[i] = lo;
+    upper[i] = hi;
+  }
+  return;
+}
+
+/**
+ * Return the length of the longest common subsequence of two arrays of
+ * instants, where two instants match if their distance is at most epsilon
+ * and their timestamps are within the window
+ *
+ * @param[in] instants1,instants2 Arrays of temporal instants
+ * @param[in] count1,count2 Number of instants in the arrays
+ * @param[in] eps Distance threshold
+ * @param[in] window Temporal matching window, negative if there is none
+ * @param[in] minlcss Length to reach, the computation is abandoned and -1
+ * is returned as soon as it cannot be reached
+ * @note Only the cells of the band are computed. Since no instant matches
+ * outside the band, a cell before the band of a row keeps the value of the
+ * row above and a cell after the band takes the value of the last cell of
+ * the band. A single row is thus updated in place, where the cells after
+ * the column last have the value of this column.
+ */
+static int
+tinstarr_lcss(const TInstant **instants1, int count1,
+  const TInstant **instants2, int count2, double eps, int64 window,
+  int minlcss)
+{
+  int *lower = palloc(sizeof(int) * count1);
+  int *upper = palloc(sizeof(int) * count1);
+  tinstarr_window_band(instants1, count1, instants2, count2, window, lower,
+    upper);
+  /* Row of the matrix with an additional column for j = -1 */
+  int *row = palloc0(sizeof(int) * (count2 + 1));
+  int last = 0;
+  int result = 0;
+  for (int i = 0; i < count1; i++)
+  {
+    /* Propagate the value of the last column up to the end of the band */
+    for (int j = last + 1; j <= upper[i] + 1; j++)
+      row[j] = row[last];
+    last = Max(last, upper[i] + 1);
+    /* Value of the cell (i - 1, j - 1) */
+    int diag = row[lower[i]];
+    for (int j = lower[i]; j <= upper[i]; j++)
+    {
+      int up = row[j + 1];
+      if (tinstant_distance(instants1[i], instants2[j]) <= eps)
+        row[j + 1] = diag + 1;
+      else
+        row[j + 1] = Max(up, row[j]);
+      diag = up;
+    }
+    result = row[last];
+    /* Each remaining row adds at most one to the length */
+    if (result + count1 - 1 - i < minlcss)
+    {
+      result = -1;
+      break;
+    }
+  }
+  pfree(lower); pfree(upper); pfree(row);
+  return result;
+}
+
+/**
+ * Return the edit distance on real sequences of two arrays of instants,
+ * where two instants match if their distance is at most epsilon and their
+ * timestamps are within the window
+ *
+ * @param[in] instants1,instants2 Arrays of temporal instants
+ * @param[in] count1,count2 Number of instants in the arrays
+ * @param[in] eps Distance threshold
+ * @param[in] window Temporal matching window, negative if there is none
+ * @param[in] maxedr Distance to stay within, the computation is abandoned
+ * and maxedr + 1 is returned as soon as it is exceeded
+ * @note Only the cells of the band are computed and the other ones are
+ * unreachable, except those of the first and last rows and columns, which
+ * account for the instants inserted or deleted before and after the band
+ */
+static int
+tinstarr_edr(const TInstant **instants1, int count1,
+  const TInstant **instants2, int count2, double eps, int64 window,
+  int maxedr)
+{
+  int *lower = palloc(sizeof(int) * count1);
+  int *upper = palloc(sizeof(int) * count1);
+  tinstarr_window_band(instants1, count1, instants2, count2, window, lower,
+    upper);
+  /* Value of the unreachable cells, greater than the cost of any path */
+  int inf = count1 + count2 + 1;
+  /* Two rows of the matrix with an additional column for j = -1, only the
+   * cells of the band are valid */
+  int *prev = palloc(sizeof(int) * (count2 + 1));
+  int *cur = palloc(sizeof(int) * (count2 + 1));
+  for (int j = 0; j <= count2; j++)
+    prev[j] = j;
+  int prevlo = 0, prevhi = count2 - 1;
+  /* Value of the cell of the last column of the previous row */
+  int lastcol = count2;
+  int result = -1;
+  for (int i = 0; i < count1; i++)
+  {
+    cur[0] = i + 1;
+    int rowmin = cur[0];
+    int curlast = Min(lastcol + 1, inf);
+    for (int j = lower[i]; j <= upper[i]; j++)
+    {
+      /* The cells (i - 1, j - 1), (i - 1, j), and (i, j - 1) */
+      int diag = (j == 0 || (j - 1 >= prevlo && j - 1 <= prevhi)) ?
+        prev[j] : inf;
+      int up = (j >= prevlo && j <= prevhi) ? prev[j + 1] :
+        ((j == count2 - 1) ? lastcol : inf);
+      int left = (j == 0 || j > lower[i]) ? cur[j] : inf;
+      int subcost = (tinstant_distance(instants1[i], instants2[j]) <= eps) ?
+        0 : 1;
+      cur[j + 1] = Min(Min(diag + subcost, up + 1), Min(left + 1, inf));
+      rowmin = Min(rowmin, cur[j + 1]);
+    }
+    if (lower[i] <= upper[i] && upper[i] == count2 - 1)
+      curlast = cur[count2];
+    lastcol = curlast;
+    rowmin = Min(rowmin, lastcol);
+    /* Every path to the last cell crosses the row */
+    if (rowmin > maxedr)
+    {
+      result = maxedr + 1;
+      break;
+    }
+    int *tmp = prev; prev = cur; cur = tmp;
+    prevlo = lower[i];
+    prevhi = upper[i];
+  }
+  if (result < 0)
+  {
+    /* Insert the remaining instants of the second array after the band of
+     * the last row or after the first column */
+    result = Min(lastcol, prev[0] + count2);
+    for (int j = prevlo; j <= prevhi; j++)
+      result = Min(result, prev[j + 1] + count2 - 1 - j);
+  }
+  pfree(lower); pfree(upper); pfree(prev); pfree(cur);
+  return result;
+}
+
+/**
+ * Ensure that two temporal points have the same SRID and dimensionality
+ */
+static void
+ensure_valid_lcss_edr(const Temporal *temp1, const Temporal *temp2)
+{
+  if (tgeo_type(temp1->temptype))
+  {
+    ensure_same_srid(tpoint_srid(temp1), tpoint_srid(temp2));
+    ensure_same_dimensionality(temp1->flags, temp2->flags);
+  }
+  return;
+}
+
+/**
+ * Return the LCSS distance between two temporal values, or a value greater
+ * than the bound if the distance is known to be greater than it
+ */
+static double
+temporal_lcss(const Temporal *temp1, const Temporal *temp2, double eps,
+  int64 window, double bound)
+{
+  ensure_valid_lcss_edr(temp1, temp2);
+  int count1, count2;
+  const TInstant **instants1 = temporal_instants(temp1, &count1);
+  const TInstant **instants2 = temporal_instants(temp2, &count2);
+  int mincount = Min(count1, count2);
+  int minlcss = (bound >= 1.0) ? 0 :
+    (int) ceil((1.0 - bound) * mincount - MOBDB_EPSILON);
+  int lcss = tinstarr_lcss(instants1, count1, instants2, count2, eps, window,
+    minlcss);
+  pfree(instants1); pfree(instants2);
+  return (lcss < 0) ? DBL_MAX : 1.0 - (double) lcss / mincount;
+}
+
+/**
+ * @ingroup libmeos_temporal_similarity
+ * @brief Return the Longest Common Subsequence (LCSS) distance between two
+ * temporal values.
+ *
+ * @param[in] temp1,temp2 Temporal values
+ * @param[in] eps Distance threshold for two instants to match
+ * @param[in] window Temporal matching window in microseconds, negative if
+ * there is none
+ * @result One minus the length of the LCSS divided by the minimum number of
+ * instants of the values
+ */
+double
+temporal_lcss_distance(const Temporal *temp1, const Temporal *temp2,
+  double eps, int64 window)
+{
+  return temporal_lcss(temp1, temp2, eps, window, DBL_MAX);
+}
+
+/**
+ * @ingroup libmeos_temporal_similarity
+ * @brief Return true if the Longest Common Subsequence (LCSS) distance
+ * between two temporal values is at most the distance.
+ *
+ * @note The computation is abandoned as soon as the distance cannot be
+ * reached
+ */
+bool
+temporal_lcss_within(const Temporal *temp1, const Temporal *temp2,
+  double eps, int64 window, double dist)
+{
+  return temporal_lcss(temp1, temp2, eps, window, dist) <= dist;
+}
+
+/**
+ * Return the EDR distance between two temporal values, or a value greater
+ * than the bound if the distance is known to be greater than it
+ */
+static int
+temporal_edr(const Temporal *temp1, const Temporal *temp2, double eps,
+  int64 window, int bound)
+{
+  ensure_valid_lcss_edr(temp1, temp2);
+  int count1, count2;
+  const TInstant **instants1 = temporal_instants(temp1, &count1);
+  const TInstant **instants2 = temporal_instants(temp2, &count2);
+  int result = tinstarr_edr(instants1, count1, instants2, count2, eps,
+    window, bound);
+  pfree(instants1); pfree(instants2);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_similarity
+ * @brief Return the Edit Distance on Real sequences (EDR) between two
+ * temporal values.
+ *
+ * @param[in] temp1,temp2 Temporal values
+ * @param[in] eps Distance threshold for two instants to match
+ * @param[in] window Temporal matching window in microseconds, negative if
+ * there is none
+ * @result Number of insertions, deletions, or substitutions of instants
+ * needed to transform one value into the other
+ */
+int
+temporal_edr_distance(const Temporal *temp1, const Temporal *temp2,
+  double eps, int64 window)
+{
+  return temporal_edr(temp1, temp2, eps, window, PG_INT32_MAX - 1);
+}
+
+/**
+ * @ingroup libmeos_temporal_similarity
+ * @brief Return true if the Edit Distance on Real sequences (EDR) between two
+ * temporal values is at most the number of edits.
+ *
+ * @note The computation is abandoned as soon as the number is exceeded
+ */
+bool
+temporal_edr_within(const Temporal *temp1, const Temporal *temp2,
+  double eps, int64 window, int edits)
+{
+  return temporal_edr(temp1, temp2, eps, window, edits) <= edits;
+}
+
 /*****************************************************************************/
 /*****************************************************************************/
 /*                        MobilityDB - PostgreSQL                            */
@@ -479,6 +1186,191 @@ Temporal_dynamic_time_warp(PG_FUNCTION_ARGS)
   return temporal_similarity_ext(fcinfo, DYNTIMEWARP);
 }
 
+/**
+ * Compute the Hausdorff distance between two temporal points
+ */
+static Datum
+temporal_hausdorff_ext(FunctionCallInfo fcinfo, HausdorffKind kind)
+{
+  Temporal *temp1 = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp2 = PG_GETARG_TEMPORAL_P(1);
+  double result = temporal_hausdorff_distance(temp1, temp2, kind);
+  PG_FREE_IF_COPY(temp1, 0);
+  PG_FREE_IF_COPY(temp2, 1);
+  PG_RETURN_FLOAT8(result);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_hausdorff_distance);
+/**
+ * Compute the Hausdorff distance between the trajectories of two temporal
+ * points.
+ */
+PGDLLEXPORT Datum
+Temporal_hausdorff_distance(PG_FUNCTION_ARGS)
+{
+  return temporal_hausdorff_ext(fcinfo, HAUSDORFF_CONTINUOUS);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_vertex_hausdorff_distance);
+/**
+ * Compute the vertex-based Hausdorff distance between two temporal points.
+ */
+PGDLLEXPORT Datum
+Temporal_vertex_hausdorff_distance(PG_FUNCTION_ARGS)
+{
+  return temporal_hausdorff_ext(fcinfo, HAUSDORFF_VERTEX);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_discrete_hausdorff_distance);
+/**
+ * Compute the discrete Hausdorff distance between two temporal points.
+ */
+PGDLLEXPORT Datum
+Temporal_discrete_hausdorff_distance(PG_FUNCTION_ARGS)
+{
+  return temporal_hausdorff_ext(fcinfo, HAUSDORFF_DISCRETE);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_hausdorff_within);
+/**
+ * Return true if the Hausdorff distance between the trajectories of two
+ * temporal points is less than the distance
+ */
+PGDLLEXPORT Datum
+Temporal_hausdorff_within(PG_FUNCTION_ARGS)
+{
+  Temporal *temp1 = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp2 = PG_GETARG_TEMPORAL_P(1);
+  double dist = PG_GETARG_FLOAT8(2);
+  ensure_positive_datum(Float8GetDatum(dist), T_FLOAT8);
+  bool result = temporal_hausdorff_within(temp1, temp2, dist,
+    HAUSDORFF_CONTINUOUS);
+  PG_FREE_IF_COPY(temp1, 0);
+  PG_FREE_IF_COPY(temp2, 1);
+  PG_RETURN_BOOL(result);
+}
+
+/*****************************************************************************
+ * LCSS and EDR distances
+ *****************************************************************************/
+
+/**
+ * Get the distance threshold and the optional temporal window of the LCSS
+ * and EDR functions
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[in] winarg Number of the argument of the window
+ * @param[out] eps Distance threshold
+ * @param[out] window Window in microseconds, -1 if not given
+ */
+static void
+similarity_eps_window(FunctionCallInfo fcinfo, int winarg, double *eps,
+  int64 *window)
+{
+  *eps = PG_GETARG_FLOAT8(2);
+  if (*eps < 0.0)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The distance threshold must be greater than or equal to 0")));
+  *window = -1;
+  if (PG_NARGS() > winarg)
+  {
+    Interval *interv = PG_GETARG_INTERVAL_P(winarg);
+    ensure_valid_duration(interv);
+    *window = get_interval_units(interv);
+  }
+  return;
+}
+
+PG_FUNCTION_INFO_V1(Temporal_lcss_distance);
+/**
+ * Compute the Longest Common Subsequence (LCSS) distance between two
+ * temporal values
+ */
+PGDLLEXPORT Datum
+Temporal_lcss_distance(PG_FUNCTION_ARGS)
+{
+  Temporal *temp1 = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp2 = PG_GETARG_TEMPORAL_P(1);
+  double eps;
+  int64 window;
+  similarity_eps_window(fcinfo, 3, &eps, &window);
+  /* Store fcinfo into a global variable for temporal geographic points */
+  if (temp1->temptype == T_TGEOGPOINT)
+    store_fcinfo(fcinfo);
+  double result = temporal_lcss_distance(temp1, temp2, eps, window);
+  PG_FREE_IF_COPY(temp1, 0);
+  PG_FREE_IF_COPY(temp2, 1);
+  PG_RETURN_FLOAT8(result);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_lcss_within);
+/**
+ * Return true if the Longest Common Subsequence (LCSS) distance between two
+ * temporal values is at most the distance
+ */
+PGDLLEXPORT Datum
+Temporal_lcss_within(PG_FUNCTION_ARGS)
+{
+  Temporal *temp1 = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp2 = PG_GETARG_TEMPORAL_P(1);
+  double dist = PG_GETARG_FLOAT8(3);
+  double eps;
+  int64 window;
+  similarity_eps_window(fcinfo, 4, &eps, &window);
+  /* Store fcinfo into a global variable for temporal geographic points */
+  if (temp1->temptype == T_TGEOGPOINT)
+    store_fcinfo(fcinfo);
+  bool result = temporal_lcss_within(temp1, temp2, eps, window, dist);
+  PG_FREE_IF_COPY(temp1, 0);
+  PG_FREE_IF_COPY(temp2, 1);
+  PG_RETURN_BOOL(result);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_edr_distance);
+/**
+ * Compute the Edit Distance on Real sequences (EDR) between two temporal
+ * values
+ */
+PGDLLEXPORT Datum
+Temporal_edr_distance(PG_FUNCTION_ARGS)
+{
+  Temporal *temp1 = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp2 = PG_GETARG_TEMPORAL_P(1);
+  double eps;
+  int64 window;
+  similarity_eps_window(fcinfo, 3, &eps, &window);
+  /* Store fcinfo into a global variable for temporal geographic points */
+  if (temp1->temptype == T_TGEOGPOINT)
+    store_fcinfo(fcinfo);
+  int result = temporal_edr_distance(temp1, temp2, eps, window);
+  PG_FREE_IF_COPY(temp1, 0);
+  PG_FREE_IF_COPY(temp2, 1);
+  PG_RETURN_INT32(result);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_edr_within);
+/**
+ * Return true if the Edit Distance on Real sequences (EDR) between two
+ * temporal values is at most the number of edits
+ */
+PGDLLEXPORT Datum
+Temporal_edr_within(PG_FUNCTION_ARGS)
+{
+  Temporal *temp1 = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp2 = PG_GETARG_TEMPORAL_P(1);
+  int edits = PG_GETARG_INT32(3);
+  double eps;
+  int64 window;
+  similarity_eps_window(fcinfo, 4, &eps, &window);
+  /* Store fcinfo into a global variable for temporal geographic points */
+  if (temp1->temptype == T_TGEOGPOINT)
+    store_fcinfo(fcinfo);
+  bool result = temporal_edr_within(temp1, temp2, eps, window, edits);
+  PG_FREE_IF_COPY(temp1, 0);
+  PG_FREE_IF_COPY(temp2, 1);
+  PG_RETURN_BOOL(result);
+}
+
 /*****************************************************************************
  * Compute the similarity path between two temporal values from the distance
  * matrix
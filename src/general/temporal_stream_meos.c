@@ -0,0 +1,820 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_stream_meos.c
+ * @brief Stateful window operators over streams of temporal instants.
+ *
+ * The operators consume the instants of many moving objects identified by a
+ * key and emit the result of each window as soon as it is closed. Tumbling
+ * windows partition the time line into intervals of a fixed size, sliding
+ * windows of a fixed size start at every multiple of the slide, and session
+ * windows group the instants separated by less than a gap. As in a temporal
+ * sequence, the values between consecutive instants of a key are
+ * interpolated, in particular at the window boundaries, unless the instants
+ * are more than the size of the windows apart, in which case the windows in
+ * between have no data and are not emitted.
+ *
+ * The instants are never buffered. Each key keeps the last instant received
+ * and the partial aggregate of its open window. Sliding windows are split
+ * into panes of the size of the slide, so that each instant updates a single
+ * pane and emitting a window combines size/slide panes.
+ */
+
+#include "general/temporal_stream.h"
+
+/* PostgreSQL */
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <utils/memutils.h>
+#include <utils/timestamp.h>
+/* MobilityDB */
+#include "general/doxygen_libmeos_api.h"
+#include "general/tempcache.h"
+#include "general/temporal_tile.h"
+#include "general/temporal_util.h"
+#include "point/tpoint_spatialfuncs.h"
+
+/*****************************************************************************
+ * Values and distances
+ *****************************************************************************/
+
+/**
+ * Set the sample from the temporal instant
+ */
+static void
+window_sample_set(const WindowOp *op, const TInstant *inst,
+  WindowSample *sample)
+{
+  memset(sample, 0, sizeof(WindowSample));
+  sample->t = inst->t;
+  if (tnumber_type(op->temptype))
+    sample->value = tnumberinst_double(inst);
+  else
+  {
+    Datum value = tinstant_value(inst);
+    if (MOBDB_FLAGS_GET_Z(inst->flags))
+      sample->point = *datum_point3dz_p(value);
+    else
+    {
+      const POINT2D *pt = datum_point2d_p(value);
+      sample->point.x = pt->x;
+      sample->point.y = pt->y;
+    }
+  }
+  return;
+}
+
+/**
+ * Set the sample to the value interpolated at the timestamp between the two
+ * samples
+ */
+static void
+window_sample_interp(const WindowOp *op, const WindowSample *s1,
+  const WindowSample *s2, TimestampTz t, WindowSample *result)
+{
+  double ratio = (double) (t - s1->t) / (double) (s2->t - s1->t);
+  result->t = t;
+  result->value = op->linear ?
+    s1->value + (s2->value - s1->value) * ratio : s1->value;
+  result->point.x = s1->point.x + (s2->point.x - s1->point.x) * ratio;
+  result->point.y = s1->point.y + (s2->point.y - s1->point.y) * ratio;
+  result->point.z = s1->point.z + (s2->point.z - s1->point.z) * ratio;
+  return;
+}
+
+/**
+ * Return the distance between the two points
+ */
+static double
+window_point_dist(const POINT3DZ *p1, const POINT3DZ *p2)
+{
+  double dx = p2->x - p1->x;
+  double dy = p2->y - p1->y;
+  double dz = p2->z - p1->z;
+  return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+/**
+ * Return the distance between the sample and the reference value
+ */
+static double
+window_sample_dist(const WindowOp *op, const WindowSample *s)
+{
+  if (tnumber_type(op->temptype))
+    return fabs(s->value - op->refvalue);
+  return window_point_dist(&s->point, &op->refpoint);
+}
+
+/**
+ * Return the minimum distance between the reference value and the values
+ * taken between the two samples
+ */
+static double
+window_segm_dist(const WindowOp *op, const WindowSample *s1,
+  const WindowSample *s2)
+{
+  if (tnumber_type(op->temptype))
+  {
+    double d1 = s1->value - op->refvalue;
+    if (! op->linear)
+      return fabs(d1);
+    double d2 = s2->value - op->refvalue;
+    if (d1 * d2 <= 0)
+      return 0.0;
+    return Min(fabs(d1), fabs(d2));
+  }
+  /* Project the reference point on the segment */
+  const POINT3DZ *a = &s1->point, *b = &s2->point, *p = &op->refpoint;
+  double dx = b->x - a->x, dy = b->y - a->y, dz = b->z - a->z;
+  double len2 = dx * dx + dy * dy + dz * dz;
+  double f = 0.0;
+  if (len2 > 0.0)
+  {
+    f = ((p->x - a->x) * dx + (p->y - a->y) * dy + (p->z - a->z) * dz) / len2;
+    f = Max(0.0, Min(1.0, f));
+  }
+  POINT3DZ proj;
+  proj.x = a->x + dx * f;
+  proj.y = a->y + dy * f;
+  proj.z = a->z + dz * f;
+  return window_point_dist(&proj, p);
+}
+
+/*****************************************************************************
+ * Partial aggregates
+ *****************************************************************************/
+
+/**
+ * Initialize the partial aggregate
+ */
+static void
+window_acc_init(WindowAcc *acc)
+{
+  memset(acc, 0, sizeof(WindowAcc));
+  acc->tmin = DT_NOEND;
+  acc->tmax = DT_NOBEGIN;
+  acc->min = DBL_MAX;
+  acc->max = -DBL_MAX;
+  return;
+}
+
+/**
+ * Return true if no data has been added to the partial aggregate
+ */
+static bool
+window_acc_empty(const WindowAcc *acc)
+{
+  return acc->tmin > acc->tmax;
+}
+
+/**
+ * Add the second partial aggregate to the first one
+ */
+static void
+window_acc_combine(WindowAcc *acc, const WindowAcc *pane)
+{
+  if (window_acc_empty(pane))
+    return;
+  acc->tmin = Min(acc->tmin, pane->tmin);
+  acc->tmax = Max(acc->tmax, pane->tmax);
+  acc->count += pane->count;
+  acc->events += pane->events;
+  acc->duration += pane->duration;
+  acc->integral += pane->integral;
+  acc->length += pane->length;
+  acc->min = Min(acc->min, pane->min);
+  acc->max = Max(acc->max, pane->max);
+  return;
+}
+
+/**
+ * Add an instant to the partial aggregate
+ *
+ * @param[in] op Window operator
+ * @param[in,out] acc Partial aggregate
+ * @param[in] s Sample of the instant
+ * @param[in,out] inside True when the previous value is within the distance
+ * of the reference value
+ */
+static void
+window_acc_instant(const WindowOp *op, WindowAcc *acc, const WindowSample *s,
+  bool *inside)
+{
+  acc->tmin = Min(acc->tmin, s->t);
+  acc->tmax = Max(acc->tmax, s->t);
+  acc->count++;
+  if (tnumber_type(op->temptype))
+  {
+    acc->min = Min(acc->min, s->value);
+    acc->max = Max(acc->max, s->value);
+  }
+  if (op->dist >= 0)
+  {
+    bool within = window_sample_dist(op, s) <= op->dist;
+    if (! *inside && within)
+      acc->events++;
+    *inside = within;
+  }
+  return;
+}
+
+/**
+ * Add the values taken between two samples to the partial aggregate
+ *
+ * @param[in] op Window operator
+ * @param[in,out] acc Partial aggregate
+ * @param[in] s1,s2 Samples at the start and the end of the segment
+ * @param[in,out] inside True when the previous value is within the distance
+ * of the reference value
+ */
+static void
+window_acc_segment(const WindowOp *op, WindowAcc *acc, const WindowSample *s1,
+  const WindowSample *s2, bool *inside)
+{
+  if (s2->t <= s1->t)
+    return;
+  double secs = (double) (s2->t - s1->t) / USECS_PER_SEC;
+  acc->tmin = Min(acc->tmin, s1->t);
+  acc->tmax = Max(acc->tmax, s2->t);
+  acc->duration += secs;
+  if (tnumber_type(op->temptype))
+  {
+    if (op->linear)
+    {
+      acc->integral += (s1->value + s2->value) / 2.0 * secs;
+      acc->min = Min(acc->min, Min(s1->value, s2->value));
+      acc->max = Max(acc->max, Max(s1->value, s2->value));
+    }
+    else
+    {
+      acc->integral += s1->value * secs;
+      acc->min = Min(acc->min, s1->value);
+      acc->max = Max(acc->max, s1->value);
+    }
+  }
+  else
+  {
+    /* The integral of the speed is the length */
+    double length = window_point_dist(&s1->point, &s2->point);
+    double speed = length / secs;
+    acc->length += length;
+    acc->integral += length;
+    acc->min = Min(acc->min, speed);
+    acc->max = Max(acc->max, speed);
+  }
+  if (op->dist >= 0)
+  {
+    if (! *inside && window_segm_dist(op, s1, s2) <= op->dist)
+      acc->events++;
+    *inside = window_sample_dist(op, op->linear ? s2 : s1) <= op->dist;
+  }
+  return;
+}
+
+/**
+ * Emit the result of a window from its partial aggregate
+ */
+static void
+window_emit(const WindowOp *op, int64 key, const WindowAcc *acc,
+  TimestampTz lower, TimestampTz upper, window_emit_fn emit, void *extra)
+{
+  WindowResult result;
+  result.key = key;
+  result.lower = lower;
+  result.upper = upper;
+  result.tmin = acc->tmin;
+  result.tmax = acc->tmax;
+  result.count = acc->count;
+  result.duration = acc->duration;
+  result.length = acc->length;
+  result.events = acc->events;
+  if (acc->min <= acc->max)
+  {
+    result.min = acc->min;
+    result.max = acc->max;
+  }
+  else
+    /* Temporal point without any segment */
+    result.min = result.max = 0.0;
+  /* A window without duration only contains a single instant */
+  result.twavg = (acc->duration > 0) ? acc->integral / acc->duration :
+    result.min;
+  emit(&result, extra);
+  return;
+}
+
+/*****************************************************************************
+ * Hash table of key states
+ *****************************************************************************/
+
+/**
+ * Return the hash value of the key
+ */
+static uint32
+window_key_hash(int64 key)
+{
+  uint64 x = (uint64) key;
+  x ^= x >> 33;
+  x *= UINT64CONST(0xff51afd7ed558ccd);
+  x ^= x >> 33;
+  x *= UINT64CONST(0xc4ceb9fe1a85ec53);
+  x ^= x >> 33;
+  return (uint32) x;
+}
+
+/**
+ * Return the state of the key, creating it if it does not exist
+ */
+static WindowKeyState *
+window_key_lookup(WindowOp *op, int64 key)
+{
+  uint32 mask = (uint32) op->capacity - 1;
+  uint32 i = window_key_hash(key) & mask;
+  while (op->states[i].used)
+  {
+    if (op->states[i].key == key)
+      return &op->states[i];
+    i = (i + 1) & mask;
+  }
+  if (op->nkeys >= op->maxkeys)
+    ereport(ERROR, (errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+      errmsg("The window operator cannot hold more than %d keys",
+        op->maxkeys)));
+  WindowKeyState *result = &op->states[i];
+  result->key = key;
+  result->used = true;
+  result->haslast = false;
+  result->inside = false;
+  result->cur = 0;
+  for (int j = 0; j < op->npanes; j++)
+    window_acc_init(&result->panes[j]);
+  op->nkeys++;
+  return result;
+}
+
+/**
+ * Remove the state of a key from the hash table
+ *
+ * The entries following the removed one in the same cluster are shifted
+ * back, so that lookups never need tombstones. Each slot keeps owning a
+ * distinct block of panes.
+ */
+static void
+window_key_delete(WindowOp *op, WindowKeyState *state)
+{
+  uint32 mask = (uint32) op->capacity - 1;
+  uint32 i = (uint32) (state - op->states);
+  uint32 j = i;
+  op->states[i].used = false;
+  op->nkeys--;
+  while (true)
+  {
+    j = (j + 1) & mask;
+    if (! op->states[j].used)
+      break;
+    uint32 home = window_key_hash(op->states[j].key) & mask;
+    /* Move the entry unless its home slot is cyclically in (i, j] */
+    bool move = (i < j) ? (home <= i || home > j) : (home <= i && home > j);
+    if (move)
+    {
+      WindowAcc *panes = op->states[i].panes;
+      op->states[i] = op->states[j];
+      op->states[j].panes = panes;
+      op->states[j].used = false;
+      i = j;
+    }
+  }
+  return;
+}
+
+/*****************************************************************************
+ * Windows
+ *****************************************************************************/
+
+/**
+ * Emit the window ending at the timestamp, if it contains data
+ *
+ * @param[in] op Window operator
+ * @param[in] state State of the key
+ * @param[in] end End of the window, which is a multiple of the slide after
+ * the start of the current pane
+ * @param[in] emit,extra Callback receiving the result and its argument
+ */
+static bool
+window_emit_until(const WindowOp *op, const WindowKeyState *state,
+  TimestampTz end, window_emit_fn emit, void *extra)
+{
+  /* Number of slides between the start of the current pane and the end */
+  int m = (int) ((end - state->start) / op->slide);
+  WindowAcc acc;
+  window_acc_init(&acc);
+  for (int j = 0; j <= op->npanes - m; j++)
+    window_acc_combine(&acc,
+      &state->panes[(state->cur - j + op->npanes) % op->npanes]);
+  if (window_acc_empty(&acc))
+    return false;
+  window_emit(op, state->key, &acc, end - op->size, end, emit, extra);
+  return true;
+}
+
+/**
+ * Close the current pane of the key, emit the window ending with it, and
+ * start the next pane
+ */
+static void
+window_pane_close(const WindowOp *op, WindowKeyState *state,
+  window_emit_fn emit, void *extra)
+{
+  TimestampTz end = state->start + op->slide;
+  window_emit_until(op, state, end, emit, extra);
+  state->cur = (state->cur + 1) % op->npanes;
+  window_acc_init(&state->panes[state->cur]);
+  state->start = end;
+  return;
+}
+
+/**
+ * Add a sample to a tumbling or sliding window operator
+ */
+static void
+window_time_add(const WindowOp *op, WindowKeyState *state,
+  const WindowSample *sample, window_emit_fn emit, void *extra)
+{
+  if (! state->haslast)
+  {
+    state->start = timestamptz_bucket(sample->t, op->slide, op->origin);
+    window_acc_instant(op, &state->panes[state->cur], sample, &state->inside);
+    return;
+  }
+  /* The instants more than the size of the windows apart are not
+   * interpolated. Close the panes containing the last instant, which emits
+   * the windows containing it, and then jump to the pane of the sample so
+   * that the windows without data are neither visited nor emitted. */
+  if (sample->t - state->last.t > op->size)
+  {
+    for (int i = 0; i < op->npanes &&
+        sample->t >= state->start + op->slide; i++)
+      window_pane_close(op, state, emit, extra);
+    if (sample->t >= state->start + op->slide)
+      state->start += ((sample->t - state->start) / op->slide) * op->slide;
+    state->inside = false;
+    window_acc_instant(op, &state->panes[state->cur], sample, &state->inside);
+    return;
+  }
+  /* Split the segment from the last sample at the pane boundaries */
+  WindowSample s1 = state->last;
+  while (sample->t >= state->start + op->slide)
+  {
+    WindowSample s2;
+    window_sample_interp(op, &state->last, sample, state->start + op->slide,
+      &s2);
+    window_acc_segment(op, &state->panes[state->cur], &s1, &s2,
+      &state->inside);
+    window_pane_close(op, state, emit, extra);
+    s1 = s2;
+  }
+  window_acc_segment(op, &state->panes[state->cur], &s1, sample,
+    &state->inside);
+  window_acc_instant(op, &state->panes[state->cur], sample, &state->inside);
+  return;
+}
+
+/**
+ * Add a sample to a session window operator
+ */
+static void
+window_session_add(const WindowOp *op, WindowKeyState *state,
+  const WindowSample *sample, window_emit_fn emit, void *extra)
+{
+  WindowAcc *acc = &state->panes[0];
+  if (state->haslast)
+  {
+    if (sample->t - state->last.t > op->size)
+    {
+      window_emit(op, state->key, acc, acc->tmin, acc->tmax, emit, extra);
+      window_acc_init(acc);
+      state->inside = false;
+    }
+    else
+      window_acc_segment(op, acc, &state->last, sample, &state->inside);
+  }
+  window_acc_instant(op, acc, sample, &state->inside);
+  return;
+}
+
+/**
+ * Emit all the windows of the key that contain data
+ */
+static int
+window_key_flush(const WindowOp *op, const WindowKeyState *state,
+  window_emit_fn emit, void *extra)
+{
+  if (op->kind == WINDOW_SESSION)
+  {
+    const WindowAcc *acc = &state->panes[0];
+    window_emit(op, state->key, acc, acc->tmin, acc->tmax, emit, extra);
+    return 1;
+  }
+  int result = 0;
+  for (int m = 1; m <= op->npanes; m++)
+  {
+    if (window_emit_until(op, state, state->start + m * op->slide, emit,
+        extra))
+      result++;
+  }
+  return result;
+}
+
+/*****************************************************************************
+ * Constructors
+ *****************************************************************************/
+
+/**
+ * Construct a window operator
+ */
+static WindowOp *
+window_op_make(WindowKind kind, CachedType temptype, int64 size, int64 slide,
+  TimestampTz origin, int maxkeys)
+{
+  if (temptype != T_TINT && temptype != T_TFLOAT && temptype != T_TGEOMPOINT)
+    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+      errmsg("Window operators only support temporal integers, temporal floats, and temporal geometric points")));
+  if (maxkeys <= 0)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The maximum number of keys must be greater than 0")));
+
+  int npanes = (kind == WINDOW_SLIDING) ? (int) (size / slide) : 1;
+  /* Keep the load factor of the hash table below one half */
+  int capacity = 8;
+  while (capacity < (int64) 2 * maxkeys && capacity < (1 << 30))
+    capacity <<= 1;
+  size_t memsize = (sizeof(WindowKeyState) +
+    sizeof(WindowAcc) * npanes) * capacity;
+  if (capacity < (int64) 2 * maxkeys || ! AllocSizeIsValid(memsize))
+    ereport(ERROR, (errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+      errmsg("The window operator requires too much memory")));
+
+  WindowOp *result = palloc0(sizeof(WindowOp));
+  result->kind = kind;
+  result->temptype = temptype;
+  result->linear = temptype_continuous(temptype);
+  result->size = size;
+  result->slide = slide;
+  result->origin = origin;
+  result->npanes = npanes;
+  result->dist = -1.0;
+  result->maxkeys = maxkeys;
+  result->capacity = capacity;
+  result->states = palloc0(sizeof(WindowKeyState) * capacity);
+  result->panes = palloc(sizeof(WindowAcc) * npanes * capacity);
+  for (int i = 0; i < capacity; i++)
+    result->states[i].panes = &result->panes[i * npanes];
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_stream
+ * @brief Construct a tumbling window operator.
+ *
+ * @param[in] temptype Temporal type of the instants
+ * @param[in] size Size of the windows
+ * @param[in] origin Origin of the windows
+ * @param[in] maxkeys Maximum number of keys with an open window
+ */
+WindowOp *
+tumbling_window_make(CachedType temptype, const Interval *size,
+  TimestampTz origin, int maxkeys)
+{
+  ensure_valid_duration(size);
+  int64 tunits = get_interval_units((Interval *) size);
+  return window_op_make(WINDOW_TUMBLING, temptype, tunits, tunits, origin,
+    maxkeys);
+}
+
+/**
+ * @ingroup libmeos_temporal_stream
+ * @brief Construct a sliding window operator.
+ *
+ * @param[in] temptype Temporal type of the instants
+ * @param[in] size Size of the windows
+ * @param[in] slide Interval between the start of consecutive windows
+ * @param[in] origin Origin of the windows
+ * @param[in] maxkeys Maximum number of keys with an open window
+ * @note The size must be a multiple of the slide
+ */
+WindowOp *
+sliding_window_make(CachedType temptype, const Interval *size,
+  const Interval *slide, TimestampTz origin, int maxkeys)
+{
+  ensure_valid_duration(size);
+  ensure_valid_duration(slide);
+  int64 sizeunits = get_interval_units((Interval *) size);
+  int64 slideunits = get_interval_units((Interval *) slide);
+  if (sizeunits % slideunits != 0)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The size of a sliding window must be a multiple of its slide")));
+  return window_op_make(WINDOW_SLIDING, temptype, sizeunits, slideunits,
+    origin, maxkeys);
+}
+
+/**
+ * @ingroup libmeos_temporal_stream
+ * @brief Construct a session window operator.
+ *
+ * @param[in] temptype Temporal type of the instants
+ * @param[in] gap Maximum interval between consecutive instants of a session
+ * @param[in] maxkeys Maximum number of keys with an open window
+ */
+WindowOp *
+session_window_make(CachedType temptype, const Interval *gap, int maxkeys)
+{
+  ensure_valid_duration(gap);
+  int64 tunits = get_interval_units((Interval *) gap);
+  return window_op_make(WINDOW_SESSION, temptype, tunits, tunits, 0,
+    maxkeys);
+}
+
+/**
+ * @ingroup libmeos_temporal_stream
+ * @brief Count in the results of the window operator the number of times
+ * the values come within a distance of a reference value.
+ *
+ * @param[in] op Window operator
+ * @param[in] value Reference number or point
+ * @param[in] dist Distance
+ */
+void
+window_op_set_dwithin(WindowOp *op, Datum value, double dist)
+{
+  if (dist < 0)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The distance threshold must be greater than or equal to 0")));
+  if (tnumber_type(op->temptype))
+    op->refvalue = datum_double(value, temptype_basetype(op->temptype));
+  else
+  {
+    const GSERIALIZED *gs = (const GSERIALIZED *) DatumGetPointer(value);
+    ensure_point_type(gs);
+    ensure_non_empty(gs);
+    memset(&op->refpoint, 0, sizeof(POINT3DZ));
+    if (gserialized_has_z(gs))
+      op->refpoint = *datum_point3dz_p(value);
+    else
+    {
+      const POINT2D *pt = datum_point2d_p(value);
+      op->refpoint.x = pt->x;
+      op->refpoint.y = pt->y;
+    }
+    op->srid = gserialized_get_srid(gs);
+  }
+  op->dist = dist;
+  return;
+}
+
+/*****************************************************************************
+ * Stream processing
+ *****************************************************************************/
+
+/**
+ * @ingroup libmeos_temporal_stream
+ * @brief Add an instant of a key to the window operator and emit the
+ * windows of the key that are closed by it.
+ *
+ * @param[in] op Window operator
+ * @param[in] key Key of the moving object
+ * @param[in] inst Instant
+ * @param[in] emit,extra Callback receiving the results and its argument
+ * @result False if the instant is discarded because its timestamp is not
+ * after the one of the last instant of the key
+ */
+bool
+window_op_consume(WindowOp *op, int64 key, const TInstant *inst,
+  window_emit_fn emit, void *extra)
+{
+  if (inst->temptype != op->temptype)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The instant must be of the temporal type of the window operator")));
+  if (op->dist >= 0 && op->temptype == T_TGEOMPOINT)
+    ensure_same_srid(tpointinst_srid(inst), op->srid);
+  WindowKeyState *state = window_key_lookup(op, key);
+  if (state->haslast && inst->t <= state->last.t)
+    return false;
+  WindowSample sample;
+  window_sample_set(op, inst, &sample);
+  if (op->kind == WINDOW_SESSION)
+    window_session_add(op, state, &sample, emit, extra);
+  else
+    window_time_add(op, state, &sample, emit, extra);
+  state->last = sample;
+  state->haslast = true;
+  return true;
+}
+
+/**
+ * @ingroup libmeos_temporal_stream
+ * @brief Emit the windows of the keys that are idle at the watermark and
+ * release their state.
+ *
+ * A key is idle when no instant after the watermark can be added to its open
+ * window: its current window or pane ends before the watermark, or, for
+ * session windows, its last instant is more than the gap before the
+ * watermark. An instant of an expired key starts a new trajectory, which is
+ * not interpolated with the previous instants of the key.
+ *
+ * @param[in] op Window operator
+ * @param[in] watermark Timestamp before which no more instants are expected
+ * @param[in] emit,extra Callback receiving the results and its argument
+ * @result Number of windows emitted
+ */
+int
+window_op_expire(WindowOp *op, TimestampTz watermark, window_emit_fn emit,
+  void *extra)
+{
+  int result = 0;
+  int i = 0;
+  while (i < op->capacity)
+  {
+    WindowKeyState *state = &op->states[i];
+    bool idle = state->used && (op->kind == WINDOW_SESSION ?
+      state->last.t + op->size < watermark :
+      state->start + op->slide <= watermark);
+    if (idle)
+    {
+      result += window_key_flush(op, state, emit, extra);
+      window_key_delete(op, state);
+      /* The slot may have received an entry shifted back by the deletion */
+      continue;
+    }
+    i++;
+  }
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_stream
+ * @brief Emit the open windows of all the keys at the end of the stream
+ * and release their state.
+ *
+ * @param[in] op Window operator
+ * @param[in] emit,extra Callback receiving the results and its argument
+ * @result Number of windows emitted
+ */
+int
+window_op_flush(WindowOp *op, window_emit_fn emit, void *extra)
+{
+  return window_op_expire(op, DT_NOEND, emit, extra);
+}
+
+/**
+ * @ingroup libmeos_temporal_stream
+ * @brief Return the memory allocated by the window operator.
+ */
+size_t
+window_op_mem_size(const WindowOp *op)
+{
+  return sizeof(WindowOp) + (sizeof(WindowKeyState) +
+    sizeof(WindowAcc) * op->npanes) * op->capacity;
+}
+
+/**
+ * @ingroup libmeos_temporal_stream
+ * @brief Free the window operator.
+ */
+void
+window_op_free(WindowOp *op)
+{
+  pfree(op->panes);
+  pfree(op->states);
+  pfree(op);
+  return;
+}
+
+/*****************************************************************************/
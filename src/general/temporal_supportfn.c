@@ -42,26 +42,37 @@
 #include <funcapi.h>
 #include <access/htup_details.h>
 #include <access/stratnum.h>
+#include <access/table.h>
 #include <catalog/namespace.h>
+#include <catalog/pg_class.h>
 #include <catalog/pg_opfamily.h>
+#include <catalog/pg_operator.h>
 #include <catalog/pg_type_d.h>
 #include <catalog/pg_am_d.h>
 #include <nodes/supportnodes.h>
 #include <nodes/nodeFuncs.h>
 #include <nodes/makefuncs.h>
+#include <nodes/pathnodes.h>
 #include <optimizer/optimizer.h>
 #include <parser/parse_func.h>
+#include <rewrite/rewriteManip.h>
 #include <utils/array.h>
 #include <utils/builtins.h>
 #include <utils/lsyscache.h>
 #include <utils/numeric.h>
+#include <utils/partcache.h>
+#include <utils/rel.h>
 #include <utils/syscache.h>
 /* MobilityDB */
 #include "general/tempcache.h"
 #include "general/temporal_util.h"
 #include "general/temporal_selfuncs.h"
+#include "general/temporal_tile.h"
 #include "general/tnumber_selfuncs.h"
+#include "point/stbox.h"
 #include "point/tpoint_selfuncs.h"
+#include "point/tpoint_spatialfuncs.h"
+#include "point/tpoint_tile.h"
 #include "npoint/tnpoint_selfuncs.h"
 
 enum TEMPORAL_FUNCTION_IDX
@@ -80,6 +91,8 @@ enum TEMPORAL_FUNCTION_IDX
   INTERSECTS_IDX                 = 8,
   TOUCHES_IDX                    = 9,
   DWITHIN_IDX                    = 10,
+  /* Recurring time pattern functions */
+  INTERSECTS_TIMEOFDAY_IDX       = 11,
 };
 
 static const int16 TemporalStrategies[] =
@@ -89,6 +102,8 @@ static const int16 TemporalStrategies[] =
   [INTERSECTS_TIMESTAMPSET_IDX]  = RTOverlapStrategyNumber,
   [INTERSECTS_PERIOD_IDX]        = RTOverlapStrategyNumber,
   [INTERSECTS_PERIODSET_IDX]     = RTOverlapStrategyNumber,
+  /* Recurring time pattern functions */
+  [INTERSECTS_TIMEOFDAY_IDX]     = RTOverlapStrategyNumber,
 };
 
 static const int16 TNumberStrategies[] =
@@ -101,6 +116,8 @@ static const int16 TNumberStrategies[] =
   /* Ever/always comparison functions */
   [EVER_EQ_IDX]                  = RTOverlapStrategyNumber,
   [ALWAYS_EQ_IDX]                = RTOverlapStrategyNumber,
+  /* Recurring time pattern functions */
+  [INTERSECTS_TIMEOFDAY_IDX]     = RTOverlapStrategyNumber,
 };
 
 static const int16 TPointStrategies[] =
@@ -119,6 +136,8 @@ static const int16 TPointStrategies[] =
   [INTERSECTS_IDX]               = RTOverlapStrategyNumber,
   [TOUCHES_IDX]                  = RTOverlapStrategyNumber,
   [DWITHIN_IDX]                  = RTOverlapStrategyNumber,
+  /* Recurring time pattern functions */
+  [INTERSECTS_TIMEOFDAY_IDX]     = RTOverlapStrategyNumber,
 };
 
 static const int16 TNPointStrategies[] =
@@ -134,6 +153,8 @@ static const int16 TNPointStrategies[] =
   [INTERSECTS_IDX]               = RTOverlapStrategyNumber,
   [TOUCHES_IDX]                  = RTOverlapStrategyNumber,
   [DWITHIN_IDX]                  = RTOverlapStrategyNumber,
+  /* Recurring time pattern functions */
+  [INTERSECTS_TIMEOFDAY_IDX]     = RTOverlapStrategyNumber,
 };
 
 /*
@@ -148,6 +169,7 @@ static const IndexableFunction TemporalIndexableFunctions[] =
   {"intersectstimestampset", INTERSECTS_TIMESTAMPSET_IDX, 2, 0},
   {"intersectsperiod", INTERSECTS_PERIOD_IDX, 2, 0},
   {"intersectsperiodset", INTERSECTS_PERIODSET_IDX, 2, 0},
+  {"intersectstimeofday", INTERSECTS_TIMEOFDAY_IDX, 2, 0},
   {NULL, 0, 0, 0}
 };
 
@@ -157,6 +179,7 @@ static const IndexableFunction TNumberIndexableFunctions[] = {
   {"intersectstimestampset", INTERSECTS_TIMESTAMPSET_IDX, 2, 0},
   {"intersectsperiod", INTERSECTS_PERIOD_IDX, 2, 0},
   {"intersectsperiodset", INTERSECTS_PERIODSET_IDX, 2, 0},
+  {"intersectstimeofday", INTERSECTS_TIMEOFDAY_IDX, 2, 0},
   /* Ever/always comparison functions */
   {"ever_eq", EVER_EQ_IDX, 2, 0},
   {"always_eq", ALWAYS_EQ_IDX, 2, 0},
@@ -172,6 +195,7 @@ static const IndexableFunction TPointIndexableFunctions[] = {
   {"intersectstimestampset", INTERSECTS_TIMESTAMPSET_IDX, 2, 0},
   {"intersectsperiod", INTERSECTS_PERIOD_IDX, 2, 0},
   {"intersectsperiodset", INTERSECTS_PERIODSET_IDX, 2, 0},
+  {"intersectstimeofday", INTERSECTS_TIMEOFDAY_IDX, 2, 0},
   /* Ever spatial relationships */
   {"contains", CONTAINS_IDX, 2, 0},
   {"disjoint", DISJOINT_IDX, 2, 0},
@@ -187,6 +211,7 @@ static const IndexableFunction TNPointIndexableFunctions[] = {
   {"intersectstimestampset", INTERSECTS_TIMESTAMPSET_IDX, 2, 0},
   {"intersectsperiod", INTERSECTS_PERIOD_IDX, 2, 0},
   {"intersectsperiodset", INTERSECTS_PERIODSET_IDX, 2, 0},
+  {"intersectstimeofday", INTERSECTS_TIMEOFDAY_IDX, 2, 0},
   /* Ever spatial relationships */
   {"contains", CONTAINS_IDX, 2, 0},
   {"disjoint", DISJOINT_IDX, 2, 0},
@@ -295,6 +320,247 @@ makeExpandExpr(Node *arg, Node *radiusarg, Oid argoid, Oid retoid,
     InvalidOid, InvalidOid, COERCE_EXPLICIT_CALL);
 }
 
+/*****************************************************************************
+ * Partition pruning
+ *****************************************************************************/
+
+/**
+ * Return the Oid of a partition key function of temporal points in the
+ * namespace of the calling function
+ */
+static Oid
+tpoint_partition_funcoid(Oid callingfunc, const char *funcname, int nargs,
+  const Oid *argtypes)
+{
+  char *nspname = get_namespace_name(get_func_namespace(callingfunc));
+  List *nspfunc = list_make2(makeString(nspname),
+    makeString(pstrdup(funcname)));
+  return LookupFuncName(nspfunc, nargs, argtypes, true);
+}
+
+/**
+ * Return a copy of the partition key expression of the relation if it is
+ * one of the partition key functions of temporal points applied to the
+ * attribute with constant grid parameters, or NULL otherwise
+ *
+ * @param[in] relid Oid of the relation
+ * @param[in] attnum Number of the attribute
+ * @param[in] callingfunc Oid of the function whose support function is
+ * called, whose namespace is the one of the partition key functions
+ */
+static FuncExpr *
+tpoint_partition_expr(Oid relid, AttrNumber attnum, Oid callingfunc)
+{
+  Oid spaceargs[] = {type_oid(T_TGEOMPOINT), FLOAT8OID,
+    type_oid(T_GEOMETRY)};
+  Oid spacetimeargs[] = {type_oid(T_TGEOMPOINT), FLOAT8OID, INTERVALOID,
+    type_oid(T_GEOMETRY), TIMESTAMPTZOID};
+  Oid spacefunc = tpoint_partition_funcoid(callingfunc, "spacepartitionkey",
+    3, spaceargs);
+  Oid spacetimefunc = tpoint_partition_funcoid(callingfunc,
+    "spacetimepartitionkey", 5, spacetimeargs);
+
+  FuncExpr *result = NULL;
+  Relation rel = table_open(relid, NoLock);
+  PartitionKey partkey = RelationGetPartitionKey(rel);
+  ListCell *lc;
+  foreach (lc, get_partition_exprs(partkey))
+  {
+    Node *expr = (Node *) lfirst(lc);
+    if (! IsA(expr, FuncExpr))
+      continue;
+    FuncExpr *funcexpr = (FuncExpr *) expr;
+    if (funcexpr->funcid != spacefunc && funcexpr->funcid != spacetimefunc)
+      continue;
+    int nargs = list_length(funcexpr->args);
+    Node *arg = linitial(funcexpr->args);
+    if (! IsA(arg, Var) || ((Var *) arg)->varattno != attnum)
+      continue;
+    /* The grid parameters must be constant */
+    bool isconst = true;
+    for (int i = 1; i < nargs; i++)
+    {
+      Node *param = (Node *) list_nth(funcexpr->args, i);
+      if (! IsA(param, Const) || ((Const *) param)->constisnull)
+        isconst = false;
+    }
+    if (isconst)
+    {
+      result = copyObject(funcexpr);
+      break;
+    }
+  }
+  table_close(rel, NoLock);
+  return result;
+}
+
+/**
+ * Return the partition keys that may contain a temporal point overlapping the
+ * box given the grid parameters of the partition key expression, or NULL if
+ * the partitions cannot be pruned
+ */
+static ArrayType *
+tpoint_partition_keys(const FuncExpr *keyexpr, const STBOX *box)
+{
+  List *args = keyexpr->args;
+  double size = DatumGetFloat8(((Const *) lsecond(args))->constvalue);
+  int64 tunits = 0;
+  TimestampTz torigin = 0;
+  GSERIALIZED *gs;
+  if (list_length(args) == 3)
+    gs = (GSERIALIZED *) PG_DETOAST_DATUM(((Const *) lthird(args))->constvalue);
+  else /* list_length(args) == 5 */
+  {
+    Interval *duration = DatumGetIntervalP(
+      ((Const *) lthird(args))->constvalue);
+    if (duration->month != 0)
+      return NULL;
+    tunits = get_interval_units(duration);
+    if (tunits <= 0)
+      return NULL;
+    gs = (GSERIALIZED *) PG_DETOAST_DATUM(((Const *) lfourth(args))->constvalue);
+    torigin = DatumGetTimestampTz(((Const *) list_nth(args, 4))->constvalue);
+  }
+  if (size <= 0 || gserialized_is_empty(gs) ||
+      ! MOBDB_FLAGS_GET_X(box->flags) ||
+      (tunits && ! MOBDB_FLAGS_GET_T(box->flags)))
+    return NULL;
+  POINT3DZ sorigin;
+  memset(&sorigin, 0, sizeof(POINT3DZ));
+  const POINT2D *p2d = gserialized_point2d_p(gs);
+  sorigin.x = p2d->x;
+  sorigin.y = p2d->y;
+  int count;
+  int64 *keys = stbox_partition_keys(box, size, tunits, &sorigin, torigin,
+    MAX_PARTITION_KEYS, &count);
+  if (keys == NULL)
+    return NULL;
+  ArrayType *result = int64arr_to_array(keys, count);
+  pfree(keys);
+  return result;
+}
+
+/**
+ * Return the Oid of the bounding box operator between the types whose
+ * function is the given one, or InvalidOid if the function is not one of the
+ * overlaps, contains, or contained bounding box functions.
+ *
+ * @note These are the only operators between a temporal point and a box that
+ * imply the overlap of the boxes and thus the partition pruning predicate
+ */
+static Oid
+tpoint_partition_oper(Oid funcid, CachedType ltype, CachedType rtype)
+{
+  static const CachedOp ops[] = {OVERLAPS_OP, CONTAINS_OP, CONTAINED_OP};
+  for (int i = 0; i < (int) (sizeof(ops) / sizeof(CachedOp)); i++)
+  {
+    Oid operid = oper_oid(ops[i], ltype, rtype);
+    if (operid != InvalidOid && get_opcode(operid) == funcid)
+      return operid;
+  }
+  return InvalidOid;
+}
+
+/**
+ * Add to a bounding box operator between a temporal point of a partitioned
+ * table and a constant box or geometry the predicate on the partition key
+ * enabling partition pruning.
+ *
+ * If the table is partitioned on spacePartitionKey(tpoint, ...) or
+ * spaceTimePartitionKey(tpoint, ...) the expression
+ * @code
+ * trip && box
+ * @endcode
+ * becomes
+ * @code
+ * trip && box AND spaceTimePartitionKey(trip, ...) = ANY(keys)
+ * @endcode
+ * where keys are the partition keys of the cells that may contain a row
+ * overlapping the box. The operators @> and <@ between a temporal point and
+ * a box imply the overlap and are handled in the same way.
+ */
+static Node *
+tpoint_partition_simplify(SupportRequestSimplify *req)
+{
+  FuncExpr *fcall = req->fcall;
+  if (req->root == NULL || list_length(fcall->args) != 2)
+    return NULL;
+
+  Node *leftarg = linitial(fcall->args);
+  Node *rightarg = lsecond(fcall->args);
+  Var *var;
+  Const *cnst;
+  if (IsA(leftarg, Var) && IsA(rightarg, Const))
+  {
+    var = (Var *) leftarg;
+    cnst = (Const *) rightarg;
+  }
+  else if (IsA(leftarg, Const) && IsA(rightarg, Var))
+  {
+    cnst = (Const *) leftarg;
+    var = (Var *) rightarg;
+  }
+  else
+    return NULL;
+  if (var->varlevelsup != 0 || var->vartype != type_oid(T_TGEOMPOINT) ||
+      cnst->constisnull ||
+      (cnst->consttype != type_oid(T_STBOX) &&
+       cnst->consttype != type_oid(T_GEOMETRY)))
+    return NULL;
+
+  /* Only the bounding box functions implying the overlap of the boxes */
+  Oid operid = tpoint_partition_oper(fcall->funcid,
+    oid_type(exprType(leftarg)), oid_type(exprType(rightarg)));
+  if (operid == InvalidOid)
+    return NULL;
+
+  /* Only partitioned tables with a partition key on the attribute */
+  RangeTblEntry *rte = planner_rt_fetch(var->varno, req->root);
+  if (rte->rtekind != RTE_RELATION ||
+      rte->relkind != RELKIND_PARTITIONED_TABLE)
+    return NULL;
+  FuncExpr *keyexpr = tpoint_partition_expr(rte->relid, var->varattno,
+    fcall->funcid);
+  if (keyexpr == NULL)
+    return NULL;
+
+  /* Get the box of the constant */
+  STBOX box;
+  memset(&box, 0, sizeof(STBOX));
+  if (cnst->consttype == type_oid(T_STBOX))
+    memcpy(&box, DatumGetSTboxP(cnst->constvalue), sizeof(STBOX));
+  else /* cnst->consttype == type_oid(T_GEOMETRY) */
+  {
+    GSERIALIZED *gs = (GSERIALIZED *) PG_DETOAST_DATUM(cnst->constvalue);
+    if (! geo_stbox(gs, &box))
+      return NULL;
+  }
+  ArrayType *keys = tpoint_partition_keys(keyexpr, &box);
+  if (keys == NULL)
+    return NULL;
+
+  /* The partition key expression of the relation refers to varno 1 */
+  ChangeVarNodes((Node *) keyexpr, 1, var->varno, 0);
+  ScalarArrayOpExpr *saop = makeNode(ScalarArrayOpExpr);
+  saop->opno = Int8EqualOperator;
+  saop->opfuncid = get_opcode(Int8EqualOperator);
+  saop->useOr = true;
+  saop->inputcollid = InvalidOid;
+  saop->args = list_make2(keyexpr, makeConst(INT8ARRAYOID, -1, InvalidOid,
+    -1, PointerGetDatum(keys), false, false));
+  saop->location = -1;
+
+  /*
+   * Rebuild the operator implemented by the function so that an index on the
+   * temporal point may still be used. The result is not simplified again by
+   * the planner and thus the predicate is only added once.
+   */
+  OpExpr *opexpr = (OpExpr *) make_opclause(operid, BOOLOID, false,
+    (Expr *) leftarg, (Expr *) rightarg, InvalidOid, InvalidOid);
+  opexpr->opfuncid = fcall->funcid;
+  return (Node *) make_andclause(list_make2(opexpr, saop));
+}
+
 /*****************************************************************************/
 
 /**
@@ -350,6 +616,14 @@ temporal_supportfn_ext(FunctionCallInfo fcinfo, TemporalFamily tempfamily)
     PG_RETURN_POINTER(req);
   }
 
+  /* Add the partition pruning predicates */
+  if (IsA(rawreq, SupportRequestSimplify) && tempfamily == TPOINTTYPE)
+  {
+    SupportRequestSimplify *req = (SupportRequestSimplify *) rawreq;
+    ret = tpoint_partition_simplify(req);
+    PG_RETURN_POINTER(ret);
+  }
+
   /* Add index support */
   if (IsA(rawreq, SupportRequestIndexCondition))
   {
@@ -398,12 +672,12 @@ temporal_supportfn_ext(FunctionCallInfo fcinfo, TemporalFamily tempfamily)
         funcarr = TNPointIndexableFunctions;
       if (! func_needs_index(funcoid, funcarr, &idxfn))
       {
-        if (isfunc)
-          elog(WARNING, "support function called from unsupported function %d",
-            funcoid);
-        else
-          elog(WARNING, "support function called from unsupported operator %d",
-            operid);
+        /* The bounding box operators are bound to the support function
+         * only for partition pruning */
+        if (isbinop)
+          PG_RETURN_POINTER((Node *) NULL);
+        elog(WARNING, "support function called from unsupported function %d",
+          funcoid);
       }
 
       /*
@@ -464,9 +738,16 @@ temporal_supportfn_ext(FunctionCallInfo fcinfo, TemporalFamily tempfamily)
         PG_RETURN_POINTER((Node *) NULL);
 
       /* Determine type of right argument of the index support expression
-       * depending on whether there is an expand function */
+       * depending on whether there is an expand function. The recurring
+       * time pattern functions only use their period argument, so that
+       * intersectsTimeOfDay(temp, p, ...) yields: temp && p */
       exproid = rightoid;
-      if (idxfn.expand_arg &&
+      if (idxfn.index == INTERSECTS_TIMEOFDAY_IDX)
+      {
+        if (req->indexarg != 0)
+          PG_RETURN_POINTER((Node *) NULL);
+      }
+      else if (idxfn.expand_arg &&
           (righttype == T_GEOMETRY || righttype == T_GEOGRAPHY ||
            righttype == T_STBOX || righttype == T_TGEOMPOINT ||
            righttype == T_TGEOGPOINT || righttype == T_TNPOINT))
@@ -665,7 +665,7 @@ tinstantset_time_split(const TInstantSet *ti, TimestampTz start,
       if (k > 0)
       {
         times[l] = lower;
-        result[l++] = tinstantset_make(instants, k, MERGE_NO);
+        result[l++] = tinstantset_make_trusted(instants, k);
         k = 0;
       }
       lower = upper;
@@ -675,7 +675,7 @@ tinstantset_time_split(const TInstantSet *ti, TimestampTz start,
   if (k > 0)
   {
     times[l] = lower;
-    result[l++] = tinstantset_make(instants, k, MERGE_NO);
+    result[l++] = tinstantset_make_trusted(instants, k);
   }
   pfree(instants);
   *buckets = times;
@@ -751,7 +751,7 @@ tsequence_time_split1(const TSequence *seq, TimestampTz start, TimestampTz end,
       }
       lower_inc1 = (m == 0) ? seq->period.lower_inc : true;
       times[m] = lower;
-      result[m++] = tsequence_make(instants, k, lower_inc1,
+      result[m++] = tsequence_make_trusted(instants, k, lower_inc1,
          (k > 1) ? false : true, linear, NORMALIZE);
       k = 0;
       lower = upper;
@@ -769,7 +769,7 @@ tsequence_time_split1(const TSequence *seq, TimestampTz start, TimestampTz end,
   {
     lower_inc1 = (m == 0) ? seq->period.lower_inc : true;
     times[m] = lower;
-    result[m++] = tsequence_make(instants, k, lower_inc1,
+    result[m++] = tsequence_make_trusted(instants, k, lower_inc1,
       seq->period.upper_inc, linear, NORMALIZE);
   }
   pfree_array((void **) tofree, l);
@@ -848,7 +848,7 @@ tsequenceset_time_split(const TSequenceSet *ts, TimestampTz start, TimestampTz e
      * if the current sequence starts on the next time bucket */
     if (k > 0 && seq->period.lower >= upper)
     {
-      result[m++] = tsequenceset_make((const TSequence **) fragments, k,
+      result[m++] = tsequenceset_make_trusted((const TSequence **) fragments, k,
         NORMALIZE);
       for (int j = 0; j < k; j++)
         pfree(fragments[j]);
@@ -866,8 +866,8 @@ tsequenceset_time_split(const TSequenceSet *ts, TimestampTz start, TimestampTz e
       if (k > 0)
       {
         fragments[k++] = sequences[0];
-        result[m++] = tsequenceset_make((const TSequence **) fragments, k,
-          NORMALIZE);
+        result[m++] = tsequenceset_make_trusted((const TSequence **) fragments,
+          k, NORMALIZE);
         for (int j = 0; j < k; j++)
           pfree(fragments[j]);
         k = 0;
@@ -891,7 +891,7 @@ tsequenceset_time_split(const TSequenceSet *ts, TimestampTz start, TimestampTz e
   /* Process the accumulated fragments of the last time bucket */
   if (k > 0)
   {
-    result[m++] = tsequenceset_make((const TSequence **) fragments, k,
+    result[m++] = tsequenceset_make_trusted((const TSequence **) fragments, k,
       NORMALIZE);
     for (int j = 0; j < k; j++)
       pfree(fragments[j]);
@@ -1358,7 +1358,8 @@ tnumberinstset_value_split(const TInstantSet *ti, Datum start_bucket, Datum size
   {
     if (numinsts[i] > 0)
     {
-      result[k] = tinstantset_make(&instants[i * ti->count], numinsts[i], MERGE_NO);
+      result[k] = tinstantset_make_trusted(&instants[i * ti->count],
+        numinsts[i]);
       values[k++] = bucket_value;
     }
     bucket_value = datum_add(bucket_value, size, basetype, basetype);
@@ -1425,7 +1426,7 @@ tnumberseq_step_value_split(TSequence **result, int *numseqs, int numcols,
       tofree[l++] = bounds[1] = tinstant_make(value, inst2->t, seq->temptype);
       k++;
     }
-    result[bucket_no * numcols + seq_no] = tsequence_make((const TInstant **) bounds,
+    result[bucket_no * numcols + seq_no] = tsequence_make_trusted((const TInstant **) bounds,
       k, lower_inc1, false, STEP, NORMALIZE);
     bounds[0] = bounds[1];
     inst1 = inst2;
@@ -1439,7 +1440,7 @@ tnumberseq_step_value_split(TSequence **result, int *numseqs, int numcols,
     bucket_value = number_bucket(value, size, start_bucket, basetype);
     bucket_no = bucket_position(bucket_value, size, start_bucket, basetype);
     seq_no = numseqs[bucket_no]++;
-    result[bucket_no * numcols + seq_no] = tsequence_make(&inst1, 1,
+    result[bucket_no * numcols + seq_no] = tsequence_make_trusted(&inst1, 1,
       true, true, STEP, NORMALIZE);
   }
   pfree_array((void **) tofree, l);
@@ -1581,7 +1582,7 @@ tnumberseq_linear_value_split(TSequence **result, int *numseqs, int numcols,
       if (k == 1 && ! upper_inc1)
         break;
       seq_no = numseqs[j]++;
-      result[j * numcols + seq_no] = tsequence_make((const TInstant **) bounds,
+      result[j * numcols + seq_no] = tsequence_make_trusted((const TInstant **) bounds,
         k, (k > 1) ? lower_inc1 : true, (k > 1) ? upper_inc1 : true,
         LINEAR, NORMALIZE_NO);
       bounds[first] = bounds[last];
@@ -1647,7 +1648,7 @@ tnumberseq_value_split(const TSequence *seq, Datum start_bucket, Datum size,
   {
     if (numseqs[i] > 0)
     {
-      result[k] = tsequenceset_make((const TSequence **)(&sequences[seq->count * i]),
+      result[k] = tsequenceset_make_trusted((const TSequence **)(&sequences[seq->count * i]),
         numseqs[i], NORMALIZE);
       values[k++] = bucket_value;
     }
@@ -1704,7 +1705,7 @@ tnumberseqset_value_split(const TSequenceSet *ts, Datum start_bucket, Datum size
   {
     if (numseqs[i] > 0)
     {
-      result[k] = tsequenceset_make((const TSequence **)(&bucketseqs[i * ts->totalcount]),
+      result[k] = tsequenceset_make_trusted((const TSequence **)(&bucketseqs[i * ts->totalcount]),
         numseqs[i], NORMALIZE);
       values[k++] = bucket_value;
     }
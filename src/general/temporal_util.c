@@ -1508,6 +1508,18 @@ timestamparr_to_array(const TimestampTz *times, int count)
   return result;
 }
 
+/**
+ * Convert a C array of 64-bit integers into a PostgreSQL array
+ */
+ArrayType *
+int64arr_to_array(const int64 *values, int count)
+{
+  assert(count > 0);
+  ArrayType *result = construct_array((Datum *) values, count, INT8OID,
+    8, true, 'd');
+  return result;
+}
+
 /**
  * Convert a C array of periods into a PostgreSQL array
  */
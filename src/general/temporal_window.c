@@ -0,0 +1,916 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file temporal_window.c
+ * Reductions of temporal values over time windows computed without
+ * restricting the temporal values to the windows.
+ *
+ * The minimum and maximum values, the time-weighted average, the integral,
+ * the duration, and the length of a temporal value over a period are
+ * obtained by locating the bounds of the period with a binary search and
+ * interpolating the temporal value only at these bounds. The instants
+ * strictly inside the period are read in place. When many windows are
+ * queried over the same value, the segment measures are accumulated once
+ * into prefix sums and the extent of the values into sparse tables, so that
+ * each window costs two binary searches and a constant number of lookups.
+ */
+
+#include "general/temporal_window.h"
+
+/* PostgreSQL */
+#include <postgres.h>
+#include <assert.h>
+#include <float.h>
+#include <funcapi.h>
+#if POSTGRESQL_VERSION_NUMBER < 120000
+#include <access/htup_details.h>
+#endif
+/* MobilityDB */
+#include "general/tempcache.h"
+#include "general/temporaltypes.h"
+#include "general/temporal_util.h"
+#include "general/time_ops.h"
+#include "point/tpoint_spatialfuncs.h"
+
+/*****************************************************************************
+ * Measures of the segments
+ *****************************************************************************/
+
+/**
+ * Function computing the measure of a segment between two timestamps
+ */
+typedef double (*twindow_measure_fn)(const TInstant *, const TInstant *, bool,
+  TimestampTz, TimestampTz);
+
+/**
+ * Return the value of a segment of a temporal number at a timestamp as a
+ * double.
+ *
+ * @param[in] inst1,inst2 Temporal instants defining the segment
+ * @param[in] linear True when the segment has linear interpolation
+ * @param[in] t Timestamp
+ * @pre The timestamp t satisfies inst1->t <= t <= inst2->t
+ * @note The interpolation is the same as in function
+ * tsegment_value_at_timestamp so that the values at the bounds of a window
+ * are those obtained by restricting the temporal number to the window
+ */
+static double
+tnumberseg_double_at_timestamp(const TInstant *inst1, const TInstant *inst2,
+  bool linear, TimestampTz t)
+{
+  double value1 = tnumberinst_double(inst1);
+  if (inst1->t == t || (! linear && t < inst2->t))
+    return value1;
+  double value2 = tnumberinst_double(inst2);
+  if (inst2->t == t || value1 == value2)
+    return value2;
+  long double duration1 = (long double) (t - inst1->t);
+  long double duration2 = (long double) (inst2->t - inst1->t);
+  long double ratio = duration1 / duration2;
+  return value1 + (double) ((long double)(value2 - value1) * ratio);
+}
+
+/**
+ * Return the integral of a segment of a temporal number between two
+ * timestamps.
+ *
+ * @pre The timestamps satisfy inst1->t <= t1 <= t2 <= inst2->t
+ */
+static double
+tnumberseg_integral(const TInstant *inst1, const TInstant *inst2, bool linear,
+  TimestampTz t1, TimestampTz t2)
+{
+  double value1 = tnumberseg_double_at_timestamp(inst1, inst2, linear, t1);
+  if (! linear)
+    return value1 * (double) (t2 - t1);
+  double value2 = tnumberseg_double_at_timestamp(inst1, inst2, linear, t2);
+  return (Max(value1, value2) + Min(value1, value2)) * (double) (t2 - t1) /
+    2.0;
+}
+
+/**
+ * Return the length traversed by a segment of a temporal point between two
+ * timestamps.
+ *
+ * @pre The timestamps satisfy inst1->t <= t1 <= t2 <= inst2->t
+ */
+static double
+tpointseg_length(const TInstant *inst1, const TInstant *inst2, bool linear,
+  TimestampTz t1, TimestampTz t2)
+{
+  if (! linear || t1 == t2)
+    return 0.0;
+  Datum value1 = (t1 == inst1->t) ? tinstant_value(inst1) :
+    tsegment_value_at_timestamp(inst1, inst2, linear, t1);
+  Datum value2 = (t2 == inst2->t) ? tinstant_value(inst2) :
+    tsegment_value_at_timestamp(inst1, inst2, linear, t2);
+  double result = datum_point_eq(value1, value2) ? 0.0 :
+    DatumGetFloat8(pt_distance_fn(inst1->flags)(value1, value2));
+  if (t1 != inst1->t)
+    pfree(DatumGetPointer(value1));
+  if (t2 != inst2->t)
+    pfree(DatumGetPointer(value2));
+  return result;
+}
+
+/*****************************************************************************
+ * Per-value structures for repeated windows
+ *****************************************************************************/
+
+/**
+ * Return the n-th sequence of a temporal sequence (set) value
+ */
+static const TSequence *
+twindow_seq_n(const Temporal *temp, int n)
+{
+  if (temp->subtype == SEQUENCE)
+    return (const TSequence *) temp;
+  return tsequenceset_seq_n((const TSequenceSet *) temp, n);
+}
+
+/**
+ * Compute the minimum and the maximum of an array of values between two
+ * positions
+ */
+static void
+twindow_values_extent(const double *values, int from, int to, double *min,
+  double *max)
+{
+  for (int i = from; i <= to; i++)
+  {
+    if (values[i] < *min)
+      *min = values[i];
+    if (values[i] > *max)
+      *max = values[i];
+  }
+  return;
+}
+
+/**
+ * Compute the minimum and the maximum of the values of the instants between
+ * two positions using the sparse tables.
+ *
+ * The blocks at both ends that are only partially covered are scanned while
+ * the blocks in between are covered by two overlapping entries of the
+ * sparse tables.
+ */
+static void
+twindow_index_extent(const TWindowIndex *idx, int from, int to, double *min,
+  double *max)
+{
+  *min = DBL_MAX;
+  *max = -DBL_MAX;
+  int block1 = from / TWINDOW_BLOCK_SIZE;
+  int block2 = to / TWINDOW_BLOCK_SIZE;
+  if (block2 - block1 <= 1)
+  {
+    twindow_values_extent(idx->values, from, to, min, max);
+    return;
+  }
+  twindow_values_extent(idx->values, from,
+    (block1 + 1) * TWINDOW_BLOCK_SIZE - 1, min, max);
+  twindow_values_extent(idx->values, block2 * TWINDOW_BLOCK_SIZE, to,
+    min, max);
+  int first = block1 + 1;
+  int level = 0;
+  while ((2 << level) <= block2 - first)
+    level++;
+  int second = block2 - (1 << level);
+  const double *mins = idx->mintable + level * idx->numblocks;
+  const double *maxs = idx->maxtable + level * idx->numblocks;
+  *min = Min(*min, Min(mins[first], mins[second]));
+  *max = Max(*max, Max(maxs[first], maxs[second]));
+  return;
+}
+
+/**
+ * @ingroup libmeos_temporal_agg
+ * @brief Build the per-value structures used for answering repeated window
+ * queries over the temporal value.
+ *
+ * @return NULL for temporal instant (set) values, which are always scanned
+ */
+TWindowIndex *
+temporal_window_index(const Temporal *temp)
+{
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT || temp->subtype == INSTANTSET)
+    return NULL;
+
+  bool extent = tnumber_type(temp->temptype);
+  twindow_measure_fn func = extent ? &tnumberseg_integral : &tpointseg_length;
+  TWindowIndex *idx = palloc(sizeof(TWindowIndex));
+  idx->numseqs = (temp->subtype == SEQUENCE) ? 1 :
+    ((const TSequenceSet *) temp)->count;
+  idx->count = 0;
+  for (int s = 0; s < idx->numseqs; s++)
+    idx->count += twindow_seq_n(temp, s)->count;
+  idx->offset = palloc(sizeof(int) * (idx->numseqs + 1));
+  idx->measure = palloc(sizeof(double) * idx->count);
+  idx->days = palloc(sizeof(int64) * (idx->numseqs + 1));
+  idx->time = palloc(sizeof(int64) * (idx->numseqs + 1));
+  idx->instsum = palloc(sizeof(double) * (idx->numseqs + 1));
+  idx->instcount = palloc(sizeof(int) * (idx->numseqs + 1));
+  idx->values = extent ? palloc(sizeof(double) * idx->count) : NULL;
+
+  /* Prefix sums of the measures, the durations, and the instantaneous
+   * sequences */
+  double measure = 0.0;
+  int k = 0;
+  idx->days[0] = idx->time[0] = 0;
+  idx->instsum[0] = 0.0;
+  idx->instcount[0] = 0;
+  for (int s = 0; s < idx->numseqs; s++)
+  {
+    const TSequence *seq = twindow_seq_n(temp, s);
+    bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags);
+    int64 usecs = seq->period.upper - seq->period.lower;
+    idx->offset[s] = k;
+    idx->days[s + 1] = idx->days[s] + usecs / USECS_PER_DAY;
+    idx->time[s + 1] = idx->time[s] + usecs % USECS_PER_DAY;
+    idx->instsum[s + 1] = idx->instsum[s];
+    idx->instcount[s + 1] = idx->instcount[s];
+    if (usecs == 0)
+    {
+      if (extent)
+        idx->instsum[s + 1] += tnumberinst_double(tsequence_inst_n(seq, 0));
+      idx->instcount[s + 1]++;
+    }
+    const TInstant *inst1 = NULL;
+    for (int i = 0; i < seq->count; i++)
+    {
+      const TInstant *inst2 = tsequence_inst_n(seq, i);
+      if (inst1)
+        measure += func(inst1, inst2, linear, inst1->t, inst2->t);
+      idx->measure[k] = measure;
+      if (extent)
+        idx->values[k] = tnumberinst_double(inst2);
+      inst1 = inst2;
+      k++;
+    }
+  }
+  idx->offset[idx->numseqs] = k;
+
+  /* Sparse tables of the extent of the values of the blocks */
+  idx->numblocks = idx->levels = 0;
+  idx->mintable = idx->maxtable = NULL;
+  if (! extent)
+    return idx;
+  idx->numblocks = (idx->count + TWINDOW_BLOCK_SIZE - 1) / TWINDOW_BLOCK_SIZE;
+  idx->levels = 1;
+  while ((1 << idx->levels) <= idx->numblocks)
+    idx->levels++;
+  idx->mintable = palloc(sizeof(double) * idx->levels * idx->numblocks);
+  idx->maxtable = palloc(sizeof(double) * idx->levels * idx->numblocks);
+  for (int b = 0; b < idx->numblocks; b++)
+  {
+    idx->mintable[b] = DBL_MAX;
+    idx->maxtable[b] = -DBL_MAX;
+    twindow_values_extent(idx->values, b * TWINDOW_BLOCK_SIZE,
+      Min((b + 1) * TWINDOW_BLOCK_SIZE, idx->count) - 1,
+      &idx->mintable[b], &idx->maxtable[b]);
+  }
+  for (int l = 1; l < idx->levels; l++)
+  {
+    const double *prevmin = idx->mintable + (l - 1) * idx->numblocks;
+    const double *prevmax = idx->maxtable + (l - 1) * idx->numblocks;
+    double *mins = idx->mintable + l * idx->numblocks;
+    double *maxs = idx->maxtable + l * idx->numblocks;
+    int half = 1 << (l - 1);
+    for (int b = 0; b + (1 << l) <= idx->numblocks; b++)
+    {
+      mins[b] = Min(prevmin[b], prevmin[b + half]);
+      maxs[b] = Max(prevmax[b], prevmax[b + half]);
+    }
+  }
+  return idx;
+}
+
+/**
+ * @ingroup libmeos_temporal_agg
+ * @brief Free the per-value structures used for answering repeated window
+ * queries.
+ */
+void
+twindow_index_free(TWindowIndex *idx)
+{
+  pfree(idx->offset);
+  pfree(idx->measure);
+  pfree(idx->days);
+  pfree(idx->time);
+  pfree(idx->instsum);
+  pfree(idx->instcount);
+  if (idx->values)
+  {
+    pfree(idx->values);
+    pfree(idx->mintable);
+    pfree(idx->maxtable);
+  }
+  pfree(idx);
+  return;
+}
+
+/*****************************************************************************
+ * Reduction of a temporal value over a window
+ *****************************************************************************/
+
+/**
+ * Structure to accumulate the reduction of a temporal value over a window
+ */
+typedef struct
+{
+  bool found;            /**< the window intersects the temporal value */
+  bool extent;           /**< compute the values of the temporal number */
+  double minvalue;       /**< minimum value */
+  double maxvalue;       /**< maximum value */
+  double measure;        /**< integral or length */
+  int64 usecs;           /**< duration in microseconds */
+  Interval duration;     /**< duration as a sum of the durations of the
+                              intersections with the sequences */
+  double instsum;        /**< sum of the values of the instantaneous
+                              intersections */
+  int instcount;         /**< number of instantaneous intersections */
+} TWindowState;
+
+/**
+ * Initialize the state of a reduction over a window
+ */
+static void
+twindow_state_init(TWindowState *state, bool extent)
+{
+  memset(state, 0, sizeof(TWindowState));
+  state->extent = extent;
+  state->minvalue = DBL_MAX;
+  state->maxvalue = -DBL_MAX;
+  return;
+}
+
+/**
+ * Add a value to the extent of the state
+ */
+static void
+twindow_state_value(TWindowState *state, double value)
+{
+  if (value < state->minvalue)
+    state->minvalue = value;
+  if (value > state->maxvalue)
+    state->maxvalue = value;
+  return;
+}
+
+/**
+ * Add an instantaneous intersection to the state
+ */
+static void
+twindow_state_inst(TWindowState *state, double value)
+{
+  if (state->extent)
+  {
+    twindow_state_value(state, value);
+    state->instsum += value;
+  }
+  state->instcount++;
+  state->found = true;
+  return;
+}
+
+/**
+ * Add a duration to the state.
+ *
+ * @note The days and the time are accumulated separately as done by the sum
+ * of the intervals returned by timestamp_mi
+ */
+static void
+twindow_state_duration(TWindowState *state, int64 days, int64 time)
+{
+  state->usecs += days * USECS_PER_DAY + time;
+  state->duration.day += (int32) days;
+  state->duration.time += time;
+  return;
+}
+
+/**
+ * Return the position of the last instant of the temporal sequence whose
+ * timestamp is less than or equal to the timestamp
+ *
+ * @pre The timestamp is greater than or equal to the first timestamp of the
+ * sequence
+ */
+static int
+tsequence_last_leq(const TSequence *seq, TimestampTz t)
+{
+  int first = 0, last = seq->count - 1;
+  while (first < last)
+  {
+    int middle = (first + last + 1) / 2;
+    if (tsequence_inst_n(seq, middle)->t <= t)
+      first = middle;
+    else
+      last = middle - 1;
+  }
+  return first;
+}
+
+/**
+ * Add to the state the extent of the values of the instants of the temporal
+ * sequence between two positions
+ */
+static void
+tsequence_window_extent(const TSequence *seq, int from, int to,
+  const TWindowIndex *idx, int offset, TWindowState *state)
+{
+  if (idx)
+  {
+    double min, max;
+    twindow_index_extent(idx, offset + from, offset + to, &min, &max);
+    twindow_state_value(state, min);
+    twindow_state_value(state, max);
+    return;
+  }
+  for (int i = from; i <= to; i++)
+    twindow_state_value(state, tnumberinst_double(tsequence_inst_n(seq, i)));
+  return;
+}
+
+/**
+ * Return the measure of the segments of the temporal sequence between two
+ * positions
+ */
+static double
+tsequence_window_measure(const TSequence *seq, int from, int to,
+  const TWindowIndex *idx, int offset, twindow_measure_fn func)
+{
+  if (idx)
+    return idx->measure[offset + to] - idx->measure[offset + from];
+  double result = 0.0;
+  bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags);
+  const TInstant *inst1 = tsequence_inst_n(seq, from);
+  for (int i = from + 1; i <= to; i++)
+  {
+    const TInstant *inst2 = tsequence_inst_n(seq, i);
+    result += func(inst1, inst2, linear, inst1->t, inst2->t);
+    inst1 = inst2;
+  }
+  return result;
+}
+
+/**
+ * Add to the state the reduction of the temporal sequence over its
+ * intersection with the window.
+ *
+ * Only the values at the bounds of the intersection are interpolated. For
+ * step interpolation the value at an exclusive upper bound is the value of
+ * the previous instant, as in the restriction of the sequence to the window.
+ *
+ * @param[in] seq Temporal sequence
+ * @param[in] p Window
+ * @param[in] idx Per-value structures, may be NULL
+ * @param[in] offset Position of the first instant of the sequence in idx
+ * @param[in] func Function computing the measure of the segments
+ * @param[inout] state State
+ * @pre The window overlaps the period of the sequence
+ */
+static void
+tsequence_window(const TSequence *seq, const Period *p,
+  const TWindowIndex *idx, int offset, twindow_measure_fn func,
+  TWindowState *state)
+{
+  bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags);
+  TimestampTz lower = Max(p->lower, seq->period.lower);
+  TimestampTz upper;
+  bool upper_inc;
+  if (p->upper < seq->period.upper)
+  {
+    upper = p->upper;
+    upper_inc = p->upper_inc;
+  }
+  else if (p->upper > seq->period.upper)
+  {
+    upper = seq->period.upper;
+    upper_inc = seq->period.upper_inc;
+  }
+  else
+  {
+    upper = p->upper;
+    upper_inc = p->upper_inc && seq->period.upper_inc;
+  }
+
+  int i = tsequence_last_leq(seq, lower);
+  const TInstant *inst1 = tsequence_inst_n(seq, i);
+  /* Instantaneous intersection */
+  if (lower == upper)
+  {
+    double value = 0.0;
+    if (state->extent)
+      value = (inst1->t == lower) ? tnumberinst_double(inst1) :
+        tnumberseg_double_at_timestamp(inst1, tsequence_inst_n(seq, i + 1),
+          linear, lower);
+    twindow_state_inst(state, value);
+    return;
+  }
+
+  int j = tsequence_last_leq(seq, upper);
+  if (tsequence_inst_n(seq, j)->t < upper)
+    j++;
+  const TInstant *inst2 = tsequence_inst_n(seq, i + 1);
+  const TInstant *inst3 = tsequence_inst_n(seq, j - 1);
+  const TInstant *inst4 = tsequence_inst_n(seq, j);
+  if (state->extent)
+  {
+    twindow_state_value(state,
+      tnumberseg_double_at_timestamp(inst1, inst2, linear, lower));
+    twindow_state_value(state, (! linear && ! upper_inc) ?
+      tnumberinst_double(inst3) :
+      tnumberseg_double_at_timestamp(inst3, inst4, linear, upper));
+    if (i + 1 < j)
+      tsequence_window_extent(seq, i + 1, j - 1, idx, offset, state);
+  }
+  if (i + 1 == j)
+    state->measure += func(inst1, inst4, linear, lower, upper);
+  else
+    state->measure += func(inst1, inst2, linear, lower, inst2->t) +
+      tsequence_window_measure(seq, i + 1, j - 1, idx, offset, func) +
+      func(inst3, inst4, linear, inst3->t, upper);
+  int64 usecs = upper - lower;
+  twindow_state_duration(state, usecs / USECS_PER_DAY, usecs % USECS_PER_DAY);
+  state->found = true;
+  return;
+}
+
+/**
+ * Add to the state the reduction of the sequences of a temporal sequence set
+ * between two positions, which are contained in the window, using the
+ * per-value structures
+ */
+static void
+tsequenceset_window_full(const TWindowIndex *idx, int first, int last,
+  TWindowState *state)
+{
+  int from = idx->offset[first];
+  int to = idx->offset[last + 1] - 1;
+  state->measure += idx->measure[to] - idx->measure[from];
+  twindow_state_duration(state, idx->days[last + 1] - idx->days[first],
+    idx->time[last + 1] - idx->time[first]);
+  state->instsum += idx->instsum[last + 1] - idx->instsum[first];
+  state->instcount += idx->instcount[last + 1] - idx->instcount[first];
+  if (state->extent)
+  {
+    double min, max;
+    twindow_index_extent(idx, from, to, &min, &max);
+    twindow_state_value(state, min);
+    twindow_state_value(state, max);
+  }
+  state->found = true;
+  return;
+}
+
+/**
+ * Determine the first and the last sequences of the temporal sequence set
+ * that overlap the window
+ *
+ * @result Return false if no sequence overlaps the window
+ */
+static bool
+tsequenceset_window_seqs(const TSequenceSet *ts, const Period *p, int *first,
+  int *last)
+{
+  int loc1, loc2;
+  tsequenceset_find_timestamp(ts, p->lower, &loc1);
+  if (loc1 < ts->count &&
+      ! overlaps_period_period(&tsequenceset_seq_n(ts, loc1)->period, p))
+    loc1++;
+  if (! tsequenceset_find_timestamp(ts, p->upper, &loc2))
+    loc2--;
+  if (loc2 >= 0 &&
+      ! overlaps_period_period(&tsequenceset_seq_n(ts, loc2)->period, p))
+    loc2--;
+  if (loc1 >= ts->count || loc2 < 0 || loc1 > loc2)
+    return false;
+  *first = loc1;
+  *last = loc2;
+  return true;
+}
+
+/**
+ * Accumulate the reduction of the temporal value over the window
+ *
+ * @param[in] temp Temporal value
+ * @param[in] p Window
+ * @param[in] idx Per-value structures, may be NULL
+ * @param[in] func Function computing the measure of the segments
+ * @param[inout] state State
+ */
+static void
+temporal_window(const Temporal *temp, const Period *p,
+  const TWindowIndex *idx, twindow_measure_fn func, TWindowState *state)
+{
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT)
+  {
+    const TInstant *inst = (const TInstant *) temp;
+    if (contains_period_timestamp(p, inst->t))
+      twindow_state_inst(state, state->extent ? tnumberinst_double(inst) : 0.0);
+  }
+  else if (temp->subtype == INSTANTSET)
+  {
+    const TInstantSet *ti = (const TInstantSet *) temp;
+    int loc;
+    tinstantset_find_timestamp(ti, p->lower, &loc);
+    for (int i = loc; i < ti->count; i++)
+    {
+      const TInstant *inst = tinstantset_inst_n(ti, i);
+      if (inst->t > p->upper || (inst->t == p->upper && ! p->upper_inc))
+        break;
+      if (contains_period_timestamp(p, inst->t))
+        twindow_state_inst(state,
+          state->extent ? tnumberinst_double(inst) : 0.0);
+    }
+  }
+  else if (temp->subtype == SEQUENCE)
+  {
+    const TSequence *seq = (const TSequence *) temp;
+    if (overlaps_period_period(&seq->period, p))
+      tsequence_window(seq, p, idx, 0, func, state);
+  }
+  else /* temp->subtype == SEQUENCESET */
+  {
+    const TSequenceSet *ts = (const TSequenceSet *) temp;
+    int first, last;
+    if (! tsequenceset_window_seqs(ts, p, &first, &last))
+      return;
+    tsequence_window(tsequenceset_seq_n(ts, first), p, idx,
+      idx ? idx->offset[first] : 0, func, state);
+    if (first == last)
+      return;
+    /* The sequences between the first and the last one are contained in the
+     * window */
+    if (idx && last - first > 1)
+      tsequenceset_window_full(idx, first + 1, last - 1, state);
+    else
+    {
+      for (int i = first + 1; i < last; i++)
+        tsequence_window(tsequenceset_seq_n(ts, i), p, idx,
+          idx ? idx->offset[i] : 0, func, state);
+    }
+    tsequence_window(tsequenceset_seq_n(ts, last), p, idx,
+      idx ? idx->offset[last] : 0, func, state);
+  }
+  return;
+}
+
+/**
+ * @ingroup libmeos_temporal_agg
+ * @brief Compute the summary statistics of the temporal number over the
+ * period without restricting the temporal number to the period.
+ *
+ * @param[in] temp Temporal number
+ * @param[in] p Period
+ * @param[in] idx Per-value structures obtained by temporal_window_index,
+ * may be NULL
+ * @param[out] stats Statistics
+ * @result Return false if the temporal number does not intersect the period
+ */
+bool
+tnumber_window_stats(const Temporal *temp, const Period *p,
+  const TWindowIndex *idx, TNumberStats *stats)
+{
+  TWindowState state;
+  twindow_state_init(&state, true);
+  temporal_window(temp, p, idx, &tnumberseg_integral, &state);
+  if (! state.found)
+    return false;
+  stats->minvalue = state.minvalue;
+  stats->maxvalue = state.maxvalue;
+  stats->integral = state.measure;
+  stats->twavg = (state.usecs == 0) ? state.instsum / state.instcount :
+    state.measure / (double) state.usecs;
+  memcpy(&stats->duration, &state.duration, sizeof(Interval));
+  return true;
+}
+
+/**
+ * @ingroup libmeos_temporal_spatial_accessor
+ * @brief Compute the length traversed by the temporal point over the period
+ * without restricting the temporal point to the period.
+ *
+ * @param[in] temp Temporal point
+ * @param[in] p Period
+ * @param[in] idx Per-value structures obtained by temporal_window_index,
+ * may be NULL
+ * @param[out] result Length
+ * @result Return false if the temporal point does not intersect the period
+ */
+bool
+tpoint_window_length(const Temporal *temp, const Period *p,
+  const TWindowIndex *idx, double *result)
+{
+  TWindowState state;
+  twindow_state_init(&state, false);
+  temporal_window(temp, p, idx, &tpointseg_length, &state);
+  if (! state.found)
+    return false;
+  *result = state.measure;
+  return true;
+}
+
+#ifndef MEOS
+
+/*****************************************************************************
+ * Functions for the PostgreSQL extension
+ *****************************************************************************/
+
+/**
+ * Return a tuple of type tnumber_stats, all the attributes of which are null
+ * when the statistics are not given
+ */
+static HeapTuple
+tnumber_stats_tuple(TupleDesc tupdesc, const TNumberStats *stats)
+{
+  Datum values[5] = {0, 0, 0, 0, 0};
+  bool isnull[5] = {1, 1, 1, 1, 1};
+  if (stats)
+  {
+    Interval *duration = palloc(sizeof(Interval));
+    memcpy(duration, &stats->duration, sizeof(Interval));
+    values[0] = Float8GetDatum(stats->minvalue);
+    values[1] = Float8GetDatum(stats->maxvalue);
+    values[2] = Float8GetDatum(stats->twavg);
+    values[3] = Float8GetDatum(stats->integral);
+    values[4] = PointerGetDatum(duration);
+    memset(isnull, 0, sizeof(isnull));
+  }
+  return heap_form_tuple(tupdesc, values, isnull);
+}
+
+/**
+ * Create the state of the functions computing the reductions of a temporal
+ * value over an array of windows. The per-value structures are only built
+ * when there is more than one window.
+ */
+static TWindowListState *
+twindow_list_state_make(FunctionCallInfo fcinfo)
+{
+  TWindowListState *state = palloc0(sizeof(TWindowListState));
+  state->temp = PG_GETARG_TEMPORAL_P(0);
+  ArrayType *array = PG_GETARG_ARRAYTYPE_P(1);
+  state->periods = periodarr_extract(array, &state->count);
+  state->idx = (state->count > 1) ? temporal_window_index(state->temp) : NULL;
+  return state;
+}
+
+PG_FUNCTION_INFO_V1(Tnumber_window_stats);
+/**
+ * Return the summary statistics of the temporal number over the period
+ */
+PGDLLEXPORT Datum
+Tnumber_window_stats(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Period *p = PG_GETARG_PERIOD_P(1);
+  TNumberStats stats;
+  bool found = tnumber_window_stats(temp, p, NULL, &stats);
+  PG_FREE_IF_COPY(temp, 0);
+  if (! found)
+    PG_RETURN_NULL();
+
+  TupleDesc tupdesc;
+  if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+      errmsg("function returning record called in context "
+        "that cannot accept type record")));
+  BlessTupleDesc(tupdesc);
+  HeapTuple tuple = tnumber_stats_tuple(tupdesc, &stats);
+  PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
+}
+
+PG_FUNCTION_INFO_V1(Tnumber_window_stats_array);
+/**
+ * Return the summary statistics of the temporal number over each period of
+ * the array
+ */
+PGDLLEXPORT Datum
+Tnumber_window_stats_array(PG_FUNCTION_ARGS)
+{
+  FuncCallContext *funcctx;
+  TWindowListState *state;
+
+  /* If the function is being called for the first time */
+  if (SRF_IS_FIRSTCALL())
+  {
+    /* Initialize the FuncCallContext */
+    funcctx = SRF_FIRSTCALL_INIT();
+    /* Switch to memory context appropriate for multiple function calls */
+    MemoryContext oldcontext =
+      MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+    /* Create function state */
+    funcctx->user_fctx = twindow_list_state_make(fcinfo);
+    /* Build a tuple description for the function output */
+    get_call_result_type(fcinfo, 0, &funcctx->tuple_desc);
+    BlessTupleDesc(funcctx->tuple_desc);
+    MemoryContextSwitchTo(oldcontext);
+  }
+
+  /* Stuff done on every call of the function */
+  funcctx = SRF_PERCALL_SETUP();
+  /* Get state */
+  state = funcctx->user_fctx;
+  /* Stop when all the windows have been processed */
+  if (state->i == state->count)
+    SRF_RETURN_DONE(funcctx);
+
+  /* Compute the statistics of the next window */
+  TNumberStats stats;
+  bool found = tnumber_window_stats(state->temp, state->periods[state->i++],
+    state->idx, &stats);
+  HeapTuple tuple = tnumber_stats_tuple(funcctx->tuple_desc,
+    found ? &stats : NULL);
+  SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_window_length);
+/**
+ * Return the length traversed by the temporal point over the period
+ */
+PGDLLEXPORT Datum
+Tpoint_window_length(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  Period *p = PG_GETARG_PERIOD_P(1);
+  double result;
+  bool found = tpoint_window_length(temp, p, NULL, &result);
+  PG_FREE_IF_COPY(temp, 0);
+  if (! found)
+    PG_RETURN_NULL();
+  PG_RETURN_FLOAT8(result);
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_window_length_array);
+/**
+ * Return the length traversed by the temporal point over each period of the
+ * array
+ */
+PGDLLEXPORT Datum
+Tpoint_window_length_array(PG_FUNCTION_ARGS)
+{
+  FuncCallContext *funcctx;
+  TWindowListState *state;
+
+  /* If the function is being called for the first time */
+  if (SRF_IS_FIRSTCALL())
+  {
+    /* Initialize the FuncCallContext */
+    funcctx = SRF_FIRSTCALL_INIT();
+    /* Switch to memory context appropriate for multiple function calls */
+    MemoryContext oldcontext =
+      MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+    /* Create function state */
+    funcctx->user_fctx = twindow_list_state_make(fcinfo);
+    MemoryContextSwitchTo(oldcontext);
+  }
+
+  /* Stuff done on every call of the function */
+  funcctx = SRF_PERCALL_SETUP();
+  /* Get state */
+  state = funcctx->user_fctx;
+  /* Stop when all the windows have been processed */
+  if (state->i == state->count)
+    SRF_RETURN_DONE(funcctx);
+
+  /* Compute the length of the next window */
+  double result;
+  if (! tpoint_window_length(state->temp, state->periods[state->i++],
+      state->idx, &result))
+    SRF_RETURN_NEXT_NULL(funcctx);
+  SRF_RETURN_NEXT(funcctx, Float8GetDatum(result));
+}
+
+#endif /* #ifndef MEOS */
+
+/*****************************************************************************/
@@ -246,8 +246,8 @@ time_agg_combinefn(FunctionCallInfo fcinfo, SkipList *state1,
     return state1;
 
   assert(state1->elemtype == state2->elemtype);
+  void **values = skiplist_values(fcinfo, state2);
   int count2 = state2->length;
-  void **values = skiplist_values(state2);
   skiplist_splice(fcinfo, state1, values, count2, NULL, CROSSINGS_NO);
   pfree(values);
   return state1;
@@ -671,7 +671,7 @@ Timestamp_tunion_finalfn(PG_FUNCTION_ARGS)
     PG_RETURN_NULL();
 
   assert(state->elemtype == TIMESTAMPTZ);
-  TimestampTz *values = (TimestampTz *) skiplist_values(state);
+  TimestampTz *values = (TimestampTz *) skiplist_values(fcinfo, state);
   TimestampSet *result = timestampset_make(values, state->length);
   pfree(values);
   PG_RETURN_POINTER(result);
@@ -690,7 +690,7 @@ Period_tunion_finalfn(PG_FUNCTION_ARGS)
     PG_RETURN_NULL();
 
   assert(state->elemtype == PERIOD);
-  const Period **values = (const Period **) skiplist_values(state);
+  const Period **values = (const Period **) skiplist_values(fcinfo, state);
   PeriodSet *result = periodset_make(values, state->length, NORMALIZE_NO);
   pfree(values);
   PG_RETURN_POINTER(result);
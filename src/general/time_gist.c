@@ -38,6 +38,8 @@
 
 /* PostgreSQL */
 #include <assert.h>
+#include <float.h>
+#include <math.h>
 #include <access/gist.h>
 #include <utils/timestamp.h>
 /* MobilityDB */
@@ -46,6 +48,7 @@
 #include "general/period.h"
 #include "general/periodset.h"
 #include "general/time_ops.h"
+#include "general/temporal.h"
 #include "general/temporal_util.h"
 #include "general/tempcache.h"
 
@@ -877,4 +880,545 @@ Period_gist_fetch(PG_FUNCTION_ARGS)
   PG_RETURN_POINTER(entry);
 }
 
+/*****************************************************************************
+ * Multi-period keys
+ *
+ * The opclasses above index a timestamp set or a period set by its bounding
+ * period. The multi-period opclasses below keep instead a period set of at
+ * most MULTIPERIOD_MAX_PERIODS disjoint periods that covers the indexed
+ * value. When the value has more periods than that, the periods separated
+ * by the smallest gaps are merged, so that the largest gaps are kept in the
+ * key. The bounding period of a key is the bounding period of the value.
+ *****************************************************************************/
+
+/**
+ * Structure keeping a gap between two consecutive periods
+ */
+typedef struct
+{
+  double gap;   /**< length of the gap in seconds */
+  int index;    /**< index of the period that precedes the gap */
+} PeriodGap;
+
+/**
+ * Compare PeriodGaps by decreasing length of the gap
+ */
+static int
+periodgap_cmp_desc(const void *a, const void *b)
+{
+  const PeriodGap *g1 = (const PeriodGap *) a;
+  const PeriodGap *g2 = (const PeriodGap *) b;
+  if (g1->gap > g2->gap)
+    return -1;
+  if (g1->gap < g2->gap)
+    return 1;
+  /* Break ties by position so that the key is deterministic */
+  return g1->index - g2->index;
+}
+
+/**
+ * Return a multi-period key from an array of periods
+ *
+ * @param[in] periods Array of periods
+ * @param[in] count Number of elements in the array
+ * @param[in] maxcount Maximum number of periods in the result
+ * @pre The periods are sorted, disjoint, and not adjacent
+ */
+PeriodSet *
+periodarr_multiperiod(const Period **periods, int count, int maxcount)
+{
+  assert(count > 0 && maxcount > 0);
+  if (count <= maxcount)
+    return periodset_make(periods, count, NORMALIZE_NO);
+
+  /* Sort the gaps between consecutive periods by decreasing length */
+  PeriodGap *gaps = palloc(sizeof(PeriodGap) * (count - 1));
+  for (int i = 0; i < count - 1; i++)
+  {
+    gaps[i].gap = period_to_secs(periods[i + 1]->lower, periods[i]->upper);
+    gaps[i].index = i;
+  }
+  qsort(gaps, (size_t) (count - 1), sizeof(PeriodGap), &periodgap_cmp_desc);
+  /* Keep the maxcount - 1 largest gaps */
+  bool *split = palloc0(sizeof(bool) * count);
+  for (int i = 0; i < maxcount - 1; i++)
+    split[gaps[i].index] = true;
+  split[count - 1] = true;
+
+  Period *newperiods = palloc(sizeof(Period) * maxcount);
+  const Period **ptrs = palloc(sizeof(Period *) * maxcount);
+  int k = 0, start = 0;
+  for (int i = 0; i < count; i++)
+  {
+    if (split[i])
+    {
+      period_set(periods[start]->lower, periods[i]->upper,
+        periods[start]->lower_inc, periods[i]->upper_inc, &newperiods[k]);
+      ptrs[k] = &newperiods[k];
+      k++;
+      start = i + 1;
+    }
+  }
+  PeriodSet *result = periodset_make(ptrs, k, NORMALIZE_NO);
+  pfree(gaps); pfree(split); pfree(newperiods); pfree(ptrs);
+  return result;
+}
+
+/**
+ * Return a multi-period key from an array of periods that may overlap and
+ * may be given in any order
+ */
+static PeriodSet *
+periodarr_multiperiod_normalize(const Period **periods, int count)
+{
+  periodarr_sort((Period **) periods, count);
+  int newcount;
+  Period **normperiods = periodarr_normalize((Period **) periods, count,
+    &newcount);
+  PeriodSet *result = periodarr_multiperiod((const Period **) normperiods,
+    newcount, MULTIPERIOD_MAX_PERIODS);
+  pfree_array((void **) normperiods, newcount);
+  return result;
+}
+
+/**
+ * Return the multi-period key of a period set
+ */
+PeriodSet *
+periodset_multiperiod(const PeriodSet *ps)
+{
+  if (ps->count <= MULTIPERIOD_MAX_PERIODS)
+    return periodset_copy(ps);
+  const Period **periods = periodset_periods(ps);
+  PeriodSet *result = periodarr_multiperiod(periods, ps->count,
+    MULTIPERIOD_MAX_PERIODS);
+  pfree(periods);
+  return result;
+}
+
+/**
+ * Return the multi-period key of a timestamp set
+ */
+static PeriodSet *
+timestampset_multiperiod(const TimestampSet *ts)
+{
+  PeriodSet *ps = timestampset_periodset(ts);
+  if (ps->count <= MULTIPERIOD_MAX_PERIODS)
+    return ps;
+  PeriodSet *result = periodset_multiperiod(ps);
+  pfree(ps);
+  return result;
+}
+
+/**
+ * Return the total duration in seconds of a multi-period key
+ */
+static double
+multiperiod_secs(const PeriodSet *ps)
+{
+  double result = 0.0;
+  for (int i = 0; i < ps->count; i++)
+  {
+    const Period *p = periodset_per_n(ps, i);
+    result += period_to_secs(p->upper, p->lower);
+  }
+  return result;
+}
+
+/**
+ * Transform the query argument into a period set
+ */
+static PeriodSet *
+time_gist_get_periodset(FunctionCallInfo fcinfo, Oid typid)
+{
+  PeriodSet *result;
+  CachedType type = oid_type(typid);
+  if (type == T_TIMESTAMPTZ)
+    result = timestamp_periodset(PG_GETARG_TIMESTAMPTZ(1));
+  else if (type == T_TIMESTAMPSET)
+  {
+    TimestampSet *ts = PG_GETARG_TIMESTAMPSET_P(1);
+    result = timestampset_periodset(ts);
+    PG_FREE_IF_COPY(ts, 1);
+  }
+  else if (type == T_PERIOD)
+    result = period_periodset(PG_GETARG_PERIOD_P(1));
+  else if (type == T_PERIODSET)
+  {
+    PeriodSet *ps = PG_GETARG_PERIODSET_P(1);
+    result = periodset_copy(ps);
+    PG_FREE_IF_COPY(ps, 1);
+  }
+  else
+    elog(ERROR, "Unsupported type for indexing: %d", type);
+  return result;
+}
+
+/**
+ * Leaf-level consistency for multi-period keys
+ *
+ * @param[in] key Element in the index
+ * @param[in] query Value being looked up in the index
+ * @param[in] strategy Operator of the operator class being applied
+ */
+static bool
+multiperiod_index_consistent_leaf(const PeriodSet *key,
+  const PeriodSet *query, StrategyNumber strategy)
+{
+  switch (strategy)
+  {
+    case RTOverlapStrategyNumber:
+      return overlaps_periodset_periodset(key, query);
+    case RTContainsStrategyNumber:
+      return contains_periodset_periodset(key, query);
+    case RTContainedByStrategyNumber:
+    {
+      /* Every period of the key covers part of the value */
+      if (! contains_period_period(&query->period, &key->period))
+        return false;
+      for (int i = 0; i < key->count; i++)
+      {
+        if (! overlaps_period_periodset(periodset_per_n(key, i), query))
+          return false;
+      }
+      return true;
+    }
+    case RTEqualStrategyNumber:
+    case RTSameStrategyNumber:
+    {
+      /* Equal values have equal keys */
+      PeriodSet *qkey = periodset_multiperiod(query);
+      bool result = periodset_eq(key, qkey);
+      pfree(qkey);
+      return result;
+    }
+    default:
+      /* The remaining operators are based on the bounding period */
+      return period_index_consistent_leaf(&key->period, &query->period,
+        strategy);
+  }
+}
+
+/**
+ * GiST internal-page consistency for multi-period keys
+ *
+ * @param[in] key Element in the index
+ * @param[in] query Value being looked up in the index
+ * @param[in] strategy Operator of the operator class being applied
+ */
+static bool
+multiperiod_gist_consistent(const PeriodSet *key, const PeriodSet *query,
+  StrategyNumber strategy)
+{
+  switch (strategy)
+  {
+    case RTOverlapStrategyNumber:
+    case RTContainedByStrategyNumber:
+      return overlaps_periodset_periodset(key, query);
+    case RTContainsStrategyNumber:
+      return contains_periodset_periodset(key, query);
+    case RTEqualStrategyNumber:
+    case RTSameStrategyNumber:
+    {
+      /* The key of an equal value is covered by the key of its ancestors */
+      PeriodSet *qkey = periodset_multiperiod(query);
+      bool result = contains_periodset_periodset(key, qkey);
+      pfree(qkey);
+      return result;
+    }
+    default:
+      return period_gist_consistent(&key->period, &query->period, strategy);
+  }
+}
+
+PG_FUNCTION_INFO_V1(Periodset_gist_multi_consistent);
+/**
+ * GiST consistent method for time types using multi-period keys
+ */
+PGDLLEXPORT Datum
+Periodset_gist_multi_consistent(PG_FUNCTION_ARGS)
+{
+  GISTENTRY *entry = (GISTENTRY *) PG_GETARG_POINTER(0);
+  StrategyNumber strategy = (StrategyNumber) PG_GETARG_UINT16(2);
+  Oid typid = PG_GETARG_OID(3);
+  bool *recheck = (bool *) PG_GETARG_POINTER(4);
+  bool result;
+
+  /* Determine whether the operator is exact */
+  *recheck = period_index_recheck(strategy);
+
+  if (DatumGetPointer(entry->key) == NULL)
+    PG_RETURN_BOOL(false);
+
+  /* Keys may be stored with a short varlena header */
+  PeriodSet *key = DatumGetPeriodSetP(entry->key);
+  PeriodSet *query = time_gist_get_periodset(fcinfo, typid);
+
+  if (GIST_LEAF(entry))
+    result = multiperiod_index_consistent_leaf(key, query, strategy);
+  else
+    result = multiperiod_gist_consistent(key, query, strategy);
+
+  pfree(query);
+  PG_RETURN_BOOL(result);
+}
+
+PG_FUNCTION_INFO_V1(Periodset_gist_multi_union);
+/**
+ * GiST union method for multi-period keys
+ */
+PGDLLEXPORT Datum
+Periodset_gist_multi_union(PG_FUNCTION_ARGS)
+{
+  GistEntryVector *entryvec = (GistEntryVector *) PG_GETARG_POINTER(0);
+  GISTENTRY *ent = entryvec->vector;
+  PeriodSet **keys = palloc(sizeof(PeriodSet *) * entryvec->n);
+  int count = 0;
+  for (int i = 0; i < entryvec->n; i++)
+  {
+    keys[i] = DatumGetPeriodSetP(ent[i].key);
+    count += keys[i]->count;
+  }
+  const Period **periods = palloc(sizeof(Period *) * count);
+  int k = 0;
+  for (int i = 0; i < entryvec->n; i++)
+  {
+    for (int j = 0; j < keys[i]->count; j++)
+      periods[k++] = periodset_per_n(keys[i], j);
+  }
+  PeriodSet *result = periodarr_multiperiod_normalize(periods, count);
+  pfree(periods); pfree(keys);
+  PG_RETURN_PERIODSET_P(result);
+}
+
+PG_FUNCTION_INFO_V1(Timestampset_gist_multi_compress);
+/**
+ * GiST compress method for timestamp sets using multi-period keys
+ */
+PGDLLEXPORT Datum
+Timestampset_gist_multi_compress(PG_FUNCTION_ARGS)
+{
+  GISTENTRY *entry = (GISTENTRY *) PG_GETARG_POINTER(0);
+  if (entry->leafkey)
+  {
+    GISTENTRY *retval = (GISTENTRY *) palloc(sizeof(GISTENTRY));
+    TimestampSet *ts = DatumGetTimestampSetP(entry->key);
+    PeriodSet *key = timestampset_multiperiod(ts);
+    gistentryinit(*retval, PeriodSetPGetDatum(key), entry->rel, entry->page,
+      entry->offset, false);
+    PG_RETURN_POINTER(retval);
+  }
+  PG_RETURN_POINTER(entry);
+}
+
+PG_FUNCTION_INFO_V1(Periodset_gist_multi_compress);
+/**
+ * GiST compress method for period sets using multi-period keys
+ */
+PGDLLEXPORT Datum
+Periodset_gist_multi_compress(PG_FUNCTION_ARGS)
+{
+  GISTENTRY *entry = (GISTENTRY *) PG_GETARG_POINTER(0);
+  if (entry->leafkey)
+  {
+    GISTENTRY *retval = (GISTENTRY *) palloc(sizeof(GISTENTRY));
+    PeriodSet *ps = DatumGetPeriodSetP(entry->key);
+    PeriodSet *key = periodset_multiperiod(ps);
+    gistentryinit(*retval, PeriodSetPGetDatum(key), entry->rel, entry->page,
+      entry->offset, false);
+    PG_RETURN_POINTER(retval);
+  }
+  PG_RETURN_POINTER(entry);
+}
+
+PG_FUNCTION_INFO_V1(Periodset_gist_multi_penalty);
+/**
+ * GiST page split penalty function for multi-period keys.
+ *
+ * The penalty is the increase of the total duration covered by the key,
+ * so that values are preferably inserted into subtrees whose gaps they do
+ * not fill.
+ */
+PGDLLEXPORT Datum
+Periodset_gist_multi_penalty(PG_FUNCTION_ARGS)
+{
+  GISTENTRY *origentry = (GISTENTRY *) PG_GETARG_POINTER(0);
+  GISTENTRY *newentry = (GISTENTRY *) PG_GETARG_POINTER(1);
+  float *penalty = (float *) PG_GETARG_POINTER(2);
+  const PeriodSet *orig = DatumGetPeriodSetP(origentry->key);
+  const PeriodSet *new = DatumGetPeriodSetP(newentry->key);
+
+  int count = orig->count + new->count;
+  const Period **periods = palloc(sizeof(Period *) * count);
+  int k = 0;
+  for (int i = 0; i < orig->count; i++)
+    periods[k++] = periodset_per_n(orig, i);
+  for (int i = 0; i < new->count; i++)
+    periods[k++] = periodset_per_n(new, i);
+  PeriodSet *merged = periodarr_multiperiod_normalize(periods, count);
+  *penalty = (float4) (multiperiod_secs(merged) - multiperiod_secs(orig));
+  pfree(periods); pfree(merged);
+
+  PG_RETURN_POINTER(penalty);
+}
+
+/**
+ * Structure keeping the bounding period of an entry for use in the
+ * function Periodset_gist_multi_picksplit
+ */
+typedef struct
+{
+  OffsetNumber index;  /**< index of the entry */
+  const Period *period; /**< bounding period of the entry */
+} MultiPeriodEntry;
+
+/**
+ * Compare MultiPeriodEntrys by their bounding period
+ */
+static int
+multiperiodentry_cmp(const void *a, const void *b)
+{
+  const MultiPeriodEntry *e1 = (const MultiPeriodEntry *) a;
+  const MultiPeriodEntry *e2 = (const MultiPeriodEntry *) b;
+  return period_cmp(e1->period, e2->period);
+}
+
+/**
+ * Return the union of the keys of the entries in a range of the array
+ */
+static PeriodSet *
+multiperiodentry_union(GistEntryVector *entryvec,
+  const MultiPeriodEntry *entries, int from, int to)
+{
+  int count = 0;
+  for (int i = from; i < to; i++)
+    count += DatumGetPeriodSetP(entryvec->vector[entries[i].index].key)->count;
+  const Period **periods = palloc(sizeof(Period *) * count);
+  int k = 0;
+  for (int i = from; i < to; i++)
+  {
+    const PeriodSet *key =
+      DatumGetPeriodSetP(entryvec->vector[entries[i].index].key);
+    for (int j = 0; j < key->count; j++)
+      periods[k++] = periodset_per_n(key, j);
+  }
+  PeriodSet *result = periodarr_multiperiod_normalize(periods, count);
+  pfree(periods);
+  return result;
+}
+
+PG_FUNCTION_INFO_V1(Periodset_gist_multi_picksplit);
+/**
+ * GiST picksplit method for multi-period keys
+ *
+ * The entries are sorted by their bounding period and split at the position
+ * with the largest gap (or the smallest overlap) between the groups among
+ * those satisfying the minimum split ratio LIMIT_RATIO.
+ */
+PGDLLEXPORT Datum
+Periodset_gist_multi_picksplit(PG_FUNCTION_ARGS)
+{
+  GistEntryVector *entryvec = (GistEntryVector *) PG_GETARG_POINTER(0);
+  GIST_SPLITVEC *v = (GIST_SPLITVEC *) PG_GETARG_POINTER(1);
+  OffsetNumber maxoff = (OffsetNumber) (entryvec->n - 1);
+  int nentries = maxoff - FirstOffsetNumber + 1;
+  MultiPeriodEntry *entries = palloc(sizeof(MultiPeriodEntry) * nentries);
+  for (OffsetNumber i = FirstOffsetNumber; i <= maxoff;
+    i = OffsetNumberNext(i))
+  {
+    const PeriodSet *key = DatumGetPeriodSetP(entryvec->vector[i].key);
+    entries[i - FirstOffsetNumber].index = i;
+    entries[i - FirstOffsetNumber].period = &key->period;
+  }
+  qsort(entries, (size_t) nentries, sizeof(MultiPeriodEntry),
+    &multiperiodentry_cmp);
+
+  /* Upper bound of the prefixes and lower bound of the suffixes */
+  TimestampTz *left_upper = palloc(sizeof(TimestampTz) * nentries);
+  TimestampTz *right_lower = palloc(sizeof(TimestampTz) * nentries);
+  left_upper[0] = entries[0].period->upper;
+  for (int i = 1; i < nentries; i++)
+    left_upper[i] = Max(left_upper[i - 1], entries[i].period->upper);
+  right_lower[nentries - 1] = entries[nentries - 1].period->lower;
+  for (int i = nentries - 2; i >= 0; i--)
+    right_lower[i] = Min(right_lower[i + 1], entries[i].period->lower);
+
+  /* Find the split position, the left group has split entries */
+  int minsplit = Max(1, (int) ceil(nentries * LIMIT_RATIO));
+  int maxsplit = Min(nentries - 1, nentries - minsplit);
+  int split = nentries / 2;
+  double bestgap = -DBL_MAX;
+  for (int i = minsplit; i <= maxsplit; i++)
+  {
+    double gap = period_to_secs(right_lower[i], left_upper[i - 1]);
+    if (gap > bestgap)
+    {
+      bestgap = gap;
+      split = i;
+    }
+  }
+
+  v->spl_left = (OffsetNumber *) palloc(sizeof(OffsetNumber) * nentries);
+  v->spl_right = (OffsetNumber *) palloc(sizeof(OffsetNumber) * nentries);
+  v->spl_nleft = v->spl_nright = 0;
+  for (int i = 0; i < nentries; i++)
+  {
+    if (i < split)
+      v->spl_left[v->spl_nleft++] = entries[i].index;
+    else
+      v->spl_right[v->spl_nright++] = entries[i].index;
+  }
+  v->spl_ldatum = PeriodSetPGetDatum(multiperiodentry_union(entryvec,
+    entries, 0, split));
+  v->spl_rdatum = PeriodSetPGetDatum(multiperiodentry_union(entryvec,
+    entries, split, nentries));
+
+  pfree(entries); pfree(left_upper); pfree(right_lower);
+  PG_RETURN_POINTER(v);
+}
+
+PG_FUNCTION_INFO_V1(Periodset_gist_multi_same);
+/**
+ * GiST same method for multi-period keys
+ */
+PGDLLEXPORT Datum
+Periodset_gist_multi_same(PG_FUNCTION_ARGS)
+{
+  PeriodSet *ps1 = PG_GETARG_PERIODSET_P(0);
+  PeriodSet *ps2 = PG_GETARG_PERIODSET_P(1);
+  bool *result = (bool *) PG_GETARG_POINTER(2);
+  *result = periodset_eq(ps1, ps2);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Periodset_gist_multi_distance);
+/**
+ * GiST support function for the nearest approach distance `|=|` of
+ * multi-period keys.
+ *
+ * @note The distance operators of time types are defined on the bounding
+ * periods of their arguments and thus, the distance is computed with the
+ * bounding period of the key, which is the one of the indexed value.
+ */
+PGDLLEXPORT Datum
+Periodset_gist_multi_distance(PG_FUNCTION_ARGS)
+{
+  GISTENTRY *entry = (GISTENTRY *) PG_GETARG_POINTER(0);
+  Oid typid = PG_GETARG_OID(3);
+  bool *recheck = (bool *) PG_GETARG_POINTER(4);
+  Period query;
+
+  /* The distance is exact */
+  *recheck = false;
+
+  if (DatumGetPointer(entry->key) == NULL)
+    PG_RETURN_FLOAT8(DBL_MAX);
+
+  if (! time_gist_get_period(fcinfo, &query, typid))
+    PG_RETURN_FLOAT8(DBL_MAX);
+
+  const PeriodSet *key = DatumGetPeriodSetP(entry->key);
+  PG_RETURN_FLOAT8(distance_secs_period_period(&key->period, &query));
+}
+
 /*****************************************************************************/
@@ -229,6 +229,48 @@ tinstantset_make_free(TInstant **instants, int count, bool merge)
   return result;
 }
 
+/**
+ * Construct a temporal instant set value from an array of temporal instant
+ * values that are known to be valid, such as the subsets of an existing
+ * value produced by the restriction, tiling, and lifting functions.
+ *
+ * The validity tests are only performed in debug builds.
+ *
+ * @param[in] instants Array of instants
+ * @param[in] count Number of elements in the array
+ * @pre The instants satisfy the conditions tested in tinstantset_make
+ */
+TInstantSet *
+tinstantset_make_trusted(const TInstant **instants, int count)
+{
+#ifdef DEBUG_BUILD
+  tinstantset_make_valid(instants, count, MERGE_NO);
+#endif
+  return tinstantset_make1(instants, count);
+}
+
+/**
+ * Construct a temporal instant set value from an array of temporal instant
+ * values that are known to be valid and free the array and the instants
+ * after the creation.
+ *
+ * @param[in] instants Array of instants
+ * @param[in] count Number of elements in the array
+ */
+TInstantSet *
+tinstantset_make_trusted_free(TInstant **instants, int count)
+{
+  if (count == 0)
+  {
+    pfree(instants);
+    return NULL;
+  }
+  TInstantSet *result = tinstantset_make_trusted((const TInstant **) instants,
+    count);
+  pfree_array((void **) instants, count);
+  return result;
+}
+
 /**
  * @ingroup libmeos_temporal_constructor
  * @brief Return a copy of the temporal value.
@@ -949,7 +991,7 @@ tinstantset_restrict_value(const TInstantSet *ti, Datum value, bool atfunc)
       instants[count++] = inst;
   }
   TInstantSet *result = (count == 0) ? NULL :
-    tinstantset_make(instants, count, MERGE_NO);
+    tinstantset_make_trusted(instants, count);
   pfree(instants);
   return result;
 }
@@ -990,7 +1032,7 @@ tinstantset_restrict_values(const TInstantSet *ti, const Datum *values,
       instants[newcount++] = inst;
   }
   TInstantSet *result = (newcount == 0) ? NULL :
-    tinstantset_make(instants, newcount, MERGE_NO);
+    tinstantset_make_trusted(instants, newcount);
   pfree(instants);
   return result;
 }
@@ -1024,7 +1066,7 @@ tnumberinstset_restrict_range(const TInstantSet *ti, const RangeType *range,
       instants[count++] = inst;
   }
   TInstantSet *result = (count == 0) ? NULL :
-    tinstantset_make(instants, count, MERGE_NO);
+    tinstantset_make_trusted(instants, count);
   pfree(instants);
   return result;
 }
@@ -1067,7 +1109,7 @@ tnumberinstset_restrict_ranges(const TInstantSet *ti, RangeType **normranges,
       instants[newcount++] = inst;
   }
   TInstantSet *result = (newcount == 0) ? NULL :
-    tinstantset_make(instants, newcount, MERGE_NO);
+    tinstantset_make_trusted(instants, newcount);
   pfree(instants);
   return result;
 }
@@ -1194,7 +1236,7 @@ tinstantset_restrict_timestamp(const TInstantSet *ti, TimestampTz t, bool atfunc
         instants[count++] = inst;
     }
     TInstantSet *result = (count == 0) ? NULL :
-      tinstantset_make(instants, count, MERGE_NO);
+      tinstantset_make_trusted(instants, count);
     pfree(instants);
     return (Temporal *) result;
   }
@@ -1219,7 +1261,7 @@ tinstantset_restrict_timestampset(const TInstantSet *ti, const TimestampSet *ts,
     if (temp == NULL || temp->subtype == INSTANTSET)
       return (TInstantSet *) temp;
     TInstant *inst1 = (TInstant *) temp;
-    result = tinstantset_make((const TInstant **) &inst1, 1, MERGE_NO);
+    result = tinstantset_make_trusted((const TInstant **) &inst1, 1);
     pfree(inst1);
     return result;
   }
@@ -1271,7 +1313,7 @@ tinstantset_restrict_timestampset(const TInstantSet *ti, const TimestampSet *ts,
     while (i < ti->count)
       instants[k++] = tinstantset_inst_n(ti, i++);
   }
-  result = (k == 0) ? NULL : tinstantset_make(instants, k, MERGE_NO);
+  result = (k == 0) ? NULL : tinstantset_make_trusted(instants, k);
   pfree(instants);
   return result;
 }
@@ -1305,7 +1347,7 @@ tinstantset_restrict_period(const TInstantSet *ti, const Period *period,
       instants[count++] = inst;
   }
   TInstantSet *result = (count == 0) ? NULL :
-    tinstantset_make(instants, count, MERGE_NO);
+    tinstantset_make_trusted(instants, count);
   pfree(instants);
   return result;
 }
@@ -1351,7 +1393,7 @@ tinstantset_restrict_periodset(const TInstantSet *ti, const PeriodSet *ps,
       instants[count++] = inst;
   }
   TInstantSet *result = (count == 0) ? NULL :
-    tinstantset_make(instants, count, MERGE_NO);
+    tinstantset_make_trusted(instants, count);
   pfree(instants);
   return result;
 }
@@ -1508,8 +1550,8 @@ intersection_tinstantset_tinstantset(const TInstantSet *ti1, const TInstantSet *
   }
   if (k != 0)
   {
-    *inter1 = tinstantset_make(instants1, k, MERGE_NO);
-    *inter2 = tinstantset_make(instants2, k, MERGE_NO);
+    *inter1 = tinstantset_make_trusted(instants1, k);
+    *inter2 = tinstantset_make_trusted(instants2, k);
   }
 
   pfree(instants1); pfree(instants2);
@@ -46,6 +46,7 @@
 #include "general/temporaltypes.h"
 #include "general/temporal_util.h"
 #include "general/lifting.h"
+#include "general/temporal_tile.h"
 
 /*****************************************************************************
  * Miscellaneous functions on datums
@@ -395,6 +396,471 @@ tnumber_derivative(const Temporal *temp)
   return result;
 }
 
+/*****************************************************************************
+ * Delta functions
+ *****************************************************************************/
+
+/**
+ * Return the number of seconds elapsed between the two instants
+ */
+static Datum
+tinstant_time_delta(const TInstant *inst1, const TInstant *inst2)
+{
+  return Float8GetDatum((double) (inst2->t - inst1->t) / 1000000);
+}
+
+/**
+ * Return the difference between the values of the two instants
+ */
+static Datum
+tnumberinst_value_delta(const TInstant *inst1, const TInstant *inst2)
+{
+  CachedType basetype = temptype_basetype(inst1->temptype);
+  return datum_sub(tinstant_value(inst2), tinstant_value(inst1), basetype,
+    basetype);
+}
+
+/**
+ * Compute in a single pass the deltas between the consecutive instants of
+ * the array. A run of instants ends when the time elapsed between two
+ * consecutive instants is greater than the maximum gap.
+ *
+ * @param[in] instants Array of instants
+ * @param[in] count Number of elements in the array
+ * @param[in] maxgap Maximum gap in PostgreSQL time units, no gap when 0
+ * @param[in] func Function computing the delta between two instants
+ * @param[in] restype Temporal type of the result
+ * @param[out] result Array of delta instants, the one of each run being
+ * located at the timestamp of its second instant
+ * @param[out] runs Number of delta instants of each run, only runs with
+ * at least one delta are output
+ * @param[out] nruns Number of runs
+ * @result Number of delta instants
+ */
+static int
+tinstarr_delta(const TInstant **instants, int count, int64 maxgap,
+  delta_func func, CachedType restype, TInstant **result, int *runs,
+  int *nruns)
+{
+  int k = 0, l = 0, run = 0;
+  for (int i = 1; i < count; i++)
+  {
+    if (maxgap > 0 && instants[i]->t - instants[i - 1]->t > maxgap)
+    {
+      /* Close the current run if it has deltas */
+      if (run > 0)
+        runs[l++] = run;
+      run = 0;
+      continue;
+    }
+    result[k++] = tinstant_make(func(instants[i - 1], instants[i]),
+      instants[i]->t, restype);
+    run++;
+  }
+  if (run > 0)
+    runs[l++] = run;
+  *nruns = l;
+  return k;
+}
+
+/**
+ * Return the deltas between the consecutive instants of a temporal instant
+ * set
+ */
+static TInstantSet *
+tinstantset_delta(const TInstantSet *ti, int64 maxgap, delta_func func,
+  CachedType restype)
+{
+  const TInstant **instants = tinstantset_instants(ti);
+  TInstant **deltas = palloc(sizeof(TInstant *) * ti->count);
+  int *runs = palloc(sizeof(int) * ti->count);
+  int nruns;
+  int count = tinstarr_delta(instants, ti->count, maxgap, func, restype,
+    deltas, runs, &nruns);
+  pfree(instants); pfree(runs);
+  if (count == 0)
+  {
+    pfree(deltas);
+    return NULL;
+  }
+  return tinstantset_make_free(deltas, count, MERGE_NO);
+}
+
+/**
+ * Compute the deltas between the consecutive instants of a temporal sequence
+ *
+ * @param[in] seq Temporal sequence
+ * @param[in] maxgap Maximum gap in PostgreSQL time units, no gap when 0
+ * @param[in] func Function computing the delta between two instants
+ * @param[in] restype Temporal type of the result
+ * @param[out] result Array of sequences with step interpolation
+ * @result Number of sequences in the output array
+ */
+static int
+tsequence_delta1(const TSequence *seq, int64 maxgap, delta_func func,
+  CachedType restype, TSequence **result)
+{
+  if (seq->count == 1)
+    return 0;
+  const TInstant **instants = palloc(sizeof(TInstant *) * seq->count);
+  for (int i = 0; i < seq->count; i++)
+    instants[i] = tsequence_inst_n(seq, i);
+  TInstant **deltas = palloc(sizeof(TInstant *) * seq->count);
+  int *runs = palloc(sizeof(int) * seq->count);
+  int nruns;
+  tinstarr_delta(instants, seq->count, maxgap, func, restype, deltas, runs,
+    &nruns);
+  int k = 0;
+  for (int i = 0; i < nruns; i++)
+  {
+    result[i] = tsequence_make((const TInstant **) &deltas[k], runs[i],
+      true, true, STEP, NORMALIZE);
+    k += runs[i];
+  }
+  pfree_array((void **) deltas, k);
+  pfree(instants); pfree(runs);
+  return nruns;
+}
+
+/**
+ * Return the deltas between the consecutive instants of a temporal sequence
+ */
+static Temporal *
+tsequence_delta(const TSequence *seq, int64 maxgap, delta_func func,
+  CachedType restype)
+{
+  TSequence **sequences = palloc(sizeof(TSequence *) * seq->count);
+  int count = tsequence_delta1(seq, maxgap, func, restype, sequences);
+  if (count == 0)
+  {
+    pfree(sequences);
+    return NULL;
+  }
+  if (count == 1)
+  {
+    TSequence *result = sequences[0];
+    pfree(sequences);
+    return (Temporal *) result;
+  }
+  return (Temporal *) tsequenceset_make_free(sequences, count, NORMALIZE);
+}
+
+/**
+ * Return the deltas between the consecutive instants of each sequence of a
+ * temporal sequence set
+ */
+static TSequenceSet *
+tsequenceset_delta(const TSequenceSet *ts, int64 maxgap, delta_func func,
+  CachedType restype)
+{
+  TSequence **sequences = palloc(sizeof(TSequence *) * ts->totalcount);
+  int k = 0;
+  for (int i = 0; i < ts->count; i++)
+    k += tsequence_delta1(tsequenceset_seq_n(ts, i), maxgap, func, restype,
+      &sequences[k]);
+  if (k == 0)
+  {
+    pfree(sequences);
+    return NULL;
+  }
+  return tsequenceset_make_free(sequences, k, NORMALIZE);
+}
+
+/**
+ * @ingroup libmeos_temporal_math
+ * @brief Return the temporal value of the deltas between the consecutive
+ * instants of a temporal value.
+ *
+ * The deltas are computed in a single pass over the instants and are
+ * located at the timestamp of the second instant of each pair. The result
+ * has step interpolation and is split when the time elapsed between two
+ * consecutive instants is greater than the maximum gap, in which case no
+ * delta is computed across the gap. The deltas are not computed across the
+ * sequences of a sequence set.
+ *
+ * @param[in] temp Temporal value
+ * @param[in] maxgap Maximum gap in PostgreSQL time units, no gap when 0
+ * @param[in] func Function computing the delta between two instants
+ * @param[in] restype Temporal type of the result
+ * @result NULL when the value has less than two instants
+ */
+Temporal *
+temporal_delta(const Temporal *temp, int64 maxgap, delta_func func,
+  CachedType restype)
+{
+  Temporal *result = NULL;
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT)
+    ;
+  else if (temp->subtype == INSTANTSET)
+    result = (Temporal *) tinstantset_delta((TInstantSet *) temp, maxgap,
+      func, restype);
+  else if (temp->subtype == SEQUENCE)
+    result = tsequence_delta((TSequence *) temp, maxgap, func, restype);
+  else /* temp->subtype == SEQUENCESET */
+    result = (Temporal *) tsequenceset_delta((TSequenceSet *) temp, maxgap,
+      func, restype);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_math
+ * @brief Return the number of seconds elapsed since the previous instant of
+ * the temporal value.
+ * @param[in] temp Temporal value
+ * @param[in] maxgap Maximum gap in PostgreSQL time units, no gap when 0
+ */
+Temporal *
+temporal_time_delta(const Temporal *temp, int64 maxgap)
+{
+  return temporal_delta(temp, maxgap, &tinstant_time_delta, T_TFLOAT);
+}
+
+/**
+ * @ingroup libmeos_temporal_math
+ * @brief Return the change of value since the previous instant of the
+ * temporal number.
+ * @param[in] temp Temporal number
+ * @param[in] maxgap Maximum gap in PostgreSQL time units, no gap when 0
+ */
+Temporal *
+tnumber_value_delta(const Temporal *temp, int64 maxgap)
+{
+  return temporal_delta(temp, maxgap, &tnumberinst_value_delta,
+    temp->temptype);
+}
+
+/*****************************************************************************
+ * Cross-correlation functions
+ *****************************************************************************/
+
+/**
+ * Return the value of the segment of a temporal number at the timestamp
+ */
+static double
+tnumbersegm_double_at_timestamp(const TInstant *inst1, const TInstant *inst2,
+  bool linear, TimestampTz t)
+{
+  double value1 = tnumberinst_double(inst1);
+  if (! linear || t == inst1->t)
+    return value1;
+  double value2 = tnumberinst_double(inst2);
+  return value1 + (value2 - value1) * (double) (t - inst1->t) /
+    (double) (inst2->t - inst1->t);
+}
+
+/**
+ * Add to the state the integrals over a time interval during which both
+ * values evolve linearly
+ *
+ * @param[in] x1,x2 Values of the first number at the start and the end
+ * @param[in] y1,y2 Values of the second number at the start and the end
+ * @param[in] duration Duration in seconds
+ * @param[in,out] state State
+ */
+static void
+xcorrstate_add(double x1, double x2, double y1, double y2, double duration,
+  XCorrState *state)
+{
+  x1 -= state->xref; x2 -= state->xref;
+  y1 -= state->yref; y2 -= state->yref;
+  state->duration += duration;
+  state->sx += duration * (x1 + x2) / 2.0;
+  state->sy += duration * (y1 + y2) / 2.0;
+  state->sxx += duration * (x1 * x1 + x1 * x2 + x2 * x2) / 3.0;
+  state->syy += duration * (y1 * y1 + y1 * y2 + y2 * y2) / 3.0;
+  state->sxy += duration *
+    (2.0 * x1 * y1 + x1 * y2 + x2 * y1 + 2.0 * x2 * y2) / 6.0;
+  return;
+}
+
+/**
+ * Return the index of the segment of the sequence containing the timestamp,
+ * which is assumed to be in the period of the sequence
+ */
+static int
+tsequence_find_segment(const TSequence *seq, TimestampTz t)
+{
+  int result = tsequence_find_timestamp(seq, t);
+  /* The timestamp is the exclusive lower bound of the sequence */
+  if (result < 0)
+    result = 0;
+  return Min(result, seq->count - 2);
+}
+
+/**
+ * Add to the state the integrals of the two temporal sequences over their
+ * common time span when the second one is shifted back by the lag
+ *
+ * The segments of both sequences are traversed together in a single sweep,
+ * so that the shifted sequence is never materialized and the sequences are
+ * not synchronized.
+ */
+static void
+tnumberseq_xcorr_add(const TSequence *seq1, const TSequence *seq2, int64 lag,
+  XCorrState *state)
+{
+  TimestampTz lower = Max(seq1->period.lower, seq2->period.lower - lag);
+  TimestampTz upper = Min(seq1->period.upper, seq2->period.upper - lag);
+  if (lower >= upper)
+    return;
+
+  bool linear1 = MOBDB_FLAGS_GET_LINEAR(seq1->flags);
+  bool linear2 = MOBDB_FLAGS_GET_LINEAR(seq2->flags);
+  int i = tsequence_find_segment(seq1, lower);
+  int j = tsequence_find_segment(seq2, lower + lag);
+  TimestampTz t = lower;
+  while (t < upper)
+  {
+    const TInstant *start1 = tsequence_inst_n(seq1, i);
+    const TInstant *end1 = tsequence_inst_n(seq1, i + 1);
+    const TInstant *start2 = tsequence_inst_n(seq2, j);
+    const TInstant *end2 = tsequence_inst_n(seq2, j + 1);
+    TimestampTz t1 = Min(Min(end1->t, end2->t - lag), upper);
+    double x1 = tnumbersegm_double_at_timestamp(start1, end1, linear1, t);
+    double x2 = linear1 ?
+      tnumbersegm_double_at_timestamp(start1, end1, linear1, t1) : x1;
+    double y1 = tnumbersegm_double_at_timestamp(start2, end2, linear2,
+      t + lag);
+    double y2 = linear2 ?
+      tnumbersegm_double_at_timestamp(start2, end2, linear2, t1 + lag) : y1;
+    xcorrstate_add(x1, x2, y1, y2, (double) (t1 - t) / USECS_PER_SEC, state);
+    if (end1->t == t1 && i < seq1->count - 2)
+      i++;
+    if (end2->t - lag == t1 && j < seq2->count - 2)
+      j++;
+    t = t1;
+  }
+  return;
+}
+
+/**
+ * Return the time-weighted correlation coefficient accumulated in the
+ * state, or false if it is undefined, that is, when the common time span
+ * is empty or when one of the values is constant
+ */
+static bool
+xcorrstate_corr(const XCorrState *state, double *result)
+{
+  if (state->duration <= 0)
+    return false;
+  double mx = state->sx / state->duration;
+  double my = state->sy / state->duration;
+  double varx = state->sxx / state->duration - mx * mx;
+  double vary = state->syy / state->duration - my * my;
+  if (varx <= MOBDB_EPSILON * state->sxx / state->duration ||
+      vary <= MOBDB_EPSILON * state->syy / state->duration)
+    return false;
+  double cov = state->sxy / state->duration - mx * my;
+  double corr = cov / sqrt(varx * vary);
+  *result = Max(-1.0, Min(1.0, corr));
+  return true;
+}
+
+/**
+ * Return the array of pointers to the sequences of the temporal sequence
+ * (set)
+ */
+static const TSequence **
+temporal_seqs_p(const Temporal *temp, int *count)
+{
+  if (temp->subtype == SEQUENCE)
+  {
+    const TSequence **result = palloc(sizeof(TSequence *));
+    result[0] = (const TSequence *) temp;
+    *count = 1;
+    return result;
+  }
+  /* temp->subtype == SEQUENCESET */
+  *count = ((const TSequenceSet *) temp)->count;
+  return tsequenceset_sequences_p((const TSequenceSet *) temp);
+}
+
+/**
+ * @ingroup libmeos_temporal_math
+ * @brief Compute the time-weighted cross-correlation of two temporal numbers
+ * for each of the lags.
+ *
+ * The correlation for a lag is the Pearson correlation coefficient of the
+ * first value and of the second value shifted back by the lag, that is,
+ * of x(t) and y(t + lag), over the time span where both are defined. It is
+ * computed by integrating the products of the piecewise linear values
+ * analytically, in a single sweep of the segments of both values per lag.
+ *
+ * @param[in] temp1,temp2 Temporal numbers
+ * @param[in] lags Lags in PostgreSQL time units
+ * @param[in] count Number of lags
+ * @param[out] values Correlation for each lag
+ * @param[out] isnull True for the lags for which the correlation is
+ * undefined
+ */
+void
+tnumber_xcorr(const Temporal *temp1, const Temporal *temp2,
+  const int64 *lags, int count, double *values, bool *isnull)
+{
+  ensure_seq_subtypes(temp1->subtype);
+  ensure_seq_subtypes(temp2->subtype);
+  int count1, count2;
+  const TSequence **seqs1 = temporal_seqs_p(temp1, &count1);
+  const TSequence **seqs2 = temporal_seqs_p(temp2, &count2);
+  /* Reference values subtracted from the values for numerical stability */
+  double xref = tnumberinst_double(tsequence_inst_n(seqs1[0], 0));
+  double yref = tnumberinst_double(tsequence_inst_n(seqs2[0], 0));
+  for (int k = 0; k < count; k++)
+  {
+    XCorrState state;
+    memset(&state, 0, sizeof(XCorrState));
+    state.xref = xref;
+    state.yref = yref;
+    int64 lag = lags[k];
+    int i = 0, j = 0;
+    while (i < count1 && j < count2)
+    {
+      tnumberseq_xcorr_add(seqs1[i], seqs2[j], lag, &state);
+      if (seqs1[i]->period.upper < seqs2[j]->period.upper - lag)
+        i++;
+      else
+        j++;
+    }
+    isnull[k] = ! xcorrstate_corr(&state, &values[k]);
+  }
+  pfree(seqs1); pfree(seqs2);
+  return;
+}
+
+/**
+ * @ingroup libmeos_temporal_math
+ * @brief Return the lag among those given for which the cross-correlation of
+ * two temporal numbers is maximal.
+ *
+ * @param[in] temp1,temp2 Temporal numbers
+ * @param[in] lags Lags in PostgreSQL time units
+ * @param[in] count Number of lags
+ * @param[out] lag Lag for which the correlation is maximal
+ * @param[out] corr Correlation for this lag
+ * @result False when the correlation is undefined for all the lags
+ */
+bool
+tnumber_best_lag(const Temporal *temp1, const Temporal *temp2,
+  const int64 *lags, int count, int64 *lag, double *corr)
+{
+  double *values = palloc(sizeof(double) * count);
+  bool *isnull = palloc(sizeof(bool) * count);
+  tnumber_xcorr(temp1, temp2, lags, count, values, isnull);
+  bool result = false;
+  for (int k = 0; k < count; k++)
+  {
+    if (! isnull[k] && (! result || values[k] > *corr))
+    {
+      *lag = lags[k];
+      *corr = values[k];
+      result = true;
+    }
+  }
+  pfree(values); pfree(isnull);
+  return result;
+}
+
 /*****************************************************************************/
 /*****************************************************************************/
 /*                        MobilityDB - PostgreSQL                            */
@@ -659,6 +1125,152 @@ Tnumber_derivative(PG_FUNCTION_ARGS)
   PG_RETURN_POINTER(result);
 }
 
+/*****************************************************************************
+ * Delta functions
+ *****************************************************************************/
+
+/**
+ * Get the optional maximum gap argument of the delta functions
+ */
+int64
+delta_get_maxgap(FunctionCallInfo fcinfo)
+{
+  if (PG_NARGS() == 1)
+    return 0;
+  Interval *maxgap = PG_GETARG_INTERVAL_P(1);
+  ensure_valid_duration(maxgap);
+  return get_interval_units(maxgap);
+}
+
+PG_FUNCTION_INFO_V1(Temporal_time_delta);
+/**
+ * Return the number of seconds elapsed since the previous instant of the
+ * temporal value
+ */
+PGDLLEXPORT Datum
+Temporal_time_delta(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  int64 maxgap = delta_get_maxgap(fcinfo);
+  Temporal *result = temporal_time_delta(temp, maxgap);
+  PG_FREE_IF_COPY(temp, 0);
+  if (result == NULL)
+    PG_RETURN_NULL();
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Tnumber_value_delta);
+/**
+ * Return the change of value since the previous instant of the temporal
+ * number
+ */
+PGDLLEXPORT Datum
+Tnumber_value_delta(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  int64 maxgap = delta_get_maxgap(fcinfo);
+  Temporal *result = tnumber_value_delta(temp, maxgap);
+  PG_FREE_IF_COPY(temp, 0);
+  if (result == NULL)
+    PG_RETURN_NULL();
+  PG_RETURN_POINTER(result);
+}
+
+/*****************************************************************************
+ * Cross-correlation functions
+ *****************************************************************************/
+
+/**
+ * Get the lags of the cross-correlation functions
+ */
+static int64 *
+xcorr_get_lags(ArrayType *array, Datum **elems, int *count)
+{
+  ensure_non_empty_array(array);
+  *elems = datumarr_extract(array, count);
+  int64 *result = palloc(sizeof(int64) * *count);
+  for (int i = 0; i < *count; i++)
+  {
+    Interval *lag = DatumGetIntervalP((*elems)[i]);
+    if (lag->month != 0)
+      ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+        errmsg("Interval defined in terms of month, year, century etc. not supported")));
+    result[i] = get_interval_units(lag);
+  }
+  return result;
+}
+
+PG_FUNCTION_INFO_V1(Tnumber_xcorr);
+/**
+ * Return the time-weighted cross-correlation of the temporal numbers for
+ * each of the lags
+ */
+PGDLLEXPORT Datum
+Tnumber_xcorr(PG_FUNCTION_ARGS)
+{
+  Temporal *temp1 = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp2 = PG_GETARG_TEMPORAL_P(1);
+  ArrayType *array = PG_GETARG_ARRAYTYPE_P(2);
+  Datum *elems;
+  int count;
+  int64 *lags = xcorr_get_lags(array, &elems, &count);
+  double *values = palloc(sizeof(double) * count);
+  bool *isnull = palloc(sizeof(bool) * count);
+  tnumber_xcorr(temp1, temp2, lags, count, values, isnull);
+  Datum *datums = palloc(sizeof(Datum) * count);
+  for (int i = 0; i < count; i++)
+    datums[i] = isnull[i] ? (Datum) 0 : Float8GetDatum(values[i]);
+  int dims[1] = {count};
+  int lbs[1] = {1};
+  ArrayType *result = construct_md_array(datums, isnull, 1, dims, lbs,
+    FLOAT8OID, 8, FLOAT8PASSBYVAL, 'd');
+  pfree(elems); pfree(lags); pfree(values); pfree(isnull); pfree(datums);
+  PG_FREE_IF_COPY(temp1, 0);
+  PG_FREE_IF_COPY(temp2, 1);
+  PG_FREE_IF_COPY(array, 2);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Tnumber_best_lag);
+/**
+ * Return the lag among those given for which the cross-correlation of the
+ * temporal numbers is maximal
+ */
+PGDLLEXPORT Datum
+Tnumber_best_lag(PG_FUNCTION_ARGS)
+{
+  Temporal *temp1 = PG_GETARG_TEMPORAL_P(0);
+  Temporal *temp2 = PG_GETARG_TEMPORAL_P(1);
+  ArrayType *array = PG_GETARG_ARRAYTYPE_P(2);
+  Datum *elems;
+  int count;
+  int64 *lags = xcorr_get_lags(array, &elems, &count);
+  int64 lag;
+  double corr;
+  bool found = tnumber_best_lag(temp1, temp2, lags, count, &lag, &corr);
+  Interval *result = NULL;
+  if (found)
+  {
+    /* Return the lag as it was given */
+    for (int i = 0; i < count; i++)
+    {
+      if (lags[i] == lag)
+      {
+        result = palloc(sizeof(Interval));
+        memcpy(result, DatumGetIntervalP(elems[i]), sizeof(Interval));
+        break;
+      }
+    }
+  }
+  pfree(elems); pfree(lags);
+  PG_FREE_IF_COPY(temp1, 0);
+  PG_FREE_IF_COPY(temp2, 1);
+  PG_FREE_IF_COPY(array, 2);
+  if (! result)
+    PG_RETURN_NULL();
+  PG_RETURN_INTERVAL_P(result);
+}
+
 #endif /* #ifndef MEOS */
 
 /*****************************************************************************/
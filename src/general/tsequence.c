@@ -475,6 +475,57 @@ tsequence_make_free(TInstant **instants, int count, bool lower_inc,
   return result;
 }
 
+/**
+ * Construct a temporal sequence value from an array of temporal instant
+ * values that are known to be valid, such as the slices of an existing
+ * sequence produced by the restriction, tiling, and lifting functions.
+ *
+ * The validity tests are only performed in debug builds.
+ *
+ * @param[in] instants Array of instants
+ * @param[in] count Number of elements in the array
+ * @param[in] lower_inc,upper_inc True when the respective bound is inclusive
+ * @param[in] linear True when the interpolation is linear
+ * @param[in] normalize True when the resulting value should be normalized
+ * @pre The instants satisfy the conditions tested in tsequence_make
+ */
+TSequence *
+tsequence_make_trusted(const TInstant **instants, int count, bool lower_inc,
+  bool upper_inc, bool linear, bool normalize)
+{
+#ifdef DEBUG_BUILD
+  tsequence_make_valid(instants, count, lower_inc, upper_inc, linear);
+#endif
+  return tsequence_make1(instants, count, lower_inc, upper_inc, linear,
+    normalize);
+}
+
+/**
+ * Construct a temporal sequence value from an array of temporal instant
+ * values that are known to be valid and free the array and the instants
+ * after the creation.
+ *
+ * @param[in] instants Array of instants
+ * @param[in] count Number of elements in the array
+ * @param[in] lower_inc,upper_inc True when the respective bound is inclusive
+ * @param[in] linear True when the interpolation is linear
+ * @param[in] normalize True when the resulting value should be normalized
+ */
+TSequence *
+tsequence_make_trusted_free(TInstant **instants, int count, bool lower_inc,
+   bool upper_inc, bool linear, bool normalize)
+{
+  if (count == 0)
+  {
+    pfree(instants);
+    return NULL;
+  }
+  TSequence *result = tsequence_make_trusted((const TInstant **) instants,
+    count, lower_inc, upper_inc, linear, normalize);
+  pfree_array((void **) instants, count);
+  return result;
+}
+
 /**
  * @ingroup libmeos_temporal_constructor
  * @brief Return a copy of the temporal value.
@@ -1022,10 +1073,10 @@ synchronize_tsequence_tsequence(const TSequence *seq1, const TSequence *seq2,
       instants2[k - 1]->t, instants2[k - 1]->temptype);
     tofree[l++] = instants2[k - 1];
   }
-  *sync1 = tsequence_make((const TInstant **) instants1, k, inter.lower_inc,
-    inter.upper_inc, linear1, NORMALIZE_NO);
-  *sync2 = tsequence_make((const TInstant **) instants2, k, inter.lower_inc,
-    inter.upper_inc, linear2, NORMALIZE_NO);
+  *sync1 = tsequence_make_trusted((const TInstant **) instants1, k,
+    inter.lower_inc, inter.upper_inc, linear1, NORMALIZE_NO);
+  *sync2 = tsequence_make_trusted((const TInstant **) instants2, k,
+    inter.lower_inc, inter.upper_inc, linear2, NORMALIZE_NO);
 
   pfree_array((void **) tofree, l);
   pfree(instants1); pfree(instants2);
@@ -1320,8 +1371,8 @@ intersection_tsequence_tinstantset(const TSequence *seq, const TInstantSet *ti,
     return false;
   }
 
-  *inter1 = tinstantset_make_free(instants1, k, MERGE_NO);
-  *inter2 = tinstantset_make(instants2, k, MERGE_NO);
+  *inter1 = tinstantset_make_trusted_free(instants1, k);
+  *inter2 = tinstantset_make_trusted(instants2, k);
   pfree(instants2);
   return true;
 }
@@ -2548,7 +2599,7 @@ tsegment_restrict_value(const TInstant *inst1, const TInstant *inst2,
   {
     instants[0] = (TInstant *) inst1;
     instants[1] = (TInstant *) inst2;
-    result[0] = tsequence_make((const TInstant **) instants, 2,
+    result[0] = tsequence_make_trusted((const TInstant **) instants, 2,
       lower_inc && lower, upper_inc && upper, linear, NORMALIZE_NO);
     return 1;
   }
@@ -2561,7 +2612,7 @@ tsegment_restrict_value(const TInstant *inst1, const TInstant *inst2,
     {
       instants[0] = (TInstant *) inst1;
       instants[1] = tinstant_make(value1, inst2->t, inst1->temptype);
-      result[k++] = tsequence_make((const TInstant **) instants, 2,
+      result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
         lower_inc, false, linear, NORMALIZE_NO);
       pfree(instants[1]);
     }
@@ -2597,7 +2648,7 @@ tsegment_restrict_value(const TInstant *inst1, const TInstant *inst2,
 
       instants[0] = (TInstant *) inst1;
       instants[1] = (TInstant *) inst2;
-      result[0] = tsequence_make((const TInstant **) instants, 2,
+      result[0] = tsequence_make_trusted((const TInstant **) instants, 2,
         ! lower_inc, upper_inc, LINEAR, NORMALIZE_NO);
       return 1;
     }
@@ -2609,7 +2660,7 @@ tsegment_restrict_value(const TInstant *inst1, const TInstant *inst2,
 
       instants[0] = (TInstant *) inst1;
       instants[1] = (TInstant *) inst2;
-      result[0] = tsequence_make((const TInstant **) instants, 2,
+      result[0] = tsequence_make_trusted((const TInstant **) instants, 2,
         lower_inc, ! upper_inc, LINEAR, NORMALIZE_NO);
       return 1;
     }
@@ -2617,11 +2668,11 @@ tsegment_restrict_value(const TInstant *inst1, const TInstant *inst2,
     {
       instants[0] = (TInstant *) inst1;
       instants[1] = tinstant_make(projvalue, t, inst1->temptype);
-      result[0] = tsequence_make((const TInstant **) instants, 2,
+      result[0] = tsequence_make_trusted((const TInstant **) instants, 2,
         lower_inc, false, LINEAR, NORMALIZE_NO);
       instants[0] = instants[1];
       instants[1] = (TInstant *) inst2;
-      result[1] = tsequence_make((const TInstant **) instants, 2,
+      result[1] = tsequence_make_trusted((const TInstant **) instants, 2,
         false, upper_inc, LINEAR, NORMALIZE_NO);
       pfree(instants[0]);
       DATUM_FREE(projvalue, basetype);
@@ -2712,7 +2763,7 @@ tsequence_restrict_value(const TSequence *seq, Datum value, bool atfunc)
     count *= 2;
   TSequence **sequences = palloc(sizeof(TSequence *) * count);
   int newcount = tsequence_restrict_value1(seq, value, atfunc, sequences);
-  return tsequenceset_make_free(sequences, newcount, NORMALIZE);
+  return tsequenceset_make_trusted_free(sequences, newcount, NORMALIZE);
 }
 
 /*****************************************************************************/
@@ -2798,7 +2849,7 @@ tsequence_restrict_values(const TSequence *seq, const Datum *values, int count,
   /* General case */
   TSequence **sequences = palloc(sizeof(TSequence *) * seq->count * count * 2);
   int newcount = tsequence_at_values1(seq, values, count, sequences);
-  TSequenceSet *atresult = tsequenceset_make_free(sequences, newcount, NORMALIZE);
+  TSequenceSet *atresult = tsequenceset_make_trusted_free(sequences, newcount, NORMALIZE);
   if (atfunc)
     return atresult;
 
@@ -2861,7 +2912,7 @@ tnumberseq_restrict_range1(const TInstant *inst1, const TInstant *inst2,
       return 0;
     instants[0] = (TInstant *) inst1;
     instants[1] = (TInstant *) inst2;
-    result[0] = tsequence_make((const TInstant **) instants, 2,
+    result[0] = tsequence_make_trusted((const TInstant **) instants, 2,
       lower_inclu, upper_inclu, linear, NORMALIZE_NO);
     return 1;
   }
@@ -2879,7 +2930,7 @@ tnumberseq_restrict_range1(const TInstant *inst1, const TInstant *inst2,
     {
       instants[0] = (TInstant *) inst1;
       instants[1] = tinstant_make(value1, inst2->t, inst1->temptype);
-      result[k++] = tsequence_make((const TInstant **) instants, 2,
+      result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
         lower_inclu, false, linear, NORMALIZE_NO);
       pfree(instants[1]);
     }
@@ -2913,7 +2964,7 @@ tnumberseq_restrict_range1(const TInstant *inst1, const TInstant *inst2,
     /* MINUS */
     instants[0] = (TInstant *) inst1;
     instants[1] = (TInstant *) inst2;
-    result[0] = tsequence_make((const TInstant **) instants, 2,
+    result[0] = tsequence_make_trusted((const TInstant **) instants, 2,
       lower_inclu, upper_inclu, linear, NORMALIZE_NO);
     return 1;
   }
@@ -2953,7 +3004,7 @@ tnumberseq_restrict_range1(const TInstant *inst1, const TInstant *inst2,
     }
     instants[0] = (TInstant *) inst1;
     instants[1] = (TInstant *) inst2;
-    result[0] = tsequence_make((const TInstant **) instants, 2,
+    result[0] = tsequence_make_trusted((const TInstant **) instants, 2,
       lower_inc1, upper_inc1, linear, NORMALIZE_NO);
     return 1;
   }
@@ -3007,7 +3058,7 @@ tnumberseq_restrict_range1(const TInstant *inst1, const TInstant *inst2,
     }
 
     /* Create the result */
-    result[0] = tsequence_make((const TInstant **) instants, 2,
+    result[0] = tsequence_make_trusted((const TInstant **) instants, 2,
       lower_inc1, upper_inc1, linear, NORMALIZE_NO);
     if (freei)
       pfree(instants[i]);
@@ -3051,18 +3102,18 @@ tnumberseq_restrict_range1(const TInstant *inst1, const TInstant *inst2,
   {
     instants[0] = (TInstant *) inst1;
     instants[1] = instbounds[0];
-    result[k++] = tsequence_make((const TInstant **) instants, 2,
+    result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
       lower_inclu, lower_inc1, linear, NORMALIZE_NO);
     instants[0] = instbounds[1];
     instants[1] = (TInstant *) inst2;
-    result[k++] = tsequence_make((const TInstant **) instants, 2,
+    result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
       upper_inc1, upper_inclu, linear, NORMALIZE_NO);
   }
   else if (instbounds[0] != NULL)
   {
     instants[0] = (TInstant *) inst1;
     instants[1] = instbounds[0];
-    result[k++] = tsequence_make((const TInstant **) instants, 2,
+    result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
       lower_inclu, lower_inc1, linear, NORMALIZE_NO);
     if (upper_inclu && upper_inc1)
       result[k++] = tinstant_tsequence(inst2, linear);
@@ -3073,7 +3124,7 @@ tnumberseq_restrict_range1(const TInstant *inst1, const TInstant *inst2,
       result[k++] = tinstant_tsequence(inst1, linear);
     instants[0] = instbounds[1];
     instants[1] = (TInstant *) inst2;
-    result[k++] = tsequence_make((const TInstant **) instants, 2,
+    result[k++] = tsequence_make_trusted((const TInstant **) instants, 2,
       upper_inc1, upper_inclu, linear, NORMALIZE_NO);
   }
 
@@ -3170,7 +3221,7 @@ tnumberseq_restrict_range(const TSequence *seq, const RangeType *range,
     count *= 2;
   TSequence **sequences = palloc(sizeof(TSequence *) * count);
   int newcount = tnumberseq_restrict_range2(seq, range, atfunc, sequences);
-  return tsequenceset_make_free(sequences, newcount, NORMALIZE);
+  return tsequenceset_make_trusted_free(sequences, newcount, NORMALIZE);
 }
 
 /*****************************************************************************/
@@ -3323,7 +3374,7 @@ tnumberseq_restrict_ranges(const TSequence *seq, RangeType **normranges,
   TSequence **sequences = palloc(sizeof(TSequence *) * maxcount);
   int newcount = tnumberseq_restrict_ranges1(seq, normranges, count, atfunc,
     bboxtest, sequences);
-  return tsequenceset_make_free(sequences, newcount, NORMALIZE);
+  return tsequenceset_make_trusted_free(sequences, newcount, NORMALIZE);
 }
 
 /*****************************************************************************/
@@ -3435,15 +3486,15 @@ tsequence_minus_timestamp1(const TSequence *seq, TimestampTz t,
       if (linear)
       {
         instants[n] = (TInstant *) inst1;
-        result[k++] = tsequence_make((const TInstant **) instants, n + 1,
-          seq->period.lower_inc, false, linear, NORMALIZE_NO);
+        result[k++] = tsequence_make_trusted((const TInstant **) instants,
+          n + 1, seq->period.lower_inc, false, linear, NORMALIZE_NO);
       }
       else
       {
         instants[n] = tinstant_make(tinstant_value(instants[n - 1]), t,
           inst1->temptype);
-        result[k++] = tsequence_make((const TInstant **) instants, n + 1,
-          seq->period.lower_inc, false, linear, NORMALIZE_NO);
+        result[k++] = tsequence_make_trusted((const TInstant **) instants,
+          n + 1, seq->period.lower_inc, false, linear, NORMALIZE_NO);
         pfree(instants[n]);
       }
     }
@@ -3454,7 +3505,7 @@ tsequence_minus_timestamp1(const TSequence *seq, TimestampTz t,
       instants[n + 1] = linear ?
         tsegment_at_timestamp(inst1, inst2, true, t) :
         tinstant_make(tinstant_value(inst1), t, inst1->temptype);
-      result[k++] = tsequence_make((const TInstant **) instants, n + 2,
+      result[k++] = tsequence_make_trusted((const TInstant **) instants, n + 2,
         seq->period.lower_inc, false, linear, NORMALIZE_NO);
       pfree(instants[n + 1]);
     }
@@ -3467,8 +3518,8 @@ tsequence_minus_timestamp1(const TSequence *seq, TimestampTz t,
     instants[0] = tsegment_at_timestamp(inst1, inst2, linear, t);
     for (i = 1; i < seq->count - n; i++)
       instants[i] = (TInstant *) tsequence_inst_n(seq, i + n);
-    result[k++] = tsequence_make((const TInstant **) instants, seq->count - n,
-      false, seq->period.upper_inc, linear, NORMALIZE_NO);
+    result[k++] = tsequence_make_trusted((const TInstant **) instants,
+      seq->count - n, false, seq->period.upper_inc, linear, NORMALIZE_NO);
     pfree(instants[0]);
   }
   return k;
@@ -3489,8 +3540,8 @@ tsequence_minus_timestamp(const TSequence *seq, TimestampTz t)
   int count = tsequence_minus_timestamp1(seq, t, sequences);
   if (count == 0)
     return NULL;
-  TSequenceSet *result = tsequenceset_make((const TSequence **) sequences,
-    count, NORMALIZE_NO);
+  TSequenceSet *result = tsequenceset_make_trusted(
+    (const TSequence **) sequences, count, NORMALIZE_NO);
   for (int i = 0; i < count; i++)
     pfree(sequences[i]);
   return result;
@@ -3513,7 +3564,7 @@ tsequence_at_timestampset(const TSequence *seq, const TimestampSet *ts)
     inst = tsequence_at_timestamp(seq, timestampset_time_n(ts, 0));
     if (inst == NULL)
       return NULL;
-    return tinstantset_make((const TInstant **) &inst, 1, MERGE_NO);
+    return tinstantset_make_trusted((const TInstant **) &inst, 1);
   }
 
   /* Bounding box test */
@@ -3528,7 +3579,7 @@ tsequence_at_timestampset(const TSequence *seq, const TimestampSet *ts)
   {
     if (! contains_timestampset_timestamp(ts, inst->t))
       return NULL;
-    return tinstantset_make((const TInstant **) &inst, 1, MERGE_NO);
+    return tinstantset_make_trusted((const TInstant **) &inst, 1);
   }
 
   /* General case */
@@ -3544,7 +3595,7 @@ tsequence_at_timestampset(const TSequence *seq, const TimestampSet *ts)
     if (inst != NULL)
       instants[k++] = inst;
   }
-  return tinstantset_make_free(instants, k, MERGE_NO);
+  return tinstantset_make_trusted_free(instants, k);
 }
 
 /*****************************************************************************/
@@ -3611,16 +3662,16 @@ tsequence_minus_timestampset1(const TSequence *seq, const TimestampSet *ts,
       if (linear)
       {
         instants[l] = (TInstant *) inst;
-        result[k++] = tsequence_make((const TInstant **) instants, l + 1,
-          lower_inc, false, linear, NORMALIZE_NO);
+        result[k++] = tsequence_make_trusted((const TInstant **) instants,
+          l + 1, lower_inc, false, linear, NORMALIZE_NO);
         instants[0] = (TInstant *) inst;
       }
       else
       {
         instants[l] = tinstant_make(tinstant_value(instants[l - 1]),
           t, inst->temptype);
-        result[k++] = tsequence_make((const TInstant **) instants, l + 1,
-          lower_inc, false, linear, NORMALIZE_NO);
+        result[k++] = tsequence_make_trusted((const TInstant **) instants,
+          l + 1, lower_inc, false, linear, NORMALIZE_NO);
         pfree(instants[l]);
         if (tofree)
         {
@@ -3643,8 +3694,8 @@ tsequence_minus_timestampset1(const TSequence *seq, const TimestampSet *ts,
         instants[l] = linear ?
           tsegment_at_timestamp(instants[l - 1], inst, true, t) :
           tinstant_make(tinstant_value(instants[l - 1]), t, inst->temptype);
-        result[k++] = tsequence_make((const TInstant **) instants, l + 1,
-          lower_inc, false, linear, NORMALIZE_NO);
+        result[k++] = tsequence_make_trusted((const TInstant **) instants,
+          l + 1, lower_inc, false, linear, NORMALIZE_NO);
         if (tofree)
           pfree(tofree);
         instants[0] = tofree = instants[l];
@@ -3659,7 +3710,7 @@ tsequence_minus_timestampset1(const TSequence *seq, const TimestampSet *ts,
   {
     for (j = i; j < seq->count; j++)
       instants[l++] = (TInstant *) tsequence_inst_n(seq, j);
-    result[k++] = tsequence_make((const TInstant **) instants, l,
+    result[k++] = tsequence_make_trusted((const TInstant **) instants, l,
       false, seq->period.upper_inc, linear, NORMALIZE_NO);
   }
   if (tofree)
@@ -3676,7 +3727,7 @@ tsequence_minus_timestampset(const TSequence *seq, const TimestampSet *ts)
 {
   TSequence **sequences = palloc0(sizeof(TSequence *) * (ts->count + 1));
   int count = tsequence_minus_timestampset1(seq, ts, sequences);
-  return tsequenceset_make_free(sequences, count, NORMALIZE);
+  return tsequenceset_make_trusted_free(sequences, count, NORMALIZE);
 }
 
 /*****************************************************************************/
@@ -3743,7 +3794,7 @@ tsequence_at_period(const TSequence *seq, const Period *p)
   }
   /* Since by definition the sequence is normalized it is not necessary to
    * normalize the projection of the sequence to the period */
-  result = tsequence_make((const TInstant **) instants, k,
+  result = tsequence_make_trusted((const TInstant **) instants, k,
     inter.lower_inc, inter.upper_inc, linear, NORMALIZE_NO);
 
   pfree(instants[0]); pfree(instants[k - 1]); pfree(instants);
@@ -3799,8 +3850,8 @@ tsequence_minus_period(const TSequence *seq, const Period *p)
   int count = tsequence_minus_period1(seq, p, sequences);
   if (count == 0)
     return NULL;
-  TSequenceSet *result = tsequenceset_make((const TSequence **) sequences,
-    count, NORMALIZE_NO);
+  TSequenceSet *result = tsequenceset_make_trusted(
+    (const TSequence **) sequences, count, NORMALIZE_NO);
   for (int i = 0; i < count; i++)
     pfree(sequences[i]);
   return result;
@@ -3948,7 +3999,7 @@ tsequence_restrict_periodset(const TSequence *seq, const PeriodSet *ps,
   TSequence **sequences = palloc(sizeof(TSequence *) * count);
   int count1 = atfunc ? tsequence_at_periodset(seq, ps, sequences) :
     tsequence_minus_periodset(seq, ps, 0, sequences);
-  return tsequenceset_make_free(sequences, count1, NORMALIZE_NO);
+  return tsequenceset_make_trusted_free(sequences, count1, NORMALIZE_NO);
 }
 
 /*****************************************************************************
@@ -123,6 +123,7 @@ tsequenceset_make_valid(const TSequence **sequences, int count)
         errmsg("Input sequences must have the same interpolation")));
     }
   }
+  ensure_valid_tseqarr(sequences, count);
   return;
 }
 
@@ -148,13 +149,12 @@ tsequenceset_make_valid(const TSequence **sequences, int count)
  * @param[in] normalize True when the resulting value should be normalized.
  * In particular, normalize is false when synchronizing two
  * temporal sequence set values before applying an operation to them.
+ * @pre The validity of the arguments has been tested before
  */
 TSequenceSet *
 tsequenceset_make1(const TSequence **sequences, int count, bool normalize)
 {
-  /* Test the validity of the sequences */
   assert(count > 0);
-  ensure_valid_tseqarr(sequences, count);
   /* Normalize the array of sequences */
   TSequence **normseqs = (TSequence **) sequences;
   int newcount = count;
@@ -265,6 +265,52 @@ tsequenceset_make_free(TSequence **sequences, int count, bool normalize)
   return result;
 }
 
+/**
+ * Construct a temporal sequence set value from an array of temporal
+ * sequence values that are known to be valid, such as the fragments of an
+ * existing value produced by the restriction, tiling, and lifting functions.
+ *
+ * The validity tests are only performed in debug builds.
+ *
+ * @param[in] sequences Array of sequences
+ * @param[in] count Number of elements in the array
+ * @param[in] normalize True when the resulting value should be normalized
+ * @pre The sequences satisfy the conditions tested in tsequenceset_make
+ */
+TSequenceSet *
+tsequenceset_make_trusted(const TSequence **sequences, int count,
+  bool normalize)
+{
+#ifdef DEBUG_BUILD
+  tsequenceset_make_valid(sequences, count);
+#endif
+  return tsequenceset_make1(sequences, count, normalize);
+}
+
+/**
+ * Construct a temporal sequence set value from an array of temporal
+ * sequence values that are known to be valid and free the array and the
+ * sequences after the creation.
+ *
+ * @param[in] sequences Array of sequences
+ * @param[in] count Number of elements in the array
+ * @param[in] normalize True when the resulting value should be normalized
+ */
+TSequenceSet *
+tsequenceset_make_trusted_free(TSequence **sequences, int count,
+  bool normalize)
+{
+  if (count == 0)
+  {
+    pfree(sequences);
+    return NULL;
+  }
+  TSequenceSet *result = tsequenceset_make_trusted(
+    (const TSequence **) sequences, count, normalize);
+  pfree_array((void **) sequences, count);
+  return result;
+}
+
 /**
  * Ensure the validity of the arguments when creating a temporal value
  * This function extends function tsequence_make_valid by spliting the
@@ -546,8 +592,8 @@ synchronize_tsequenceset_tsequence(const TSequenceSet *ts, const TSequence *seq,
     return false;
   }
 
-  *inter1 = tsequenceset_make_free(sequences1, k, NORMALIZE_NO);
-  *inter2 = tsequenceset_make_free(sequences2, k, NORMALIZE_NO);
+  *inter1 = tsequenceset_make_trusted_free(sequences1, k, NORMALIZE_NO);
+  *inter2 = tsequenceset_make_trusted_free(sequences2, k, NORMALIZE_NO);
   return true;
 }
 
@@ -606,8 +652,8 @@ synchronize_tsequenceset_tsequenceset(const TSequenceSet *ts1,
     return false;
   }
 
-  *inter1 = tsequenceset_make_free(sequences1, k, NORMALIZE_NO);
-  *inter2 = tsequenceset_make_free(sequences2, k, NORMALIZE_NO);
+  *inter1 = tsequenceset_make_trusted_free(sequences1, k, NORMALIZE_NO);
+  *inter2 = tsequenceset_make_trusted_free(sequences2, k, NORMALIZE_NO);
   return true;
 }
 
@@ -696,8 +742,8 @@ intersection_tsequenceset_tinstantset(const TSequenceSet *ts,
     return false;
   }
 
-  *inter1 = tinstantset_make_free(instants1, k, MERGE_NO);
-  *inter2 = tinstantset_make(instants2, k, MERGE_NO);
+  *inter1 = tinstantset_make_trusted_free(instants1, k);
+  *inter2 = tinstantset_make_trusted(instants2, k);
   pfree(instants2);
   return true;
 }
@@ -1790,7 +1836,7 @@ tsequenceset_restrict_value(const TSequenceSet *ts, Datum value, bool atfunc)
     const TSequence *seq = tsequenceset_seq_n(ts, i);
     k += tsequence_restrict_value1(seq, value, atfunc, &sequences[k]);
   }
-  return tsequenceset_make_free(sequences, k, NORMALIZE);
+  return tsequenceset_make_trusted_free(sequences, k, NORMALIZE);
 }
 
 /**
@@ -1822,7 +1868,8 @@ tsequenceset_restrict_values(const TSequenceSet *ts, const Datum *values,
     const TSequence *seq = tsequenceset_seq_n(ts, i);
     k += tsequence_at_values1(seq, values, count, &sequences[k]);
   }
-  TSequenceSet *atresult = tsequenceset_make_free(sequences, k, NORMALIZE);
+  TSequenceSet *atresult = tsequenceset_make_trusted_free(sequences, k,
+    NORMALIZE);
   if (atfunc)
     return atresult;
 
@@ -1874,7 +1921,7 @@ tnumberseqset_restrict_range(const TSequenceSet *ts, const RangeType *range,
     const TSequence *seq = tsequenceset_seq_n(ts, i);
     k += tnumberseq_restrict_range2(seq, range, atfunc, &sequences[k]);
   }
-  return tsequenceset_make_free(sequences, k, NORMALIZE);
+  return tsequenceset_make_trusted_free(sequences, k, NORMALIZE);
 }
 
 /**
@@ -1912,7 +1959,7 @@ tnumberseqset_restrict_ranges(const TSequenceSet *ts, RangeType **normranges,
     k += tnumberseq_restrict_ranges1(seq, normranges, count, atfunc,
       BBOX_TEST, &sequences[k]);
   }
-  return tsequenceset_make_free(sequences, k, NORMALIZE);
+  return tsequenceset_make_trusted_free(sequences, k, NORMALIZE);
 }
 
 /**
@@ -1978,7 +2025,8 @@ tsequenceset_restrict_timestamp(const TSequenceSet *ts, TimestampTz t,
       sequences[k++] = tsequence_copy(tsequenceset_seq_n(ts, j));
     /* k is never equal to 0 since in that case it is a singleton sequence set
        and it has been dealt by tsequence_minus_timestamp above */
-    return (Temporal *) tsequenceset_make_free(sequences, k, NORMALIZE_NO);
+    return (Temporal *) tsequenceset_make_trusted_free(sequences, k,
+      NORMALIZE_NO);
   }
 }
 
@@ -1998,8 +2046,8 @@ tsequenceset_restrict_timestampset(const TSequenceSet *ts1,
     if (atfunc && temp != NULL)
     {
       TInstant *inst = (TInstant *) temp;
-      Temporal *result = (Temporal *) tinstantset_make((const TInstant **) &inst,
-        1, MERGE_NO);
+      Temporal *result = (Temporal *) tinstantset_make_trusted((const TInstant **) &inst,
+        1);
       pfree(inst);
       return result;
     }
@@ -2043,7 +2091,7 @@ tsequenceset_restrict_timestampset(const TSequenceSet *ts1,
           j++;
       }
     }
-    return (Temporal *) tinstantset_make_free(instants, count, MERGE_NO);
+    return (Temporal *) tinstantset_make_trusted_free(instants, count);
   }
   else
   {
@@ -2058,7 +2106,7 @@ tsequenceset_restrict_timestampset(const TSequenceSet *ts1,
       k += tsequence_minus_timestampset1(seq, ts2, &sequences[k]);
 
     }
-    return (Temporal *) tsequenceset_make_free(sequences, k, NORMALIZE);
+    return (Temporal *) tsequenceset_make_trusted_free(sequences, k, NORMALIZE);
   }
 }
 
@@ -2124,7 +2172,8 @@ tsequenceset_restrict_period(const TSequenceSet *ts, const Period *p,
     }
     /* Since both the tsequenceset and the period are normalized it is not
      * necessary to normalize the result of the projection */
-    result = tsequenceset_make((const TSequence **) sequences, k, NORMALIZE_NO);
+    result = tsequenceset_make_trusted((const TSequence **) sequences, k,
+      NORMALIZE_NO);
     for (int i = 0; i < l; i++)
       pfree(tofree[i]);
     pfree(sequences);
@@ -2233,7 +2282,7 @@ tsequenceset_restrict_periodset(const TSequenceSet *ts, const PeriodSet *ps,
   }
   /* It is necessary to normalize despite the fact that both the tsequenceset
   * and the periodset are normalized */
-  return tsequenceset_make_free(sequences, k, NORMALIZE);
+  return tsequenceset_make_trusted_free(sequences, k, NORMALIZE);
 }
 
 /*****************************************************************************
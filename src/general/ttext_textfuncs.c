@@ -29,15 +29,17 @@
 
 /**
  * @file ttext_textfuncs.c
- * @brief Temporal text functions: `textcat`, `lower`, `upper`.
+ * @brief Temporal text functions: `textcat`, `lower`, `upper`, and pattern
+ * matching.
  */
 
 #include "general/ttext_textfuncs.h"
 
 /* PostgreSQL */
+#include <access/hash.h>
 #include <utils/builtins.h>
 /* MobilityDB */
-#include "general/temporal.h"
+#include "general/temporaltypes.h"
 #include "general/temporal_util.h"
 #include "general/lifting.h"
 
@@ -133,6 +135,301 @@ textfunc_ttext_ttext(const Temporal *temp1, const Temporal *temp2,
   return tfunc_temporal_temporal(temp1, temp2, &lfinfo);
 }
 
+/*****************************************************************************
+ * Pattern matching functions
+ *****************************************************************************/
+
+/**
+ * Create the structure used for matching a pattern against the values of
+ * temporal text values
+ *
+ * @note The structure keeps a direct-mapped cache of the strings already
+ * tested so that the pattern is evaluated once per distinct string. The cache
+ * is also reused across temporal values when the caller keeps the structure,
+ * as it is done by the PostgreSQL functions for each call site.
+ */
+TextPattern *
+textpattern_make(const text *pattern, PatternKind kind, Oid collation)
+{
+  TextPattern *result = palloc0(sizeof(TextPattern));
+  result->kind = kind;
+  result->collation = collation;
+  result->pattern = (text *) PG_DETOAST_DATUM_COPY(PointerGetDatum(pattern));
+  result->mcxt = CurrentMemoryContext;
+  return result;
+}
+
+/**
+ * Free the structure used for matching a pattern
+ */
+void
+textpattern_free(TextPattern *pat)
+{
+  for (int i = 0; i < PATTERN_CACHE_SIZE; i++)
+  {
+    if (pat->cache[i].value)
+      pfree(pat->cache[i].value);
+  }
+  pfree(pat->pattern);
+  pfree(pat);
+  return;
+}
+
+/**
+ * Return true if the text value matches the pattern.
+ *
+ * The result is looked up in the cache of the structure before calling the
+ * PostgreSQL matching function. Regular expressions are compiled by
+ * PostgreSQL, which keeps the compiled expressions in its own cache.
+ */
+bool
+textpattern_match(TextPattern *pat, Datum value)
+{
+  text *txt = DatumGetTextPP(value);
+  int len = VARSIZE_ANY_EXHDR(txt);
+  uint32 hash = DatumGetUInt32(hash_any((unsigned char *) VARDATA_ANY(txt),
+    len));
+  PatternMatch *entry = &pat->cache[hash % PATTERN_CACHE_SIZE];
+  if (entry->value && entry->hash == hash &&
+      (int) VARSIZE_ANY_EXHDR(entry->value) == len &&
+      memcmp(VARDATA_ANY(entry->value), VARDATA_ANY(txt), len) == 0)
+    return entry->match;
+
+  PGFunction func = (pat->kind == PATTERN_LIKE) ? &textlike :
+    ((pat->kind == PATTERN_ILIKE) ? &texticlike : &textregexeq);
+  bool result = DatumGetBool(DirectFunctionCall2Coll(func, pat->collation,
+    PointerGetDatum(txt), PointerGetDatum(pat->pattern)));
+  /* Replace the entry of the cache */
+  MemoryContext oldcontext = MemoryContextSwitchTo(pat->mcxt);
+  if (entry->value)
+    pfree(entry->value);
+  entry->value = (text *) PG_DETOAST_DATUM_COPY(PointerGetDatum(txt));
+  MemoryContextSwitchTo(oldcontext);
+  entry->hash = hash;
+  entry->match = result;
+  return result;
+}
+
+/**
+ * Return a temporal Boolean stating whether the value of the temporal text
+ * instant matches the pattern
+ */
+static TInstant *
+tinstant_match_pattern(const TInstant *inst, TextPattern *pat)
+{
+  bool match = textpattern_match(pat, tinstant_value(inst));
+  return tinstant_make(BoolGetDatum(match), inst->t, T_TBOOL);
+}
+
+/**
+ * Return a temporal Boolean stating whether the values of the temporal text
+ * instant set match the pattern
+ */
+static TInstantSet *
+tinstantset_match_pattern(const TInstantSet *ti, TextPattern *pat)
+{
+  TInstant **instants = palloc(sizeof(TInstant *) * ti->count);
+  for (int i = 0; i < ti->count; i++)
+    instants[i] = tinstant_match_pattern(tinstantset_inst_n(ti, i), pat);
+  return tinstantset_make_trusted_free(instants, ti->count);
+}
+
+/**
+ * Return a temporal Boolean stating whether the values of the temporal text
+ * sequence match the pattern.
+ *
+ * The result is built run-wise, that is, only the instants starting a new
+ * run of equal Boolean values and the last instant are kept, which yields a
+ * normalized sequence.
+ */
+static TSequence *
+tsequence_match_pattern(const TSequence *seq, TextPattern *pat)
+{
+  TInstant **instants = palloc(sizeof(TInstant *) * seq->count);
+  const TInstant *inst = tsequence_inst_n(seq, 0);
+  bool match = textpattern_match(pat, tinstant_value(inst));
+  instants[0] = tinstant_make(BoolGetDatum(match), inst->t, T_TBOOL);
+  int k = 1;
+  for (int i = 1; i < seq->count; i++)
+  {
+    inst = tsequence_inst_n(seq, i);
+    bool match1 = textpattern_match(pat, tinstant_value(inst));
+    if (match1 != match || i == seq->count - 1)
+      instants[k++] = tinstant_make(BoolGetDatum(match1), inst->t, T_TBOOL);
+    match = match1;
+  }
+  return tsequence_make_trusted_free(instants, k, seq->period.lower_inc,
+    seq->period.upper_inc, STEP, NORMALIZE_NO);
+}
+
+/**
+ * Return a temporal Boolean stating whether the values of the temporal text
+ * sequence set match the pattern
+ */
+static TSequenceSet *
+tsequenceset_match_pattern(const TSequenceSet *ts, TextPattern *pat)
+{
+  TSequence **sequences = palloc(sizeof(TSequence *) * ts->count);
+  for (int i = 0; i < ts->count; i++)
+    sequences[i] = tsequence_match_pattern(tsequenceset_seq_n(ts, i), pat);
+  return tsequenceset_make_trusted_free(sequences, ts->count, NORMALIZE);
+}
+
+/**
+ * Return a temporal Boolean stating whether the values of the temporal text
+ * match the pattern
+ */
+Temporal *
+ttext_match_pattern(const Temporal *temp, TextPattern *pat)
+{
+  Temporal *result;
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT)
+    result = (Temporal *) tinstant_match_pattern((TInstant *) temp, pat);
+  else if (temp->subtype == INSTANTSET)
+    result = (Temporal *) tinstantset_match_pattern((TInstantSet *) temp, pat);
+  else if (temp->subtype == SEQUENCE)
+    result = (Temporal *) tsequence_match_pattern((TSequence *) temp, pat);
+  else /* temp->subtype == SEQUENCESET */
+    result = (Temporal *) tsequenceset_match_pattern((TSequenceSet *) temp,
+      pat);
+  return result;
+}
+
+/*****************************************************************************/
+
+/**
+ * Restrict the temporal text instant set to (the complement of) the values
+ * matching the pattern
+ */
+static TInstantSet *
+tinstantset_restrict_pattern(const TInstantSet *ti, TextPattern *pat,
+  bool atfunc)
+{
+  const TInstant **instants = palloc(sizeof(TInstant *) * ti->count);
+  int k = 0;
+  for (int i = 0; i < ti->count; i++)
+  {
+    const TInstant *inst = tinstantset_inst_n(ti, i);
+    if (textpattern_match(pat, tinstant_value(inst)) == atfunc)
+      instants[k++] = inst;
+  }
+  TInstantSet *result = (k == 0) ? NULL :
+    tinstantset_make_trusted(instants, k);
+  pfree(instants);
+  return result;
+}
+
+/**
+ * Restrict the temporal text sequence to (the complement of) the values
+ * matching the pattern
+ *
+ * @param[out] result Array on which the pointers of the newly constructed
+ * sequences are stored
+ * @param[in] seq Temporal value
+ * @param[in] pat Pattern
+ * @param[in] atfunc True when the restriction is at, false for minus
+ * @return Number of resulting sequences returned
+ * @note Since temporal text values have step interpolation, each maximal run
+ * of instants whose values are kept yields one sequence, which is closed by
+ * an exclusive instant at the timestamp of the next instant.
+ */
+static int
+tsequence_restrict_pattern1(const TSequence *seq, TextPattern *pat,
+  bool atfunc, TSequence **result)
+{
+  /* Instantaneous sequence */
+  if (seq->count == 1)
+  {
+    const TInstant *inst = tsequence_inst_n(seq, 0);
+    if (textpattern_match(pat, tinstant_value(inst)) != atfunc)
+      return 0;
+    result[0] = tsequence_copy(seq);
+    return 1;
+  }
+
+  /* General case */
+  const TInstant **instants = palloc(sizeof(TInstant *) * (seq->count + 1));
+  bool lower_inc = seq->period.lower_inc;
+  int ninsts = 0, k = 0;
+  for (int i = 0; i < seq->count; i++)
+  {
+    const TInstant *inst = tsequence_inst_n(seq, i);
+    if (textpattern_match(pat, tinstant_value(inst)) == atfunc)
+    {
+      if (ninsts == 0)
+        lower_inc = (i == 0) ? seq->period.lower_inc : true;
+      instants[ninsts++] = inst;
+    }
+    else if (ninsts > 0)
+    {
+      TInstant *end = tinstant_make(tinstant_value(instants[ninsts - 1]),
+        inst->t, seq->temptype);
+      instants[ninsts++] = end;
+      result[k++] = tsequence_make_trusted(instants, ninsts, lower_inc, false,
+        STEP, NORMALIZE);
+      pfree(end);
+      ninsts = 0;
+    }
+  }
+  /* A run reaching the end of the sequence keeps its upper bound. With an
+   * exclusive upper bound the last two values are equal and thus the run
+   * has at least two instants */
+  if (ninsts > 0)
+    result[k++] = tsequence_make_trusted(instants, ninsts, lower_inc,
+      seq->period.upper_inc, STEP, NORMALIZE);
+  pfree(instants);
+  return k;
+}
+
+/**
+ * Restrict the temporal text sequence set to (the complement of) the values
+ * matching the pattern
+ */
+static TSequenceSet *
+tsequenceset_restrict_pattern(const TSequenceSet *ts, TextPattern *pat,
+  bool atfunc)
+{
+  TSequence **sequences = palloc(sizeof(TSequence *) * ts->totalcount);
+  int k = 0;
+  for (int i = 0; i < ts->count; i++)
+    k += tsequence_restrict_pattern1(tsequenceset_seq_n(ts, i), pat, atfunc,
+      &sequences[k]);
+  return tsequenceset_make_trusted_free(sequences, k, NORMALIZE);
+}
+
+/**
+ * Restrict the temporal text value to (the complement of) the values matching
+ * the pattern
+ */
+Temporal *
+ttext_restrict_pattern(const Temporal *temp, TextPattern *pat, bool atfunc)
+{
+  Temporal *result;
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT)
+  {
+    const TInstant *inst = (const TInstant *) temp;
+    result = (textpattern_match(pat, tinstant_value(inst)) == atfunc) ?
+      (Temporal *) tinstant_copy(inst) : NULL;
+  }
+  else if (temp->subtype == INSTANTSET)
+    result = (Temporal *) tinstantset_restrict_pattern((TInstantSet *) temp,
+      pat, atfunc);
+  else if (temp->subtype == SEQUENCE)
+  {
+    const TSequence *seq = (const TSequence *) temp;
+    TSequence **sequences = palloc(sizeof(TSequence *) * seq->count);
+    int count = tsequence_restrict_pattern1(seq, pat, atfunc, sequences);
+    result = (Temporal *) tsequenceset_make_trusted_free(sequences, count,
+      NORMALIZE);
+  }
+  else /* temp->subtype == SEQUENCESET */
+    result = (Temporal *) tsequenceset_restrict_pattern((TSequenceSet *) temp,
+      pat, atfunc);
+  return result;
+}
+
 /*****************************************************************************/
 /*****************************************************************************/
 /*                        MobilityDB - PostgreSQL                            */
@@ -218,6 +515,126 @@ Ttext_lower(PG_FUNCTION_ARGS)
   PG_RETURN_POINTER(result);
 }
 
+/*****************************************************************************
+ * Pattern matching
+ *****************************************************************************/
+
+/**
+ * Return the pattern structure cached for the call site, which is created
+ * again only when the pattern or the collation changes
+ */
+static TextPattern *
+textpattern_cached(FunctionCallInfo fcinfo, text *pattern, PatternKind kind)
+{
+  TextPattern *pat = (TextPattern *) fcinfo->flinfo->fn_extra;
+  Oid collation = PG_GET_COLLATION();
+  int len = VARSIZE_ANY_EXHDR(pattern);
+  if (pat != NULL && pat->kind == kind && pat->collation == collation &&
+      (int) VARSIZE_ANY_EXHDR(pat->pattern) == len &&
+      memcmp(VARDATA_ANY(pat->pattern), VARDATA_ANY(pattern), len) == 0)
+    return pat;
+
+  if (pat != NULL)
+    textpattern_free(pat);
+  MemoryContext oldcontext =
+    MemoryContextSwitchTo(fcinfo->flinfo->fn_mcxt);
+  pat = textpattern_make(pattern, kind, collation);
+  MemoryContextSwitchTo(oldcontext);
+  fcinfo->flinfo->fn_extra = pat;
+  return pat;
+}
+
+/**
+ * Return a temporal Boolean stating whether the values of the temporal text
+ * match the pattern
+ */
+static Datum
+ttext_match_pattern_ext(FunctionCallInfo fcinfo, PatternKind kind)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  text *pattern = PG_GETARG_TEXT_PP(1);
+  TextPattern *pat = textpattern_cached(fcinfo, pattern, kind);
+  Temporal *result = ttext_match_pattern(temp, pat);
+  PG_FREE_IF_COPY(temp, 0);
+  PG_FREE_IF_COPY(pattern, 1);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Ttext_like);
+/**
+ * Return a temporal Boolean stating whether the values of the temporal text
+ * match the LIKE pattern
+ */
+PGDLLEXPORT Datum
+Ttext_like(PG_FUNCTION_ARGS)
+{
+  return ttext_match_pattern_ext(fcinfo, PATTERN_LIKE);
+}
+
+PG_FUNCTION_INFO_V1(Ttext_ilike);
+/**
+ * Return a temporal Boolean stating whether the values of the temporal text
+ * match the case-insensitive LIKE pattern
+ */
+PGDLLEXPORT Datum
+Ttext_ilike(PG_FUNCTION_ARGS)
+{
+  return ttext_match_pattern_ext(fcinfo, PATTERN_ILIKE);
+}
+
+PG_FUNCTION_INFO_V1(Ttext_regexp_like);
+/**
+ * Return a temporal Boolean stating whether the values of the temporal text
+ * match the POSIX regular expression
+ */
+PGDLLEXPORT Datum
+Ttext_regexp_like(PG_FUNCTION_ARGS)
+{
+  return ttext_match_pattern_ext(fcinfo, PATTERN_REGEX);
+}
+
+/**
+ * Restrict the temporal text value to (the complement of) the values
+ * matching the pattern, which is a LIKE pattern unless the optional third
+ * argument states that it is a regular expression
+ */
+static Datum
+ttext_restrict_pattern_ext(FunctionCallInfo fcinfo, bool atfunc)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  text *pattern = PG_GETARG_TEXT_PP(1);
+  bool regex = (PG_NARGS() > 2) ? PG_GETARG_BOOL(2) : false;
+  TextPattern *pat = textpattern_cached(fcinfo, pattern,
+    regex ? PATTERN_REGEX : PATTERN_LIKE);
+  Temporal *result = ttext_restrict_pattern(temp, pat, atfunc);
+  PG_FREE_IF_COPY(temp, 0);
+  PG_FREE_IF_COPY(pattern, 1);
+  if (! result)
+    PG_RETURN_NULL();
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Ttext_at_pattern);
+/**
+ * Restrict the temporal text value to the values matching the pattern
+ */
+PGDLLEXPORT Datum
+Ttext_at_pattern(PG_FUNCTION_ARGS)
+{
+  return ttext_restrict_pattern_ext(fcinfo, REST_AT);
+}
+
+PG_FUNCTION_INFO_V1(Ttext_minus_pattern);
+/**
+ * Restrict the temporal text value to the complement of the values matching
+ * the pattern
+ */
+PGDLLEXPORT Datum
+Ttext_minus_pattern(PG_FUNCTION_ARGS)
+{
+  return ttext_restrict_pattern_ext(fcinfo, REST_MINUS);
+}
+
 #endif /* #ifndef MEOS */
 
 /*****************************************************************************/
@@ -29,12 +29,14 @@
 
 /**
  * @file ttext_textfuncs.c
- * @brief Temporal text functions: `textcat`, `lower`, `upper`.
+ * @brief Temporal text functions: `textcat`, `lower`, `upper`, and pattern
+ * matching.
  */
 
 #include "general/ttext_textfuncs.h"
 
 /* PostgreSQL */
+#include <catalog/pg_collation.h>
 #include <utils/builtins.h>
 /* MobilityDB */
 #include "general/temporal.h"
@@ -102,3 +104,84 @@ ttext_lower(const Temporal *temp)
 }
 
 /*****************************************************************************/
+
+/*****************************************************************************
+ * Pattern matching
+ *****************************************************************************/
+
+/**
+ * @ingroup libmeos_temporal_text
+ * @brief Return a temporal Boolean stating whether the values of the temporal
+ * text match the LIKE pattern
+ */
+Temporal *
+ttext_like(const Temporal *temp, const text *pattern)
+{
+  TextPattern *pat = textpattern_make(pattern, PATTERN_LIKE,
+    DEFAULT_COLLATION_OID);
+  Temporal *result = ttext_match_pattern(temp, pat);
+  textpattern_free(pat);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_text
+ * @brief Return a temporal Boolean stating whether the values of the temporal
+ * text match the case-insensitive LIKE pattern
+ */
+Temporal *
+ttext_ilike(const Temporal *temp, const text *pattern)
+{
+  TextPattern *pat = textpattern_make(pattern, PATTERN_ILIKE,
+    DEFAULT_COLLATION_OID);
+  Temporal *result = ttext_match_pattern(temp, pat);
+  textpattern_free(pat);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_text
+ * @brief Return a temporal Boolean stating whether the values of the temporal
+ * text match the POSIX regular expression
+ */
+Temporal *
+ttext_regexp_like(const Temporal *temp, const text *pattern)
+{
+  TextPattern *pat = textpattern_make(pattern, PATTERN_REGEX,
+    DEFAULT_COLLATION_OID);
+  Temporal *result = ttext_match_pattern(temp, pat);
+  textpattern_free(pat);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_text
+ * @brief Restrict the temporal text value to the values matching the LIKE
+ * pattern or the regular expression
+ */
+Temporal *
+ttext_at_pattern(const Temporal *temp, const text *pattern, bool regex)
+{
+  TextPattern *pat = textpattern_make(pattern,
+    regex ? PATTERN_REGEX : PATTERN_LIKE, DEFAULT_COLLATION_OID);
+  Temporal *result = ttext_restrict_pattern(temp, pat, REST_AT);
+  textpattern_free(pat);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_text
+ * @brief Restrict the temporal text value to the complement of the values
+ * matching the LIKE pattern or the regular expression
+ */
+Temporal *
+ttext_minus_pattern(const Temporal *temp, const text *pattern, bool regex)
+{
+  TextPattern *pat = textpattern_make(pattern,
+    regex ? PATTERN_REGEX : PATTERN_LIKE, DEFAULT_COLLATION_OID);
+  Temporal *result = ttext_restrict_pattern(temp, pat, REST_MINUS);
+  textpattern_free(pat);
+  return result;
+}
+
+/*****************************************************************************/
@@ -31,19 +31,31 @@
  * @file tnpoint_aggfuncs.c
  * @brief Aggregate functions for temporal network points.
  *
- * The only function currently provided is temporal centroid.
+ * The functions provided are temporal centroid and edge statistics, which
+ * aggregate the traversal time, the distance, and the entry and exit counts
+ * of temporal network points by route and time bucket.
  */
 
 #include "npoint/tnpoint_aggfuncs.h"
 
 /* PostgreSQL */
 #include <assert.h>
+#include <math.h>
+#include <funcapi.h>
+#include <libpq/pqformat.h>
+#include <utils/array.h>
+#include <utils/lsyscache.h>
+#include <utils/typcache.h>
 /* MobilityDB */
 #include "general/temporal_aggfuncs.h"
+#include "general/temporaltypes.h"
+#include "general/temporal_tile.h"
+#include "general/temporal_util.h"
 #include "point/tpoint.h"
 #include "point/tpoint_spatialfuncs.h"
 #include "point/tpoint_aggfuncs.h"
 #include "npoint/tnpoint.h"
+#include "npoint/tnpoint_static.h"
 
 /*****************************************************************************/
 
@@ -55,8 +67,8 @@ PG_FUNCTION_INFO_V1(Tnpoint_tcentroid_transfn);
 PGDLLEXPORT Datum
 Tnpoint_tcentroid_transfn(PG_FUNCTION_ARGS)
 {
-  SkipList *state = PG_ARGISNULL(0) ? NULL :
-    (SkipList *) PG_GETARG_POINTER(0);
+  TCentroidState *state = PG_ARGISNULL(0) ? NULL :
+    (TCentroidState *) PG_GETARG_POINTER(0);
   if (PG_ARGISNULL(1))
   {
     if (state)
@@ -66,33 +78,389 @@ Tnpoint_tcentroid_transfn(PG_FUNCTION_ARGS)
   }
   Temporal *temp = PG_GETARG_TEMPORAL_P(1);
   Temporal *temp1 = tnpoint_tgeompoint(temp);
+  state = tpoint_tcentroid_transfn(fcinfo, state, temp1);
+  pfree(temp1);
+  PG_FREE_IF_COPY(temp, 1);
+  PG_RETURN_POINTER(state);
+}
+
+/*****************************************************************************
+ * Edge statistics
+ *****************************************************************************/
 
-  geoaggstate_check_temp(state, temp1);
-  Datum (*func)(Datum, Datum) = MOBDB_FLAGS_GET_Z(temp1->flags) ?
-    &datum_sum_double4 : &datum_sum_double3;
+/** Initial number of cells of edge statistics aggregation */
+#define EDGESTATS_INITIAL_CAPACITY 64
 
-  int count;
-  Temporal **temparr = tpoint_transform_tcentroid(temp1, &count);
-  if (state)
+/**
+ * Create an empty edge statistics state in the aggregate memory context
+ */
+static EdgeStatsState *
+edgestats_state_make(FunctionCallInfo fcinfo, int64 size, TimestampTz origin)
+{
+  MemoryContext ctx, oldctx;
+  if (! AggCheckCallContext(fcinfo, &ctx))
+    ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR),
+      errmsg("Operation not supported")));
+  oldctx = MemoryContextSwitchTo(ctx);
+  EdgeStatsState *result = palloc0(sizeof(EdgeStatsState));
+  result->size = size;
+  result->origin = origin;
+  HASHCTL info;
+  memset(&info, 0, sizeof(info));
+  info.keysize = sizeof(EdgeStatsKey);
+  info.entrysize = sizeof(EdgeStatsEntry);
+  info.hcxt = ctx;
+  result->cells = hash_create("Edge statistics state",
+    EDGESTATS_INITIAL_CAPACITY, &info, HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+  memset(&info, 0, sizeof(info));
+  info.keysize = sizeof(int64);
+  info.entrysize = sizeof(RouteLengthEntry);
+  info.hcxt = ctx;
+  result->lengths = hash_create("Edge statistics route lengths",
+    EDGESTATS_INITIAL_CAPACITY, &info, HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+  MemoryContextSwitchTo(oldctx);
+  return result;
+}
+
+/**
+ * Ensure that the time buckets of the edge statistics state are the given
+ * ones
+ */
+static void
+edgestats_state_check(const EdgeStatsState *state, int64 size,
+  TimestampTz origin)
+{
+  if (state->size != size || state->origin != origin)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The time buckets must be the same for all values of edge statistics aggregation")));
+  return;
+}
+
+/**
+ * Add the traversal time, the distance, and the entry and exit counts to the
+ * cell of the route and time bucket
+ */
+static void
+edgestats_state_add(EdgeStatsState *state, int64 rid, TimestampTz bucket,
+  int64 duration, double distance, int64 entries, int64 exits)
+{
+  EdgeStatsKey key;
+  bool found;
+  key.rid = rid;
+  key.bucket = bucket;
+  EdgeStatsEntry *entry = (EdgeStatsEntry *) hash_search(state->cells, &key,
+    HASH_ENTER, &found);
+  if (! found)
   {
-    ensure_same_tempsubtype_skiplist(state, temparr[0]);
-    skiplist_splice(fcinfo, state, (void **) temparr, count, func, false);
+    entry->duration = 0;
+    entry->distance = 0.0;
+    entry->entries = 0;
+    entry->exits = 0;
   }
-  else
+  entry->duration += duration;
+  entry->distance += distance;
+  entry->entries += entries;
+  entry->exits += exits;
+  return;
+}
+
+/**
+ * Return the length of the route, which is read from the edge table only the
+ * first time the route is found by the aggregation
+ */
+static double
+edgestats_route_length(EdgeStatsState *state, int64 rid)
+{
+  bool found;
+  RouteLengthEntry *entry = (RouteLengthEntry *) hash_search(state->lengths,
+    &rid, HASH_FIND, &found);
+  if (found)
+    return entry->length;
+  double length = route_length(rid);
+  entry = (RouteLengthEntry *) hash_search(state->lengths, &rid, HASH_ENTER,
+    &found);
+  entry->length = length;
+  return length;
+}
+
+/**
+ * Attribute the segment of a temporal network point sequence to the time
+ * buckets it spans. Since the position varies linearly with time within a
+ * segment, the distance of each part is proportional to its duration.
+ */
+static void
+tnpointsegm_edgestats(EdgeStatsState *state, const Npoint *np1,
+  const Npoint *np2, TimestampTz t1, TimestampTz t2, bool linear)
+{
+  double delta = linear ? fabs(np2->pos - np1->pos) : 0.0;
+  double length = (delta > 0.0) ? edgestats_route_length(state, np1->rid) :
+    0.0;
+  TimestampTz lower = t1;
+  TimestampTz bucket = timestamptz_bucket(lower, state->size, state->origin);
+  while (lower < t2)
   {
-    state = skiplist_make(fcinfo, (void **) temparr, count, TEMPORAL);
-    struct GeoAggregateState extra =
+    TimestampTz upper = Min(bucket + state->size, t2);
+    double distance = (delta > 0.0) ?
+      delta * length * (double) (upper - lower) / (double) (t2 - t1) : 0.0;
+    edgestats_state_add(state, np1->rid, bucket, upper - lower, distance, 0,
+      0);
+    lower = upper;
+    bucket += state->size;
+  }
+  return;
+}
+
+/**
+ * Add a temporal network point sequence to the edge statistics state.
+ *
+ * The instants are visited once. The sequence enters a route at its first
+ * instant and exits it at its last instant, step sequences may in addition
+ * change route at any instant.
+ */
+static void
+tnpointseq_edgestats(EdgeStatsState *state, const TSequence *seq)
+{
+  bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags);
+  const TInstant *inst1 = tsequence_inst_n(seq, 0);
+  const Npoint *np1 = DatumGetNpointP(tinstant_value(inst1));
+  edgestats_state_add(state, np1->rid,
+    timestamptz_bucket(inst1->t, state->size, state->origin), 0, 0.0, 1, 0);
+  for (int i = 1; i < seq->count; i++)
+  {
+    const TInstant *inst2 = tsequence_inst_n(seq, i);
+    const Npoint *np2 = DatumGetNpointP(tinstant_value(inst2));
+    tnpointsegm_edgestats(state, np1, np2, inst1->t, inst2->t, linear);
+    if (np1->rid != np2->rid)
     {
-      .srid = tpoint_srid(temp1),
-      .hasz = MOBDB_FLAGS_GET_Z(temp1->flags) != 0
-    };
-    aggstate_set_extra(fcinfo, state, &extra, sizeof(struct GeoAggregateState));
+      TimestampTz bucket = timestamptz_bucket(inst2->t, state->size,
+        state->origin);
+      edgestats_state_add(state, np1->rid, bucket, 0, 0.0, 0, 1);
+      edgestats_state_add(state, np2->rid, bucket, 0, 0.0, 1, 0);
+    }
+    inst1 = inst2;
+    np1 = np2;
+  }
+  edgestats_state_add(state, np1->rid,
+    timestamptz_bucket(inst1->t, state->size, state->origin), 0, 0.0, 0, 1);
+  return;
+}
+
+/**
+ * Add a temporal network point to the edge statistics state
+ */
+static void
+tnpoint_edgestats(EdgeStatsState *state, const Temporal *temp)
+{
+  if (temp->subtype == SEQUENCE)
+    tnpointseq_edgestats(state, (TSequence *) temp);
+  else if (temp->subtype == SEQUENCESET)
+  {
+    const TSequenceSet *ts = (TSequenceSet *) temp;
+    for (int i = 0; i < ts->count; i++)
+      tnpointseq_edgestats(state, tsequenceset_seq_n(ts, i));
   }
+  else
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("Edge statistics require temporal network points with sequence or sequence set subtype")));
+  return;
+}
 
-  pfree_array((void **) temparr, count);
-  pfree(temp1);
+PG_FUNCTION_INFO_V1(Tnpoint_edgestats_transfn);
+/**
+ * Transition function for edge statistics aggregation of temporal network
+ * points, which attributes the traversal time, the distance, and the entry
+ * and exit counts to cells defined by a route identifier and a time bucket
+ */
+PGDLLEXPORT Datum
+Tnpoint_edgestats_transfn(PG_FUNCTION_ARGS)
+{
+  EdgeStatsState *state = PG_ARGISNULL(0) ? NULL :
+    (EdgeStatsState *) PG_GETARG_POINTER(0);
+  if (PG_ARGISNULL(1) || PG_ARGISNULL(2) ||
+      (PG_NARGS() > 3 && PG_ARGISNULL(3)))
+  {
+    if (state)
+      PG_RETURN_POINTER(state);
+    else
+      PG_RETURN_NULL();
+  }
+  Temporal *temp = PG_GETARG_TEMPORAL_P(1);
+  Interval *duration = PG_GETARG_INTERVAL_P(2);
+  TimestampTz origin = (PG_NARGS() > 3) ? PG_GETARG_TIMESTAMPTZ(3) :
+    DatumGetTimestampTz(call_input(TIMESTAMPTZOID, "2000-01-03"));
+  ensure_valid_duration(duration);
+  int64 tunits = get_interval_units(duration);
+  if (! state)
+    state = edgestats_state_make(fcinfo, tunits, origin);
+  else
+    edgestats_state_check(state, tunits, origin);
+  tnpoint_edgestats(state, temp);
   PG_FREE_IF_COPY(temp, 1);
   PG_RETURN_POINTER(state);
 }
 
+PG_FUNCTION_INFO_V1(Tnpoint_edgestats_combinefn);
+/**
+ * Combine function for edge statistics aggregation of temporal network points
+ */
+PGDLLEXPORT Datum
+Tnpoint_edgestats_combinefn(PG_FUNCTION_ARGS)
+{
+  EdgeStatsState *state1 = PG_ARGISNULL(0) ? NULL :
+    (EdgeStatsState *) PG_GETARG_POINTER(0);
+  EdgeStatsState *state2 = PG_ARGISNULL(1) ? NULL :
+    (EdgeStatsState *) PG_GETARG_POINTER(1);
+  if (! state2)
+  {
+    if (state1)
+      PG_RETURN_POINTER(state1);
+    else
+      PG_RETURN_NULL();
+  }
+  if (! state1)
+    state1 = edgestats_state_make(fcinfo, state2->size, state2->origin);
+  else
+    edgestats_state_check(state1, state2->size, state2->origin);
+  HASH_SEQ_STATUS status;
+  EdgeStatsEntry *entry;
+  hash_seq_init(&status, state2->cells);
+  while ((entry = (EdgeStatsEntry *) hash_seq_search(&status)) != NULL)
+    edgestats_state_add(state1, entry->key.rid, entry->key.bucket,
+      entry->duration, entry->distance, entry->entries, entry->exits);
+  PG_RETURN_POINTER(state1);
+}
+
+/**
+ * Comparator of edge statistics cells on route identifier and time bucket
+ */
+static int
+edgestats_entry_cmp(const void *a, const void *b)
+{
+  const EdgeStatsEntry *e1 = *(const EdgeStatsEntry **) a;
+  const EdgeStatsEntry *e2 = *(const EdgeStatsEntry **) b;
+  if (e1->key.rid != e2->key.rid)
+    return (e1->key.rid < e2->key.rid) ? -1 : 1;
+  if (e1->key.bucket != e2->key.bucket)
+    return (e1->key.bucket < e2->key.bucket) ? -1 : 1;
+  return 0;
+}
+
+PG_FUNCTION_INFO_V1(Tnpoint_edgestats_finalfn);
+/**
+ * Final function for edge statistics aggregation of temporal network points.
+ * The result is an array of `edge_stats` records ordered by route identifier
+ * and time bucket.
+ */
+PGDLLEXPORT Datum
+Tnpoint_edgestats_finalfn(PG_FUNCTION_ARGS)
+{
+  /* The final function is strict, we do not need to test for null values */
+  EdgeStatsState *state = (EdgeStatsState *) PG_GETARG_POINTER(0);
+  int count = (int) hash_get_num_entries(state->cells);
+  if (count == 0)
+    PG_RETURN_NULL();
+
+  /* Collect the cells sorted by route identifier and time bucket */
+  EdgeStatsEntry **entries = palloc(sizeof(EdgeStatsEntry *) * count);
+  HASH_SEQ_STATUS status;
+  EdgeStatsEntry *entry;
+  int k = 0;
+  hash_seq_init(&status, state->cells);
+  while ((entry = (EdgeStatsEntry *) hash_seq_search(&status)) != NULL)
+    entries[k++] = entry;
+  qsort(entries, count, sizeof(EdgeStatsEntry *), &edgestats_entry_cmp);
+
+  /* Build the records of the result */
+  Oid elemtype = get_element_type(get_fn_expr_rettype(fcinfo->flinfo));
+  TupleDesc tupdesc = lookup_rowtype_tupdesc_copy(elemtype, -1);
+  BlessTupleDesc(tupdesc);
+  Datum *records = palloc(sizeof(Datum) * count);
+  for (int i = 0; i < count; i++)
+  {
+    Datum values[7];
+    bool isnull[7] = {0};
+    Interval *duration = palloc0(sizeof(Interval));
+    duration->time = entries[i]->duration;
+    values[0] = Int64GetDatum(entries[i]->key.rid);
+    values[1] = TimestampTzGetDatum(entries[i]->key.bucket);
+    values[2] = PointerGetDatum(duration);
+    values[3] = Float8GetDatum(entries[i]->distance);
+    if (entries[i]->duration > 0)
+      values[4] = Float8GetDatum(entries[i]->distance /
+        ((double) entries[i]->duration / USECS_PER_SEC));
+    else
+      isnull[4] = true;
+    values[5] = Int64GetDatum(entries[i]->entries);
+    values[6] = Int64GetDatum(entries[i]->exits);
+    HeapTuple tuple = heap_form_tuple(tupdesc, values, isnull);
+    records[i] = HeapTupleGetDatum(tuple);
+  }
+  ArrayType *result = construct_array(records, count, elemtype, -1, false,
+    'd');
+  pfree(entries);
+  pfree(records);
+  PG_RETURN_ARRAYTYPE_P(result);
+}
+
+PG_FUNCTION_INFO_V1(Tnpoint_edgestats_serialize);
+/**
+ * Serialize the state value of edge statistics aggregation
+ */
+PGDLLEXPORT Datum
+Tnpoint_edgestats_serialize(PG_FUNCTION_ARGS)
+{
+  EdgeStatsState *state = (EdgeStatsState *) PG_GETARG_POINTER(0);
+  StringInfoData buf;
+  pq_begintypsend(&buf);
+  pq_sendint64(&buf, state->size);
+  pq_sendint64(&buf, state->origin);
+  pq_sendint32(&buf, (uint32) hash_get_num_entries(state->cells));
+  HASH_SEQ_STATUS status;
+  EdgeStatsEntry *entry;
+  hash_seq_init(&status, state->cells);
+  while ((entry = (EdgeStatsEntry *) hash_seq_search(&status)) != NULL)
+  {
+    pq_sendint64(&buf, entry->key.rid);
+    pq_sendint64(&buf, entry->key.bucket);
+    pq_sendint64(&buf, entry->duration);
+    pq_sendfloat8(&buf, entry->distance);
+    pq_sendint64(&buf, entry->entries);
+    pq_sendint64(&buf, entry->exits);
+  }
+  PG_RETURN_BYTEA_P(pq_endtypsend(&buf));
+}
+
+PG_FUNCTION_INFO_V1(Tnpoint_edgestats_deserialize);
+/**
+ * Deserialize the state value of edge statistics aggregation
+ */
+PGDLLEXPORT Datum
+Tnpoint_edgestats_deserialize(PG_FUNCTION_ARGS)
+{
+  bytea *data = PG_GETARG_BYTEA_P(0);
+  StringInfoData buf =
+  {
+    .cursor = 0,
+    .data = VARDATA(data),
+    .len = VARSIZE(data) - VARHDRSZ,
+    .maxlen = VARSIZE(data) - VARHDRSZ
+  };
+  int64 size = pq_getmsgint64(&buf);
+  TimestampTz origin = (TimestampTz) pq_getmsgint64(&buf);
+  EdgeStatsState *result = edgestats_state_make(fcinfo, size, origin);
+  int count = (int) pq_getmsgint(&buf, 4);
+  for (int i = 0; i < count; i++)
+  {
+    int64 rid = pq_getmsgint64(&buf);
+    TimestampTz bucket = (TimestampTz) pq_getmsgint64(&buf);
+    int64 duration = pq_getmsgint64(&buf);
+    double distance = pq_getmsgfloat8(&buf);
+    int64 entries = pq_getmsgint64(&buf);
+    int64 exits = pq_getmsgint64(&buf);
+    edgestats_state_add(result, rid, bucket, duration, distance, entries,
+      exits);
+  }
+  PG_RETURN_POINTER(result);
+}
+
 /*****************************************************************************/
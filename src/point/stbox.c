@@ -37,6 +37,7 @@
 /* PostgreSQL */
 #include <assert.h>
 #include <utils/builtins.h>
+#include <utils/lsyscache.h>
 /* MobilityDB */
 #include "general/period.h"
 #include "general/timestampset.h"
@@ -1064,6 +1065,227 @@ adjacent_stbox_stbox(const STBOX *box1, const STBOX *box2)
   }
 }
 
+/*****************************************************************************
+ * Batch topological functions
+ *
+ * See the batch topological functions for temporal boxes, whose block
+ * kernels are shared by these functions.
+ *****************************************************************************/
+
+/**
+ * Return true if the spatiotemporal boxes satisfy the predicate
+ */
+static bool
+stbox_pred(BoxPred pred, const STBOX *box1, const STBOX *box2)
+{
+  if (pred == BOX_OVERLAPS)
+    return overlaps_stbox_stbox(box1, box2);
+  if (pred == BOX_CONTAINS)
+    return contains_stbox_stbox(box1, box2);
+  return contained_stbox_stbox(box1, box2);
+}
+
+/**
+ * Filter a block of spatiotemporal boxes with the same flags and SRID
+ * stored as a structure of arrays
+ */
+static void
+stbox_filter_block(const STBOX *box, BoxPred pred, bool hasx, bool hasz,
+  bool hast, const STBoxBuffer *block, int start, int count, uint8 *mask)
+{
+  memset(mask, 1, count);
+  if (hasx)
+  {
+    boxfilter_double(pred, box->xmin, box->xmax, &block->xmin[start],
+      &block->xmax[start], count, mask);
+    boxfilter_double(pred, box->ymin, box->ymax, &block->ymin[start],
+      &block->ymax[start], count, mask);
+  }
+  if (hasz)
+    boxfilter_double(pred, box->zmin, box->zmax, &block->zmin[start],
+      &block->zmax[start], count, mask);
+  if (hast)
+    boxfilter_timestamp(pred, box->tmin, box->tmax, &block->tmin[start],
+      &block->tmax[start], count, mask);
+  return;
+}
+
+/**
+ * Set the pointers of the arrays of the buffer to consecutive arrays of
+ * count elements starting at the address
+ */
+static void
+stboxbuf_set_arrays(STBoxBuffer *buf, char *ptr, int count)
+{
+  buf->xmin = (double *) ptr;
+  buf->xmax = buf->xmin + count;
+  buf->ymin = buf->xmax + count;
+  buf->ymax = buf->ymin + count;
+  buf->zmin = buf->ymax + count;
+  buf->zmax = buf->zmin + count;
+  buf->tmin = (TimestampTz *) (buf->zmax + count);
+  buf->tmax = buf->tmin + count;
+  return;
+}
+
+/**
+ * Copy the spatiotemporal boxes into the arrays of the buffer
+ */
+static void
+stboxbuf_set_boxes(STBoxBuffer *buf, const STBOX *boxes, int count)
+{
+  for (int i = 0; i < count; i++)
+  {
+    buf->xmin[i] = boxes[i].xmin;
+    buf->xmax[i] = boxes[i].xmax;
+    buf->ymin[i] = boxes[i].ymin;
+    buf->ymax[i] = boxes[i].ymax;
+    buf->zmin[i] = boxes[i].zmin;
+    buf->zmax[i] = boxes[i].zmax;
+    buf->tmin[i] = boxes[i].tmin;
+    buf->tmax[i] = boxes[i].tmax;
+  }
+  return;
+}
+
+/**
+ * @ingroup libmeos_box_topo
+ * @brief Construct a buffer storing the spatiotemporal boxes as a structure
+ * of arrays for the batch topological functions.
+ *
+ * @param[in] boxes Array of boxes
+ * @param[in] count Number of elements in the array
+ * @note All the boxes must have the same dimensions and SRID
+ */
+STBoxBuffer *
+stboxbuf_make(const STBOX *boxes, int count)
+{
+  assert(count > 0);
+  for (int i = 1; i < count; i++)
+  {
+    if (boxes[i].flags != boxes[0].flags || boxes[i].srid != boxes[0].srid)
+      ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+        errmsg("The boxes of the buffer must have the same dimensions and SRID")));
+  }
+  /* Allocate the structure and the arrays in a single chunk */
+  size_t size = double_pad(sizeof(STBoxBuffer)) +
+    (sizeof(double) * 6 + sizeof(TimestampTz) * 2) * count;
+  STBoxBuffer *result = palloc(size);
+  result->count = count;
+  result->srid = boxes[0].srid;
+  result->flags = boxes[0].flags;
+  stboxbuf_set_arrays(result,
+    (char *) result + double_pad(sizeof(STBoxBuffer)), count);
+  stboxbuf_set_boxes(result, boxes, count);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_box_topo
+ * @brief Set the bitmap of the spatiotemporal boxes of the buffer that
+ * satisfy the predicate with respect to the box and return the number of
+ * matches.
+ *
+ * @param[in] box Query box
+ * @param[in] buf Buffer of boxes
+ * @param[in] pred Predicate
+ * @param[out] bitmap Bitmap of (count + 7) / 8 bytes where bit j of byte i
+ * is set when box 8 * i + j is a match
+ */
+int
+stboxbuf_filter(const STBOX *box, const STBoxBuffer *buf, BoxPred pred,
+  uint8 *bitmap)
+{
+  /* Verify the dimensions and the SRID once for all the boxes */
+  STBOX tmpl;
+  memset(&tmpl, 0, sizeof(STBOX));
+  tmpl.srid = buf->srid;
+  tmpl.flags = buf->flags;
+  bool hasx, hasz, hast, geodetic;
+  topo_stbox_stbox_init(box, &tmpl, &hasx, &hasz, &hast, &geodetic);
+  uint8 mask[BOX_FILTER_BLOCK];
+  int result = 0;
+  for (int i = 0; i < buf->count; i += BOX_FILTER_BLOCK)
+  {
+    int n = Min(BOX_FILTER_BLOCK, buf->count - i);
+    stbox_filter_block(box, pred, hasx, hasz || geodetic, hast, buf, i, n,
+      mask);
+    result += boxfilter_bitmap(mask, n, &bitmap[i / 8]);
+  }
+  return result;
+}
+
+/**
+ * @ingroup libmeos_box_topo
+ * @brief Set the selection vector of the spatiotemporal boxes of the array
+ * that satisfy the predicate with respect to the box and return the number
+ * of matches.
+ *
+ * @param[in] box Query box
+ * @param[in] boxes Array of boxes
+ * @param[in] count Number of elements in the array
+ * @param[in] pred Predicate
+ * @param[out] sel Selection vector of count elements receiving the
+ * positions of the matches
+ */
+int
+stboxarr_filter(const STBOX *box, const STBOX *boxes, int count,
+  BoxPred pred, int *sel)
+{
+  /* Storage for transposing a block, with 8 arrays of 8-byte values */
+  double data[8 * BOX_FILTER_BLOCK];
+  STBoxBuffer block;
+  stboxbuf_set_arrays(&block, (char *) data, BOX_FILTER_BLOCK);
+  uint8 mask[BOX_FILTER_BLOCK];
+  bool hasx = false, hasz = false, hast = false, geodetic = false;
+  bool init = false;
+  int16 flags = 0;
+  int32 srid = 0;
+  int result = 0;
+  for (int i = 0; i < count; i += BOX_FILTER_BLOCK)
+  {
+    int n = Min(BOX_FILTER_BLOCK, count - i);
+    const STBOX *boxesblk = &boxes[i];
+    bool same = true;
+    for (int j = 1; j < n; j++)
+      same &= (boxesblk[j].flags == boxesblk[0].flags &&
+        boxesblk[j].srid == boxesblk[0].srid);
+    if (! same)
+    {
+      /* Boxes with different dimensions are verified pair by pair */
+      for (int j = 0; j < n; j++)
+        mask[j] = stbox_pred(pred, box, &boxesblk[j]);
+    }
+    else
+    {
+      if (! init || boxesblk[0].flags != flags || boxesblk[0].srid != srid)
+      {
+        topo_stbox_stbox_init(box, &boxesblk[0], &hasx, &hasz, &hast,
+          &geodetic);
+        flags = boxesblk[0].flags;
+        srid = boxesblk[0].srid;
+        init = true;
+      }
+      stboxbuf_set_boxes(&block, boxesblk, n);
+      stbox_filter_block(box, pred, hasx, hasz || geodetic, hast, &block, 0,
+        n, mask);
+    }
+    result += boxfilter_selection(mask, n, i, &sel[result]);
+  }
+  return result;
+}
+
+/**
+ * @ingroup libmeos_box_topo
+ * @brief Free the buffer of spatiotemporal boxes.
+ */
+void
+stboxbuf_free(STBoxBuffer *buf)
+{
+  pfree(buf);
+  return;
+}
+
 /*****************************************************************************
  * Position operators
  *****************************************************************************/
@@ -2308,6 +2530,93 @@ Adjacent_stbox_stbox(PG_FUNCTION_ARGS)
   PG_RETURN_BOOL(adjacent_stbox_stbox(box1, box2));
 }
 
+/*****************************************************************************/
+
+/**
+ * Return the positions of the spatiotemporal boxes of the array that satisfy
+ * the predicate with respect to the box
+ *
+ * @note The NULL elements of the array are skipped. The result is an empty
+ * array when the array is empty or no box satisfies the predicate.
+ */
+static Datum
+stboxarr_filter_ext(FunctionCallInfo fcinfo, BoxPred pred)
+{
+  STBOX *box = PG_GETARG_STBOX_P(0);
+  ArrayType *array = PG_GETARG_ARRAYTYPE_P(1);
+  Datum *values;
+  bool *nulls, byval;
+  int16 typlen;
+  char align;
+  int count;
+  get_typlenbyvalalign(ARR_ELEMTYPE(array), &typlen, &byval, &align);
+  deconstruct_array(array, ARR_ELEMTYPE(array), typlen, byval, align,
+    &values, &nulls, &count);
+  /* Copy the non-null boxes into a contiguous array keeping their position */
+  STBOX *boxes = palloc(sizeof(STBOX) * Max(count, 1));
+  int *pos = palloc(sizeof(int) * Max(count, 1));
+  int nboxes = 0;
+  for (int i = 0; i < count; i++)
+  {
+    if (nulls[i])
+      continue;
+    boxes[nboxes] = *DatumGetSTboxP(values[i]);
+    pos[nboxes++] = i;
+  }
+  int *sel = palloc(sizeof(int) * Max(nboxes, 1));
+  int nsel = (nboxes == 0) ? 0 :
+    stboxarr_filter(box, boxes, nboxes, pred, sel);
+  pfree(values); pfree(nulls); pfree(boxes);
+  PG_FREE_IF_COPY(array, 1);
+  ArrayType *result;
+  if (nsel == 0)
+    result = construct_empty_array(INT4OID);
+  else
+  {
+    /* The positions of the SQL array start at 1 */
+    Datum *positions = palloc(sizeof(Datum) * nsel);
+    for (int i = 0; i < nsel; i++)
+      positions[i] = Int32GetDatum(pos[sel[i]] + 1);
+    result = construct_array(positions, nsel, INT4OID, 4, true, 'i');
+    pfree(positions);
+  }
+  pfree(pos); pfree(sel);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Contains_stbox_stboxarr);
+/**
+ * Return the positions of the spatiotemporal boxes of the array that are
+ * contained by the spatiotemporal box
+ */
+PGDLLEXPORT Datum
+Contains_stbox_stboxarr(PG_FUNCTION_ARGS)
+{
+  return stboxarr_filter_ext(fcinfo, BOX_CONTAINS);
+}
+
+PG_FUNCTION_INFO_V1(Contained_stbox_stboxarr);
+/**
+ * Return the positions of the spatiotemporal boxes of the array that contain
+ * the spatiotemporal box
+ */
+PGDLLEXPORT Datum
+Contained_stbox_stboxarr(PG_FUNCTION_ARGS)
+{
+  return stboxarr_filter_ext(fcinfo, BOX_CONTAINED);
+}
+
+PG_FUNCTION_INFO_V1(Overlaps_stbox_stboxarr);
+/**
+ * Return the positions of the spatiotemporal boxes of the array that overlap
+ * the spatiotemporal box
+ */
+PGDLLEXPORT Datum
+Overlaps_stbox_stboxarr(PG_FUNCTION_ARGS)
+{
+  return stboxarr_filter_ext(fcinfo, BOX_OVERLAPS);
+}
+
 /*****************************************************************************
  * Position operators
  *****************************************************************************/
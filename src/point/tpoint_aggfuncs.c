@@ -38,6 +38,9 @@
 
 /* PostgreSQL */
 #include <assert.h>
+#include <math.h>
+#include <libpq/pqformat.h>
+#include <utils/hsearch.h>
 /* MobilityDB */
 #include "general/temporaltypes.h"
 #include "general/tempcache.h"
@@ -70,20 +73,6 @@ geoaggstate_check(const SkipList *state, int32_t srid, bool hasz)
   return;
 }
 
-/**
- * Check the validity of the temporal point values for aggregation
- */
-static void
-geoaggstate_check_state(const SkipList *state1, const SkipList *state2)
-{
-  if(! state2)
-    return ;
-  struct GeoAggregateState *extra2 = state2->extra;
-  if (extra2)
-    geoaggstate_check(state1, extra2->srid, extra2->hasz);
-  return;
-}
-
 /**
  * Check the validity of the temporal point values for aggregation
  */
@@ -276,6 +265,185 @@ Tpoint_extent_combinefn(PG_FUNCTION_ARGS)
  * Centroid
  *****************************************************************************/
 
+/**
+ * Add a value to a sum using Neumaier's compensated summation
+ *
+ * @param[inout] sum Running sum
+ * @param[inout] comp Running compensation of the lost low-order bits
+ * @param[in] value Value to add
+ */
+static void
+tcentroid_sum_add(double *sum, double *comp, double value)
+{
+  double t = *sum + value;
+  if (fabs(*sum) >= fabs(value))
+    *comp += (*sum - t) + value;
+  else
+    *comp += (value - t) + *sum;
+  *sum = t;
+  return;
+}
+
+/**
+ * Add the coordinates of a point to the entry of its timestamp
+ */
+static void
+tcentroid_state_add(TCentroidState *state, TimestampTz t, double x, double y,
+  double z, int64 count)
+{
+  bool found;
+  TCentroidEntry *entry = (TCentroidEntry *) hash_search(state->hash, &t,
+    HASH_ENTER, &found);
+  if (! found)
+  {
+    memset(entry->sum, 0, sizeof(entry->sum));
+    memset(entry->comp, 0, sizeof(entry->comp));
+    entry->count = 0;
+  }
+  tcentroid_sum_add(&entry->sum[0], &entry->comp[0], x);
+  tcentroid_sum_add(&entry->sum[1], &entry->comp[1], y);
+  if (state->hasz)
+    tcentroid_sum_add(&entry->sum[2], &entry->comp[2], z);
+  entry->count += count;
+  return;
+}
+
+/**
+ * Create an empty temporal centroid state in the aggregate memory context
+ */
+static TCentroidState *
+tcentroid_state_make(FunctionCallInfo fcinfo, int32 srid, bool hasz,
+  int16 subtype)
+{
+  MemoryContext ctx, oldctx;
+  TCentroidState *result;
+  if (! AggCheckCallContext(fcinfo, &ctx))
+    ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR),
+      errmsg("Operation not supported")));
+  oldctx = MemoryContextSwitchTo(ctx);
+  result = palloc0(sizeof(TCentroidState));
+  result->srid = srid;
+  result->hasz = hasz;
+  result->subtype = subtype;
+  if (subtype == INSTANT)
+  {
+    HASHCTL info;
+    memset(&info, 0, sizeof(info));
+    info.keysize = sizeof(TimestampTz);
+    info.entrysize = sizeof(TCentroidEntry);
+    info.hcxt = ctx;
+    result->hash = hash_create("Temporal centroid state",
+      TCENTROID_INITIAL_CAPACITY, &info, HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+  }
+  MemoryContextSwitchTo(oldctx);
+  return result;
+}
+
+/**
+ * Check the validity of the temporal point values for aggregation
+ */
+static void
+tcentroid_state_check(const TCentroidState *state, int32 srid, bool hasz,
+  int16 subtype)
+{
+  if (state->srid != srid)
+    ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR),
+      errmsg("Geometries must have the same SRID for temporal aggregation")));
+  if (state->hasz != hasz)
+    ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR),
+      errmsg("Geometries must have the same dimensionality for temporal aggregation")));
+  if (state->subtype != subtype)
+    ereport(ERROR, (errcode(ERRCODE_INTERNAL_ERROR),
+      errmsg("Cannot aggregate temporal values of different type")));
+  return;
+}
+
+/**
+ * Add the instants of a temporal point with instant or instant set subtype
+ * to the state, reading the coordinates directly from the points
+ */
+static void
+tpointinst_tcentroid_add(TCentroidState *state, const Temporal *temp)
+{
+  int count = (temp->subtype == INSTANT) ? 1 : ((TInstantSet *) temp)->count;
+  for (int i = 0; i < count; i++)
+  {
+    const TInstant *inst = (temp->subtype == INSTANT) ? (TInstant *) temp :
+      tinstantset_inst_n((TInstantSet *) temp, i);
+    if (state->hasz)
+    {
+      const POINT3DZ *point = datum_point3dz_p(tinstant_value(inst));
+      tcentroid_state_add(state, inst->t, point->x, point->y, point->z, 1);
+    }
+    else
+    {
+      const POINT2D *point = datum_point2d_p(tinstant_value(inst));
+      tcentroid_state_add(state, inst->t, point->x, point->y, 0.0, 1);
+    }
+  }
+  return;
+}
+
+/**
+ * Add the sequences of a temporal point with sequence or sequence set
+ * subtype to the skiplist of the state
+ *
+ * @note The raw-coordinate state does not apply to sequences, whose values
+ * are transformed into temporal double3/double4 values as before
+ */
+static void
+tpointseq_tcentroid_add(FunctionCallInfo fcinfo, TCentroidState *state,
+  const Temporal *temp)
+{
+  datum_func2 func = state->hasz ? &datum_sum_double4 : &datum_sum_double3;
+  int count;
+  Temporal **temparr = tpoint_transform_tcentroid(temp, &count);
+  if (state->seqstate)
+  {
+    ensure_same_tempsubtype_skiplist(state->seqstate, temparr[0]);
+    skiplist_splice(fcinfo, state->seqstate, (void **) temparr, count, func,
+      false);
+  }
+  else
+    state->seqstate = skiplist_make(fcinfo, (void **) temparr, count,
+      TEMPORAL);
+  pfree_array((void **) temparr, count);
+  return;
+}
+
+/**
+ * Transition function for temporal centroid aggregation of temporal point
+ * values
+ *
+ * Values with instant or instant set subtype accumulate compensated sums of
+ * their coordinates and counts per distinct timestamp in a hash table.
+ * Values with sequence or sequence set subtype keep the skiplist aggregation
+ * of temporal double3/double4 values since their interpolated values must be
+ * synchronized.
+ *
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[inout] state State, may be NULL
+ * @param[in] temp Temporal point
+ */
+TCentroidState *
+tpoint_tcentroid_transfn(FunctionCallInfo fcinfo, TCentroidState *state,
+  const Temporal *temp)
+{
+  int32 srid = tpoint_srid(temp);
+  bool hasz = MOBDB_FLAGS_GET_Z(temp->flags) != 0;
+  int16 subtype = (temp->subtype == INSTANT || temp->subtype == INSTANTSET) ?
+    INSTANT : SEQUENCE;
+  if (state)
+    tcentroid_state_check(state, srid, hasz, subtype);
+  else
+    state = tcentroid_state_make(fcinfo, srid, hasz, subtype);
+  if (subtype == INSTANT)
+    tpointinst_tcentroid_add(state, temp);
+  else
+    tpointseq_tcentroid_add(fcinfo, state, temp);
+  return state;
+}
+
 PG_FUNCTION_INFO_V1(Tpoint_tcentroid_transfn);
 /**
  * Transition function for temporal centroid aggregation of temporal point values
@@ -283,8 +451,8 @@ PG_FUNCTION_INFO_V1(Tpoint_tcentroid_transfn);
 PGDLLEXPORT Datum
 Tpoint_tcentroid_transfn(PG_FUNCTION_ARGS)
 {
-  SkipList *state = PG_ARGISNULL(0) ? NULL :
-    (SkipList *) PG_GETARG_POINTER(0);
+  TCentroidState *state = PG_ARGISNULL(0) ? NULL :
+    (TCentroidState *) PG_GETARG_POINTER(0);
   Temporal *temp = PG_ARGISNULL(1) ? NULL : PG_GETARG_TEMPORAL_P(1);
   /* Can't do anything with null inputs */
   if (! state && ! temp)
@@ -295,29 +463,7 @@ Tpoint_tcentroid_transfn(PG_FUNCTION_ARGS)
     PG_RETURN_POINTER(state);
   }
 
-  geoaggstate_check_temp(state, temp);
-  datum_func2 func = MOBDB_FLAGS_GET_Z(temp->flags) ?
-    &datum_sum_double4 : &datum_sum_double3;
-
-  int count;
-  Temporal **temparr = tpoint_transform_tcentroid(temp, &count);
-  if (state)
-  {
-    ensure_same_tempsubtype_skiplist(state, temparr[0]);
-    skiplist_splice(fcinfo, state, (void **) temparr, count, func, false);
-  }
-  else
-  {
-    state = skiplist_make(fcinfo, (void **) temparr, count, TEMPORAL);
-    struct GeoAggregateState extra =
-    {
-      .srid = tpoint_srid(temp),
-      .hasz = MOBDB_FLAGS_GET_Z(temp->flags) != 0
-    };
-    aggstate_set_extra(fcinfo, state, &extra, sizeof(struct GeoAggregateState));
-  }
-
-  pfree_array((void **) temparr, count);
+  state = tpoint_tcentroid_transfn(fcinfo, state, temp);
   PG_FREE_IF_COPY(temp, 1);
   PG_RETURN_POINTER(state);
 }
@@ -331,23 +477,88 @@ PG_FUNCTION_INFO_V1(Tpoint_tcentroid_combinefn);
 PGDLLEXPORT Datum
 Tpoint_tcentroid_combinefn(PG_FUNCTION_ARGS)
 {
-  SkipList *state1 = PG_ARGISNULL(0) ? NULL :
-    (SkipList *) PG_GETARG_POINTER(0);
-  SkipList *state2 = PG_ARGISNULL(1) ? NULL :
-    (SkipList *) PG_GETARG_POINTER(1);
-
-  geoaggstate_check_state(state1, state2);
-  struct GeoAggregateState *extra = NULL;
-  if (state1 && state1->extra)
-    extra = state1->extra;
-  if (state2 && state2->extra)
-    extra = state2->extra;
-  assert(extra != NULL);
-  datum_func2 func = extra->hasz ? &datum_sum_double4 : &datum_sum_double3;
-  SkipList *result = temporal_tagg_combinefn1(fcinfo, state1, state2,
-    func, false);
+  TCentroidState *state1 = PG_ARGISNULL(0) ? NULL :
+    (TCentroidState *) PG_GETARG_POINTER(0);
+  TCentroidState *state2 = PG_ARGISNULL(1) ? NULL :
+    (TCentroidState *) PG_GETARG_POINTER(1);
+  if (! state1 && ! state2)
+    PG_RETURN_NULL();
+  if (! state2)
+    PG_RETURN_POINTER(state1);
+  if (! state1)
+    PG_RETURN_POINTER(state2);
 
-  PG_RETURN_POINTER(result);
+  tcentroid_state_check(state1, state2->srid, state2->hasz, state2->subtype);
+  if (state1->subtype == INSTANT)
+  {
+    HASH_SEQ_STATUS status;
+    TCentroidEntry *entry;
+    hash_seq_init(&status, state2->hash);
+    while ((entry = (TCentroidEntry *) hash_seq_search(&status)) != NULL)
+    {
+      /* Add the sums and then the compensations of the second state */
+      tcentroid_state_add(state1, entry->t, entry->sum[0], entry->sum[1],
+        entry->sum[2], entry->count);
+      tcentroid_state_add(state1, entry->t, entry->comp[0], entry->comp[1],
+        entry->comp[2], 0);
+    }
+  }
+  else
+  {
+    datum_func2 func = state1->hasz ? &datum_sum_double4 : &datum_sum_double3;
+    state1->seqstate = temporal_tagg_combinefn1(fcinfo, state1->seqstate,
+      state2->seqstate, func, false);
+  }
+  PG_RETURN_POINTER(state1);
+}
+
+/*****************************************************************************/
+
+/**
+ * Comparator of the entries of a temporal centroid state by timestamp
+ */
+static int
+tcentroid_entry_cmp(const void *a, const void *b)
+{
+  TimestampTz t1 = (*(const TCentroidEntry **) a)->t;
+  TimestampTz t2 = (*(const TCentroidEntry **) b)->t;
+  return (t1 < t2) ? -1 : ((t1 > t2) ? 1 : 0);
+}
+
+/**
+ * Final function for temporal centroid aggregation of temporal point values
+ * with instant type. The output instants are built once from the sums of
+ * the entries sorted by timestamp.
+ */
+static TInstantSet *
+tcentroid_state_finalfn(const TCentroidState *state)
+{
+  int count = (int) hash_get_num_entries(state->hash);
+  TCentroidEntry **entries = palloc(sizeof(TCentroidEntry *) * count);
+  HASH_SEQ_STATUS status;
+  TCentroidEntry *entry;
+  int i = 0;
+  hash_seq_init(&status, state->hash);
+  while ((entry = (TCentroidEntry *) hash_seq_search(&status)) != NULL)
+    entries[i++] = entry;
+  qsort(entries, count, sizeof(TCentroidEntry *), &tcentroid_entry_cmp);
+
+  TInstant **instants = palloc(sizeof(TInstant *) * count);
+  for (i = 0; i < count; i++)
+  {
+    const TCentroidEntry *e = entries[i];
+    assert(e->count != 0);
+    double x = (e->sum[0] + e->comp[0]) / e->count;
+    double y = (e->sum[1] + e->comp[1]) / e->count;
+    double z = state->hasz ? (e->sum[2] + e->comp[2]) / e->count : 0.0;
+    /* Notice that for the moment we do not aggregate temporal geographic
+     * points */
+    Datum value = point_make(x, y, z, state->hasz, false, state->srid);
+    instants[i] = tinstant_make(value, e->t, T_TGEOMPOINT);
+    pfree(DatumGetPointer(value));
+  }
+  pfree(entries);
+  return tinstantset_make_free(instants, count, MERGE_NO);
 }
 
 /*****************************************************************************/
@@ -383,28 +594,6 @@ doublen_to_point(const TInstant *inst, int srid)
   return result;
 }
 
-/**
- * Final function for temporal centroid aggregation of temporal point values
- * with instant type
- *
- * @param[in] instants Temporal values
- * @param[in] count Number of elements in the array
- * @param[in] srid SRID of the values
- */
-static TInstantSet *
-tpointinst_tcentroid_finalfn(TInstant **instants, int count, int srid)
-{
-  TInstant **newinstants = palloc(sizeof(TInstant *) * count);
-  for (int i = 0; i < count; i++)
-  {
-    TInstant *inst = instants[i];
-    Datum value = doublen_to_point(inst, srid);
-    newinstants[i] = tinstant_make(value, inst->t, T_TGEOMPOINT);
-    pfree(DatumGetPointer(value));
-  }
-  return tinstantset_make_free(newinstants, count, MERGE_NO);
-}
-
 /**
  * Final function for temporal centroid aggregation of temporal point values
  * with sequence type
@@ -443,23 +632,109 @@ PGDLLEXPORT Datum
 Tpoint_tcentroid_finalfn(PG_FUNCTION_ARGS)
 {
   /* The final function is strict, we do not need to test for null values */
-  SkipList *state = (SkipList *) PG_GETARG_POINTER(0);
-  if (state->length == 0)
-    PG_RETURN_NULL();
+  TCentroidState *state = (TCentroidState *) PG_GETARG_POINTER(0);
+  Temporal *result;
+  if (state->subtype == INSTANT)
+  {
+    if (hash_get_num_entries(state->hash) == 0)
+      PG_RETURN_NULL();
+    result = (Temporal *) tcentroid_state_finalfn(state);
+  }
+  else /* state->subtype == SEQUENCE */
+  {
+    if (! state->seqstate || state->seqstate->length == 0)
+      PG_RETURN_NULL();
+    Temporal **values = (Temporal **) skiplist_values(fcinfo, state->seqstate);
+    result = (Temporal *) tpointseq_tcentroid_finalfn((TSequence **) values,
+      state->seqstate->length, state->srid);
+    pfree(values);
+  }
+  PG_RETURN_POINTER(result);
+}
 
-  Temporal **values = (Temporal **) skiplist_values(state);
-  int32_t srid = ((struct GeoAggregateState *) state->extra)->srid;
-  Temporal *result = NULL;
-  assert(values[0]->subtype == INSTANT || values[0]->subtype == SEQUENCE);
-  if (values[0]->subtype == INSTANT)
-    result = (Temporal *)tpointinst_tcentroid_finalfn(
-      (TInstant **)values, state->length, srid);
-  else /* values[0]->subtype == SEQUENCE */
-    result = (Temporal *)tpointseq_tcentroid_finalfn(
-      (TSequence **)values, state->length, srid);
+/*****************************************************************************/
 
-  pfree(values);
+PG_FUNCTION_INFO_V1(Tpoint_tcentroid_serialize);
+/**
+ * Serialize the state value of temporal centroid aggregation
+ */
+PGDLLEXPORT Datum
+Tpoint_tcentroid_serialize(PG_FUNCTION_ARGS)
+{
+  TCentroidState *state = (TCentroidState *) PG_GETARG_POINTER(0);
+  StringInfoData buf;
+  pq_begintypsend(&buf);
+  pq_sendint32(&buf, (uint32) state->srid);
+  pq_sendbyte(&buf, state->hasz ? 1 : 0);
+  pq_sendint16(&buf, state->subtype);
+  if (state->subtype == INSTANT)
+  {
+    HASH_SEQ_STATUS status;
+    TCentroidEntry *entry;
+    int ndims = state->hasz ? 3 : 2;
+    pq_sendint32(&buf, (uint32) hash_get_num_entries(state->hash));
+    hash_seq_init(&status, state->hash);
+    while ((entry = (TCentroidEntry *) hash_seq_search(&status)) != NULL)
+    {
+      pq_sendint64(&buf, entry->t);
+      pq_sendint64(&buf, entry->count);
+      for (int i = 0; i < ndims; i++)
+      {
+        pq_sendfloat8(&buf, entry->sum[i]);
+        pq_sendfloat8(&buf, entry->comp[i]);
+      }
+    }
+  }
+  else
+  {
+    pq_sendbyte(&buf, state->seqstate ? 1 : 0);
+    if (state->seqstate)
+      aggstate_write(fcinfo, state->seqstate, &buf);
+  }
+  PG_RETURN_BYTEA_P(pq_endtypsend(&buf));
+}
 
+PG_FUNCTION_INFO_V1(Tpoint_tcentroid_deserialize);
+/**
+ * Deserialize the state value of temporal centroid aggregation
+ */
+PGDLLEXPORT Datum
+Tpoint_tcentroid_deserialize(PG_FUNCTION_ARGS)
+{
+  bytea *data = PG_GETARG_BYTEA_P(0);
+  StringInfoData buf =
+  {
+    .cursor = 0,
+    .data = VARDATA(data),
+    .len = VARSIZE(data) - VARHDRSZ,
+    .maxlen = VARSIZE(data) - VARHDRSZ
+  };
+  int32 srid = (int32) pq_getmsgint(&buf, 4);
+  bool hasz = pq_getmsgbyte(&buf) != 0;
+  int16 subtype = (int16) pq_getmsgint(&buf, 2);
+  TCentroidState *result = tcentroid_state_make(fcinfo, srid, hasz, subtype);
+  if (subtype == INSTANT)
+  {
+    int count = (int) pq_getmsgint(&buf, 4);
+    int ndims = hasz ? 3 : 2;
+    for (int i = 0; i < count; i++)
+    {
+      bool found;
+      TimestampTz t = (TimestampTz) pq_getmsgint64(&buf);
+      TCentroidEntry *entry = (TCentroidEntry *) hash_search(result->hash, &t,
+        HASH_ENTER, &found);
+      entry->count = pq_getmsgint64(&buf);
+      memset(entry->sum, 0, sizeof(entry->sum));
+      memset(entry->comp, 0, sizeof(entry->comp));
+      for (int j = 0; j < ndims; j++)
+      {
+        entry->sum[j] = pq_getmsgfloat8(&buf);
+        entry->comp[j] = pq_getmsgfloat8(&buf);
+      }
+    }
+  }
+  else if (pq_getmsgbyte(&buf))
+    result->seqstate = aggstate_read(fcinfo, &buf);
   PG_RETURN_POINTER(result);
 }
 
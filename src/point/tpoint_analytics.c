@@ -1572,6 +1572,501 @@ tpoint_simplify(Temporal *temp, double eps_dist, double eps_speed)
   return result;
 }
 
+/*****************************************************************************
+ * Trajectory filtering functions
+ *****************************************************************************/
+
+/**
+ * Variance of the velocity assumed for the first instant of a sequence by
+ * the Kalman smoother, large enough to let the measurements dominate.
+ */
+#define KALMAN_VELOCITY_VARIANCE 1.0e6
+
+/**
+ * Signature of the functions smoothing the coordinates of an array of
+ * instants in place
+ */
+typedef void (*tpointinstarr_smooth_fn)(TInstant **, int, bool, double,
+  double);
+
+/**
+ * Remove from the array of instants those that cannot be reached from the
+ * last retained instant without exceeding the maximum speed or acceleration.
+ * The array is compacted in place and the first instant is always retained.
+ *
+ * @param[in,out] instants Array of instants
+ * @param[in] count Number of elements in the array
+ * @param[in] maxspeed Maximum speed in units per second
+ * @param[in] maxaccel Maximum acceleration in units per second squared,
+ * not verified when negative
+ * @param[in] func Distance function (2D, 3D, or geodetic)
+ * @result Number of retained instants
+ */
+static int
+tpointinstarr_filter_speed(const TInstant **instants, int count,
+  double maxspeed, double maxaccel, datum_func2 func)
+{
+  double prevspeed = -1.0;
+  int k = 1;
+  for (int i = 1; i < count; i++)
+  {
+    double speed = tpointinst_speed(instants[k - 1], instants[i], func);
+    if (speed > maxspeed)
+      continue;
+    if (maxaccel >= 0 && prevspeed >= 0)
+    {
+      double duration = (double) (instants[i]->t - instants[k - 1]->t) /
+        1000000;
+      if (fabs(speed - prevspeed) / duration > maxaccel)
+        continue;
+    }
+    instants[k++] = instants[i];
+    prevspeed = speed;
+  }
+  return k;
+}
+
+/**
+ * Remove the outliers of a temporal instant set point
+ */
+static TInstantSet *
+tpointinstset_filter_speed(const TInstantSet *ti, double maxspeed,
+  double maxaccel, datum_func2 func)
+{
+  const TInstant **instants = tinstantset_instants(ti);
+  int count = tpointinstarr_filter_speed(instants, ti->count, maxspeed,
+    maxaccel, func);
+  TInstantSet *result = tinstantset_make(instants, count, MERGE_NO);
+  pfree(instants);
+  return result;
+}
+
+/**
+ * Remove the outliers of a temporal sequence point
+ */
+static TSequence *
+tpointseq_filter_speed(const TSequence *seq, double maxspeed,
+  double maxaccel, datum_func2 func)
+{
+  const TInstant **instants = palloc(sizeof(TInstant *) * seq->count);
+  for (int i = 0; i < seq->count; i++)
+    instants[i] = tsequence_inst_n(seq, i);
+  int count = tpointinstarr_filter_speed(instants, seq->count, maxspeed,
+    maxaccel, func);
+  /* When the last instant is removed the retained one closes the sequence */
+  bool lower_inc = (count == 1) ? true : seq->period.lower_inc;
+  bool upper_inc = (count == 1 ||
+    instants[count - 1] != tsequence_inst_n(seq, seq->count - 1)) ? true :
+    seq->period.upper_inc;
+  TSequence *result = tsequence_make(instants, count, lower_inc, upper_inc,
+    MOBDB_FLAGS_GET_LINEAR(seq->flags), NORMALIZE);
+  pfree(instants);
+  return result;
+}
+
+/**
+ * Remove the outliers of a temporal sequence set point
+ */
+static TSequenceSet *
+tpointseqset_filter_speed(const TSequenceSet *ts, double maxspeed,
+  double maxaccel, datum_func2 func)
+{
+  TSequence **sequences = palloc(sizeof(TSequence *) * ts->count);
+  for (int i = 0; i < ts->count; i++)
+    sequences[i] = tpointseq_filter_speed(tsequenceset_seq_n(ts, i),
+      maxspeed, maxaccel, func);
+  return tsequenceset_make_free(sequences, ts->count, NORMALIZE);
+}
+
+/**
+ * @ingroup libmeos_temporal_input_analytics
+ * @brief Remove from the temporal point the instants that imply a speed or
+ * an acceleration greater than the given thresholds.
+ *
+ * The instants are visited in a single pass and each one is compared with
+ * the last retained instant, which avoids that a single spike also rejects
+ * its valid successor. The first instant of each sequence is taken as
+ * reference and thus always retained.
+ *
+ * @param[in] temp Temporal point
+ * @param[in] maxspeed Maximum speed in units per second, meters per second
+ * for geographies
+ * @param[in] maxaccel Maximum acceleration in units per second squared, not
+ * verified when negative
+ */
+Temporal *
+tpoint_filter_speed(const Temporal *temp, double maxspeed, double maxaccel)
+{
+  if (maxspeed <= 0)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The maximum speed must be greater than 0")));
+
+  Temporal *result;
+  datum_func2 func = distance_fn(temp->flags);
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT)
+    result = (Temporal *) tinstant_copy((TInstant *) temp);
+  else if (temp->subtype == INSTANTSET)
+    result = (Temporal *) tpointinstset_filter_speed((TInstantSet *) temp,
+      maxspeed, maxaccel, func);
+  else if (temp->subtype == SEQUENCE)
+    result = (Temporal *) tpointseq_filter_speed((TSequence *) temp,
+      maxspeed, maxaccel, func);
+  else /* temp->subtype == SEQUENCESET */
+    result = (Temporal *) tpointseqset_filter_speed((TSequenceSet *) temp,
+      maxspeed, maxaccel, func);
+  return result;
+}
+
+/*****************************************************************************/
+
+/**
+ * Overwrite the coordinates of the point of a temporal instant.
+ *
+ * @note The instant must be a private copy since the value is modified
+ * in place.
+ */
+static void
+tpointinst_set_coords(TInstant *inst, double x, double y, double z,
+  bool hasz)
+{
+  Datum value = tinstant_value(inst);
+  if (hasz)
+  {
+    POINT3DZ *pt = (POINT3DZ *) datum_point3dz_p(value);
+    pt->x = x; pt->y = y; pt->z = z;
+  }
+  else
+  {
+    POINT2D *pt = (POINT2D *) datum_point2d_p(value);
+    pt->x = x; pt->y = y;
+  }
+  return;
+}
+
+/**
+ * Return the median of the array of values, which is reordered.
+ * An insertion sort is used since the windows are small.
+ */
+static double
+double_median(double *values, int count)
+{
+  for (int i = 1; i < count; i++)
+  {
+    double value = values[i];
+    int j = i - 1;
+    while (j >= 0 && values[j] > value)
+    {
+      values[j + 1] = values[j];
+      j--;
+    }
+    values[j + 1] = value;
+  }
+  return (count % 2 == 1) ? values[count / 2] :
+    (values[count / 2 - 1] + values[count / 2]) / 2.0;
+}
+
+/**
+ * Replace in place the coordinates of the array of instants by the moving
+ * median of each dimension.
+ *
+ * The window is centered on each instant and shrinks symmetrically near the
+ * extremities so that the first and last points are kept unchanged.
+ *
+ * @param[in,out] instants Array of instants
+ * @param[in] count Number of elements in the array
+ * @param[in] hasz True when the points have Z dimension
+ * @param[in] size Number of instants in the window
+ * @param[in] unused Unused, to comply with the signature of the smoothers
+ */
+static void
+tpointinstarr_median(TInstant **instants, int count, bool hasz, double size,
+  double unused __attribute__((unused)))
+{
+  int half = (int) size / 2;
+  if (count < 3 || half == 0)
+    return;
+
+  /* Read all the original coordinates before overwriting them */
+  int ndims = hasz ? 3 : 2;
+  double *coords = palloc(sizeof(double) * count * ndims);
+  double *window = palloc(sizeof(double) * (2 * half + 1));
+  POINT4D p;
+  for (int i = 0; i < count; i++)
+  {
+    datum_point4d(tinstant_value(instants[i]), &p);
+    coords[i] = p.x;
+    coords[count + i] = p.y;
+    if (hasz)
+      coords[2 * count + i] = p.z;
+  }
+
+  double median[3] = {0};
+  for (int i = 1; i < count - 1; i++)
+  {
+    int h = Min(half, Min(i, count - 1 - i));
+    for (int d = 0; d < ndims; d++)
+    {
+      memcpy(window, &coords[d * count + i - h], sizeof(double) * (2 * h + 1));
+      median[d] = double_median(window, 2 * h + 1);
+    }
+    tpointinst_set_coords(instants[i], median[0], median[1], median[2], hasz);
+  }
+  pfree(coords); pfree(window);
+  return;
+}
+
+/**
+ * Smooth one dimension of the positions with a constant-velocity Kalman
+ * filter followed by a Rauch-Tung-Striebel backward pass.
+ *
+ * The state of the filter is the position and the velocity, and the
+ * symmetric covariance matrices are stored as their three distinct values.
+ *
+ * @param[in] z Measured positions
+ * @param[in] dt Number of seconds elapsed since the previous measurement,
+ * the first element is not used
+ * @param[in] count Number of measurements
+ * @param[in] q Spectral density of the acceleration noise
+ * @param[in] r2 Variance of the measurement noise
+ * @param[in] work Work array of 10 * count elements
+ * @param[out] result Smoothed positions
+ */
+static void
+kalman_smooth1(const double *z, const double *dt, int count, double q,
+  double r2, double *work, double *result)
+{
+  double *xf = work, *pf = work + 2 * count;
+  double *xp = work + 5 * count, *pp = work + 7 * count;
+
+  /* Forward filter */
+  xf[0] = z[0]; xf[1] = 0.0;
+  pf[0] = r2; pf[1] = 0.0; pf[2] = KALMAN_VELOCITY_VARIANCE;
+  for (int i = 1; i < count; i++)
+  {
+    double d = dt[i];
+    const double *x = &xf[2 * (i - 1)], *p = &pf[3 * (i - 1)];
+    /* Prediction */
+    double x0 = x[0] + d * x[1], x1 = x[1];
+    double p00 = p[0] + 2 * d * p[1] + d * d * p[2] + q * d * d * d / 3;
+    double p01 = p[1] + d * p[2] + q * d * d / 2;
+    double p11 = p[2] + q * d;
+    xp[2 * i] = x0; xp[2 * i + 1] = x1;
+    pp[3 * i] = p00; pp[3 * i + 1] = p01; pp[3 * i + 2] = p11;
+    /* Correction */
+    double s = p00 + r2;
+    double k0 = p00 / s, k1 = p01 / s;
+    double y = z[i] - x0;
+    xf[2 * i] = x0 + k0 * y;
+    xf[2 * i + 1] = x1 + k1 * y;
+    pf[3 * i] = (1 - k0) * p00;
+    pf[3 * i + 1] = (1 - k0) * p01;
+    pf[3 * i + 2] = p11 - k1 * p01;
+  }
+
+  /* Backward smoother */
+  double sx0 = xf[2 * (count - 1)], sx1 = xf[2 * (count - 1) + 1];
+  double sp00 = pf[3 * (count - 1)], sp01 = pf[3 * (count - 1) + 1],
+    sp11 = pf[3 * (count - 1) + 2];
+  result[count - 1] = sx0;
+  for (int i = count - 2; i >= 0; i--)
+  {
+    double d = dt[i + 1];
+    const double *x = &xf[2 * i], *p = &pf[3 * i];
+    const double *x2 = &xp[2 * (i + 1)], *p2 = &pp[3 * (i + 1)];
+    double det = p2[0] * p2[2] - p2[1] * p2[1];
+    if (det <= 0)
+    {
+      sx0 = x[0]; sx1 = x[1];
+      sp00 = p[0]; sp01 = p[1]; sp11 = p[2];
+      result[i] = sx0;
+      continue;
+    }
+    /* Gain C = P_f F^T P_p^-1 */
+    double m00 = p[0] + p[1] * d, m01 = p[1];
+    double m10 = p[1] + p[2] * d, m11 = p[2];
+    double c00 = (m00 * p2[2] - m01 * p2[1]) / det;
+    double c01 = (m01 * p2[0] - m00 * p2[1]) / det;
+    double c10 = (m10 * p2[2] - m11 * p2[1]) / det;
+    double c11 = (m11 * p2[0] - m10 * p2[1]) / det;
+    /* State */
+    double dx0 = sx0 - x2[0], dx1 = sx1 - x2[1];
+    sx0 = x[0] + c00 * dx0 + c01 * dx1;
+    sx1 = x[1] + c10 * dx0 + c11 * dx1;
+    /* Covariance P_s = P_f + C (P_s' - P_p) C^T */
+    double d00 = sp00 - p2[0], d01 = sp01 - p2[1], d11 = sp11 - p2[2];
+    double e00 = c00 * d00 + c01 * d01, e01 = c00 * d01 + c01 * d11;
+    double e10 = c10 * d00 + c11 * d01, e11 = c10 * d01 + c11 * d11;
+    sp00 = p[0] + e00 * c00 + e01 * c01;
+    sp01 = p[1] + e00 * c10 + e01 * c11;
+    sp11 = p[2] + e10 * c10 + e11 * c11;
+    result[i] = sx0;
+  }
+  return;
+}
+
+/**
+ * Replace in place the coordinates of the array of instants by those
+ * estimated by a constant-velocity Kalman smoother applied independently
+ * to each dimension.
+ *
+ * @param[in,out] instants Array of instants
+ * @param[in] count Number of elements in the array
+ * @param[in] hasz True when the points have Z dimension
+ * @param[in] q Spectral density of the acceleration noise
+ * @param[in] r Standard deviation of the measurement noise
+ */
+static void
+tpointinstarr_kalman(TInstant **instants, int count, bool hasz, double q,
+  double r)
+{
+  if (count < 2)
+    return;
+
+  int ndims = hasz ? 3 : 2;
+  /* Coordinates, elapsed times, smoothed values, and work space */
+  double *buffer = palloc(sizeof(double) * count * (2 * ndims + 11));
+  double *coords = buffer, *smooth = buffer + ndims * count;
+  double *dt = buffer + 2 * ndims * count, *work = dt + count;
+  POINT4D p;
+  for (int i = 0; i < count; i++)
+  {
+    datum_point4d(tinstant_value(instants[i]), &p);
+    coords[i] = p.x;
+    coords[count + i] = p.y;
+    if (hasz)
+      coords[2 * count + i] = p.z;
+    dt[i] = (i == 0) ? 0.0 :
+      (double) (instants[i]->t - instants[i - 1]->t) / 1000000;
+  }
+  for (int d = 0; d < ndims; d++)
+    kalman_smooth1(&coords[d * count], dt, count, q, r * r, work,
+      &smooth[d * count]);
+  for (int i = 0; i < count; i++)
+    tpointinst_set_coords(instants[i], smooth[i], smooth[count + i],
+      hasz ? smooth[2 * count + i] : 0.0, hasz);
+  pfree(buffer);
+  return;
+}
+
+/**
+ * Smooth the coordinates of a temporal point.
+ *
+ * The temporal point is copied once and the coordinates are overwritten in
+ * the copy, from which the result is then constructed in order to recompute
+ * the bounding boxes and to normalize the sequences. No value is allocated
+ * for individual instants.
+ */
+static Temporal *
+tpoint_smooth(const Temporal *temp, tpointinstarr_smooth_fn func,
+  double param1, double param2)
+{
+  bool hasz = MOBDB_FLAGS_GET_Z(temp->flags);
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT)
+    return (Temporal *) tinstant_copy((TInstant *) temp);
+
+  Temporal *copy = temporal_copy(temp);
+  Temporal *result;
+  if (copy->subtype == INSTANTSET)
+  {
+    TInstantSet *ti = (TInstantSet *) copy;
+    TInstant **instants = palloc(sizeof(TInstant *) * ti->count);
+    for (int i = 0; i < ti->count; i++)
+      instants[i] = (TInstant *) tinstantset_inst_n(ti, i);
+    func(instants, ti->count, hasz, param1, param2);
+    result = (Temporal *) tinstantset_make((const TInstant **) instants,
+      ti->count, MERGE_NO);
+    pfree(instants);
+  }
+  else
+  {
+    const TSequence **seqs;
+    int count;
+    if (copy->subtype == SEQUENCE)
+    {
+      seqs = palloc(sizeof(TSequence *));
+      seqs[0] = (TSequence *) copy;
+      count = 1;
+    }
+    else /* copy->subtype == SEQUENCESET */
+    {
+      seqs = tsequenceset_sequences_p((TSequenceSet *) copy);
+      count = ((TSequenceSet *) copy)->count;
+    }
+    TSequence **sequences = palloc(sizeof(TSequence *) * count);
+    TInstant **instants = palloc(sizeof(TInstant *) *
+      temporal_num_instants(copy));
+    for (int i = 0; i < count; i++)
+    {
+      const TSequence *seq = seqs[i];
+      for (int j = 0; j < seq->count; j++)
+        instants[j] = (TInstant *) tsequence_inst_n(seq, j);
+      func(instants, seq->count, hasz, param1, param2);
+      sequences[i] = tsequence_make((const TInstant **) instants, seq->count,
+        seq->period.lower_inc, seq->period.upper_inc,
+        MOBDB_FLAGS_GET_LINEAR(seq->flags), NORMALIZE);
+    }
+    if (copy->subtype == SEQUENCE)
+    {
+      result = (Temporal *) sequences[0];
+      pfree(sequences);
+    }
+    else
+      result = (Temporal *) tsequenceset_make_free(sequences, count,
+        NORMALIZE);
+    pfree(instants); pfree(seqs);
+  }
+  pfree(copy);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_input_analytics
+ * @brief Smooth the temporal point with a moving median filter.
+ *
+ * The median is computed independently for each dimension over a window
+ * centered on each instant, which removes isolated spikes while preserving
+ * sharp turns. Near the extremities the window shrinks symmetrically.
+ *
+ * @param[in] temp Temporal point
+ * @param[in] size Number of instants in the window, must be odd
+ */
+Temporal *
+tpoint_filter_median(const Temporal *temp, int size)
+{
+  if (size < 1 || size % 2 == 0)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The window size must be a positive odd number")));
+  return tpoint_smooth(temp, &tpointinstarr_median, (double) size, 0.0);
+}
+
+/**
+ * @ingroup libmeos_temporal_input_analytics
+ * @brief Smooth the temporal point with a constant-velocity Kalman filter
+ * followed by a Rauch-Tung-Striebel backward pass.
+ *
+ * Each dimension is smoothed independently. For geographies the filter is
+ * applied on the longitude and latitude, and the parameters are thus
+ * expressed in degrees.
+ *
+ * @param[in] temp Temporal point
+ * @param[in] q Spectral density of the acceleration noise, in squared units
+ * per cubed second
+ * @param[in] r Standard deviation of the measurement noise, in units
+ */
+Temporal *
+tpoint_filter_kalman(const Temporal *temp, double q, double r)
+{
+  if (q < 0)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The process noise must be greater than or equal to 0")));
+  if (r <= 0)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The measurement noise must be greater than 0")));
+  return tpoint_smooth(temp, &tpointinstarr_kalman, q, r);
+}
+
 /*****************************************************************************
  * Mapbox Vector Tile functions for temporal points.
  *****************************************************************************/
@@ -2483,6 +2978,50 @@ Tpoint_simplify(PG_FUNCTION_ARGS)
   PG_RETURN_POINTER(result);
 }
 
+PG_FUNCTION_INFO_V1(Tpoint_filter_speed);
+/**
+ * Remove from the temporal point the instants that imply a speed or an
+ * acceleration greater than the given thresholds
+ */
+PGDLLEXPORT Datum
+Tpoint_filter_speed(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  double maxspeed = PG_GETARG_FLOAT8(1);
+  double maxaccel = PG_GETARG_FLOAT8(2);
+  Temporal *result = tpoint_filter_speed(temp, maxspeed, maxaccel);
+  PG_FREE_IF_COPY(temp, 0);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_filter_median);
+/**
+ * Smooth the temporal point with a moving median filter
+ */
+PGDLLEXPORT Datum
+Tpoint_filter_median(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  int size = PG_GETARG_INT32(1);
+  Temporal *result = tpoint_filter_median(temp, size);
+  PG_FREE_IF_COPY(temp, 0);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_filter_kalman);
+/**
+ * Smooth the temporal point with a constant-velocity Kalman smoother
+ */
+PGDLLEXPORT Datum
+Tpoint_filter_kalman(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  double q = PG_GETARG_FLOAT8(1);
+  double r = PG_GETARG_FLOAT8(2);
+  Temporal *result = tpoint_filter_kalman(temp, q, r);
+  PG_FREE_IF_COPY(temp, 0);
+  PG_RETURN_POINTER(result);
+}
 /*****************************************************************************
  * Mapbox Vector Tile functions for temporal points.
  *****************************************************************************/
@@ -29,7 +29,8 @@
 
 /**
  * @file tpoint_in.c
- * @brief Input of temporal points in WKT, EWKT, WKB, EWKB, and MF-JSON format.
+ * @brief Input of temporal points in WKT, EWKT, WKB, EWKB, MF-JSON, and
+ * encoded polyline format.
  */
 
 #include "point/tpoint_in.h"
@@ -37,6 +38,7 @@
 /* PostgreSQL */
 #include <assert.h>
 #include <float.h>
+#include <math.h>
 /* JSON-C */
 #include <json-c/json.h>
 /* MobilityDB */
@@ -364,40 +366,47 @@ tpointseqset_from_mfjson(json_object *mfjson, int srid, CachedType temptype,
 }
 
 /**
- * @ingroup libmeos_temporal_input_output
- * @brief Return a temporal point from its MF-JSON representation
+ * Return the name of the coordinate reference system of the MF-JSON object,
+ * or NULL if it is not given
+ */
+char *
+tpoint_mfjson_srs(json_object *poObj)
+{
+  json_object *poObjSrs = findMemberByName(poObj, "crs");
+  if (poObjSrs == NULL)
+    return NULL;
+  json_object *poObjSrsType = findMemberByName(poObjSrs, "type");
+  if (poObjSrsType == NULL)
+    return NULL;
+  json_object *poObjSrsProps = findMemberByName(poObjSrs, "properties");
+  if (poObjSrsProps == NULL)
+    return NULL;
+  json_object *poNameURL = findMemberByName(poObjSrsProps, "name");
+  if (poNameURL == NULL)
+    return NULL;
+  const char *pszName = json_object_get_string(poNameURL);
+  if (pszName == NULL)
+    return NULL;
+  char *result = palloc(strlen(pszName) + 1);
+  strcpy(result, pszName);
+  return result;
+}
+
+/**
+ * Return a temporal point from its parsed MF-JSON representation
+ *
+ * @param[in] poObj Parsed MF-JSON object
+ * @param[in] srid SRID of the coordinate reference system of the object
+ * @param[in] temptype Temporal type
  */
 Temporal *
-tpoint_from_mfjson_ext(FunctionCallInfo fcinfo, text *mfjson_input,
-  CachedType temptype)
+tpoint_from_mfjson_obj(json_object *poObj, int srid, CachedType temptype)
 {
-  char *mfjson = text2cstring(mfjson_input);
-  char *srs = NULL;
-  int srid = 0;
   Temporal *result = NULL;
-
-  json_tokener *jstok = NULL;
-  json_object *poObj = NULL;
   json_object *poObjType = NULL;
   json_object *poObjInterp = NULL;
   json_object *poObjInterp1 = NULL;
   json_object *poObjDates = NULL;
-  json_object *poObjSrs = NULL;
-
-  /* Begin to parse json */
-  jstok = json_tokener_new();
-  poObj = json_tokener_parse_ex(jstok, mfjson, -1);
-  if (jstok->err != json_tokener_success)
-  {
-    char err[256];
-    snprintf(err, 256, "%s (at offset %d)",
-      json_tokener_error_desc(jstok->err), jstok->char_offset);
-    json_tokener_free(jstok);
-    json_object_put(poObj);
-    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
-      errmsg("Error while processing MFJSON string")));
-  }
-  json_tokener_free(jstok);
 
   /*
    * Ensure that it is a moving point
@@ -429,40 +438,13 @@ tpoint_from_mfjson_ext(FunctionCallInfo fcinfo, text *mfjson_input,
     ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
       errmsg("Multiple 'interpolations' values in MFJSON string")));
 
-  /* Parse crs and set SRID of temporal point */
-  poObjSrs = findMemberByName(poObj, "crs");
-  if (poObjSrs != NULL)
-  {
-    json_object *poObjSrsType = findMemberByName(poObjSrs, "type");
-    if (poObjSrsType != NULL)
-    {
-      json_object *poObjSrsProps = findMemberByName(poObjSrs, "properties");
-      if (poObjSrsProps)
-      {
-        json_object *poNameURL = findMemberByName(poObjSrsProps, "name");
-        if (poNameURL)
-        {
-          const char *pszName = json_object_get_string(poNameURL);
-          if (pszName)
-          {
-            srs = palloc(strlen(pszName) + 1);
-            strcpy(srs, pszName);
-          }
-        }
-      }
-    }
-  }
-
-  if (srs)
-  {
-    srid = getSRIDbySRS(fcinfo, srs);
-    pfree(srs);
-  }
-
   /* Read interpolation value */
   poObjInterp1 = json_object_array_get_idx(poObjInterp, 0);
   const char *pszInterp = json_object_get_string(poObjInterp1);
-  if (pszInterp)
+  if (pszInterp == NULL)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("Invalid 'interpolations' value in MFJSON string")));
+  else
   {
     if (strcmp(pszInterp, "Discrete") == 0)
     {
@@ -491,6 +473,43 @@ tpoint_from_mfjson_ext(FunctionCallInfo fcinfo, text *mfjson_input,
   return result;
 }
 
+/**
+ * @ingroup libmeos_temporal_input_output
+ * @brief Return a temporal point from its MF-JSON representation
+ */
+Temporal *
+tpoint_from_mfjson_ext(FunctionCallInfo fcinfo, text *mfjson_input,
+  CachedType temptype)
+{
+  char *mfjson = text2cstring(mfjson_input);
+  int srid = 0;
+
+  /* Begin to parse json */
+  json_tokener *jstok = json_tokener_new();
+  json_object *poObj = json_tokener_parse_ex(jstok, mfjson, -1);
+  if (jstok->err != json_tokener_success)
+  {
+    char err[256];
+    snprintf(err, 256, "%s (at offset %d)",
+      json_tokener_error_desc(jstok->err), jstok->char_offset);
+    json_tokener_free(jstok);
+    json_object_put(poObj);
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("Error while processing MFJSON string")));
+  }
+  json_tokener_free(jstok);
+
+  /* Parse crs and set SRID of temporal point */
+  char *srs = tpoint_mfjson_srs(poObj);
+  if (srs)
+  {
+    srid = getSRIDbySRS(fcinfo, srs);
+    pfree(srs);
+  }
+
+  return tpoint_from_mfjson_obj(poObj, srid, temptype);
+}
+
 /*****************************************************************************
  * Input in EWKB format
  * Please refer to the file tpoint_out.c where the binary format is explained
@@ -918,6 +937,216 @@ tpoint_from_ewkt(const char *wkt, CachedType temptype)
   return result;
 }
 
+/*****************************************************************************
+ * Input in encoded polyline format
+ * Please refer to the file tpoint_out.c where the format is explained
+ *****************************************************************************/
+
+/**
+ * Structure used for passing the parse state between the parsing functions
+ */
+typedef struct
+{
+  const uint8_t *pos;  /**< Current parse position */
+  const uint8_t *end;  /**< End of the input */
+  bool binary;         /**< Binary vs text input */
+  bool hasz;           /**< Z? */
+  bool geodetic;       /**< Geodetic? */
+  bool linear;         /**< Linear interpolation? */
+  int32_t srid;        /**< SRID */
+  double scale;        /**< 10^precision */
+  int64 x, y, z;       /**< Coordinates of the previous instant */
+  TimestampTz t;       /**< Timestamp of the previous instant */
+} polyline_parse_state;
+
+/**
+ * Read an integer and advance the parse state forward
+ */
+static int64
+int64_from_polyline_state(polyline_parse_state *s)
+{
+  uint64 zz = 0;
+  int shift = 0;
+  while (true)
+  {
+    if (s->pos >= s->end)
+      ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
+        errmsg("Unexpected end of encoded polyline")));
+    if (shift > 63)
+      ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
+        errmsg("Invalid integer in encoded polyline")));
+    uint8_t c = *s->pos++;
+    bool more;
+    if (s->binary)
+    {
+      zz |= (uint64) (c & 0x7F) << shift;
+      more = (c & 0x80) != 0;
+      shift += 7;
+    }
+    else
+    {
+      if (c < POLYLINE_CHAR_OFFSET || c > POLYLINE_CHAR_OFFSET + 0x3F)
+        ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
+          errmsg("Invalid character in encoded polyline: %c", c)));
+      c -= POLYLINE_CHAR_OFFSET;
+      zz |= (uint64) (c & 0x1F) << shift;
+      more = (c & 0x20) != 0;
+      shift += 5;
+    }
+    if (! more)
+      break;
+  }
+  /* Reverse the zig-zag encoding */
+  return (int64) (zz >> 1) ^ -((int64) (zz & 1));
+}
+
+/**
+ * Read a number of instants or of sequences and advance the parse state
+ * forward. The number is bounded by the length of the remaining input since
+ * every instant takes at least one byte per coordinate and for the timestamp.
+ */
+static int
+count_from_polyline_state(polyline_parse_state *s)
+{
+  int64 count = int64_from_polyline_state(s);
+  int64 maxcount = (s->end - s->pos) / (s->hasz ? 4 : 3);
+  if (count < 1 || count > maxcount)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
+      errmsg("Invalid number of elements in encoded polyline")));
+  return (int) count;
+}
+
+/**
+ * Return a temporal instant point from its encoded polyline representation,
+ * which is the difference with the previous instant
+ */
+static TInstant *
+tpointinst_from_polyline_state(polyline_parse_state *s)
+{
+  /* Additions are made in unsigned arithmetic to avoid overflow on
+   * invalid input */
+  s->x = (int64) ((uint64) s->x + (uint64) int64_from_polyline_state(s));
+  s->y = (int64) ((uint64) s->y + (uint64) int64_from_polyline_state(s));
+  if (s->hasz)
+    s->z = (int64) ((uint64) s->z + (uint64) int64_from_polyline_state(s));
+  s->t = (TimestampTz) ((uint64) s->t +
+    (uint64) int64_from_polyline_state(s));
+  if (! IS_VALID_TIMESTAMP(s->t))
+    ereport(ERROR, (errcode(ERRCODE_DATETIME_VALUE_OUT_OF_RANGE),
+      errmsg("Timestamp out of range in encoded polyline")));
+  double x = s->x / s->scale, y = s->y / s->scale;
+  /* Same check as the input function of geography */
+  if (s->geodetic && (fabs(x) > 180.0 || fabs(y) > 90.0))
+    ereport(ERROR, (errcode(ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE),
+      errmsg("Coordinate values are out of range [-180 -90, 180 90] for GEOGRAPHY type")));
+  LWPOINT *point = s->hasz ?
+    lwpoint_make3dz(s->srid, x, y, s->z / s->scale) :
+    lwpoint_make2d(s->srid, x, y);
+  FLAGS_SET_GEODETIC(point->flags, s->geodetic);
+  GSERIALIZED *gs = geo_serialize((LWGEOM *) point);
+  lwpoint_free(point);
+  TInstant *result = tinstant_make(PointerGetDatum(gs), s->t,
+    s->geodetic ? T_TGEOGPOINT : T_TGEOMPOINT);
+  pfree(gs);
+  return result;
+}
+
+/**
+ * Return a temporal sequence point from its encoded polyline representation
+ */
+static TSequence *
+tpointseq_from_polyline_state(polyline_parse_state *s)
+{
+  int count = count_from_polyline_state(s);
+  int64 bounds = int64_from_polyline_state(s);
+  if (bounds & ~(MOBDB_WKB_LOWER_INC | MOBDB_WKB_UPPER_INC))
+    ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
+      errmsg("Invalid bounds in encoded polyline")));
+  TInstant **instants = palloc(sizeof(TInstant *) * count);
+  for (int i = 0; i < count; i++)
+    instants[i] = tpointinst_from_polyline_state(s);
+  return tsequence_make_free(instants, count,
+    (bounds & MOBDB_WKB_LOWER_INC) != 0, (bounds & MOBDB_WKB_UPPER_INC) != 0,
+    s->linear, NORMALIZE);
+}
+
+/**
+ * @ingroup libmeos_temporal_input_output
+ * @brief Return a temporal point from its encoded polyline representation.
+ *
+ * @param[in] polyline Encoded polyline
+ * @param[in] size Size of the encoded polyline
+ * @param[in] binary True when the integers are written in chunks of 7 bits
+ * instead of characters of the polyline alphabet
+ * @param[in] temptype Type of the result
+ */
+Temporal *
+tpoint_from_polyline(const char *polyline, size_t size, bool binary,
+  CachedType temptype)
+{
+  polyline_parse_state s;
+  memset(&s, 0, sizeof(polyline_parse_state));
+  s.pos = (const uint8_t *) polyline;
+  s.end = s.pos + size;
+  s.binary = binary;
+
+  /* Read the header */
+  int64 flags = int64_from_polyline_state(&s);
+  int64 subtype = flags & 0x0F;
+  if (subtype < INSTANT || subtype > SEQUENCESET ||
+      (flags & ~(MOBDB_WKB_ZFLAG | MOBDB_WKB_GEODETICFLAG |
+        MOBDB_WKB_LINEAR_INTERP | 0x0F)))
+    ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
+      errmsg("Invalid flags in encoded polyline")));
+  s.hasz = (flags & MOBDB_WKB_ZFLAG) != 0;
+  s.geodetic = (flags & MOBDB_WKB_GEODETICFLAG) != 0;
+  s.linear = (flags & MOBDB_WKB_LINEAR_INTERP) != 0;
+  if (s.geodetic != (temptype == T_TGEOGPOINT))
+    ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
+      errmsg("The encoded polyline is not a %s",
+        temptype == T_TGEOGPOINT ? "tgeogpoint" : "tgeompoint")));
+  int64 srid = int64_from_polyline_state(&s);
+  if (srid < 0 || srid > SRID_MAXIMUM)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
+      errmsg("Invalid SRID in encoded polyline")));
+  s.srid = (int32_t) srid;
+  /* Geographies without SRID take the default one, as done by PostGIS */
+  if (s.geodetic && s.srid == SRID_UNKNOWN)
+    s.srid = SRID_DEFAULT;
+  int64 precision = int64_from_polyline_state(&s);
+  if (precision < 0 || precision > POLYLINE_MAX_PRECISION)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
+      errmsg("Invalid number of decimal digits in encoded polyline")));
+  s.scale = pow(10.0, (double) precision);
+
+  /* Read the instants */
+  Temporal *result;
+  if (subtype == INSTANT)
+    result = (Temporal *) tpointinst_from_polyline_state(&s);
+  else if (subtype == INSTANTSET)
+  {
+    int count = count_from_polyline_state(&s);
+    TInstant **instants = palloc(sizeof(TInstant *) * count);
+    for (int i = 0; i < count; i++)
+      instants[i] = tpointinst_from_polyline_state(&s);
+    result = (Temporal *) tinstantset_make_free(instants, count, MERGE_NO);
+  }
+  else if (subtype == SEQUENCE)
+    result = (Temporal *) tpointseq_from_polyline_state(&s);
+  else /* subtype == SEQUENCESET */
+  {
+    int count = count_from_polyline_state(&s);
+    TSequence **sequences = palloc(sizeof(TSequence *) * count);
+    for (int i = 0; i < count; i++)
+      sequences[i] = tpointseq_from_polyline_state(&s);
+    result = (Temporal *) tsequenceset_make_free(sequences, count, NORMALIZE);
+  }
+  if (s.pos != s.end)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
+      errmsg("Unexpected data after the end of the encoded polyline")));
+  return result;
+}
+
 /*****************************************************************************/
 /*****************************************************************************/
 /*                        MobilityDB - PostgreSQL                            */
@@ -1002,6 +1231,46 @@ Tpoint_from_ewkt(PG_FUNCTION_ARGS)
   PG_RETURN_POINTER(result);
 }
 
+/*****************************************************************************
+ * Input in encoded polyline format
+ *****************************************************************************/
+
+/**
+ * Return a temporal point from its encoded polyline representation as text
+ * or binary
+ */
+static Datum
+tpoint_from_polyline_ext(FunctionCallInfo fcinfo, bool binary)
+{
+  /* Text and bytea share the same varlena representation */
+  bytea *polyline = PG_GETARG_BYTEA_P(0);
+  Oid temptypid = get_fn_expr_rettype(fcinfo->flinfo);
+  Temporal *result = tpoint_from_polyline(VARDATA(polyline),
+    VARSIZE(polyline) - VARHDRSZ, binary, oid_type(temptypid));
+  PG_FREE_IF_COPY(polyline, 0);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_from_polyline);
+/**
+ * Return a temporal point from its encoded polyline representation
+ */
+PGDLLEXPORT Datum
+Tpoint_from_polyline(PG_FUNCTION_ARGS)
+{
+  return tpoint_from_polyline_ext(fcinfo, false);
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_from_polyline_binary);
+/**
+ * Return a temporal point from its binary encoded polyline representation
+ */
+PGDLLEXPORT Datum
+Tpoint_from_polyline_binary(PG_FUNCTION_ARGS)
+{
+  return tpoint_from_polyline_ext(fcinfo, true);
+}
+
 #endif /* #ifndef MEOS */
 
 /*****************************************************************************/
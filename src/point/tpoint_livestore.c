@@ -0,0 +1,979 @@
+/***********************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2022, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+ *
+ *****************************************************************************/
+
+/**
+ * @file tpoint_livestore.c
+ * @brief Shared-memory store of the latest position and of a short tail of
+ * recent positions of moving objects.
+ *
+ * The store is only available when MobilityDB is loaded through the
+ * `shared_preload_libraries` parameter and `mobilitydb.live_capacity` is
+ * greater than zero. The positions are kept in a fixed array of slots in
+ * shared memory. A hash table maps the object identifiers to the slots, and
+ * a uniform grid whose cells are hashed into a fixed number of buckets
+ * indexes the slots by their latest position. Updates lock the store in
+ * exclusive mode. Queries lock it in shared mode only while copying the
+ * qualifying positions, the results are built after releasing the lock.
+ * The store never writes to the heap and its content is lost on restart.
+ */
+
+#include "point/tpoint_livestore.h"
+
+/* PostgreSQL */
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <funcapi.h>
+#include <miscadmin.h>
+#if POSTGRESQL_VERSION_NUMBER < 120000
+#include <access/htup_details.h>
+#endif
+#include <storage/ipc.h>
+#include <storage/lwlock.h>
+#include <storage/shmem.h>
+#include <utils/guc.h>
+#include <utils/hsearch.h>
+#include <utils/timestamp.h>
+/* MobilityDB */
+#include "general/temporaltypes.h"
+#include "general/tempcache.h"
+#include "general/temporal_util.h"
+#include "point/postgis.h"
+#include "point/stbox.h"
+#include "point/tpoint.h"
+#include "point/tpoint_spatialfuncs.h"
+
+/*****************************************************************************
+ * Configuration parameters
+ *****************************************************************************/
+
+/** Maximum number of objects in the store, 0 disables the store */
+static int livestore_capacity = LIVESTORE_DEFAULT_CAPACITY;
+/** Number of positions kept per object, including the latest one */
+static int livestore_tail = LIVESTORE_DEFAULT_TAIL;
+/** Size of the cells of the grid indexing the latest positions */
+static double livestore_cellsize = LIVESTORE_DEFAULT_CELLSIZE;
+
+/*****************************************************************************
+ * Shared-memory structures
+ *****************************************************************************/
+
+/**
+ * Position of a moving object
+ */
+typedef struct
+{
+  double x;          /**< x coordinate */
+  double y;          /**< y coordinate */
+  double z;          /**< z coordinate, 0 if the position is 2D */
+  TimestampTz t;     /**< timestamp */
+} LivePos;
+
+/**
+ * Slot of the store keeping the positions of a moving object in a ring
+ * buffer of `tail` elements
+ */
+typedef struct
+{
+  int64 id;          /**< object identifier */
+  int64 cellx;       /**< grid cell of the latest position */
+  int64 celly;
+  int32 bucket;      /**< grid bucket of the slot, -1 if the slot is free */
+  int32 prev;        /**< previous slot in the bucket, -1 if none */
+  int32 next;        /**< next slot in the bucket or in the free list */
+  int32 srid;        /**< SRID of the positions */
+  bool hasz;         /**< the positions have Z coordinates */
+  int16 count;       /**< number of positions in the ring buffer */
+  int16 last;        /**< location of the latest position in the ring */
+  LivePos tail[FLEXIBLE_ARRAY_MEMBER];
+} LiveSlot;
+
+/**
+ * Header of the store
+ */
+typedef struct
+{
+  LWLock *lock;      /**< lock protecting the whole store */
+  int capacity;      /**< number of slots */
+  int tail;          /**< number of positions per slot */
+  double cellsize;   /**< size of the grid cells */
+  int nbuckets;      /**< number of grid buckets, a power of 2 */
+  int count;         /**< number of slots in use */
+  int freelist;      /**< first free slot, -1 if none */
+  Size slotsize;     /**< size of a slot */
+  int32 *buckets;    /**< first slot of each bucket, -1 if none */
+  char *slots;       /**< array of slots */
+} LiveStore;
+
+/**
+ * Entry of the hash table mapping the object identifiers to the slots
+ */
+typedef struct
+{
+  int64 id;          /**< hash key, must be first */
+  int32 slot;        /**< slot of the object */
+} LiveEntry;
+
+/**
+ * Position copied from the store as the result of a query
+ */
+typedef struct
+{
+  int64 id;          /**< object identifier */
+  LivePos pos;       /**< latest position */
+  int32 srid;        /**< SRID of the position */
+  bool hasz;         /**< the position has Z coordinates */
+  double dist;       /**< distance to the query point, if any */
+} LiveResult;
+
+/**
+ * State of the set-returning functions querying the store
+ */
+typedef struct
+{
+  LiveResult *results;  /**< positions to return */
+  int count;            /**< number of positions */
+  int i;                /**< next position to return */
+} LiveState;
+
+#define LIVESTORE_SLOT(i) \
+  ((LiveSlot *) (livestore->slots + (Size) (i) * livestore->slotsize))
+
+/* Bound on the absolute value of the grid cell coordinates */
+#define LIVESTORE_MAX_CELL ((double) (INT64CONST(1) << 62))
+
+static LiveStore *livestore = NULL;
+static HTAB *livestore_hash = NULL;
+static shmem_startup_hook_type prev_shmem_startup_hook = NULL;
+
+/*****************************************************************************
+ * Initialization
+ *****************************************************************************/
+
+/**
+ * Return the size of a slot of the store
+ */
+static Size
+livestore_slotsize(void)
+{
+  return MAXALIGN(offsetof(LiveSlot, tail) + sizeof(LivePos) * livestore_tail);
+}
+
+/**
+ * Return the number of grid buckets, that is, the smallest power of 2 not
+ * less than the capacity of the store
+ */
+static int
+livestore_nbuckets(void)
+{
+  int result = 1;
+  while (result < livestore_capacity)
+    result <<= 1;
+  return result;
+}
+
+/**
+ * Return the size of the shared memory needed by the store
+ */
+static Size
+livestore_memsize(void)
+{
+  Size result = MAXALIGN(sizeof(LiveStore));
+  result = add_size(result,
+    MAXALIGN(mul_size(livestore_nbuckets(), sizeof(int32))));
+  result = add_size(result, mul_size(livestore_capacity, livestore_slotsize()));
+  result = add_size(result,
+    hash_estimate_size(livestore_capacity, sizeof(LiveEntry)));
+  return result;
+}
+
+/**
+ * Allocate or attach to the store in shared memory
+ */
+static void
+livestore_shmem_startup(void)
+{
+  HASHCTL info;
+  Size size;
+  bool found;
+
+  if (prev_shmem_startup_hook)
+    prev_shmem_startup_hook();
+
+  size = MAXALIGN(sizeof(LiveStore)) +
+    MAXALIGN(sizeof(int32) * livestore_nbuckets()) +
+    livestore_slotsize() * livestore_capacity;
+  LWLockAcquire(AddinShmemInitLock, LW_EXCLUSIVE);
+  livestore = ShmemInitStruct("MobilityDB live store", size, &found);
+  if (! found)
+  {
+    livestore->lock = &(GetNamedLWLockTranche("mobilitydb_livestore"))->lock;
+    livestore->capacity = livestore_capacity;
+    livestore->tail = livestore_tail;
+    livestore->cellsize = livestore_cellsize;
+    livestore->nbuckets = livestore_nbuckets();
+    livestore->count = 0;
+    livestore->slotsize = livestore_slotsize();
+    livestore->buckets = (int32 *) ((char *) livestore +
+      MAXALIGN(sizeof(LiveStore)));
+    livestore->slots = (char *) livestore->buckets +
+      MAXALIGN(sizeof(int32) * livestore->nbuckets);
+    for (int i = 0; i < livestore->nbuckets; i++)
+      livestore->buckets[i] = -1;
+    /* Chain all the slots in the free list */
+    for (int i = 0; i < livestore->capacity; i++)
+    {
+      LiveSlot *slot = LIVESTORE_SLOT(i);
+      slot->bucket = slot->prev = -1;
+      slot->next = (i < livestore->capacity - 1) ? i + 1 : -1;
+    }
+    livestore->freelist = 0;
+  }
+  memset(&info, 0, sizeof(info));
+  info.keysize = sizeof(int64);
+  info.entrysize = sizeof(LiveEntry);
+  livestore_hash = ShmemInitHash("MobilityDB live store identifiers",
+    livestore_capacity, livestore_capacity, &info, HASH_ELEM | HASH_BLOBS);
+  LWLockRelease(AddinShmemInitLock);
+  return;
+}
+
+/**
+ * Reserve the shared memory and the lock of the store
+ */
+static void
+livestore_shmem_request(void)
+{
+  RequestAddinShmemSpace(livestore_memsize());
+  RequestNamedLWLockTranche("mobilitydb_livestore", 1);
+  return;
+}
+
+/**
+ * Define the configuration parameters of the store and, when MobilityDB is
+ * loaded through `shared_preload_libraries`, reserve its shared memory
+ *
+ * @note Called from the initialization function of the extension
+ */
+void
+livestore_init(void)
+{
+  DefineCustomIntVariable("mobilitydb.live_capacity",
+    "Maximum number of moving objects in the live position store.",
+    "Zero disables the store. Requires loading MobilityDB through "
+    "shared_preload_libraries.",
+    &livestore_capacity, LIVESTORE_DEFAULT_CAPACITY, 0,
+    LIVESTORE_MAX_CAPACITY, PGC_POSTMASTER, 0, NULL, NULL, NULL);
+  DefineCustomIntVariable("mobilitydb.live_tail",
+    "Number of recent positions kept per moving object in the live position "
+    "store.", NULL,
+    &livestore_tail, LIVESTORE_DEFAULT_TAIL, 1, LIVESTORE_MAX_TAIL,
+    PGC_POSTMASTER, 0, NULL, NULL, NULL);
+  DefineCustomRealVariable("mobilitydb.live_cellsize",
+    "Size of the grid cells indexing the live position store.",
+    "Expressed in the units of the spatial reference system of the positions.",
+    &livestore_cellsize, LIVESTORE_DEFAULT_CELLSIZE, FLT_EPSILON, DBL_MAX,
+    PGC_POSTMASTER, 0, NULL, NULL, NULL);
+
+  if (! process_shared_preload_libraries_in_progress || livestore_capacity == 0)
+    return;
+
+  livestore_shmem_request();
+  prev_shmem_startup_hook = shmem_startup_hook;
+  shmem_startup_hook = livestore_shmem_startup;
+  return;
+}
+
+/**
+ * Ensure that the store is available
+ */
+static void
+ensure_livestore(void)
+{
+  if (! livestore)
+    ereport(ERROR, (errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+      errmsg("The live position store is not available"),
+      errhint("Add MobilityDB to shared_preload_libraries and set "
+        "mobilitydb.live_capacity to a positive value.")));
+  return;
+}
+
+/*****************************************************************************
+ * Grid functions
+ *****************************************************************************/
+
+/**
+ * Return the grid cell coordinate of a coordinate value
+ */
+static int64
+livestore_cell(double value)
+{
+  double result = floor(value / livestore->cellsize);
+  if (result > LIVESTORE_MAX_CELL)
+    result = LIVESTORE_MAX_CELL;
+  else if (result < -LIVESTORE_MAX_CELL)
+    result = -LIVESTORE_MAX_CELL;
+  return (int64) result;
+}
+
+/**
+ * Return the bucket of a grid cell
+ */
+static int32
+livestore_bucket(int64 cellx, int64 celly)
+{
+  uint64 hash = ((uint64) cellx * UINT64CONST(73856093)) ^
+    ((uint64) celly * UINT64CONST(19349663));
+  return (int32) (hash & (uint64) (livestore->nbuckets - 1));
+}
+
+/**
+ * Remove a slot from its grid bucket
+ */
+static void
+livestore_unlink(LiveSlot *slot)
+{
+  if (slot->prev >= 0)
+    LIVESTORE_SLOT(slot->prev)->next = slot->next;
+  else
+    livestore->buckets[slot->bucket] = slot->next;
+  if (slot->next >= 0)
+    LIVESTORE_SLOT(slot->next)->prev = slot->prev;
+  slot->bucket = slot->prev = slot->next = -1;
+  return;
+}
+
+/**
+ * Add a slot to the grid bucket of its latest position
+ */
+static void
+livestore_link(LiveSlot *slot, int32 i)
+{
+  slot->bucket = livestore_bucket(slot->cellx, slot->celly);
+  slot->prev = -1;
+  slot->next = livestore->buckets[slot->bucket];
+  if (slot->next >= 0)
+    LIVESTORE_SLOT(slot->next)->prev = i;
+  livestore->buckets[slot->bucket] = i;
+  return;
+}
+
+/*****************************************************************************
+ * Update functions
+ *****************************************************************************/
+
+/**
+ * Add a position of a moving object to the store. Positions that are not
+ * after the latest position of the object are ignored.
+ *
+ * @note The store must be locked in exclusive mode
+ */
+static bool
+livestore_put(int64 id, const LivePos *pos, int32 srid, bool hasz)
+{
+  LiveEntry *entry;
+  LiveSlot *slot;
+  int32 i;
+  int64 cellx, celly;
+  bool found;
+
+  entry = (LiveEntry *) hash_search(livestore_hash, &id, HASH_ENTER_NULL,
+    &found);
+  if (! found && (! entry || livestore->freelist < 0))
+  {
+    if (entry)
+      hash_search(livestore_hash, &id, HASH_REMOVE, NULL);
+    ereport(ERROR, (errcode(ERRCODE_OUT_OF_MEMORY),
+      errmsg("The live position store is full"),
+      errhint("Increase mobilitydb.live_capacity.")));
+  }
+  if (found)
+  {
+    i = entry->slot;
+    slot = LIVESTORE_SLOT(i);
+    if (slot->srid != srid || slot->hasz != hasz)
+      ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+        errmsg("The positions of the object " INT64_FORMAT
+          " must have the same SRID and dimensionality", id)));
+    if (pos->t <= slot->tail[slot->last].t)
+      return false;
+  }
+  else
+  {
+    /* Take a slot from the free list */
+    i = livestore->freelist;
+    slot = LIVESTORE_SLOT(i);
+    livestore->freelist = slot->next;
+    slot->id = id;
+    slot->bucket = slot->prev = slot->next = -1;
+    slot->srid = srid;
+    slot->hasz = hasz;
+    slot->count = 0;
+    slot->last = -1;
+    entry->slot = i;
+    livestore->count++;
+  }
+  slot->last = (int16) ((slot->last + 1) % livestore->tail);
+  slot->tail[slot->last] = *pos;
+  if (slot->count < livestore->tail)
+    slot->count++;
+  /* Move the slot to another grid bucket only when the cell changes */
+  cellx = livestore_cell(pos->x);
+  celly = livestore_cell(pos->y);
+  if (slot->bucket < 0 || slot->cellx != cellx || slot->celly != celly)
+  {
+    if (slot->bucket >= 0)
+      livestore_unlink(slot);
+    slot->cellx = cellx;
+    slot->celly = celly;
+    livestore_link(slot, i);
+  }
+  return true;
+}
+
+/**
+ * Add the instants of a temporal point to the store and return the number
+ * of positions added
+ */
+static int
+livestore_update(int64 id, const Temporal *temp)
+{
+  int count, result = 0;
+  int32 srid = tpoint_srid(temp);
+  bool hasz = MOBDB_FLAGS_GET_Z(temp->flags);
+  const TInstant **instants = temporal_instants(temp, &count);
+  LWLockAcquire(livestore->lock, LW_EXCLUSIVE);
+  for (int i = 0; i < count; i++)
+  {
+    POINT4D p;
+    LivePos pos;
+    datum_point4d(tinstant_value(instants[i]), &p);
+    pos.x = p.x;
+    pos.y = p.y;
+    pos.z = p.z;
+    pos.t = instants[i]->t;
+    if (livestore_put(id, &pos, srid, hasz))
+      result++;
+  }
+  LWLockRelease(livestore->lock);
+  pfree(instants);
+  return result;
+}
+
+/**
+ * Remove a moving object from the store
+ */
+static bool
+livestore_remove(int64 id)
+{
+  LiveEntry *entry;
+  bool result = false;
+  LWLockAcquire(livestore->lock, LW_EXCLUSIVE);
+  entry = (LiveEntry *) hash_search(livestore_hash, &id, HASH_REMOVE, NULL);
+  if (entry)
+  {
+    int32 i = entry->slot;
+    LiveSlot *slot = LIVESTORE_SLOT(i);
+    livestore_unlink(slot);
+    slot->next = livestore->freelist;
+    livestore->freelist = i;
+    livestore->count--;
+    result = true;
+  }
+  LWLockRelease(livestore->lock);
+  return result;
+}
+
+/*****************************************************************************
+ * Query functions
+ *****************************************************************************/
+
+/**
+ * Append the latest position of a slot to an array of results
+ */
+static void
+liveresult_append(LiveResult **results, int *count, int *maxcount,
+  const LiveSlot *slot, double dist)
+{
+  LiveResult *res;
+  if (*count == *maxcount)
+  {
+    *maxcount *= 2;
+    *results = repalloc(*results, sizeof(LiveResult) * *maxcount);
+  }
+  res = &(*results)[(*count)++];
+  res->id = slot->id;
+  res->pos = slot->tail[slot->last];
+  res->srid = slot->srid;
+  res->hasz = slot->hasz;
+  res->dist = dist;
+  return;
+}
+
+/**
+ * Return true if the latest position of a slot is in a spatiotemporal box
+ */
+static bool
+liveslot_in_stbox(const LiveSlot *slot, const STBOX *box)
+{
+  const LivePos *pos = &slot->tail[slot->last];
+  if (slot->srid != box->srid ||
+      pos->x < box->xmin || pos->x > box->xmax ||
+      pos->y < box->ymin || pos->y > box->ymax)
+    return false;
+  if (slot->hasz && MOBDB_FLAGS_GET_Z(box->flags) &&
+      (pos->z < box->zmin || pos->z > box->zmax))
+    return false;
+  if (MOBDB_FLAGS_GET_T(box->flags) &&
+      (pos->t < box->tmin || pos->t > box->tmax))
+    return false;
+  return true;
+}
+
+/**
+ * Return the distance between the latest position of a slot and a point.
+ * The Z coordinates are taken into account when both positions have them.
+ */
+static double
+liveslot_distance(const LiveSlot *slot, const LivePos *point, bool hasz)
+{
+  const LivePos *pos = &slot->tail[slot->last];
+  double dx = pos->x - point->x, dy = pos->y - point->y;
+  double dz = (hasz && slot->hasz) ? pos->z - point->z : 0.0;
+  return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+/**
+ * Return the objects whose latest position is in a spatiotemporal box. If a
+ * point is given, only the objects at most at the given distance of the
+ * point are returned together with their distance.
+ */
+static LiveResult *
+livestore_window(const STBOX *box, const LivePos *point, bool hasz,
+  double dist, int *count)
+{
+  int maxcount = 64;
+  LiveResult *result = palloc(sizeof(LiveResult) * maxcount);
+  int64 cellxmin, cellxmax, cellymin, cellymax;
+  *count = 0;
+  LWLockAcquire(livestore->lock, LW_SHARED);
+  cellxmin = livestore_cell(box->xmin);
+  cellxmax = livestore_cell(box->xmax);
+  cellymin = livestore_cell(box->ymin);
+  cellymax = livestore_cell(box->ymax);
+  if (((double) cellxmax - cellxmin + 1) * ((double) cellymax - cellymin + 1)
+      <= livestore->nbuckets)
+  {
+    /* Visit the buckets of the cells covered by the box. Since distinct cells
+     * may share a bucket, only the slots of the visited cell are kept. */
+    for (int64 cellx = cellxmin; cellx <= cellxmax; cellx++)
+    {
+      for (int64 celly = cellymin; celly <= cellymax; celly++)
+      {
+        int32 i = livestore->buckets[livestore_bucket(cellx, celly)];
+        while (i >= 0)
+        {
+          LiveSlot *slot = LIVESTORE_SLOT(i);
+          if (slot->cellx == cellx && slot->celly == celly &&
+              liveslot_in_stbox(slot, box))
+          {
+            double d = point ? liveslot_distance(slot, point, hasz) : 0.0;
+            if (! point || d <= dist)
+              liveresult_append(&result, count, &maxcount, slot, d);
+          }
+          i = slot->next;
+        }
+      }
+    }
+  }
+  else
+  {
+    /* The box covers more cells than there are buckets, scan all slots */
+    for (int32 i = 0; i < livestore->capacity; i++)
+    {
+      LiveSlot *slot = LIVESTORE_SLOT(i);
+      if (slot->bucket >= 0 && liveslot_in_stbox(slot, box))
+      {
+        double d = point ? liveslot_distance(slot, point, hasz) : 0.0;
+        if (! point || d <= dist)
+          liveresult_append(&result, count, &maxcount, slot, d);
+      }
+    }
+  }
+  LWLockRelease(livestore->lock);
+  return result;
+}
+
+/**
+ * Add a slot to the k nearest neighbors found so far, which are kept sorted
+ * by increasing distance
+ */
+static void
+liveknn_add(LiveResult *result, int *count, int k, const LiveSlot *slot,
+  const LivePos *point, int32 srid, bool hasz)
+{
+  double dist;
+  int pos;
+  if (slot->srid != srid)
+    return;
+  dist = liveslot_distance(slot, point, hasz);
+  if (*count == k && dist >= result[k - 1].dist)
+    return;
+  pos = (*count < k) ? (*count)++ : k - 1;
+  while (pos > 0 && result[pos - 1].dist > dist)
+  {
+    result[pos] = result[pos - 1];
+    pos--;
+  }
+  result[pos].id = slot->id;
+  result[pos].pos = slot->tail[slot->last];
+  result[pos].srid = slot->srid;
+  result[pos].hasz = slot->hasz;
+  result[pos].dist = dist;
+  return;
+}
+
+/**
+ * Return the k objects whose latest position is nearest to a point
+ *
+ * The grid cells are visited by rings of increasing radius around the cell
+ * of the point. After visiting the rings up to radius r, every position at
+ * most at distance r * cellsize of the point has been found, and thus the
+ * search stops as soon as the k-th neighbor found is within this distance.
+ * When the rings cover more cells than there are buckets, all slots are
+ * scanned instead.
+ */
+static LiveResult *
+livestore_knn(const LivePos *point, int32 srid, bool hasz, int k,
+  int *count)
+{
+  LiveResult *result = palloc(sizeof(LiveResult) * k);
+  int64 cellx, celly;
+  bool done = false;
+  *count = 0;
+  LWLockAcquire(livestore->lock, LW_SHARED);
+  cellx = livestore_cell(point->x);
+  celly = livestore_cell(point->y);
+  for (int64 r = 0; ! done; r++)
+  {
+    if ((2.0 * r + 1) * (2.0 * r + 1) > livestore->nbuckets)
+    {
+      *count = 0;
+      for (int32 i = 0; i < livestore->capacity; i++)
+      {
+        LiveSlot *slot = LIVESTORE_SLOT(i);
+        if (slot->bucket >= 0)
+          liveknn_add(result, count, k, slot, point, srid, hasz);
+      }
+      break;
+    }
+    for (int64 cx = cellx - r; cx <= cellx + r; cx++)
+    {
+      /* Only the cells on the border of the ring are visited */
+      int64 step = (cx == cellx - r || cx == cellx + r) ? 1 : Max(2 * r, 1);
+      for (int64 cy = celly - r; cy <= celly + r; cy += step)
+      {
+        int32 i = livestore->buckets[livestore_bucket(cx, cy)];
+        while (i >= 0)
+        {
+          LiveSlot *slot = LIVESTORE_SLOT(i);
+          if (slot->cellx == cx && slot->celly == cy)
+            liveknn_add(result, count, k, slot, point, srid, hasz);
+          i = slot->next;
+        }
+      }
+    }
+    done = (*count == k && result[k - 1].dist <= r * livestore->cellsize);
+  }
+  LWLockRelease(livestore->lock);
+  return result;
+}
+
+/**
+ * Return the recent positions of a moving object as a temporal point
+ * instant set, or NULL if the object is not in the store
+ */
+static Temporal *
+livestore_tail_tpoint(int64 id)
+{
+  LivePos pos[LIVESTORE_MAX_TAIL];
+  LiveEntry *entry;
+  TInstant **instants;
+  int32 srid = 0;
+  bool hasz = false;
+  int count = 0;
+
+  LWLockAcquire(livestore->lock, LW_SHARED);
+  entry = (LiveEntry *) hash_search(livestore_hash, &id, HASH_FIND, NULL);
+  if (entry)
+  {
+    LiveSlot *slot = LIVESTORE_SLOT(entry->slot);
+    srid = slot->srid;
+    hasz = slot->hasz;
+    count = slot->count;
+    /* Copy the ring buffer from the oldest to the latest position */
+    for (int i = 0; i < count; i++)
+      pos[i] = slot->tail[(slot->last - count + 1 + i + livestore->tail) %
+        livestore->tail];
+  }
+  LWLockRelease(livestore->lock);
+  if (count == 0)
+    return NULL;
+
+  instants = palloc(sizeof(TInstant *) * count);
+  for (int i = 0; i < count; i++)
+  {
+    Datum value = point_make(pos[i].x, pos[i].y, pos[i].z, hasz, false, srid);
+    instants[i] = tinstant_make(value, pos[i].t, T_TGEOMPOINT);
+    pfree(DatumGetPointer(value));
+  }
+  return (Temporal *) tinstantset_make_free(instants, count, MERGE_NO);
+}
+
+/*****************************************************************************/
+/*****************************************************************************/
+/*                        MobilityDB - PostgreSQL                            */
+/*****************************************************************************/
+/*****************************************************************************/
+
+#ifndef MEOS
+
+PG_FUNCTION_INFO_V1(Live_update);
+/**
+ * Add the instants of a temporal point to the live position store
+ */
+PGDLLEXPORT Datum
+Live_update(PG_FUNCTION_ARGS)
+{
+  int64 id = PG_GETARG_INT64(0);
+  Temporal *temp = PG_GETARG_TEMPORAL_P(1);
+  ensure_livestore();
+  ensure_not_geodetic(temp->flags);
+  int result = livestore_update(id, temp);
+  PG_FREE_IF_COPY(temp, 1);
+  PG_RETURN_INT32(result);
+}
+
+PG_FUNCTION_INFO_V1(Live_remove);
+/**
+ * Remove a moving object from the live position store
+ */
+PGDLLEXPORT Datum
+Live_remove(PG_FUNCTION_ARGS)
+{
+  int64 id = PG_GETARG_INT64(0);
+  ensure_livestore();
+  PG_RETURN_BOOL(livestore_remove(id));
+}
+
+PG_FUNCTION_INFO_V1(Live_count);
+/**
+ * Return the number of moving objects in the live position store
+ */
+PGDLLEXPORT Datum
+Live_count(PG_FUNCTION_ARGS __attribute__((unused)))
+{
+  int result;
+  ensure_livestore();
+  LWLockAcquire(livestore->lock, LW_SHARED);
+  result = livestore->count;
+  LWLockRelease(livestore->lock);
+  PG_RETURN_INT32(result);
+}
+
+PG_FUNCTION_INFO_V1(Live_tail);
+/**
+ * Return the recent positions of a moving object in the live position store
+ */
+PGDLLEXPORT Datum
+Live_tail(PG_FUNCTION_ARGS)
+{
+  int64 id = PG_GETARG_INT64(0);
+  ensure_livestore();
+  Temporal *result = livestore_tail_tpoint(id);
+  if (! result)
+    PG_RETURN_NULL();
+  PG_RETURN_POINTER(result);
+}
+
+/**
+ * Return the next position of a set-returning function querying the live
+ * position store
+ */
+static Datum
+live_srf_next(FunctionCallInfo fcinfo, bool withdist)
+{
+  FuncCallContext *funcctx = SRF_PERCALL_SETUP();
+  LiveState *state = funcctx->user_fctx;
+  bool isnull[3] = {0,0,0}; /* needed to say no value is null */
+  Datum tuple_arr[3]; /* used to construct the composite return value */
+  HeapTuple tuple;
+  LiveResult *res;
+  Datum value;
+
+  if (state->i == state->count)
+    SRF_RETURN_DONE(funcctx);
+
+  res = &state->results[state->i++];
+  value = point_make(res->pos.x, res->pos.y, res->pos.z, res->hasz, false,
+    res->srid);
+  tuple_arr[0] = Int64GetDatum(res->id);
+  tuple_arr[1] = PointerGetDatum(tinstant_make(value, res->pos.t,
+    T_TGEOMPOINT));
+  if (withdist)
+    tuple_arr[2] = Float8GetDatum(res->dist);
+  pfree(DatumGetPointer(value));
+  tuple = heap_form_tuple(funcctx->tuple_desc, tuple_arr, isnull);
+  SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+}
+
+/**
+ * Initialize a set-returning function querying the live position store
+ */
+static FuncCallContext *
+live_srf_init(FunctionCallInfo fcinfo, MemoryContext *oldcontext)
+{
+  FuncCallContext *funcctx = SRF_FIRSTCALL_INIT();
+  /* Switch to memory context appropriate for multiple function calls */
+  *oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+  funcctx->user_fctx = palloc0(sizeof(LiveState));
+  /* Build a tuple description for the function output */
+  get_call_result_type(fcinfo, 0, &funcctx->tuple_desc);
+  BlessTupleDesc(funcctx->tuple_desc);
+  return funcctx;
+}
+
+/**
+ * Return the coordinates of a point geometry
+ */
+static void
+live_point(const GSERIALIZED *gs, LivePos *point)
+{
+  POINT4D p;
+  ensure_point_type(gs);
+  ensure_non_empty(gs);
+  datum_point4d(PointerGetDatum(gs), &p);
+  point->x = p.x;
+  point->y = p.y;
+  point->z = p.z;
+  point->t = 0;
+  return;
+}
+
+PG_FUNCTION_INFO_V1(Live_window);
+/**
+ * Return the moving objects whose latest position in the live position
+ * store is in a spatiotemporal box
+ */
+PGDLLEXPORT Datum
+Live_window(PG_FUNCTION_ARGS)
+{
+  if (SRF_IS_FIRSTCALL())
+  {
+    STBOX *box = PG_GETARG_STBOX_P(0);
+    MemoryContext oldcontext;
+    ensure_livestore();
+    ensure_has_X_stbox(box);
+    ensure_not_geodetic(box->flags);
+    FuncCallContext *funcctx = live_srf_init(fcinfo, &oldcontext);
+    LiveState *state = funcctx->user_fctx;
+    state->results = livestore_window(box, NULL, false, 0.0, &state->count);
+    MemoryContextSwitchTo(oldcontext);
+  }
+  return live_srf_next(fcinfo, false);
+}
+
+PG_FUNCTION_INFO_V1(Live_dwithin);
+/**
+ * Return the moving objects whose latest position in the live position
+ * store is at most at a given distance of a point, together with their
+ * distance
+ */
+PGDLLEXPORT Datum
+Live_dwithin(PG_FUNCTION_ARGS)
+{
+  if (SRF_IS_FIRSTCALL())
+  {
+    GSERIALIZED *gs = PG_GETARG_GSERIALIZED_P(0);
+    double dist = PG_GETARG_FLOAT8(1);
+    MemoryContext oldcontext;
+    LivePos point;
+    STBOX box;
+    ensure_livestore();
+    live_point(gs, &point);
+    if (dist < 0.0)
+      ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+        errmsg("The distance must be positive")));
+    bool hasz = (bool) FLAGS_GET_Z(GS_FLAGS(gs));
+    stbox_set(true, false, false, false, gserialized_get_srid(gs),
+      point.x - dist, point.x + dist, point.y - dist, point.y + dist,
+      0.0, 0.0, 0, 0, &box);
+    FuncCallContext *funcctx = live_srf_init(fcinfo, &oldcontext);
+    LiveState *state = funcctx->user_fctx;
+    state->results = livestore_window(&box, &point, hasz, dist,
+      &state->count);
+    MemoryContextSwitchTo(oldcontext);
+    PG_FREE_IF_COPY(gs, 0);
+  }
+  return live_srf_next(fcinfo, true);
+}
+
+PG_FUNCTION_INFO_V1(Live_knn);
+/**
+ * Return the k moving objects whose latest position in the live position
+ * store is nearest to a point, together with their distance
+ */
+PGDLLEXPORT Datum
+Live_knn(PG_FUNCTION_ARGS)
+{
+  if (SRF_IS_FIRSTCALL())
+  {
+    GSERIALIZED *gs = PG_GETARG_GSERIALIZED_P(0);
+    int k = PG_GETARG_INT32(1);
+    MemoryContext oldcontext;
+    LivePos point;
+    ensure_livestore();
+    live_point(gs, &point);
+    if (k <= 0)
+      ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+        errmsg("The number of neighbors must be positive")));
+    bool hasz = (bool) FLAGS_GET_Z(GS_FLAGS(gs));
+    FuncCallContext *funcctx = live_srf_init(fcinfo, &oldcontext);
+    LiveState *state = funcctx->user_fctx;
+    state->results = livestore_knn(&point, gserialized_get_srid(gs), hasz,
+      Min(k, livestore->capacity), &state->count);
+    MemoryContextSwitchTo(oldcontext);
+    PG_FREE_IF_COPY(gs, 0);
+  }
+  return live_srf_next(fcinfo, true);
+}
+
+#endif /* #ifndef MEOS */
+
+/*****************************************************************************/
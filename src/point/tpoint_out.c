@@ -29,8 +29,8 @@
 
 /**
  * @file tpoint_out.c
- * @brief Output of temporal points in WKT, EWKT, WKB, EWKB, and MF-JSON
- * format.
+ * @brief Output of temporal points in WKT, EWKT, WKB, EWKB, MF-JSON, and
+ * encoded polyline format.
  */
 
 #include "point/tpoint_out.h"
@@ -38,6 +38,8 @@
 /* PostgreSQL */
 #include <assert.h>
 #include <float.h>
+#include <math.h>
+#include <lib/stringinfo.h>
 #include <utils/builtins.h>
 /* PostGIS */
 #if POSTGIS_VERSION_NUMBER >= 30000
@@ -1272,6 +1274,205 @@ tpoint_as_hexewkb(const Temporal *temp, uint8_t variant, size_t *size)
   return result;
 }
 
+/*****************************************************************************
+ * Output in encoded polyline format
+ *
+ * The format extends the encoded polyline algorithm of Google Maps to
+ * temporal points. The output is a stream of integers as follows
+ * - Linear, Geodetic, Z, Temporal Subtype, as in the WKB format
+ * - SRID
+ * - Number of decimal digits of the coordinates
+ * - Number of sequences (for sequence sets only)
+ * - For each sequence (or for the single instant set or sequence)
+ *   - Number of instants (except for instants)
+ *   - Lower/upper inclusive, as in the WKB format (for sequences only)
+ *   - For each instant, the difference with the previous instant of the
+ *     coordinates multiplied by 10^precision and rounded, and of the
+ *     timestamp in microseconds
+ * Each integer is zig-zag encoded so that values with a small absolute value
+ * take few bytes and written as a variable-length sequence of chunks of
+ * 5 bits, each of them being offset into the characters '?' to '~' as in the
+ * original algorithm, or of 7 bits in the binary variant.
+ *****************************************************************************/
+
+/**
+ * Structure used for passing the state between the writing functions
+ */
+typedef struct
+{
+  StringInfo buf;      /**< Output buffer */
+  bool binary;         /**< Binary vs text output */
+  bool hasz;           /**< Z? */
+  int precision;       /**< Number of decimal digits of the coordinates */
+  double scale;        /**< 10^precision */
+  int64 x, y, z;       /**< Coordinates of the previous instant */
+  TimestampTz t;       /**< Timestamp of the previous instant */
+} polyline_write_state;
+
+/**
+ * Writes into the buffer an integer represented in encoded polyline format
+ */
+static void
+int64_to_polyline_buf(polyline_write_state *s, int64 value)
+{
+  uint64 zz = ((uint64) value << 1) ^ (uint64) (value >> 63);
+  if (s->binary)
+  {
+    while (zz >= 0x80)
+    {
+      appendStringInfoChar(s->buf, (char) ((zz & 0x7F) | 0x80));
+      zz >>= 7;
+    }
+  }
+  else
+  {
+    while (zz >= 0x20)
+    {
+      appendStringInfoChar(s->buf,
+        (char) (((zz & 0x1F) | 0x20) + POLYLINE_CHAR_OFFSET));
+      zz >>= 5;
+    }
+    zz += POLYLINE_CHAR_OFFSET;
+  }
+  appendStringInfoChar(s->buf, (char) zz);
+  return;
+}
+
+/**
+ * Return a coordinate multiplied by 10^precision and rounded. The result is
+ * bounded by 2^62 so that the difference of two coordinates does not
+ * overflow.
+ */
+static int64
+coord_to_polyline(polyline_write_state *s, double coord)
+{
+  double result = rint(coord * s->scale);
+  if (isnan(result) || fabs(result) >= 4611686018427387904.0)
+    ereport(ERROR, (errcode(ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE),
+      errmsg("Coordinate %g cannot be encoded with %d decimal digits",
+        coord, s->precision)));
+  return (int64) result;
+}
+
+/**
+ * Writes into the buffer the temporal instant point represented in
+ * encoded polyline format as the difference with the previous instant
+ */
+static void
+tpointinst_to_polyline_buf(polyline_write_state *s, const TInstant *inst)
+{
+  int64 x, y, z = 0;
+  if (s->hasz)
+  {
+    const POINT3DZ *point = datum_point3dz_p(tinstant_value(inst));
+    x = coord_to_polyline(s, point->x);
+    y = coord_to_polyline(s, point->y);
+    z = coord_to_polyline(s, point->z);
+  }
+  else
+  {
+    const POINT2D *point = datum_point2d_p(tinstant_value(inst));
+    x = coord_to_polyline(s, point->x);
+    y = coord_to_polyline(s, point->y);
+  }
+  int64_to_polyline_buf(s, x - s->x);
+  int64_to_polyline_buf(s, y - s->y);
+  if (s->hasz)
+    int64_to_polyline_buf(s, z - s->z);
+  int64_to_polyline_buf(s, inst->t - s->t);
+  s->x = x;
+  s->y = y;
+  s->z = z;
+  s->t = inst->t;
+  return;
+}
+
+/**
+ * Writes into the buffer the instants of the temporal sequence point
+ * represented in encoded polyline format preceded by their number and the
+ * bounds of the sequence
+ */
+static void
+tpointseq_to_polyline_buf(polyline_write_state *s, const TSequence *seq)
+{
+  uint8_t bounds = 0;
+  if (seq->period.lower_inc)
+    bounds |= MOBDB_WKB_LOWER_INC;
+  if (seq->period.upper_inc)
+    bounds |= MOBDB_WKB_UPPER_INC;
+  int64_to_polyline_buf(s, seq->count);
+  int64_to_polyline_buf(s, bounds);
+  for (int i = 0; i < seq->count; i++)
+    tpointinst_to_polyline_buf(s, tsequence_inst_n(seq, i));
+  return;
+}
+
+/**
+ * @ingroup libmeos_temporal_input_output
+ * @brief Return the temporal point in encoded polyline format.
+ *
+ * @param[in] temp Temporal point
+ * @param[in] precision Number of decimal digits of the coordinates
+ * @param[in] binary True when the integers are written in chunks of 7 bits
+ * instead of characters of the polyline alphabet
+ * @param[out] size Size of the result, excluding the null terminator
+ */
+char *
+tpoint_as_polyline(const Temporal *temp, int precision, bool binary,
+  size_t *size)
+{
+  ensure_valid_tempsubtype(temp->subtype);
+  if (precision < 0 || precision > POLYLINE_MAX_PRECISION)
+    ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+      errmsg("The number of decimal digits must be between 0 and %d",
+        POLYLINE_MAX_PRECISION)));
+
+  StringInfoData buf;
+  initStringInfo(&buf);
+  polyline_write_state s;
+  memset(&s, 0, sizeof(polyline_write_state));
+  s.buf = &buf;
+  s.binary = binary;
+  s.hasz = MOBDB_FLAGS_GET_Z(temp->flags);
+  s.precision = precision;
+  s.scale = pow(10.0, precision);
+
+  /* Write the header */
+  uint8_t flags = temp->subtype;
+  if (s.hasz)
+    flags |= MOBDB_WKB_ZFLAG;
+  if (MOBDB_FLAGS_GET_GEODETIC(temp->flags))
+    flags |= MOBDB_WKB_GEODETICFLAG;
+  if (MOBDB_FLAGS_GET_LINEAR(temp->flags))
+    flags |= MOBDB_WKB_LINEAR_INTERP;
+  int64_to_polyline_buf(&s, flags);
+  int64_to_polyline_buf(&s, tpoint_srid(temp));
+  int64_to_polyline_buf(&s, precision);
+
+  /* Write the instants */
+  if (temp->subtype == INSTANT)
+    tpointinst_to_polyline_buf(&s, (TInstant *) temp);
+  else if (temp->subtype == INSTANTSET)
+  {
+    const TInstantSet *ti = (TInstantSet *) temp;
+    int64_to_polyline_buf(&s, ti->count);
+    for (int i = 0; i < ti->count; i++)
+      tpointinst_to_polyline_buf(&s, tinstantset_inst_n(ti, i));
+  }
+  else if (temp->subtype == SEQUENCE)
+    tpointseq_to_polyline_buf(&s, (TSequence *) temp);
+  else /* temp->subtype == SEQUENCESET */
+  {
+    const TSequenceSet *ts = (TSequenceSet *) temp;
+    int64_to_polyline_buf(&s, ts->count);
+    for (int i = 0; i < ts->count; i++)
+      tpointseq_to_polyline_buf(&s, tsequenceset_seq_n(ts, i));
+  }
+
+  *size = (size_t) buf.len;
+  return buf.data;
+}
+
 /*****************************************************************************/
 /*****************************************************************************/
 /*                        MobilityDB - PostgreSQL                            */
@@ -1598,6 +1799,49 @@ Tpoint_as_hexewkb(PG_FUNCTION_ARGS)
   PG_RETURN_TEXT_P(result);
 }
 
+/*****************************************************************************
+ * Output in encoded polyline format
+ *****************************************************************************/
+
+/**
+ * Output the temporal point in encoded polyline format as text or binary
+ */
+static Datum
+tpoint_as_polyline_ext(FunctionCallInfo fcinfo, bool binary)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  int precision = PG_GETARG_INT32(1);
+  size_t size;
+  char *polyline = tpoint_as_polyline(temp, precision, binary, &size);
+  /* Text and bytea share the same varlena representation */
+  bytea *result = palloc(size + VARHDRSZ);
+  memcpy(VARDATA(result), polyline, size);
+  SET_VARSIZE(result, size + VARHDRSZ);
+  pfree(polyline);
+  PG_FREE_IF_COPY(temp, 0);
+  PG_RETURN_BYTEA_P(result);
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_as_polyline);
+/**
+ * Output the temporal point in encoded polyline format
+ */
+PGDLLEXPORT Datum
+Tpoint_as_polyline(PG_FUNCTION_ARGS)
+{
+  return tpoint_as_polyline_ext(fcinfo, false);
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_as_polyline_binary);
+/**
+ * Output the temporal point in binary encoded polyline format
+ */
+PGDLLEXPORT Datum
+Tpoint_as_polyline_binary(PG_FUNCTION_ARGS)
+{
+  return tpoint_as_polyline_ext(fcinfo, true);
+}
+
 #endif /* #ifndef MEOS */
 
 /*****************************************************************************/
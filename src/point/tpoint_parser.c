@@ -214,6 +214,103 @@ stbox_parse(char **str)
 
 /*****************************************************************************/
 
+/**
+ * Return true if the character may start a coordinate of a point
+ */
+static bool
+point_coord_start(char c)
+{
+  return (c >= '0' && c <= '9') || c == '-' || c == '.';
+}
+
+/**
+ * Parse a point in WKT or EWKT format from the buffer without calling the
+ * input function of the base type, e.g., "Point(1 1)", "Point Z(1 1 1)", or
+ * "SRID=5676;Point(1 1)", and consume the '@' that follows it.
+ *
+ * This avoids building and serializing a full LWGEOM through the generic
+ * WKT lexer of PostGIS for every instant, which dominates the cost of loading
+ * textual temporal points.
+ *
+ * @param[in,out] str Input string
+ * @param[in] geodetic True for geography points
+ * @result The serialized point, or NULL without consuming input when the
+ * value is not a plain point, e.g., a point in HexEWKB format, with an M
+ * dimension, with a geodetic SRID other than the default one, or with
+ * coordinates out of the geodetic range. In that case, the caller falls back
+ * to the input function of the base type, which also raises the errors.
+ */
+static GSERIALIZED *
+point_parse_fast(char **str, bool geodetic)
+{
+  char *cur = *str, *end;
+  int srid = SRID_UNKNOWN;
+  if (strncasecmp(cur, "SRID=", 5) == 0)
+  {
+    cur += 5;
+    long val = strtol(cur, &end, 10);
+    if (end == cur || *end != ';' || val <= 0 || val > SRID_USER_MAXIMUM)
+      return NULL;
+    srid = (int) val;
+    cur = end + 1;
+    p_whitespace(&cur);
+  }
+  if (strncasecmp(cur, "POINT", 5) != 0)
+    return NULL;
+  cur += 5;
+  p_whitespace(&cur);
+  bool hasz = false;
+  if (*cur == 'Z' || *cur == 'z')
+  {
+    hasz = true;
+    cur++;
+    p_whitespace(&cur);
+  }
+  if (*cur != '(')
+    return NULL;
+  cur++;
+  double coords[3];
+  int ncoords = 0;
+  while (ncoords < 3)
+  {
+    p_whitespace(&cur);
+    if (! point_coord_start(*cur))
+      break;
+    coords[ncoords++] = strtod(cur, &end);
+    if (end == cur)
+      return NULL;
+    cur = end;
+  }
+  p_whitespace(&cur);
+  /* A point with a fourth coordinate or with the M modifier, which is not
+   * accepted above, is left to the input function of the base type. Three
+   * coordinates without the Z modifier are read as Z, as done by PostGIS */
+  if (ncoords < 2 || (hasz && ncoords != 3) || *cur != ')')
+    return NULL;
+  cur++;
+  p_whitespace(&cur);
+  if (*cur != '@')
+    return NULL;
+  if (geodetic)
+  {
+    if (srid == SRID_UNKNOWN)
+      srid = SRID_DEFAULT;
+    if (srid != SRID_DEFAULT || fabs(coords[0]) > 180.0 ||
+        fabs(coords[1]) > 90.0)
+      return NULL;
+  }
+
+  LWPOINT *point = (ncoords == 3) ?
+    lwpoint_make3dz(srid, coords[0], coords[1], coords[2]) :
+    lwpoint_make2d(srid, coords[0], coords[1]);
+  FLAGS_SET_GEODETIC(point->flags, geodetic);
+  GSERIALIZED *result = geo_serialize((LWGEOM *) point);
+  lwpoint_free(point);
+  /* Consume the '@' as done by basetype_parse */
+  *str = cur + 1;
+  return result;
+}
+
 /**
  * @ingroup libmeos_temporal_input_output
  * @brief Parse a temporal point value of instant type from the buffer.
@@ -222,20 +319,25 @@ stbox_parse(char **str)
  * @param[in] temptype Temporal type
  * @param[in] end Set to true when reading a single instant to ensure there is
  * no moreinput after the sequence
- * @param[in] make Set to false for the first pass to do not create the instant
  * @param[in] tpoint_srid SRID of the temporal point
+ * @note When the SRID of the temporal point is only known after parsing the
+ * instant, the SRID of the instant must be set afterwards with the function
+ * #tpointinstarr_set_srid
  */
 TInstant *
-tpointinst_parse(char **str, CachedType temptype, bool end, bool make,
-  int *tpoint_srid)
+tpointinst_parse(char **str, CachedType temptype, bool end, int *tpoint_srid)
 {
   p_whitespace(str);
-  /* The next instruction will throw an exception if it fails */
-  Datum geo = basetype_parse(str, temptype_basetypid(temptype));
-  GSERIALIZED *gs = (GSERIALIZED *) PG_DETOAST_DATUM(geo);
-  ensure_point_type(gs);
-  ensure_non_empty(gs);
-  ensure_has_not_M_gs(gs);
+  GSERIALIZED *gs = point_parse_fast(str, temptype == T_TGEOGPOINT);
+  if (gs == NULL)
+  {
+    /* The next instruction will throw an exception if it fails */
+    Datum geo = basetype_parse(str, temptype_basetypid(temptype));
+    gs = (GSERIALIZED *) PG_DETOAST_DATUM(geo);
+    ensure_point_type(gs);
+    ensure_non_empty(gs);
+    ensure_has_not_M_gs(gs);
+  }
   /* If one of the SRID of the temporal point and of the geometry
    * is SRID_UNKNOWN and the other not, copy the SRID */
   int geo_srid = gserialized_get_srid(gs);
@@ -252,12 +354,60 @@ tpointinst_parse(char **str, CachedType temptype, bool end, bool make,
   /* The next instruction will throw an exception if it fails */
   TimestampTz t = timestamp_parse(str);
   ensure_end_input(str, end);
-  TInstant *result = make ?
-    tinstant_make(PointerGetDatum(gs), t, temptype) : NULL;
+  TInstant *result = tinstant_make(PointerGetDatum(gs), t, temptype);
   pfree(gs);
   return result;
 }
 
+/**
+ * Set the SRID of the instants parsed before the SRID of the temporal point
+ * was known, e.g., the first instant in
+ * "[Point(1 1)@2000-01-01, SRID=5676;Point(2 2)@2000-01-02]"
+ */
+static void
+tpointinstarr_set_srid(TInstant **instants, int count, int srid)
+{
+  if (srid == SRID_UNKNOWN)
+    return;
+  for (int i = 0; i < count; i++)
+  {
+    GSERIALIZED *gs = (GSERIALIZED *) DatumGetPointer(
+      tinstant_value(instants[i]));
+    if (gserialized_get_srid(gs) == SRID_UNKNOWN)
+      gserialized_set_srid(gs, srid);
+  }
+  return;
+}
+
+/**
+ * Parse the comma-separated instants of a temporal point in a single pass,
+ * storing them into an array that is enlarged as needed
+ *
+ * @param[in] str Input string
+ * @param[in] temptype Temporal type
+ * @param[in] tpoint_srid SRID of the temporal point
+ * @param[out] count Number of instants
+ */
+static TInstant **
+tpointinstarr_parse(char **str, CachedType temptype, int *tpoint_srid,
+  int *count)
+{
+  int maxcount = 16;
+  TInstant **result = palloc(sizeof(TInstant *) * maxcount);
+  int k = 0;
+  do
+  {
+    if (k == maxcount)
+    {
+      maxcount *= 2;
+      result = repalloc(result, sizeof(TInstant *) * maxcount);
+    }
+    result[k++] = tpointinst_parse(str, temptype, false, tpoint_srid);
+  } while (p_comma(str));
+  *count = k;
+  return result;
+}
+
 /**
  * @ingroup libmeos_temporal_input_output
  * @brief Parse a temporal point value of instant set type from the buffer.
@@ -273,88 +423,71 @@ tpointinstset_parse(char **str, CachedType temptype, int *tpoint_srid)
   /* We are sure to find an opening brace because that was the condition
    * to call this function in the dispatch function tpoint_parse */
   p_obrace(str);
-
-  /* First parsing */
-  char *bak = *str;
-  tpointinst_parse(str, temptype, false, false, tpoint_srid);
-  int count = 1;
-  while (p_comma(str))
-  {
-    count++;
-    tpointinst_parse(str, temptype, false, false, tpoint_srid);
-  }
+  int count;
+  TInstant **instants = tpointinstarr_parse(str, temptype, tpoint_srid,
+    &count);
   if (!p_cbrace(str))
     ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
       errmsg("Could not parse temporal value")));
   ensure_end_input(str, true);
-
-  /* Second parsing */
-  *str = bak;
-  TInstant **instants = palloc(sizeof(TInstant *) * count);
-  for (int i = 0; i < count; i++)
-  {
-    p_comma(str);
-    instants[i] = tpointinst_parse(str, temptype, false, true, tpoint_srid);
-  }
-  p_cbrace(str);
+  tpointinstarr_set_srid(instants, count, *tpoint_srid);
   return tinstantset_make_free(instants, count, MERGE_NO);
 }
 
 /**
- * @ingroup libmeos_temporal_input_output
- * @brief Parse a temporal point value of sequence type from the buffer.
+ * Parse the instants and the bounds of a temporal point value of sequence
+ * type from the buffer without constructing the sequence, since its SRID may
+ * only be known after parsing the next sequences of a sequence set
  *
  * @param[in] str Input string
  * @param[in] temptype Temporal type
- * @param[in] linear True when the interpolation is linear
- * @param[in] end Set to true when reading a single instant to ensure there is
- * no moreinput after the sequence
- * @param[in] make Set to false for the first pass to do not create the instant
  * @param[in] tpoint_srid SRID of the temporal point
-*/
-TSequence *
-tpointseq_parse(char **str, CachedType temptype, bool linear, bool end,
-  bool make, int *tpoint_srid)
+ * @param[out] count Number of instants
+ * @param[out] lower_inc,upper_inc Bounds of the sequence
+ */
+static TInstant **
+tpointseq_parse_instants(char **str, CachedType temptype, int *tpoint_srid,
+  int *count, bool *lower_inc, bool *upper_inc)
 {
   p_whitespace(str);
-  bool lower_inc = false, upper_inc = false;
   /* We are sure to find an opening bracket or parenthesis because that was the
    * condition to call this function in the dispatch function tpoint_parse */
   if (p_obracket(str))
-    lower_inc = true;
+    *lower_inc = true;
   else if (p_oparen(str))
-    lower_inc = false;
-
-  /* First parsing */
-  char *bak = *str;
-  tpointinst_parse(str, temptype, false, false, tpoint_srid);
-  int count = 1;
-  while (p_comma(str))
-  {
-    count++;
-    tpointinst_parse(str, temptype, false, false, tpoint_srid);
-  }
+    *lower_inc = false;
+  TInstant **result = tpointinstarr_parse(str, temptype, tpoint_srid, count);
   if (p_cbracket(str))
-    upper_inc = true;
+    *upper_inc = true;
   else if (p_cparen(str))
-    upper_inc = false;
+    *upper_inc = false;
   else
     ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
       errmsg("Could not parse temporal value")));
-  ensure_end_input(str, end);
-  if (! make)
-    return NULL;
+  return result;
+}
 
-  /* Second parsing */
-  *str = bak;
-  TInstant **instants = palloc(sizeof(TInstant *) * count);
-  for (int i = 0; i < count; i++)
-  {
-    p_comma(str);
-    instants[i] = tpointinst_parse(str, temptype, false, true, tpoint_srid);
-  }
-  p_cbracket(str);
-  p_cparen(str);
+/**
+ * @ingroup libmeos_temporal_input_output
+ * @brief Parse a temporal point value of sequence type from the buffer.
+ *
+ * @param[in] str Input string
+ * @param[in] temptype Temporal type
+ * @param[in] linear True when the interpolation is linear
+ * @param[in] end Set to true when reading a single instant to ensure there is
+ * no moreinput after the sequence
+ * @param[in] tpoint_srid SRID of the temporal point
+*/
+TSequence *
+tpointseq_parse(char **str, CachedType temptype, bool linear, bool end,
+  int *tpoint_srid)
+{
+  int count;
+  bool lower_inc = false, upper_inc = false;
+  TInstant **instants = tpointseq_parse_instants(str, temptype, tpoint_srid,
+    &count, &lower_inc, &upper_inc);
+  ensure_end_input(str, end);
+  tpointinstarr_set_srid(instants, count, *tpoint_srid);
   return tsequence_make_free(instants, count, lower_inc, upper_inc,
     linear, NORMALIZE);
 }
@@ -376,31 +509,38 @@ tpointseqset_parse(char **str, CachedType temptype, bool linear,
   /* We are sure to find an opening brace because that was the condition
    * to call this function in the dispatch function tpoint_parse */
   p_obrace(str);
-
-  /* First parsing */
-  char *bak = *str;
-  tpointseq_parse(str, temptype, linear, false, false, tpoint_srid);
-  int count = 1;
-  while (p_comma(str))
+  int maxcount = 8, count = 0;
+  TInstant ***instants = palloc(sizeof(TInstant **) * maxcount);
+  int *countinst = palloc(sizeof(int) * maxcount);
+  bool *lower_inc = palloc(sizeof(bool) * maxcount);
+  bool *upper_inc = palloc(sizeof(bool) * maxcount);
+  do
   {
+    if (count == maxcount)
+    {
+      maxcount *= 2;
+      instants = repalloc(instants, sizeof(TInstant **) * maxcount);
+      countinst = repalloc(countinst, sizeof(int) * maxcount);
+      lower_inc = repalloc(lower_inc, sizeof(bool) * maxcount);
+      upper_inc = repalloc(upper_inc, sizeof(bool) * maxcount);
+    }
+    instants[count] = tpointseq_parse_instants(str, temptype, tpoint_srid,
+      &countinst[count], &lower_inc[count], &upper_inc[count]);
     count++;
-    tpointseq_parse(str, temptype, linear, false, false, tpoint_srid);
-  }
+  } while (p_comma(str));
   if (!p_cbrace(str))
     ereport(ERROR, (errcode(ERRCODE_INVALID_TEXT_REPRESENTATION),
       errmsg("Could not parse temporal value")));
   ensure_end_input(str, true);
 
-  /* Second parsing */
-  *str = bak;
   TSequence **sequences = palloc(sizeof(TSequence *) * count);
   for (int i = 0; i < count; i++)
   {
-    p_comma(str);
-    sequences[i] = tpointseq_parse(str, temptype, linear, false, true,
-      tpoint_srid);
+    tpointinstarr_set_srid(instants[i], countinst[i], *tpoint_srid);
+    sequences[i] = tsequence_make_free(instants[i], countinst[i],
+      lower_inc[i], upper_inc[i], linear, NORMALIZE);
   }
-  p_cbrace(str);
+  pfree(instants); pfree(countinst); pfree(lower_inc); pfree(upper_inc);
   return tsequenceset_make_free(sequences, count, NORMALIZE);
 }
 
@@ -459,11 +599,10 @@ tpoint_parse(char **str, Oid temptype)
   {
     /* Pass the SRID specification */
     *str = bak;
-    result = (Temporal *) tpointinst_parse(str, temptype, true, true,
-      &tpoint_srid);
+    result = (Temporal *) tpointinst_parse(str, temptype, true, &tpoint_srid);
   }
   else if (**str == '[' || **str == '(')
-    result = (Temporal *) tpointseq_parse(str, temptype, linear, true, true,
+    result = (Temporal *) tpointseq_parse(str, temptype, linear, true,
       &tpoint_srid);
   else if (**str == '{')
   {
@@ -36,6 +36,8 @@
 
 /* PostgreSQL */
 #include <assert.h>
+#include <funcapi.h>
+#include <access/htup_details.h>
 #if POSTGRESQL_VERSION_NUMBER < 120000
 #define M_PI 3.14159265358979323846
 #define RADIANS_PER_DEGREE 0.0174532925199432957692
@@ -55,6 +57,7 @@
 #include "general/rangetypes_ext.h"
 #include "general/temporaltypes.h"
 #include "general/tempcache.h"
+#include "general/temporal_tile.h"
 #include "general/tnumber_mathfuncs.h"
 #include "point/postgis.h"
 #include "point/stbox.h"
@@ -3094,6 +3097,127 @@ tpoint_speed(const Temporal *temp)
   return result;
 }
 
+/**
+ * Return the distance between the points of the two instants
+ */
+static Datum
+tpointinst_displacement(const TInstant *inst1, const TInstant *inst2)
+{
+  Datum value1 = tinstant_value(inst1);
+  Datum value2 = tinstant_value(inst2);
+  if (datum_point_eq(value1, value2))
+    return Float8GetDatum(0.0);
+  datum_func2 func = distance_fn(inst1->flags);
+  return func(value1, value2);
+}
+
+/**
+ * @ingroup libmeos_temporal_spatial_accessor
+ * @brief Return the distance traveled since the previous instant of the
+ * temporal point.
+ *
+ * Contrary to the speed, the displacement is computed between the
+ * consecutive instants whatever the interpolation of the temporal point.
+ * @param[in] temp Temporal point
+ * @param[in] maxgap Maximum gap in PostgreSQL time units, no gap when 0
+ * @see temporal_delta
+ */
+Temporal *
+tpoint_displacement(const Temporal *temp, int64 maxgap)
+{
+  return temporal_delta(temp, maxgap, &tpointinst_displacement, T_TFLOAT);
+}
+
+/*****************************************************************************
+ * Summary statistics
+ *****************************************************************************/
+
+/**
+ * Accumulate the length and the maximum speed of the segments of the
+ * temporal sequence point
+ *
+ * @param[in] seq Temporal sequence point
+ * @param[inout] stats Statistics
+ * @pre The temporal point has linear interpolation
+ */
+static void
+tpointseq_stats_iter(const TSequence *seq, TPointStats *stats)
+{
+  if (seq->count == 1)
+    return;
+  datum_func2 func = pt_distance_fn(seq->flags);
+  const TInstant *inst1 = tsequence_inst_n(seq, 0);
+  Datum value1 = tinstant_value(inst1);
+  for (int i = 1; i < seq->count; i++)
+  {
+    const TInstant *inst2 = tsequence_inst_n(seq, i);
+    Datum value2 = tinstant_value(inst2);
+    double dist = datum_point_eq(value1, value2) ? 0.0 :
+      DatumGetFloat8(func(value1, value2));
+    double speed = dist / ((double)(inst2->t - inst1->t) / 1000000.0);
+    stats->length += dist;
+    if (! stats->hasspeed || speed > stats->maxspeed)
+      stats->maxspeed = speed;
+    stats->hasspeed = true;
+    inst1 = inst2;
+    value1 = value2;
+  }
+  return;
+}
+
+/**
+ * @ingroup libmeos_temporal_spatial_accessor
+ * @brief Compute the summary statistics of the temporal point.
+ *
+ * The length and the speeds are obtained in a single pass over the segments
+ * instead of building the speed and the trajectory of the temporal point,
+ * the other statistics are read from the header and the bounding box.
+ *
+ * @param[in] temp Temporal point
+ * @param[out] stats Statistics
+ * @note The average speed is the length divided by the duration and is only
+ * defined when the point has at least one linear segment
+ */
+void
+tpoint_stats(const Temporal *temp, TPointStats *stats)
+{
+  ensure_valid_tempsubtype(temp->subtype);
+  stats->numinst = temporal_num_instants(temp);
+  Interval *duration = temporal_duration(temp);
+  memcpy(&stats->duration, duration, sizeof(Interval));
+  pfree(duration);
+  stats->length = stats->maxspeed = stats->avgspeed = 0.0;
+  stats->hasspeed = false;
+  stats->startvalue = temporal_start_value((Temporal *) temp);
+  stats->endvalue = temporal_end_value((Temporal *) temp);
+  temporal_bbox(temp, &stats->box);
+  if (temp->subtype == INSTANT || temp->subtype == INSTANTSET ||
+      ! MOBDB_FLAGS_GET_LINEAR(temp->flags))
+    return;
+
+  double secs;
+  if (temp->subtype == SEQUENCE)
+  {
+    const TSequence *seq = (const TSequence *) temp;
+    tpointseq_stats_iter(seq, stats);
+    secs = (double) (seq->period.upper - seq->period.lower) / 1000000.0;
+  }
+  else /* temp->subtype == SEQUENCESET */
+  {
+    const TSequenceSet *ts = (const TSequenceSet *) temp;
+    secs = 0.0;
+    for (int i = 0; i < ts->count; i++)
+    {
+      const TSequence *seq = tsequenceset_seq_n(ts, i);
+      tpointseq_stats_iter(seq, stats);
+      secs += (double) (seq->period.upper - seq->period.lower) / 1000000.0;
+    }
+  }
+  if (stats->hasspeed)
+    stats->avgspeed = stats->length / secs;
+  return;
+}
+
 /*****************************************************************************
  * Time-weighed centroid for temporal geometry points
  *****************************************************************************/
@@ -5499,6 +5623,64 @@ Tpoint_speed(PG_FUNCTION_ARGS)
   PG_RETURN_POINTER(result);
 }
 
+PG_FUNCTION_INFO_V1(Tpoint_displacement);
+/**
+ * Return the distance traveled since the previous instant of the temporal
+ * point
+ */
+PGDLLEXPORT Datum
+Tpoint_displacement(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  int64 maxgap = delta_get_maxgap(fcinfo);
+  /* Store fcinfo into a global variable */
+  store_fcinfo(fcinfo);
+  Temporal *result = tpoint_displacement(temp, maxgap);
+  PG_FREE_IF_COPY(temp, 0);
+  if (result == NULL)
+    PG_RETURN_NULL();
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_stats);
+/**
+ * Return the summary statistics of the temporal point
+ */
+PGDLLEXPORT Datum
+Tpoint_stats(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  /* Store fcinfo into a global variable */
+  store_fcinfo(fcinfo);
+  TPointStats stats;
+  tpoint_stats(temp, &stats);
+  PG_FREE_IF_COPY(temp, 0);
+
+  TupleDesc tupdesc;
+  if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+    ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+      errmsg("function returning record called in context "
+        "that cannot accept type record")));
+  BlessTupleDesc(tupdesc);
+  Datum values[8];
+  bool isnull[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  Interval *duration = palloc(sizeof(Interval));
+  memcpy(duration, &stats.duration, sizeof(Interval));
+  STBOX *box = palloc(sizeof(STBOX));
+  memcpy(box, &stats.box, sizeof(STBOX));
+  values[0] = Int32GetDatum(stats.numinst);
+  values[1] = PointerGetDatum(duration);
+  values[2] = Float8GetDatum(stats.length);
+  values[3] = Float8GetDatum(stats.maxspeed);
+  values[4] = Float8GetDatum(stats.avgspeed);
+  isnull[3] = isnull[4] = ! stats.hasspeed;
+  values[5] = stats.startvalue;
+  values[6] = stats.endvalue;
+  values[7] = PointerGetDatum(box);
+  HeapTuple tuple = heap_form_tuple(tupdesc, values, isnull);
+  PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
+}
+
 /*****************************************************************************
  * Time-weighed centroid for temporal geometry points
  *****************************************************************************/
@@ -1214,3 +1214,607 @@ Tpoint_space_time_split(PG_FUNCTION_ARGS)
 }
 
 /*****************************************************************************/
+
+/*****************************************************************************
+ * Cell coverings
+ *****************************************************************************/
+
+/**
+ * Comparator for the keys of the cells
+ */
+static int
+int64_cmp(const void *a, const void *b)
+{
+  int64 k1 = *(const int64 *) a;
+  int64 k2 = *(const int64 *) b;
+  return (k1 < k2) ? -1 : ((k1 > k2) ? 1 : 0);
+}
+
+/**
+ * Initialize the structure collecting the cells covered by a value
+ *
+ * @param[out] cover Cell cover
+ * @param[in] size Cell size for the spatial dimensions in the units of the SRID
+ * @param[in] tunits Cell size for the temporal dimension in PostgreSQL time
+ * units, only the spatial dimensions are considered when it is equal to 0
+ * @param[in] sorigin Spatial origin of the cells
+ * @param[in] torigin Time origin of the cells
+ */
+static void
+cellcover_init(CellCover *cover, double size, int64 tunits,
+  const POINT3DZ *sorigin, TimestampTz torigin)
+{
+  cover->numdims = tunits ? 3 : 2;
+  cover->size[0] = cover->size[1] = size;
+  cover->origin[0] = sorigin->x;
+  cover->origin[1] = sorigin->y;
+  cover->size[2] = (double) tunits;
+  cover->origin[2] = (double) torigin;
+  cover->count = 0;
+  cover->maxcount = 64;
+  cover->keys = palloc(sizeof(int64) * cover->maxcount);
+  cover->all = false;
+  return;
+}
+
+/**
+ * Get the coordinates of the cell containing the position
+ */
+static void
+cellcover_get_cell(const CellCover *cover, const double *pos, int64 *cell)
+{
+  for (int i = 0; i < cover->numdims; i++)
+    cell[i] = (int64) floor((pos[i] - cover->origin[i]) / cover->size[i]);
+  return;
+}
+
+/**
+ * Return the key of a cell.
+ *
+ * The coordinates of the cell are packed in 64 bits, that is, 32 bits per
+ * dimension in 2D and 21 bits per dimension with time. Distant cells that
+ * wrap around to the same key only yield false positives, which are removed
+ * by the recheck of the query.
+ */
+static int64
+cellcover_key(const CellCover *cover, const int64 *cell)
+{
+  int bits = 64 / cover->numdims;
+  uint64 mask = ((uint64) 1 << bits) - 1;
+  uint64 key = 0;
+  for (int i = 0; i < cover->numdims; i++)
+    key = (key << bits) | ((uint64) cell[i] & mask);
+  return (int64) key;
+}
+
+/**
+ * Sort the keys of the cover and remove the duplicates
+ */
+static void
+cellcover_unique(CellCover *cover)
+{
+  qsort(cover->keys, (size_t) cover->count, sizeof(int64), &int64_cmp);
+  int k = 0;
+  for (int i = 0; i < cover->count; i++)
+  {
+    if (k == 0 || cover->keys[i] != cover->keys[k - 1])
+      cover->keys[k++] = cover->keys[i];
+  }
+  cover->count = k;
+  return;
+}
+
+/**
+ * Add to the cover the key of a cell.
+ *
+ * Since the cells of consecutive segments overlap, the duplicate keys are
+ * removed before growing the array beyond the maximum number of keys. If
+ * there are still too many keys, the cover stands for all the cells:
+ * contrary to a query box, the keys of an indexed value cannot be truncated
+ * without losing results.
+ */
+static void
+cellcover_add(CellCover *cover, const int64 *cell)
+{
+  if (cover->all)
+    return;
+  if (cover->count == cover->maxcount)
+  {
+    if (cover->maxcount >= MAX_CELL_KEYS)
+    {
+      cellcover_unique(cover);
+      if (cover->count >= MAX_CELL_KEYS)
+      {
+        cover->all = true;
+        return;
+      }
+    }
+    /* Grow the array unless removing the duplicates freed enough space */
+    if (cover->count > cover->maxcount / 2)
+    {
+      cover->maxcount *= 2;
+      cover->keys = repalloc(cover->keys, sizeof(int64) * cover->maxcount);
+    }
+  }
+  cover->keys[cover->count++] = cellcover_key(cover, cell);
+  return;
+}
+
+/**
+ * Add to the cover all the cells between the lower and upper cells
+ */
+static void
+cellcover_add_box(CellCover *cover, const int64 *lower, const int64 *upper)
+{
+  int64 cell[3];
+  memcpy(cell, lower, sizeof(int64) * cover->numdims);
+  while (! cover->all)
+  {
+    cellcover_add(cover, cell);
+    /* Advance to the next cell, the first dimension varying fastest */
+    int i = 0;
+    while (i < cover->numdims)
+    {
+      if (cell[i] < upper[i])
+      {
+        cell[i]++;
+        break;
+      }
+      cell[i] = lower[i];
+      i++;
+    }
+    if (i == cover->numdims)
+      break;
+  }
+  return;
+}
+
+/**
+ * Add to the cover the cells traversed by a segment.
+ *
+ * The segment is halved until its extremities are in the same or in adjacent
+ * cells, and then all the cells of its bounding box are added. Contrary to
+ * the Bresenham traversal used for the split functions, which connects the
+ * cells of the extremities, this yields a superset of the cells actually
+ * traversed, as required for an index.
+ *
+ * @param[out] cover Cell cover
+ * @param[in] pos1, pos2 Extremities of the segment
+ * @param[in] depth Recursion depth
+ */
+static void
+cellcover_add_segment(CellCover *cover, const double *pos1,
+  const double *pos2, int depth)
+{
+  if (cover->all)
+    return;
+  int64 cell1[3], cell2[3], lower[3], upper[3];
+  cellcover_get_cell(cover, pos1, cell1);
+  cellcover_get_cell(cover, pos2, cell2);
+  bool adjacent = true;
+  for (int i = 0; i < cover->numdims; i++)
+  {
+    lower[i] = Min(cell1[i], cell2[i]);
+    upper[i] = Max(cell1[i], cell2[i]);
+    if (upper[i] - lower[i] > 1)
+      adjacent = false;
+  }
+  if (adjacent || depth == MAX_CELL_DEPTH)
+  {
+    cellcover_add_box(cover, lower, upper);
+    return;
+  }
+  double middle[3];
+  for (int i = 0; i < cover->numdims; i++)
+    middle[i] = (pos1[i] + pos2[i]) / 2;
+  cellcover_add_segment(cover, pos1, middle, depth + 1);
+  cellcover_add_segment(cover, middle, pos2, depth + 1);
+  return;
+}
+
+/**
+ * Get the position of a temporal instant point in the grid
+ */
+static void
+tpointinst_cell_pos(const TInstant *inst, double *pos)
+{
+  const POINT2D *pt = datum_point2d_p(tinstant_value(inst));
+  pos[0] = pt->x;
+  pos[1] = pt->y;
+  pos[2] = (double) inst->t;
+  return;
+}
+
+/**
+ * Add to the cover the cells of the instants of a temporal point
+ */
+static void
+tpointinstarr_cells(CellCover *cover, const TInstant **instants, int count)
+{
+  double pos[3];
+  for (int i = 0; i < count; i++)
+  {
+    tpointinst_cell_pos(instants[i], pos);
+    cellcover_add_segment(cover, pos, pos, 0);
+  }
+  return;
+}
+
+/**
+ * Add to the cover the cells traversed by a temporal sequence point
+ */
+static void
+tpointseq_cells(CellCover *cover, const TSequence *seq)
+{
+  double pos1[3], pos2[3];
+  tpointinst_cell_pos(tsequence_inst_n(seq, 0), pos1);
+  bool linear = MOBDB_FLAGS_GET_LINEAR(seq->flags);
+  for (int i = 1; i < seq->count; i++)
+  {
+    tpointinst_cell_pos(tsequence_inst_n(seq, i), pos2);
+    if (linear)
+      cellcover_add_segment(cover, pos1, pos2, 0);
+    else
+    {
+      /* The point stays at the same location until the next instant */
+      double pos3[3] = {pos1[0], pos1[1], pos2[2]};
+      cellcover_add_segment(cover, pos1, pos3, 0);
+    }
+    memcpy(pos1, pos2, sizeof(pos1));
+  }
+  /* Add the last instant, which may be the only one */
+  if (! linear || seq->count == 1)
+    cellcover_add_segment(cover, pos1, pos1, 0);
+  return;
+}
+
+/**
+ * Return the sorted keys of the cover without duplicates, or the key
+ * standing for all the cells if there are too many keys
+ */
+static int64 *
+cellcover_keys(CellCover *cover, int *count)
+{
+  if (cover->all)
+  {
+    cover->keys[0] = CELL_KEY_ALL;
+    cover->count = 1;
+  }
+  else
+    cellcover_unique(cover);
+  *count = cover->count;
+  return cover->keys;
+}
+
+/**
+ * @ingroup libmeos_temporal_tiling
+ * @brief Return the keys of the cells of a spatial or spatiotemporal grid
+ * traversed by a temporal point.
+ *
+ * The cells only consider the X, Y, and optionally T dimensions, so that an
+ * index on the keys may be used for points with or without Z dimension. When
+ * the temporal point traverses more than MAX_CELL_KEYS cells, the result is
+ * the single key CELL_KEY_ALL, which is a key of every box, so that the
+ * temporal point is selected by all the queries and filtered by their
+ * recheck.
+ *
+ * @param[in] temp Temporal point
+ * @param[in] size Cell size for the spatial dimensions in the units of the SRID
+ * @param[in] tunits Cell size for the temporal dimension in PostgreSQL time
+ * units, only the spatial dimensions are considered when it is equal to 0
+ * @param[in] sorigin Spatial origin of the cells
+ * @param[in] torigin Time origin of the cells
+ * @param[out] count Number of keys in the result
+ */
+int64 *
+tpoint_cells(const Temporal *temp, double size, int64 tunits,
+  const POINT3DZ *sorigin, TimestampTz torigin, int *count)
+{
+  CellCover cover;
+  cellcover_init(&cover, size, tunits, sorigin, torigin);
+  ensure_valid_tempsubtype(temp->subtype);
+  if (temp->subtype == INSTANT)
+  {
+    const TInstant *inst = (const TInstant *) temp;
+    tpointinstarr_cells(&cover, &inst, 1);
+  }
+  else if (temp->subtype == INSTANTSET)
+  {
+    const TInstantSet *ti = (const TInstantSet *) temp;
+    for (int i = 0; i < ti->count; i++)
+    {
+      const TInstant *inst = tinstantset_inst_n(ti, i);
+      tpointinstarr_cells(&cover, &inst, 1);
+    }
+  }
+  else if (temp->subtype == SEQUENCE)
+    tpointseq_cells(&cover, (const TSequence *) temp);
+  else /* temp->subtype == SEQUENCESET */
+  {
+    const TSequenceSet *ts = (const TSequenceSet *) temp;
+    for (int i = 0; i < ts->count; i++)
+      tpointseq_cells(&cover, tsequenceset_seq_n(ts, i));
+  }
+  return cellcover_keys(&cover, count);
+}
+
+/**
+ * @ingroup libmeos_temporal_tiling
+ * @brief Return the keys of the cells of a spatial or spatiotemporal grid
+ * intersecting a spatiotemporal box.
+ *
+ * @param[in] box Box
+ * @param[in] size Cell size for the spatial dimensions in the units of the SRID
+ * @param[in] tunits Cell size for the temporal dimension in PostgreSQL time
+ * units, only the spatial dimensions are considered when it is equal to 0
+ * @param[in] sorigin Spatial origin of the cells
+ * @param[in] torigin Time origin of the cells
+ * @param[out] count Number of keys in the result
+ * @result NULL when the box covers more than MAX_CELL_KEYS cells
+ * @note The result always contains the key CELL_KEY_ALL of the temporal
+ * points traversing too many cells
+ */
+int64 *
+stbox_cells(const STBOX *box, double size, int64 tunits,
+  const POINT3DZ *sorigin, TimestampTz torigin, int *count)
+{
+  CellCover cover;
+  cellcover_init(&cover, size, tunits, sorigin, torigin);
+  double pos1[3] = {box->xmin, box->ymin, (double) box->tmin};
+  double pos2[3] = {box->xmax, box->ymax, (double) box->tmax};
+  int64 lower[3], upper[3];
+  cellcover_get_cell(&cover, pos1, lower);
+  cellcover_get_cell(&cover, pos2, upper);
+  double ncells = 1;
+  for (int i = 0; i < cover.numdims; i++)
+    ncells *= (double) (upper[i] - lower[i] + 1);
+  if (ncells > MAX_CELL_KEYS)
+  {
+    pfree(cover.keys);
+    return NULL;
+  }
+  cellcover_add_box(&cover, lower, upper);
+  int64 *result = cellcover_keys(&cover, count);
+  /* The key is the smallest one and the keys are sorted */
+  if (result[0] != CELL_KEY_ALL)
+  {
+    result = repalloc(result, sizeof(int64) * (*count + 1));
+    memmove(&result[1], result, sizeof(int64) * *count);
+    result[0] = CELL_KEY_ALL;
+    (*count)++;
+  }
+  return result;
+}
+
+/*****************************************************************************/
+
+/*****************************************************************************
+ * Partition keys
+ *****************************************************************************/
+
+/**
+ * @ingroup libmeos_temporal_tiling
+ * @brief Return the partition key of a temporal point, that is, the key of
+ * the cell of a spatial or spatiotemporal grid containing it.
+ *
+ * The cells are considered closed so that the fragments obtained by
+ * splitting a temporal point with spaceSplit or spaceTimeSplit, which may
+ * touch the upper bounds of their tile, have the key of their tile. An error
+ * is raised when the temporal point spans several cells, since the planner
+ * would otherwise prune a partition containing it.
+ *
+ * @param[in] temp Temporal point
+ * @param[in] size Cell size for the spatial dimensions in the units of the SRID
+ * @param[in] tunits Cell size for the temporal dimension in PostgreSQL time
+ * units, only the spatial dimensions are considered when it is equal to 0
+ * @param[in] sorigin Spatial origin of the cells
+ * @param[in] torigin Time origin of the cells
+ */
+int64
+tpoint_partition_key(const Temporal *temp, double size, int64 tunits,
+  const POINT3DZ *sorigin, TimestampTz torigin)
+{
+  CellCover cover;
+  cellcover_init(&cover, size, tunits, sorigin, torigin);
+  STBOX box;
+  temporal_bbox(temp, &box);
+  double lower[3] = {box.xmin, box.ymin, (double) box.tmin};
+  double upper[3] = {box.xmax, box.ymax, (double) box.tmax};
+  int64 cell[3];
+  cellcover_get_cell(&cover, lower, cell);
+  for (int i = 0; i < cover.numdims; i++)
+  {
+    double max = cover.origin[i] + (cell[i] + 1) * cover.size[i];
+    if (! MOBDB_FP_LE(upper[i], max))
+      ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+        errmsg("The temporal point spans several partition cells")));
+  }
+  int64 result = cellcover_key(&cover, cell);
+  pfree(cover.keys);
+  return result;
+}
+
+/**
+ * @ingroup libmeos_temporal_tiling
+ * @brief Return the partition keys of the cells of a spatial or
+ * spatiotemporal grid that may contain a temporal point overlapping a
+ * spatiotemporal box.
+ *
+ * Since the cells are considered closed in tpoint_partition_key, the cells
+ * whose upper bound is equal to the lower bound of the box are also
+ * returned.
+ *
+ * @param[in] box Box
+ * @param[in] size Cell size for the spatial dimensions in the units of the SRID
+ * @param[in] tunits Cell size for the temporal dimension in PostgreSQL time
+ * units, only the spatial dimensions are considered when it is equal to 0
+ * @param[in] sorigin Spatial origin of the cells
+ * @param[in] torigin Time origin of the cells
+ * @param[in] maxcount Maximum number of keys
+ * @param[out] count Number of keys in the result
+ * @result NULL when the box covers more than the maximum number of keys
+ */
+int64 *
+stbox_partition_keys(const STBOX *box, double size, int64 tunits,
+  const POINT3DZ *sorigin, TimestampTz torigin, int maxcount, int *count)
+{
+  CellCover cover;
+  cellcover_init(&cover, size, tunits, sorigin, torigin);
+  double pos1[3] = {box->xmin, box->ymin, (double) box->tmin};
+  double pos2[3] = {box->xmax, box->ymax, (double) box->tmax};
+  int64 lower[3], upper[3];
+  cellcover_get_cell(&cover, pos1, lower);
+  cellcover_get_cell(&cover, pos2, upper);
+  double ncells = 1;
+  for (int i = 0; i < cover.numdims; i++)
+  {
+    double min = cover.origin[i] + lower[i] * cover.size[i];
+    if (MOBDB_FP_LE(pos1[i], min))
+      lower[i]--;
+    ncells *= (double) (upper[i] - lower[i] + 1);
+  }
+  if (ncells > maxcount)
+  {
+    pfree(cover.keys);
+    return NULL;
+  }
+  cellcover_add_box(&cover, lower, upper);
+  return cellcover_keys(&cover, count);
+}
+
+/*****************************************************************************/
+
+/**
+ * Get the parameters of the grid from the arguments of the cell functions
+ */
+static void
+cells_get_args(FunctionCallInfo fcinfo, int32 srid, double *size,
+  int64 *tunits, POINT3DZ *sorigin, TimestampTz *torigin)
+{
+  *size = PG_GETARG_FLOAT8(1);
+  ensure_positive_datum(Float8GetDatum(*size), T_FLOAT8);
+  GSERIALIZED *gs;
+  if (PG_NARGS() == 3)
+  {
+    gs = PG_GETARG_GSERIALIZED_P(2);
+    *tunits = 0;
+    *torigin = 0;
+  }
+  else /* PG_NARGS() == 5 */
+  {
+    Interval *duration = PG_GETARG_INTERVAL_P(2);
+    ensure_valid_duration(duration);
+    *tunits = get_interval_units(duration);
+    gs = PG_GETARG_GSERIALIZED_P(3);
+    *torigin = PG_GETARG_TIMESTAMPTZ(4);
+  }
+  ensure_non_empty(gs);
+  ensure_point_type(gs);
+  int32 gs_srid = gserialized_get_srid(gs);
+  if (gs_srid != SRID_UNKNOWN)
+    ensure_same_srid(srid, gs_srid);
+  /* Only the X and Y dimensions of the origin are used */
+  memset(sorigin, 0, sizeof(POINT3DZ));
+  const POINT2D *p2d = gserialized_point2d_p(gs);
+  sorigin->x = p2d->x;
+  sorigin->y = p2d->y;
+  return;
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_cells);
+/**
+ * Return the keys of the cells of a spatial or spatiotemporal grid traversed
+ * by a temporal point
+ */
+PGDLLEXPORT Datum
+Tpoint_cells(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  double size;
+  int64 tunits;
+  POINT3DZ sorigin;
+  TimestampTz torigin;
+  cells_get_args(fcinfo, tpoint_srid(temp), &size, &tunits, &sorigin,
+    &torigin);
+  int count;
+  int64 *keys = tpoint_cells(temp, size, tunits, &sorigin, torigin, &count);
+  ArrayType *result = int64arr_to_array(keys, count);
+  pfree(keys);
+  PG_FREE_IF_COPY(temp, 0);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Stbox_cells);
+/**
+ * Return the keys of the cells of a spatial or spatiotemporal grid
+ * intersecting a spatiotemporal box, or NULL if the box covers too many
+ * cells
+ */
+PGDLLEXPORT Datum
+Stbox_cells(PG_FUNCTION_ARGS)
+{
+  STBOX *box = PG_GETARG_STBOX_P(0);
+  ensure_has_X_stbox(box);
+  double size;
+  int64 tunits;
+  POINT3DZ sorigin;
+  TimestampTz torigin;
+  cells_get_args(fcinfo, box->srid, &size, &tunits, &sorigin, &torigin);
+  if (tunits)
+    ensure_has_T_stbox(box);
+  int count;
+  int64 *keys = stbox_cells(box, size, tunits, &sorigin, torigin, &count);
+  if (keys == NULL)
+    PG_RETURN_NULL();
+  ArrayType *result = int64arr_to_array(keys, count);
+  pfree(keys);
+  PG_RETURN_POINTER(result);
+}
+
+PG_FUNCTION_INFO_V1(Tpoint_partition_key);
+/**
+ * Return the partition key of a temporal point
+ */
+PGDLLEXPORT Datum
+Tpoint_partition_key(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  double size;
+  int64 tunits;
+  POINT3DZ sorigin;
+  TimestampTz torigin;
+  cells_get_args(fcinfo, tpoint_srid(temp), &size, &tunits, &sorigin,
+    &torigin);
+  int64 result = tpoint_partition_key(temp, size, tunits, &sorigin, torigin);
+  PG_FREE_IF_COPY(temp, 0);
+  PG_RETURN_INT64(result);
+}
+
+PG_FUNCTION_INFO_V1(Stbox_partition_keys);
+/**
+ * Return the partition keys of the cells that may contain a temporal point
+ * overlapping a spatiotemporal box, or NULL if the box covers too many cells
+ */
+PGDLLEXPORT Datum
+Stbox_partition_keys(PG_FUNCTION_ARGS)
+{
+  STBOX *box = PG_GETARG_STBOX_P(0);
+  ensure_has_X_stbox(box);
+  double size;
+  int64 tunits;
+  POINT3DZ sorigin;
+  TimestampTz torigin;
+  cells_get_args(fcinfo, box->srid, &size, &tunits, &sorigin, &torigin);
+  if (tunits)
+    ensure_has_T_stbox(box);
+  int count;
+  int64 *keys = stbox_partition_keys(box, size, tunits, &sorigin, torigin,
+    MAX_CELL_KEYS, &count);
+  if (keys == NULL)
+    PG_RETURN_NULL();
+  ArrayType *result = int64arr_to_array(keys, count);
+  pfree(keys);
+  PG_RETURN_POINTER(result);
+}
+
+/*****************************************************************************/
@@ -101,6 +101,33 @@ DROP INDEX IF EXISTS tbl_periodset_big_rtree_idx;
 
 -------------------------------------------------------------------------------
 
+CREATE INDEX tbl_timestampset_big_multi_rtree_idx ON tbl_timestampset_big USING GIST(ts timestampset_multi_rtree_ops);
+CREATE INDEX tbl_periodset_big_multi_rtree_idx ON tbl_periodset_big USING GIST(ps periodset_multi_rtree_ops);
+
+SELECT COUNT(*) FROM tbl_timestampset_big WHERE ts && period '[2001-01-01, 2001-02-01]';
+SELECT COUNT(*) FROM tbl_timestampset_big WHERE ts <@ period '[2001-01-01, 2001-02-01]';
+SELECT COUNT(*) FROM tbl_timestampset_big WHERE ts -|- period '[2001-01-01, 2001-02-01]';
+SELECT COUNT(*) FROM tbl_timestampset_big WHERE ts <<# period '[2001-01-01, 2001-02-01]';
+SELECT COUNT(*) FROM tbl_timestampset_big WHERE ts &<# period '[2001-01-01, 2001-02-01]';
+SELECT COUNT(*) FROM tbl_timestampset_big WHERE ts #>> period '[2001-01-01, 2001-02-01]';
+SELECT COUNT(*) FROM tbl_timestampset_big WHERE ts #&> period '[2001-01-01, 2001-02-01]';
+
+SELECT COUNT(*) FROM tbl_periodset_big WHERE ps && period '[2001-01-01, 2001-02-01]';
+SELECT COUNT(*) FROM tbl_periodset_big WHERE ps @> period '[2001-01-01, 2001-02-01]';
+SELECT COUNT(*) FROM tbl_periodset_big WHERE ps <@ period '[2001-01-01, 2001-02-01]';
+SELECT COUNT(*) FROM tbl_periodset_big WHERE ps <<# period '[2001-01-01, 2001-02-01]';
+SELECT COUNT(*) FROM tbl_periodset_big WHERE ps &<# period '[2001-01-01, 2001-02-01]';
+SELECT COUNT(*) FROM tbl_periodset_big WHERE ps #>> period '[2001-01-01, 2001-02-01]';
+SELECT COUNT(*) FROM tbl_periodset_big WHERE ps #&> period '[2001-01-01, 2001-02-01]';
+
+SELECT array_agg(DISTINCT dimension ORDER BY dimension) FROM gistIndexStats('tbl_periodset_big_multi_rtree_idx');
+SELECT bool_and(entries >= nodes AND fillfactor > 0 AND fillfactor <= 1 AND overlap >= 0 AND deadspace <= extent) FROM gistIndexStats('tbl_timestampset_big_multi_rtree_idx');
+
+DROP INDEX IF EXISTS tbl_timestampset_big_multi_rtree_idx;
+DROP INDEX IF EXISTS tbl_periodset_big_multi_rtree_idx;
+
+-------------------------------------------------------------------------------
+
 DROP TABLE IF EXISTS tbl_period_test;
 CREATE TABLE tbl_period_test AS
 SELECT period '[2000-01-01,2000-01-02]';
@@ -168,6 +168,30 @@ SELECT COUNT(*) FROM tbl_tbox t1, tbl_tbox t2 WHERE t1.b <@ t2.b;
 SELECT COUNT(*) FROM tbl_tbox t1, tbl_tbox t2 WHERE t1.b -|- t2.b;
 SELECT COUNT(*) FROM tbl_tbox t1, tbl_tbox t2 WHERE t1.b ~= t2.b;
 
+SELECT tbox_overlaps(tbox 'TBOX((1,2001-01-01),(2,2001-01-02))', ARRAY[tbox 'TBOX((1,2001-01-01),(2,2001-01-02))', tbox 'TBOX((3,2001-01-01),(4,2001-01-02))', tbox 'TBOX((1.5,2001-01-01),(3,2001-01-03))']);
+SELECT tbox_contains(tbox 'TBOX((1,2001-01-01),(3,2001-01-03))', ARRAY[tbox 'TBOX((1,2001-01-01),(2,2001-01-02))', tbox 'TBOX((3,2001-01-01),(4,2001-01-02))', tbox 'TBOX((1.5,2001-01-01),(3,2001-01-03))']);
+SELECT tbox_contained(tbox 'TBOX((3.5,2001-01-01),(4,2001-01-02))', ARRAY[tbox 'TBOX((1,2001-01-01),(2,2001-01-02))', tbox 'TBOX((3,2001-01-01),(4,2001-01-02))', tbox 'TBOX((1.5,2001-01-01),(3,2001-01-03))']);
+SELECT tbox_overlaps(tbox 'TBOX((5,2001-01-01),(6,2001-01-02))', ARRAY[tbox 'TBOX((1,2001-01-01),(2,2001-01-02))', tbox 'TBOX((3,2001-01-01),(4,2001-01-02))', tbox 'TBOX((1.5,2001-01-01),(3,2001-01-03))']);
+SELECT tbox_overlaps(tbox 'TBOX((1.0,), (2.0,))', ARRAY[tbox 'TBOX((1,2001-01-01),(2,2001-01-02))', tbox 'TBOX((3.0,), (4.0,))', tbox 'TBOX((1.5,), (3.0,))']);
+SELECT tbox_overlaps(tbox 'TBOX((1,2001-01-01),(2,2001-01-02))', ARRAY[NULL, tbox 'TBOX((1,2001-01-01),(2,2001-01-02))', NULL, tbox 'TBOX((1.5,2001-01-01),(3,2001-01-03))']);
+SELECT tbox_overlaps(tbox 'TBOX((1,2001-01-01),(2,2001-01-02))', ARRAY[NULL::tbox, NULL]);
+SELECT tbox_overlaps(tbox 'TBOX((1,2001-01-01),(2,2001-01-02))', '{}'::tbox[]);
+/* Errors */
+SELECT tbox_overlaps(tbox 'TBOX((1),(2))', ARRAY[tbox 'TBOX((,2001-01-01),(,2001-01-02))']);
+
+WITH boxes(arr) AS (SELECT array_agg(b ORDER BY k) FROM tbl_tbox WHERE b IS NOT NULL)
+SELECT COUNT(*) FROM tbl_tbox t, boxes
+WHERE t.b IS NOT NULL AND tbox_overlaps(t.b, arr) IS DISTINCT FROM
+  COALESCE((SELECT array_agg(i ORDER BY i) FROM unnest(arr) WITH ORDINALITY u(b, i) WHERE t.b && u.b), '{}');
+WITH boxes(arr) AS (SELECT array_agg(b ORDER BY k) FROM tbl_tbox WHERE b IS NOT NULL)
+SELECT COUNT(*) FROM tbl_tbox t, boxes
+WHERE t.b IS NOT NULL AND tbox_contains(t.b, arr) IS DISTINCT FROM
+  COALESCE((SELECT array_agg(i ORDER BY i) FROM unnest(arr) WITH ORDINALITY u(b, i) WHERE t.b @> u.b), '{}');
+WITH boxes(arr) AS (SELECT array_agg(b ORDER BY k) FROM tbl_tbox WHERE b IS NOT NULL)
+SELECT COUNT(*) FROM tbl_tbox t, boxes
+WHERE t.b IS NOT NULL AND tbox_contained(t.b, arr) IS DISTINCT FROM
+  COALESCE((SELECT array_agg(i ORDER BY i) FROM unnest(arr) WITH ORDINALITY u(b, i) WHERE t.b <@ u.b), '{}');
+
 -------------------------------------------------------------------------------
 -- Position operators
 -------------------------------------------------------------------------------
@@ -2358,6 +2358,21 @@ SELECT intersectsPeriodSet(ttext '{AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-0
 SELECT intersectsPeriodSet(ttext '[AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-03]', periodset '{[2000-01-01,2000-01-02]}');
 SELECT intersectsPeriodSet(ttext '{[AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-03],[CCC@2000-01-04, CCC@2000-01-05]}', periodset '{[2000-01-01,2000-01-02]}');
 
+SELECT atTimeOfDay(tint '1@2000-01-01 10:00', '08:00', '12:00', '{0,1,2,3,4,5,6}', 'UTC');
+SELECT atTimeOfDay(tint '1@2000-01-01 10:00', '12:00', '14:00', '{0,1,2,3,4,5,6}', 'UTC');
+SELECT atTimeOfDay(tint '{1@2000-01-01 10:00, 2@2000-01-01 14:00, 1@2000-01-02 09:00}', '08:00', '12:00', '{0,1,2,3,4,5,6}', 'UTC');
+SELECT atTimeOfDay(tfloat '[1@2000-01-01, 3@2000-01-03]', '06:00', '18:00', '{0,1,2,3,4,5,6}', 'UTC');
+SELECT atTimeOfDay(tint '[1@2000-01-01, 2@2000-01-02, 3@2000-01-04]', '08:00', '10:00', '{1,2}', 'UTC');
+SELECT atTimeOfDay(ttext '[AAA@2000-01-01 20:00, BBB@2000-01-02 04:00]', '22:00', '02:00', '{0,1,2,3,4,5,6}', 'UTC');
+SELECT atTimeOfDay(tint '[1@2000-01-01, 1@2000-01-02]', '08:00', '09:00', '{0,1,2,3,4,5,6}', 'Europe/Brussels');
+SELECT minusTimeOfDay(tint '[1@2000-01-01, 1@2000-01-03]', '00:00', '12:00', '{0,1,2,3,4,5,6}', 'UTC');
+SELECT intersectsTimeOfDay(tint '{1@2000-01-01 10:00, 2@2000-01-01 14:00}', '11:00', '13:00', '{0,1,2,3,4,5,6}', 'UTC');
+SELECT intersectsTimeOfDay(tfloat '[1@2000-01-01, 3@2000-01-03]', '06:00', '18:00', '{1}', 'UTC');
+SELECT intersectsTimeOfDay(tfloat '[1@2000-01-01, 3@2000-01-03]', period '[2000-01-02, 2000-01-03]', '06:00', '18:00', '{0}', 'UTC');
+/* Errors */
+SELECT atTimeOfDay(tint '1@2000-01-01', '08:00', '08:00');
+SELECT atTimeOfDay(tint '1@2000-01-01', '08:00', '09:00', '{7}');
+
 SELECT integral(tint '1@2000-01-01');
 SELECT integral(tint '{1@2000-01-01, 2@2000-01-02, 1@2000-01-03}');
 SELECT integral(tint '[1@2000-01-01, 2@2000-01-02, 1@2000-01-03]');
@@ -2388,6 +2403,21 @@ SELECT round(twAvg(tfloat 'Interp=Stepwise;[1.5@2000-01-01, 2.5@2000-01-02, 1.5@
 SELECT round(twAvg(tfloat '{[1.5@2000-01-01, 2.5@2000-01-02, 1.5@2000-01-03],[3.5@2000-01-04, 3.5@2000-01-05]}')::numeric, 6);
 SELECT round(twAvg(tfloat 'Interp=Stepwise;{[1.5@2000-01-01, 2.5@2000-01-02, 1.5@2000-01-03],[3.5@2000-01-04, 3.5@2000-01-05]}')::numeric, 6);
 
+SELECT (summaryStats(tfloat '[1@2000-01-01, 3@2000-01-03]')).twAvg;
+SELECT (summaryStats(tint '{1@2000-01-01, 3@2000-01-03}')).maxValue;
+SELECT (summaryStats(tfloat '{[1@2000-01-01, 3@2000-01-03],[5@2000-01-04, 5@2000-01-05]}')).integral;
+SELECT (summaryStats(tfloat '{[1@2000-01-01, 3@2000-01-03],[5@2000-01-04, 5@2000-01-05]}')).twAvg;
+
+SELECT (summaryStats(tfloat '[1@2000-01-01, 3@2000-01-03]', period '[2000-01-01 12:00, 2000-01-02 12:00]')).minValue;
+SELECT (summaryStats(tfloat '[1@2000-01-01, 3@2000-01-03]', period '[2000-01-01 12:00, 2000-01-02 12:00]')).twAvg;
+SELECT (summaryStats(tfloat '[1@2000-01-01, 3@2000-01-03]', period '[2000-01-02, 2000-01-02]')).twAvg;
+SELECT (summaryStats(tint '[1@2000-01-01, 3@2000-01-03]', period '[2000-01-01 12:00, 2000-01-03)')).maxValue;
+SELECT (summaryStats(tint '[1@2000-01-01, 3@2000-01-03]', period '[2000-01-01 12:00, 2000-01-03]')).maxValue;
+SELECT (summaryStats(tfloat '{[1@2000-01-01, 3@2000-01-03],[5@2000-01-04, 5@2000-01-05]}', period '[2000-01-02, 2000-01-04 12:00]')).integral;
+SELECT (summaryStats(tfloat '{[1@2000-01-01, 3@2000-01-03],[5@2000-01-04, 5@2000-01-05]}', period '[2000-01-02, 2000-01-04 12:00]')).duration;
+SELECT summaryStats(tfloat '[1@2000-01-01, 3@2000-01-03]', period '[2000-02-01, 2000-02-02]') IS NULL;
+SELECT integral FROM summaryStats(tfloat '{[1@2000-01-01, 3@2000-01-03],[5@2000-01-04, 5@2000-01-05]}', ARRAY[period '[2000-01-01, 2000-01-02]', '[2000-01-02, 2000-01-04 12:00]', '[2000-02-01, 2000-02-02]']);
+
 -------------------------------------------------------------------------------
 -- Comparison functions and B-tree indexing
 -------------------------------------------------------------------------------
@@ -538,6 +538,29 @@ SELECT round(sum(integral(temp))::numeric, 6) FROM tbl_tfloat;
 SELECT round(sum(twAvg(temp))::numeric, 6) FROM tbl_tint;
 SELECT round(sum(twAvg(temp))::numeric, 6) FROM tbl_tfloat;
 
+SELECT COUNT(*) FROM tbl_tint, tbl_period WHERE temp && p AND
+  ((summaryStats(temp, p)).minValue <> (summaryStats(atPeriod(temp, p))).minValue OR
+   (summaryStats(temp, p)).maxValue <> (summaryStats(atPeriod(temp, p))).maxValue OR
+   (summaryStats(temp, p)).duration <> (summaryStats(atPeriod(temp, p))).duration OR
+   abs((summaryStats(temp, p)).integral - integral(atPeriod(temp, p))) > 1e-6 * abs(integral(atPeriod(temp, p))) + 1e-6);
+SELECT COUNT(*) FROM tbl_tfloat, tbl_period WHERE temp && p AND
+  ((summaryStats(temp, p)).minValue <> (summaryStats(atPeriod(temp, p))).minValue OR
+   (summaryStats(temp, p)).maxValue <> (summaryStats(atPeriod(temp, p))).maxValue OR
+   (summaryStats(temp, p)).duration <> (summaryStats(atPeriod(temp, p))).duration OR
+   abs((summaryStats(temp, p)).integral - integral(atPeriod(temp, p))) > 1e-6 * abs(integral(atPeriod(temp, p))) + 1e-6);
+WITH windows AS (SELECT array_agg(p ORDER BY k) AS arr FROM tbl_period WHERE k <= 20)
+SELECT COUNT(*) FROM tbl_tint, windows,
+  LATERAL summaryStats(temp, arr) WITH ORDINALITY AS s(minValue, maxValue, twAvg, integral, duration, n)
+WHERE s.minValue IS DISTINCT FROM (summaryStats(temp, arr[n])).minValue OR
+  s.maxValue IS DISTINCT FROM (summaryStats(temp, arr[n])).maxValue OR
+  s.duration IS DISTINCT FROM (summaryStats(temp, arr[n])).duration;
+WITH windows AS (SELECT array_agg(p ORDER BY k) AS arr FROM tbl_period WHERE k <= 20)
+SELECT COUNT(*) FROM tbl_tfloat, windows,
+  LATERAL summaryStats(temp, arr) WITH ORDINALITY AS s(minValue, maxValue, twAvg, integral, duration, n)
+WHERE s.minValue IS DISTINCT FROM (summaryStats(temp, arr[n])).minValue OR
+  s.maxValue IS DISTINCT FROM (summaryStats(temp, arr[n])).maxValue OR
+  s.duration IS DISTINCT FROM (summaryStats(temp, arr[n])).duration;
+
 -------------------------------------------------------------------------------
 -- Comparison functions and B-tree indexing
 -------------------------------------------------------------------------------
@@ -595,3 +618,35 @@ SELECT COUNT(*) FROM tbl_ttext t1, tbl_ttext t2
 WHERE t1.temp >= t2.temp;
 
 ------------------------------------------------------------------------------
+-- Compaction of fragments
+
+DROP TABLE IF EXISTS tbl_tint_frag;
+CREATE TABLE tbl_tint_frag(k int, temp tint);
+INSERT INTO tbl_tint_frag VALUES
+(1, tint '[1@2000-01-01, 2@2000-01-02]'),
+(1, tint '[2@2000-01-02, 3@2000-01-03]'),
+(1, tint '[3@2000-01-03, 4@2000-01-04]'),
+(2, tint '[1@2000-01-01, 1@2000-01-03]'),
+(2, tint '[2@2000-01-02, 2@2000-01-04]'),
+(3, tint '[1@2000-01-01, 2@2000-01-02]'),
+(3, tint '[3@2000-01-05, 4@2000-01-06]');
+SELECT compactTable('tbl_tint_frag', 'k', 'temp');
+SELECT k, temp FROM tbl_tint_frag ORDER BY k, startTimestamp(temp);
+SELECT compactTable('tbl_tint_frag', 'k', 'temp', '3 days');
+SELECT k, temp FROM tbl_tint_frag ORDER BY k, startTimestamp(temp);
+DROP TABLE tbl_tint_frag;
+
+-- The first batch only holds a group that cannot be merged
+CREATE TABLE tbl_tint_frag(k int, temp tint);
+INSERT INTO tbl_tint_frag VALUES
+(1, tint '[1@2000-01-01, 1@2000-01-03]'),
+(1, tint '[2@2000-01-02, 2@2000-01-04]'),
+(2, tint '[1@2000-01-01, 2@2000-01-02]'),
+(2, tint '[2@2000-01-02, 3@2000-01-03]');
+SET mobilitydb.compact_batch = 1;
+SELECT compactTable('tbl_tint_frag', 'k', 'temp');
+RESET mobilitydb.compact_batch;
+SELECT k, temp FROM tbl_tint_frag ORDER BY k, startTimestamp(temp);
+DROP TABLE tbl_tint_frag;
+
+------------------------------------------------------------------------------
@@ -582,3 +582,24 @@ SELECT round(derivative(tfloat 'Interp=Stepwise;{[1@2000-01-01, 2@2000-01-02, 1@
 
 -------------------------------------------------------------------------------
 
+SELECT timeDelta(tint '{1@2000-01-01, 2@2000-01-02, 4@2000-01-04}');
+SELECT valueDelta(tint '[1@2000-01-01, 2@2000-01-02, 4@2000-01-04]');
+SELECT valueDelta(tfloat '{[1@2000-01-01, 2@2000-01-02, 4@2000-01-03, 5@2000-01-06, 7@2000-01-07]}', '1 day');
+SELECT valueDelta(tint '1@2000-01-01');
+/* Errors */
+SELECT valueDelta(tint '{1@2000-01-01, 2@2000-01-02}', '-1 day');
+
+SELECT array_agg(round(c::numeric, 6)) FROM unnest(crossCorrelation(tfloat '[0@2000-01-01, 10@2000-01-11, 0@2000-01-21]', tfloat '[0@2000-01-03, 10@2000-01-13, 0@2000-01-23]', '{-2 days, 0, 2 days, 4 days}')) c;
+SELECT array_agg(round(c::numeric, 6)) FROM unnest(crossCorrelation(tint '[1@2000-01-01, 3@2000-01-02, 2@2000-01-03, 2@2000-01-04]', tint '[1@2000-01-02, 3@2000-01-03, 2@2000-01-04, 2@2000-01-05]', '{0, 1 day}')) c;
+SELECT array_agg(round(c::numeric, 6)) FROM unnest(crossCorrelation(tfloat '{[0@2000-01-01, 4@2000-01-05], [4@2000-01-06, 0@2000-01-10]}', tfloat '[0@2000-01-01, 4@2000-01-05, 4@2000-01-06, 0@2000-01-10]', '{0, 1 day}')) c;
+SELECT crossCorrelation(tfloat '[0@2000-01-01, 10@2000-01-11, 0@2000-01-21]', tfloat '[0@2000-01-01, 10@2000-01-11, 0@2000-01-21]', '{30 days}');
+SELECT crossCorrelation(tfloat '[1@2000-01-01, 1@2000-01-03]', tfloat '[0@2000-01-01, 10@2000-01-11, 0@2000-01-21]', '{0}');
+SELECT bestLag(tfloat '[0@2000-01-01, 10@2000-01-11, 0@2000-01-21]', tfloat '[0@2000-01-03, 10@2000-01-13, 0@2000-01-23]', '{-2 days, 0, 2 days, 4 days}');
+SELECT bestLag(tfloat '[0@2000-01-01, 10@2000-01-11, 0@2000-01-21]', tfloat '[0@2000-01-03, 10@2000-01-13, 0@2000-01-23]', '{30 days}');
+/* Errors */
+SELECT crossCorrelation(tfloat '{1@2000-01-01, 2@2000-01-02}', tfloat '[0@2000-01-01, 10@2000-01-11, 0@2000-01-21]', '{0}');
+SELECT crossCorrelation(tfloat '[0@2000-01-01, 10@2000-01-11, 0@2000-01-21]', tfloat '[0@2000-01-03, 10@2000-01-13, 0@2000-01-23]', '{1 month}');
+SELECT crossCorrelation(tfloat '[0@2000-01-01, 10@2000-01-11, 0@2000-01-21]', tfloat '[0@2000-01-03, 10@2000-01-13, 0@2000-01-23]', '{}');
+
+-------------------------------------------------------------------------------
+
@@ -71,3 +71,26 @@ SELECT lower(ttext '[AA@2000-01-01, BB@2000-01-02, AA@2000-01-03]');
 SELECT lower(ttext '{[AA@2000-01-01, BB@2000-01-02, AA@2000-01-03],[CC@2000-01-04, CC@2000-01-05]}');
 
 -------------------------------------------------------------------------------
+-- Temporal pattern matching
+-------------------------------------------------------------------------------
+
+SELECT like(ttext 'AA@2000-01-01', 'A%');
+SELECT like(ttext '{AA@2000-01-01, BB@2000-01-02, AA@2000-01-03}', 'A%');
+SELECT like(ttext '[AA@2000-01-01, BB@2000-01-02, AA@2000-01-03]', 'A%');
+SELECT like(ttext '{[AA@2000-01-01, BB@2000-01-02, AA@2000-01-03],[CC@2000-01-04, CC@2000-01-05]}', 'A%');
+SELECT ilike(ttext '[AA@2000-01-01, bb@2000-01-02, AA@2000-01-03]', 'B%');
+SELECT ilike(ttext '[Éclair@2000-01-01, éclair@2000-01-02]', 'é%' COLLATE "C");
+SELECT ilike(ttext '[Éclair@2000-01-01, éclair@2000-01-02]', 'é%' COLLATE "und-x-icu");
+SELECT regexp_like(ttext '[ERR1@2000-01-01, ERR2@2000-01-02, OK@2000-01-03]', '^ERR[0-9]');
+SELECT regexp_like(ttext '{[ERR1@2000-01-01, ERR2@2000-01-02, OK@2000-01-03],[OK@2000-01-04, OK@2000-01-05]}', '^ERR');
+
+SELECT atPattern(ttext 'AA@2000-01-01', 'A%');
+SELECT atPattern(ttext '{AA@2000-01-01, BB@2000-01-02, AA@2000-01-03}', 'A%');
+SELECT atPattern(ttext '[AA@2000-01-01, BB@2000-01-02, AA@2000-01-03]', 'A%');
+SELECT atPattern(ttext '{[ERR1@2000-01-01, ERR2@2000-01-02, OK@2000-01-03],[OK@2000-01-04, OK@2000-01-05]}', '^ERR', true);
+SELECT minusPattern(ttext 'AA@2000-01-01', 'B%');
+SELECT minusPattern(ttext '{AA@2000-01-01, BB@2000-01-02, AA@2000-01-03}', 'A%');
+SELECT minusPattern(ttext '[AA@2000-01-01, BB@2000-01-02, AA@2000-01-03]', 'A%');
+SELECT minusPattern(ttext '{[ERR1@2000-01-01, ERR2@2000-01-02, OK@2000-01-03],[OK@2000-01-04, OK@2000-01-05]}', '^ERR', true);
+
+-------------------------------------------------------------------------------
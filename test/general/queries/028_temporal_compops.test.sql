@@ -1684,4 +1684,7 @@ SELECT temporal_tge(ttext '{AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-03}', te
 SELECT temporal_tge(ttext '[AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-03]', text 'AAA', false);
 SELECT temporal_tge(ttext '{[AAA@2000-01-01, BBB@2000-01-02, AAA@2000-01-03],[CCC@2000-01-04, CCC@2000-01-05]}', text 'AAA', false);
 
+SELECT tfloat '{[1@2000-01-01, 3@2000-01-03],[3@2000-01-04, 1@2000-01-06]}' #< 2;
+SELECT tfloat '{[1@2000-01-01, 3@2000-01-03],[3@2000-01-04, 1@2000-01-06]}' #> tfloat '[2@2000-01-01, 2@2000-01-06]';
+
 -------------------------------------------------------------------------------
@@ -704,3 +704,24 @@ WITH Temp AS (
 SELECT COUNT(*) FROM Temp;
 
 -------------------------------------------------------------------------------
+-- LCSS and EDR distances
+-------------------------------------------------------------------------------
+
+SELECT lcssDistance(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1.1@2000-01-01, 2.1@2000-01-02, 10@2000-01-03, 4.1@2000-01-04]', 0.5);
+SELECT lcssDistance(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1.1@2000-01-01, 2.1@2000-01-02, 10@2000-01-03, 4.1@2000-01-04]', 0.5, '1 hour');
+SELECT lcssDistance(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1@2000-01-03, 2@2000-01-04]', 0.5);
+SELECT lcssDistance(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1@2000-01-03, 2@2000-01-04]', 0.5, '1 hour');
+SELECT lcssDistance(tint '{1@2000-01-01, 2@2000-01-02}', tint '{1@2000-01-01, 3@2000-01-02}', 0);
+SELECT lcssWithin(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1.1@2000-01-01, 2.1@2000-01-02, 10@2000-01-03, 4.1@2000-01-04]', 0.5, 0.3);
+SELECT lcssWithin(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1.1@2000-01-01, 2.1@2000-01-02, 10@2000-01-03, 4.1@2000-01-04]', 0.5, 0.2);
+SELECT edrDistance(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1.1@2000-01-01, 2.1@2000-01-02, 10@2000-01-03, 4.1@2000-01-04]', 0.5);
+SELECT edrDistance(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1@2000-01-03, 2@2000-01-04]', 0.5);
+SELECT edrDistance(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1@2000-01-03, 2@2000-01-04]', 0.5, '1 hour');
+SELECT edrDistance(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1@2000-01-02, 2@2000-01-03, 3@2000-01-04, 4@2000-01-05]', 0.5);
+SELECT edrDistance(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1@2000-01-02, 2@2000-01-03, 3@2000-01-04, 4@2000-01-05]', 0.5, '1 hour');
+SELECT edrDistance(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1@2000-01-02, 2@2000-01-03, 3@2000-01-04, 4@2000-01-05]', 0.5, '1 day');
+SELECT edrWithin(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1.1@2000-01-01, 2.1@2000-01-02, 10@2000-01-03, 4.1@2000-01-04]', 0.5, 1);
+SELECT edrWithin(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1.1@2000-01-01, 2.1@2000-01-02, 10@2000-01-03, 4.1@2000-01-04]', 0.5, 0);
+SELECT lcssDistance(tfloat '[1@2000-01-01, 2@2000-01-02, 3@2000-01-03, 4@2000-01-04]', tfloat '[1.1@2000-01-01, 2.1@2000-01-02, 10@2000-01-03, 4.1@2000-01-04]', -1);
+
+-------------------------------------------------------------------------------
@@ -246,3 +246,28 @@ SET force_parallel_mode=off;
 
 -------------------------------------------------------------------------------
 
+-------------------------------------------------------------------------------
+-- Spilling the state of the aggregates
+-------------------------------------------------------------------------------
+
+CREATE TABLE tbl_aggspill_test AS SELECT
+  (SELECT tunion(ts) FROM tbl_timestampset) AS tunion_ts,
+  (SELECT tunion(p) FROM tbl_period) AS tunion_p,
+  (SELECT tcount(p) FROM tbl_period) AS tcount_p,
+  (SELECT tcount(inst) FROM tbl_tint_inst) AS tcount_inst,
+  (SELECT tsum(seq) FROM tbl_tint_seq) AS tsum_seq,
+  (SELECT tcount(ts) FROM tbl_tfloat_seqset) AS tcount_ts;
+SET mobilitydb.aggregate_spill_mem = '1kB';
+SELECT
+  (SELECT tunion(ts) FROM tbl_timestampset) = tunion_ts AS tunion_ts,
+  (SELECT tunion(p) FROM tbl_period) = tunion_p AS tunion_p,
+  (SELECT tcount(p) FROM tbl_period) = tcount_p AS tcount_p,
+  (SELECT tcount(inst) FROM tbl_tint_inst) = tcount_inst AS tcount_inst,
+  (SELECT tsum(seq) FROM tbl_tint_seq) = tsum_seq AS tsum_seq,
+  (SELECT tcount(ts) FROM tbl_tfloat_seqset) = tcount_ts AS tcount_ts
+FROM tbl_aggspill_test;
+SELECT (aggregateSpillStats()).runs > 0 AS spilled;
+RESET mobilitydb.aggregate_spill_mem;
+DROP TABLE tbl_aggspill_test;
+
+-------------------------------------------------------------------------------
@@ -254,6 +254,18 @@ SELECT COUNT(*) FROM tbl_ttext_big WHERE temp #&> ttext '[AAA@2001-01-01, BBB@20
 SELECT COUNT(*) FROM tbl_tint_big WHERE tint '[1@2001-01-01, 10@2001-02-01]' << temp;
 SELECT COUNT(*) FROM tbl_tint_big WHERE tint '[1@2001-01-01, 10@2001-02-01]' &< temp;
 
+-- Index quality diagnostics
+SELECT array_agg(DISTINCT dimension ORDER BY dimension) FROM gistIndexStats('tbl_tfloat_big_rtree_idx');
+SELECT nodes FROM gistIndexStats('tbl_tbool_big_rtree_idx') WHERE level = 0;
+SELECT bool_and(entries >= nodes AND fillfactor > 0 AND fillfactor <= 1 AND overlap >= 0 AND deadspace <= extent) FROM gistIndexStats('tbl_tint_big_rtree_idx');
+SELECT * FROM spgistIndexStats('tbl_tint_big_rtree_idx');
+DROP ROLE IF EXISTS mobdb_index_stats;
+CREATE ROLE mobdb_index_stats;
+SET ROLE mobdb_index_stats;
+SELECT * FROM gistIndexStats('tbl_tint_big_rtree_idx');
+RESET ROLE;
+DROP ROLE mobdb_index_stats;
+
 -------------------------------------------------------------------------------
 
 DROP INDEX tbl_tbool_big_rtree_idx;
@@ -453,6 +465,12 @@ SELECT COUNT(*) FROM tbl_ttext_big WHERE temp &<# ttext '[AAA@2001-01-01, BBB@20
 SELECT COUNT(*) FROM tbl_ttext_big WHERE temp #>> ttext '[AAA@2001-01-01, BBB@2001-02-01]';
 SELECT COUNT(*) FROM tbl_ttext_big WHERE temp #&> ttext '[AAA@2001-01-01, BBB@2001-02-01]';
 
+-- Index quality diagnostics
+SELECT array_agg(DISTINCT dimension ORDER BY dimension) FROM spgistIndexStats('tbl_tfloat_big_quadtree_idx');
+SELECT nodes FROM spgistIndexStats('tbl_tbool_big_quadtree_idx') WHERE level = 0;
+SELECT bool_and(entries >= nodes AND fillfactor > 0 AND fillfactor <= 1 AND overlap >= 0 AND deadspace <= extent) FROM spgistIndexStats('tbl_tint_big_quadtree_idx');
+SELECT * FROM gistIndexStats('tbl_tint_big_quadtree_idx');
+
 -------------------------------------------------------------------------------
 
 DROP INDEX tbl_tbool_big_quadtree_idx;
@@ -73,3 +73,15 @@ SELECT k%10, numSequences(wcount(ts, '1 hour')) FROM tbl_tnpoint_seqset GROUP BY
 SELECT k%10, numSequences(tcentroid(ts)) FROM tbl_tnpoint_seqset GROUP BY k%10 ORDER BY k%10;
 
 -------------------------------------------------------------------------------
+
+SELECT (s).rid, (s).bucket, (s).duration, (s).distance > 0 AS moving, (s).entries, (s).exits
+FROM (SELECT unnest(edgeStats(temp, '1 day')) AS s FROM ( VALUES
+  (tnpoint '[Npoint(1, 0.2)@2000-01-01 12:00, Npoint(1, 0.6)@2000-01-02 12:00]'),
+  ('{[Npoint(2, 0.1)@2000-01-01, Npoint(2, 0.3)@2000-01-01 06:00], [Npoint(1, 0.5)@2000-01-02, Npoint(1, 0.5)@2000-01-02 06:00]}'),
+  ('[Npoint(3, 0.5)@2000-01-01, Npoint(3, 0.5)@2000-01-01 01:00]'),
+  (NULL)) t(temp)) t1;
+/* Errors */
+SELECT edgeStats(temp, '1 day') FROM ( VALUES
+  (tnpoint '{Npoint(1, 0.3)@2000-01-01, Npoint(1, 0.5)@2000-01-02}')) t(temp);
+
+-------------------------------------------------------------------------------
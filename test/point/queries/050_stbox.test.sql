@@ -257,6 +257,30 @@ SELECT COUNT(*) FROM tbl_stbox t1, tbl_stbox t2 WHERE t1.b <@ t2.b;
 SELECT COUNT(*) FROM tbl_stbox t1, tbl_stbox t2 WHERE t1.b ~= t2.b;
 SELECT COUNT(*) FROM tbl_stbox t1, tbl_stbox t2 WHERE t1.b -|- t2.b;
 
+SELECT stbox_overlaps(stbox 'STBOX((1.0, 1.0), (2.0, 2.0))', ARRAY[stbox 'STBOX((1.0, 1.0), (2.0, 2.0))', stbox 'STBOX((3.0, 3.0), (4.0, 4.0))', stbox 'STBOX((1.5, 1.5), (3.0, 3.0))']);
+SELECT stbox_contains(stbox 'STBOX((1.0, 1.0), (3.0, 3.0))', ARRAY[stbox 'STBOX((1.0, 1.0), (2.0, 2.0))', stbox 'STBOX((3.0, 3.0), (4.0, 4.0))', stbox 'STBOX((1.5, 1.5), (3.0, 3.0))']);
+SELECT stbox_contained(stbox 'STBOX((3.5, 3.5), (4.0, 4.0))', ARRAY[stbox 'STBOX((1.0, 1.0), (2.0, 2.0))', stbox 'STBOX((3.0, 3.0), (4.0, 4.0))', stbox 'STBOX((1.5, 1.5), (3.0, 3.0))']);
+SELECT stbox_overlaps(stbox 'STBOX((5.0, 5.0), (6.0, 6.0))', ARRAY[stbox 'STBOX((1.0, 1.0), (2.0, 2.0))', stbox 'STBOX((3.0, 3.0), (4.0, 4.0))', stbox 'STBOX((1.5, 1.5), (3.0, 3.0))']);
+SELECT stbox_overlaps(stbox 'STBOX((1.0, 1.0), (2.0, 2.0))', ARRAY[stbox 'STBOX T((1.0, 1.0, 2000-01-01), (2.0, 2.0, 2000-01-02))', stbox 'STBOX((3.0, 3.0), (4.0, 4.0))', stbox 'STBOX Z((1.5, 1.5, 1.5), (3.0, 3.0, 3.0))']);
+SELECT stbox_overlaps(stbox 'STBOX((1.0, 1.0), (2.0, 2.0))', ARRAY[NULL, stbox 'STBOX((1.0, 1.0), (2.0, 2.0))', NULL, stbox 'STBOX((1.5, 1.5), (3.0, 3.0))']);
+SELECT stbox_overlaps(stbox 'STBOX((1.0, 1.0), (2.0, 2.0))', ARRAY[NULL::stbox, NULL]);
+SELECT stbox_overlaps(stbox 'STBOX((1.0, 1.0), (2.0, 2.0))', '{}'::stbox[]);
+/* Errors */
+SELECT stbox_overlaps(stbox 'STBOX((1.0, 1.0), (2.0, 2.0))', ARRAY[stbox 'GEODSTBOX((1.0, 2.0, 3.0), (1.0, 2.0, 3.0))']);
+
+WITH boxes(arr) AS (SELECT array_agg(b ORDER BY k) FROM tbl_stbox WHERE b IS NOT NULL)
+SELECT COUNT(*) FROM tbl_stbox t, boxes
+WHERE t.b IS NOT NULL AND stbox_overlaps(t.b, arr) IS DISTINCT FROM
+  COALESCE((SELECT array_agg(i ORDER BY i) FROM unnest(arr) WITH ORDINALITY u(b, i) WHERE t.b && u.b), '{}');
+WITH boxes(arr) AS (SELECT array_agg(b ORDER BY k) FROM tbl_stbox WHERE b IS NOT NULL)
+SELECT COUNT(*) FROM tbl_stbox t, boxes
+WHERE t.b IS NOT NULL AND stbox_contains(t.b, arr) IS DISTINCT FROM
+  COALESCE((SELECT array_agg(i ORDER BY i) FROM unnest(arr) WITH ORDINALITY u(b, i) WHERE t.b @> u.b), '{}');
+WITH boxes(arr) AS (SELECT array_agg(b ORDER BY k) FROM tbl_stbox WHERE b IS NOT NULL)
+SELECT COUNT(*) FROM tbl_stbox t, boxes
+WHERE t.b IS NOT NULL AND stbox_contained(t.b, arr) IS DISTINCT FROM
+  COALESCE((SELECT array_agg(i ORDER BY i) FROM unnest(arr) WITH ORDINALITY u(b, i) WHERE t.b <@ u.b), '{}');
+
 -------------------------------------------------------------------------------
 -- Position operators
 -------------------------------------------------------------------------------
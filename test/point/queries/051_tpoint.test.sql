@@ -120,6 +120,10 @@ SELECT asewkt(tgeompoint '[SRID=4326;Point(0 1)@2000-01-01, SRID=4326;Point(0 1)
 SELECT asewkt(tgeompoint 'SRID=4326;{[Point(0 1)@2000-01-01], [Point(0 1)@2000-01-02]}');
 SELECT asewkt(tgeompoint '{[SRID=4326;Point(0 1)@2000-01-01], [Point(0 1)@2000-01-02]}');
 SELECT asewkt(tgeompoint '{[SRID=4326;Point(0 1)@2000-01-01], [SRID=4326;Point(0 1)@2000-01-02]}');
+SELECT asewkt(tgeompoint '[Point(0 1)@2000-01-01, SRID=4326;Point(0 1)@2000-01-02]');
+SELECT asewkt(tgeompoint '{[Point(0 1)@2000-01-01], [SRID=4326;Point(0 1)@2000-01-02]}');
+SELECT asewkt(tgeompoint '{0101000000000000000000F03F000000000000F03F@2000-01-01, Point(2 2)@2000-01-02}');
+SELECT asewkt(tgeompoint '[Point Z (1 1 1)@2000-01-01, POINTZ(2 2 2)@2000-01-02]');
 
 /* Errors */
 SELECT tgeompoint '{SRID=5676;Point(0 1)@2000-01-01, SRID=3812;Point(0 1)@2000-01-02}';
@@ -47,6 +47,7 @@ SELECT tgeompointFromMFJSON('{"types":"MovingPoint","coordinates":[1,1],"datetim
 SELECT tgeompointFromMFJSON('{"type":"XXX","coordinates":[1],"datetimes":"2000-01-01T00:00:00+01","interpolations":["Discrete"]}');
 SELECT tgeompointFromMFJSON('{"type":"MovingPoint","coordinates":[1,1],"datetimes":"2000-01-01T00:00:00+01","interpolationss":["Discrete"]}');
 SELECT tgeompointFromMFJSON('{"type":"MovingPoint","coordinates":[1,1],"datetimes":"2000-01-01T00:00:00+01","interpolations":["XXX"]}');
+SELECT tgeompointFromMFJSON('{"type":"MovingPoint","coordinates":[1,1],"datetimes":"2000-01-01T00:00:00+01","interpolations":[null]}');
 SELECT tgeompointFromMFJSON('{"type":"MovingPoint","coordinates":[1,1],"datetimes":"2000-01-01T00:00:00+01","interpolations":["Discrete","Linear"]}');
 
 SELECT tgeompointFromMFJSON('{"type":"MovingPoint","coordinates":"[1,1]","datetimes":"2000-01-01T00:00:00+01","interpolations":["Discrete"]}');
@@ -100,3 +101,19 @@ select asEWKT(tgeompointFromEWKB(asEWKB(tgeompoint 'SRID=5676;Point(1 1 1)@2000-
 select asEWKT(tgeompointFromEWKB(asEWKB(tgeompoint 'SRID=5676;Point(1 1)@2000-01-01', 'ABC')));
 
 ----------------------------------------------------------------------
+
+SELECT asEWKT(tgeompointFromPolyline(asPolyline(tgeompoint '{[Point(1 2)@2000-01-01, Point(3 4)@2000-01-02],[Point(1 2)@2000-01-03, Point(3 4)@2000-01-04]}')));
+SELECT asEWKT(tgeompointFromPolyline(asPolyline(tgeompoint 'Interp=Stepwise;[Point(1 2)@2000-01-01, Point(3 4)@2000-01-02]')));
+SELECT asEWKT(tgeompointFromPolyline(asPolyline(tgeompoint 'SRID=4326;{Point(1.123456 2 3)@2000-01-01, Point(4 5 6)@2000-01-02}', 2)));
+SELECT asEWKT(tgeogpointFromPolyline(asPolyline(tgeogpoint '[Point(1.5 2.5)@2000-01-01, Point(3.5 4.5)@2000-01-02)')));
+SELECT asEWKT(tgeompointFromPolylineBinary(asPolylineBinary(tgeompoint '(Point(1 2)@2000-01-01, Point(3 4)@2000-01-02]')));
+SELECT asEWKT(tgeogpointFromPolylineBinary(asPolylineBinary(tgeogpoint 'Point(1 2)@2000-01-01')));
+/* Errors */
+SELECT tgeompointFromPolyline('aG?I_ibE');
+SELECT tgeompointFromPolyline('aG?I_ibE_ibE?A');
+SELECT tgeogpointFromPolyline(asPolyline(tgeompoint 'Point(1 1)@2000-01-01'));
+SELECT tgeogpointFromPolyline('aIkmG?SgE?');
+SELECT tgeogpointFromPolyline('aIkmG?oKS?');
+SELECT tgeompointFromPolyline('aG_c`|@?AA?');
+
+----------------------------------------------------------------------
@@ -116,6 +116,19 @@ select asEWKB(tgeompoint 'SRID=5676;Point(1 1)@2000-01-01', 'ABCD');
 
 -------------------------------------------------------------------------------
 
+SELECT asPolyline(tgeompoint 'Point(1 1)@2000-01-01');
+SELECT asPolyline(tgeompoint '[Point(1 1)@2000-01-01, Point(2 2)@2000-01-02]');
+SELECT asPolyline(tgeompoint '{[Point(1 1)@2000-01-01, Point(2 2)@2000-01-02],[Point(3 3)@2000-01-03, Point(3 3)@2000-01-04]}');
+SELECT asPolyline(tgeompoint 'SRID=4326;{Point(50.81381 4.38426)@2000-01-01, Point(50.81385 4.38431)@2000-01-01 00:01:00}');
+SELECT asPolyline(tgeompoint 'SRID=4326;[Point(1 2 3)@2000-01-01, Point(4 5 6)@2000-01-02)', 1);
+SELECT asPolylineBinary(tgeompoint 'Point(1 1)@2000-01-01');
+SELECT asPolylineBinary(tgeompoint '[Point(1 1)@2000-01-01, Point(2 2)@2000-01-02]');
+/* Errors */
+SELECT asPolyline(tgeompoint 'Point(1 1)@2000-01-01', 16);
+SELECT asPolyline(tgeompoint 'Point(1e20 1)@2000-01-01');
+
+-------------------------------------------------------------------------------
+
 SELECT astext('{}'::geometry[]);
 
 -------------------------------------------------------------------------------
@@ -67,4 +67,11 @@ SELECT DISTINCT tgeogpointFromEWKB(asEWKB(temp)) = temp FROM tbl_tgeogpoint;
 SELECT DISTINCT tgeompointFromHexEWKB(asHexEWKB(temp)) = temp FROM tbl_tgeompoint;
 SELECT DISTINCT tgeogpointFromHexEWKB(asHexEWKB(temp)) = temp FROM tbl_tgeogpoint;
 
+-- The coordinates are rounded to the number of decimal digits
+SELECT DISTINCT getTime(tgeompointFromPolyline(asPolyline(temp))) = getTime(temp) FROM tbl_tgeompoint;
+SELECT DISTINCT getTime(tgeogpointFromPolyline(asPolyline(temp))) = getTime(temp) FROM tbl_tgeogpoint;
+
+SELECT DISTINCT getTime(tgeompointFromPolylineBinary(asPolylineBinary(temp))) = getTime(temp) FROM tbl_tgeompoint;
+SELECT DISTINCT getTime(tgeogpointFromPolylineBinary(asPolylineBinary(temp))) = getTime(temp) FROM tbl_tgeogpoint;
+
 -------------------------------------------------------------------------------
@@ -375,6 +375,22 @@ SELECT round(speed(tgeompoint 'Interp=Stepwise;{[Point(1 1 1)@2000-01-01, Point(
 SELECT round(speed(tgeogpoint 'Interp=Stepwise;[Point(1.5 1.5 1.5)@2000-01-01, Point(2.5 2.5 2.5)@2000-01-02, Point(1.5 1.5 1.5)@2000-01-03]'), 6);
 SELECT round(speed(tgeogpoint 'Interp=Stepwise;{[Point(1.5 1.5 1.5)@2000-01-01, Point(2.5 2.5 2.5)@2000-01-02, Point(1.5 1.5 1.5)@2000-01-03],[Point(3.5 3.5 3.5)@2000-01-04, Point(3.5 3.5 3.5)@2000-01-05]}'), 6);
 
+SELECT timeDelta(tgeompoint '[Point(1 1)@2000-01-01, Point(2 2)@2000-01-02, Point(1 1)@2000-01-04]');
+SELECT displacement(tgeompoint '{[Point(1 1)@2000-01-01, Point(4 5)@2000-01-02, Point(4 5)@2000-01-03],[Point(3 3)@2000-01-04, Point(3 3)@2000-01-05]}');
+SELECT displacement(tgeompoint 'Interp=Stepwise;[Point(0 0)@2000-01-01, Point(3 4)@2000-01-02, Point(3 4)@2000-01-05]', '1 day');
+SELECT displacement(tgeogpoint 'Point(1.5 1.5)@2000-01-01');
+
+SELECT (summaryStats(tgeompoint '[Point(0 0)@2000-01-01 00:00:00, Point(3 4)@2000-01-01 00:00:05, Point(3 4)@2000-01-01 00:00:10]')).length;
+SELECT (summaryStats(tgeompoint '[Point(0 0)@2000-01-01 00:00:00, Point(3 4)@2000-01-01 00:00:05, Point(3 4)@2000-01-01 00:00:10]')).maxSpeed;
+SELECT (summaryStats(tgeompoint '[Point(0 0)@2000-01-01 00:00:00, Point(3 4)@2000-01-01 00:00:05, Point(3 4)@2000-01-01 00:00:10]')).avgSpeed;
+SELECT (summaryStats(tgeompoint '{Point(1 1)@2000-01-01, Point(2 2)@2000-01-02}')).maxSpeed;
+SELECT ST_AsText((summaryStats(tgeompoint '[Point(0 0)@2000-01-01, Point(3 4)@2000-01-02]')).endValue);
+
+SELECT length(tgeompoint '[Point(0 0)@2000-01-01, Point(4 0)@2000-01-05]', period '[2000-01-02, 2000-01-04]');
+SELECT length(tgeompoint '{[Point(0 0)@2000-01-01, Point(2 0)@2000-01-03], [Point(2 0)@2000-01-04, Point(2 3)@2000-01-07]}', period '[2000-01-02, 2000-01-06]');
+SELECT length(tgeompoint '[Point(0 0)@2000-01-01, Point(4 0)@2000-01-05]', period '[2001-01-01, 2001-01-02]') IS NULL;
+SELECT length(tgeompoint '[Point(0 0)@2000-01-01, Point(4 0)@2000-01-05]', ARRAY[period '[2000-01-01, 2000-01-02]', '[2000-01-02, 2000-01-05]', '[2001-01-01, 2001-01-02]']);
+
 -- 2D
 SELECT ST_AsText(round(twcentroid(tgeompoint 'Point(1 1)@2000-01-01'), 6));
 SELECT ST_AsText(round(twcentroid(tgeompoint '{Point(1 1)@2000-01-01, Point(2 2)@2000-01-02, Point(1 1)@2000-01-03}'), 6));
@@ -100,6 +100,11 @@ SELECT round(MAX(length(temp))::numeric, 6) FROM tbl_tgeompoint3D;
 SELECT COUNT(*) FROM tbl_tgeogpoint WHERE length(temp) = ST_Length(trajectory(temp));
 SELECT COUNT(*) FROM tbl_tgeogpoint3D WHERE length(temp) = ST_Length(trajectory(temp));
 
+SELECT COUNT(*) FROM tbl_tgeompoint, tbl_period WHERE temp && p AND
+  abs(length(temp, p) - length(atPeriod(temp, p))) > 1e-6;
+SELECT COUNT(*) FROM tbl_tgeompoint3D, tbl_period WHERE temp && p AND
+  abs(length(temp, p) - length(atPeriod(temp, p))) > 1e-6;
+
 SELECT round(MAX(maxValue(cumulativeLength(temp)))::numeric, 6) FROM tbl_tgeompoint;
 SELECT round(MAX(maxValue(cumulativeLength(temp)))::numeric, 6) FROM tbl_tgeogpoint;
 SELECT round(MAX(maxValue(cumulativeLength(temp)))::numeric, 6) FROM tbl_tgeompoint3D;
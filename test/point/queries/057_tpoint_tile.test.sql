@@ -176,4 +176,46 @@ FROM (SELECT spaceTimeSplit(tgeompoint 'Interp=Stepwise;{[Point(1 1 1)@2000-01-0
 /* Errors */
 SELECT spaceTimeSplit(tgeompoint 'SRID=5676;Point(1 1 1)@2000-01-01', 2.0, '2 days', 'SRID=3812;Point(0.5 0.5 0.5)');
 
+-------------------------------------------------------------------------------
+
+-------------------------------------------------------------------------------
+-- Cell coverings
+-------------------------------------------------------------------------------
+
+SELECT spaceCells(tgeompoint '[Point(1 1)@2000-01-01, Point(3 1)@2000-01-02]', 1.0);
+SELECT spaceCells(tgeompoint '{Point(-1 1)@2000-01-01, Point(1 1)@2000-01-02}', 1.0);
+SELECT spaceCells(stbox 'STBOX((1.0, 1.0), (2.0, 1.0))', 1.0);
+SELECT spaceTimeCells(tgeompoint '[Point(1 1)@2000-01-03, Point(3 1)@2000-01-04]', 1.0, '1 day');
+SELECT spaceTimeCells(tgeompoint 'Interp=Stepwise;[Point(1 1)@2000-01-03, Point(3 1)@2000-01-05]', 1.0, '1 day');
+SELECT spaceTimeCells(stbox 'STBOX T((2.5, 1.5, 2000-01-03), (2.6, 1.6, 2000-01-03 12:00:00))', 1.0, '1 day');
+SELECT spaceTimeCells(tgeompoint '[Point(1 1)@2000-01-03, Point(3 1)@2000-01-04]', 1.0, '1 day') &&
+  spaceTimeCells(stbox 'STBOX T((2.5, 1.5, 2000-01-03), (2.6, 1.6, 2000-01-03 12:00:00))', 1.0, '1 day');
+SELECT overlapsSpaceTimeCells(tgeompoint '[Point(1 1)@2000-01-03, Point(3 1)@2000-01-04]',
+  stbox 'STBOX T((2.5, 0.5, 2000-01-03), (2.6, 0.6, 2000-01-03 12:00:00))', 1.0, '1 day');
+
+SELECT spaceCells(stbox 'STBOX((0, 0), (10000, 10000))', 1.0) IS NULL;
+SELECT overlapsSpaceCells(tgeompoint '[Point(1 1)@2000-01-01, Point(3 1)@2000-01-02]',
+  stbox 'STBOX((0, 0), (10000, 10000))', 1.0);
+/* Temporal point traversing too many cells */
+SELECT spaceCells(tgeompoint '[Point(0 0)@2000-01-01, Point(1100000 0)@2000-01-02]', 1.0);
+SELECT overlapsSpaceCells(tgeompoint '[Point(0 0)@2000-01-01, Point(1100000 0)@2000-01-02]',
+  stbox 'STBOX((5.5, -0.5), (6.5, 0.5))', 1.0);
+SELECT overlapsSpaceCells(tgeompoint '[Point(0 0)@2000-01-01, Point(1100000 0)@2000-01-02]',
+  stbox 'STBOX((5.5, 1.5), (6.5, 2.5))', 1.0);
+
+-------------------------------------------------------------------------------
+
+-------------------------------------------------------------------------------
+-- Partition keys
+-------------------------------------------------------------------------------
+
+SELECT spacePartitionKey(tgeompoint '[Point(1 1)@2000-01-01, Point(5 5)@2000-01-02]', 10.0);
+SELECT spaceTimePartitionKey(tgeompoint '[Point(11 1)@2000-01-03, Point(20 5)@2000-01-04]', 10.0, '1 day');
+SELECT spacePartitionKeys(stbox 'STBOX((10.0, 5.0), (25.0, 8.0))', 10.0);
+SELECT spaceTimePartitionKeys(stbox 'STBOX T((2.5, 1.5, 2000-01-04), (2.6, 1.6, 2000-01-04 12:00:00))', 1.0, '1 day');
+SELECT spacePartitionKeys(stbox 'STBOX((0, 0), (10000, 10000))', 1.0) IS NULL;
+/* Errors */
+SELECT spacePartitionKey(tgeompoint '[Point(1 1)@2000-01-01, Point(15 5)@2000-01-02]', 10.0);
+
+
 -------------------------------------------------------------------------------
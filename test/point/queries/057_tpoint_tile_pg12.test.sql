@@ -0,0 +1,69 @@
+-------------------------------------------------------------------------------
+--
+-- This MobilityDB code is provided under The PostgreSQL License.
+-- Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+-- contributors
+--
+-- MobilityDB includes portions of PostGIS version 3 source code released
+-- under the GNU General Public License (GPLv2 or later).
+-- Copyright (c) 2001-2022, PostGIS contributors
+--
+-- Permission to use, copy, modify, and distribute this software and its
+-- documentation for any purpose, without fee, and without a written
+-- agreement is hereby granted, provided that the above copyright notice and
+-- this paragraph and the following two paragraphs appear in all copies.
+--
+-- IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+-- DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+-- LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+-- EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+-- OF SUCH DAMAGE.
+--
+-- UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+-- INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+-- AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+-- AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+-- PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+--
+-------------------------------------------------------------------------------
+
+-- Partition pruning with the support functions
+
+CREATE TABLE tbl_tgeompoint_part(k int, trip tgeompoint)
+  PARTITION BY LIST (spacePartitionKey(trip, 10.0));
+CREATE TABLE tbl_tgeompoint_part_0_0 PARTITION OF tbl_tgeompoint_part FOR VALUES IN (0);
+CREATE TABLE tbl_tgeompoint_part_0_1 PARTITION OF tbl_tgeompoint_part FOR VALUES IN (1);
+CREATE TABLE tbl_tgeompoint_part_1_0 PARTITION OF tbl_tgeompoint_part FOR VALUES IN (4294967296);
+CREATE TABLE tbl_tgeompoint_part_1_1 PARTITION OF tbl_tgeompoint_part FOR VALUES IN (4294967297);
+CREATE FUNCTION scanned_partitions(query text) RETURNS SETOF text AS $$
+DECLARE
+  line text;
+BEGIN
+  FOR line IN EXECUTE 'EXPLAIN (COSTS OFF) ' || query LOOP
+    IF line ~ 'Scan on ' THEN
+      RETURN NEXT substring(line FROM 'Scan on (\w+)');
+    END IF;
+  END LOOP;
+END;
+$$ LANGUAGE plpgsql;
+SELECT scanned_partitions('SELECT k FROM tbl_tgeompoint_part WHERE trip && stbox ''STBOX((1.0, 1.0), (5.0, 5.0))''');
+SELECT scanned_partitions('SELECT k FROM tbl_tgeompoint_part WHERE trip && stbox ''STBOX((5.0, 1.0), (15.0, 5.0))''');
+SELECT scanned_partitions('SELECT k FROM tbl_tgeompoint_part WHERE trip && geometry ''Point(12 2)''');
+SELECT scanned_partitions('SELECT k FROM tbl_tgeompoint_part WHERE stbox ''STBOX((1.0, 11.0), (5.0, 15.0))'' @> trip');
+SELECT scanned_partitions('SELECT k FROM tbl_tgeompoint_part WHERE trip <@ stbox ''STBOX((11.0, 11.0), (15.0, 15.0))''');
+DROP TABLE tbl_tgeompoint_part;
+-- The partition key function is matched on its Oid
+CREATE SCHEMA test_partition;
+CREATE FUNCTION test_partition.spacePartitionKey(tgeompoint, float,
+    sorigin geometry DEFAULT 'Point(0 0 0)')
+  RETURNS bigint AS $$ BEGIN RETURN 0; END; $$ LANGUAGE plpgsql IMMUTABLE;
+CREATE TABLE tbl_tgeompoint_part(k int, trip tgeompoint)
+  PARTITION BY LIST (test_partition.spacePartitionKey(trip, 10.0));
+CREATE TABLE tbl_tgeompoint_part_0_0 PARTITION OF tbl_tgeompoint_part FOR VALUES IN (0);
+CREATE TABLE tbl_tgeompoint_part_0_1 PARTITION OF tbl_tgeompoint_part FOR VALUES IN (1);
+SELECT scanned_partitions('SELECT k FROM tbl_tgeompoint_part WHERE trip && stbox ''STBOX((11.0, 11.0), (15.0, 15.0))''');
+DROP TABLE tbl_tgeompoint_part;
+DROP SCHEMA test_partition CASCADE;
+DROP FUNCTION scanned_partitions(text);
+
+-------------------------------------------------------------------------------
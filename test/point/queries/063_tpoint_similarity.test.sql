@@ -587,4 +587,34 @@ WITH Temp AS (
   SELECT dynamicTimeWarpPath(tgeogpoint '{[Point(1.5 1.5 1.5)@2000-01-01, Point(2.5 2.5 2.5)@2000-01-02, Point(1.5 1.5 1.5)@2000-01-03],[Point(3.5 3.5 3.5)@2000-01-04, Point(3.5 3.5 3.5)@2000-01-05]}', tgeogpoint '{[Point(1.5 1.5 1.5)@2000-01-01, Point(2.5 2.5 2.5)@2000-01-02, Point(1.5 1.5 1.5)@2000-01-03],[Point(3.5 3.5 3.5)@2000-01-04, Point(3.5 3.5 3.5)@2000-01-05]}') )
 SELECT COUNT(*) FROM Temp;
 
+-------------------------------------------------------------------------------
+-- Hausdorff distance
+-------------------------------------------------------------------------------
+
+SELECT round(hausdorffDistance(tgeompoint '[Point(0 0)@2000-01-01, Point(2 0)@2000-01-02]', tgeompoint '[Point(1 1)@2000-01-01, Point(1 3)@2000-01-02]')::numeric, 6);
+SELECT round(hausdorffDistance(tgeompoint '[Point(0 0)@2000-01-01, Point(10 0)@2000-01-02]', tgeompoint '{[Point(0 1)@2000-01-01, Point(1 1)@2000-01-02], [Point(9 1)@2000-01-03, Point(10 1)@2000-01-04]}')::numeric, 6);
+SELECT round(hausdorffDistance(tgeompoint '[Point(0 0 0)@2000-01-01, Point(4 0 0)@2000-01-02]', tgeompoint '{Point(0 0 1)@2000-01-01, Point(4 0 1)@2000-01-02}')::numeric, 6);
+SELECT round(vertexHausdorffDistance(tgeompoint '[Point(0 0)@2000-01-01, Point(2 0)@2000-01-02]', tgeompoint '[Point(1 1)@2000-01-01, Point(1 3)@2000-01-02]')::numeric, 6);
+SELECT round(vertexHausdorffDistance(tgeompoint '{Point(0 0)@2000-01-01, Point(2 0)@2000-01-02}', tgeompoint '[Point(1 1)@2000-01-01, Point(1 3)@2000-01-02]')::numeric, 6);
+SELECT round(vertexHausdorffDistance(tgeompoint '[Point(0 0)@2000-01-01, Point(2 0)@2000-01-02]', tgeompoint '[Point(0 1)@2000-01-01, Point(2 1)@2000-01-02]')::numeric, 6);
+SELECT round(vertexHausdorffDistance(tgeompoint '[Point(0 0)@2000-01-01, Point(10 0)@2000-01-02]', tgeompoint '{[Point(0 1)@2000-01-01, Point(1 1)@2000-01-02], [Point(9 1)@2000-01-03, Point(10 1)@2000-01-04]}')::numeric, 6);
+SELECT round(discreteHausdorffDistance(tgeompoint '[Point(0 0)@2000-01-01, Point(2 0)@2000-01-02]', tgeompoint '[Point(1 1)@2000-01-01, Point(1 3)@2000-01-02]')::numeric, 6);
+SELECT hausdorffWithin(tgeompoint '[Point(0 0)@2000-01-01, Point(2 0)@2000-01-02]', tgeompoint '[Point(1 1)@2000-01-01, Point(1 3)@2000-01-02]', 3.5);
+SELECT hausdorffWithin(tgeompoint '[Point(0 0)@2000-01-01, Point(2 0)@2000-01-02]', tgeompoint '[Point(1 1)@2000-01-01, Point(1 3)@2000-01-02]', 2);
+SELECT hausdorffWithin(tgeompoint '[Point(0 0)@2000-01-01, Point(10 0)@2000-01-02]', tgeompoint '{[Point(0 1)@2000-01-01, Point(1 1)@2000-01-02], [Point(9 1)@2000-01-03, Point(10 1)@2000-01-04]}', 2);
+SELECT hausdorffWithin(tgeompoint '[Point(0 0)@2000-01-01, Point(10 0)@2000-01-02]', tgeompoint '{[Point(0 1)@2000-01-01, Point(1 1)@2000-01-02], [Point(9 1)@2000-01-03, Point(10 1)@2000-01-04]}', 4.2);
+SELECT hausdorffDistance(tgeompoint '[Point(0 0)@2000-01-01, Point(2 0)@2000-01-02]', tgeompoint 'SRID=5676;Point(1 1)@2000-01-01');
+
+-------------------------------------------------------------------------------
+-- LCSS and EDR distances
+-------------------------------------------------------------------------------
+
+SELECT round(lcssDistance(tgeompoint '[Point(0 0)@2000-01-01, Point(1 0)@2000-01-02, Point(2 0)@2000-01-03]', tgeompoint '[Point(0 0.1)@2000-01-01, Point(5 5)@2000-01-02, Point(2 0.1)@2000-01-03]', 0.5)::numeric, 6);
+SELECT round(lcssDistance(tgeogpoint '[Point(0 0)@2000-01-01, Point(1 0)@2000-01-02, Point(2 0)@2000-01-03]', tgeogpoint '[Point(0 0.1)@2000-01-01, Point(5 5)@2000-01-02, Point(2 0.1)@2000-01-03]', 20000, '1 day')::numeric, 6);
+SELECT lcssWithin(tgeompoint '[Point(0 0)@2000-01-01, Point(1 0)@2000-01-02, Point(2 0)@2000-01-03]', tgeompoint '[Point(0 0.1)@2000-01-01, Point(5 5)@2000-01-02, Point(2 0.1)@2000-01-03]', 0.5, 0.5);
+SELECT edrDistance(tgeompoint '[Point(0 0)@2000-01-01, Point(1 0)@2000-01-02, Point(2 0)@2000-01-03]', tgeompoint '[Point(0 0.1)@2000-01-01, Point(5 5)@2000-01-02, Point(2 0.1)@2000-01-03]', 0.5);
+SELECT edrWithin(tgeompoint '[Point(0 0)@2000-01-01, Point(1 0)@2000-01-02, Point(2 0)@2000-01-03]', tgeompoint '[Point(0 0.1)@2000-01-01, Point(5 5)@2000-01-02, Point(2 0.1)@2000-01-03]', 0.5, 0, '1 day');
+SELECT lcssDistance(tgeompoint '[Point(0 0)@2000-01-01, Point(2 0)@2000-01-02]', tgeompoint 'SRID=5676;Point(1 1)@2000-01-01', 0.5);
+SELECT edrDistance(tgeompoint '[Point(0 0)@2000-01-01, Point(2 0)@2000-01-02]', tgeompoint 'SRID=5676;Point(1 1)@2000-01-01', 0.5);
+
 --------------------------------------------------------
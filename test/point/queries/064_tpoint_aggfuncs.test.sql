@@ -40,6 +40,10 @@ SELECT asText(tcentroid(temp)) FROM (VALUES
   (tgeompoint '[Point(1 1 1)@2000-01-01, Point(2 2 2)@2000-01-02)'),
   (tgeompoint '[Point(3 3 3)@2000-01-03, Point(4 4 4)@2000-01-04)'),
   (tgeompoint '[Point(2 2 2)@2000-01-02, Point(3 3 3)@2000-01-03)')) t(temp);
+SELECT asText(tcentroid(temp)) FROM (VALUES
+  (tgeompoint '{Point(1 1)@2000-01-01, Point(2 2)@2000-01-02}'),
+  (tgeompoint '{Point(3 3)@2000-01-01, Point(4 4)@2000-01-03}'),
+  (tgeompoint 'Point(5 5)@2000-01-02')) t(temp);
 
 /* Errors */
 SELECT asText(tcentroid(temp)) FROM (VALUES
@@ -0,0 +1,56 @@
+-------------------------------------------------------------------------------
+--
+-- This MobilityDB code is provided under The PostgreSQL License.
+-- Copyright (c) 2016-2022, Université libre de Bruxelles and MobilityDB
+-- contributors
+--
+-- MobilityDB includes portions of PostGIS version 3 source code released
+-- under the GNU General Public License (GPLv2 or later).
+-- Copyright (c) 2001-2022, PostGIS contributors
+--
+-- Permission to use, copy, modify, and distribute this software and its
+-- documentation for any purpose, without fee, and without a written
+-- agreement is hereby granted, provided that the above copyright notice and
+-- this paragraph and the following two paragraphs appear in all copies.
+--
+-- IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+-- DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+-- LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+-- EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+-- OF SUCH DAMAGE.
+--
+-- UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+-- INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+-- AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+-- AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+-- PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS. 
+--
+-------------------------------------------------------------------------------
+
+SELECT liveCount();
+SELECT liveUpdate(1, tgeompoint '{Point(1 1)@2000-01-01, Point(2 2)@2000-01-02}');
+SELECT liveUpdate(1, tgeompoint 'Point(3 3)@2000-01-01');
+SELECT liveUpdate(2, tgeompoint '[Point(10 10)@2000-01-01, Point(20 20)@2000-01-03]');
+SELECT liveUpdate(3, tgeompoint 'Point(5000 5000)@2000-01-01');
+SELECT liveCount();
+SELECT asText(liveTail(1));
+SELECT liveTail(4) IS NULL;
+SELECT id, asText(inst) FROM liveWindow(stbox 'STBOX((0, 0), (100, 100))') ORDER BY id;
+SELECT id, round(dist::numeric, 6) FROM liveDWithin(geometry 'Point(0 0)', 30) ORDER BY id;
+SELECT id, round(dist::numeric, 6) FROM liveKnn(geometry 'Point(0 0)', 2);
+SELECT id, round(dist::numeric, 6) FROM liveKnn(geometry 'Point(4000 4000)', 1);
+SELECT liveRemove(1);
+SELECT liveRemove(1);
+SELECT liveCount();
+
+-- Errors
+SELECT liveUpdate(2, tgeompoint 'SRID=5676;Point(1 1)@2000-01-04');
+SELECT * FROM liveDWithin(geometry 'Point(0 0)', -1);
+SELECT * FROM liveKnn(geometry 'Point(0 0)', 0);
+SELECT * FROM liveKnn(geometry 'Linestring(0 0,1 1)', 1);
+
+SELECT liveRemove(2);
+SELECT liveRemove(3);
+SELECT liveCount();
+
+-------------------------------------------------------------------------------
@@ -27,6 +27,75 @@ PGCTL="${BIN_DIR}/pg_ctl -w -D ${DBDIR} -l ${WORKDIR}/log/postgres.log -o -k -o
 # -o -c -o enable_seqscan=off -o -c -o enable_bitmapscan=off -o -c -o enable_indexscan=on -o -c -o enable_indexonlyscan=on"
 
 POSTGIS="@POSTGIS_LIBRARY@"
+MOBILITYDB="@CMAKE_BINARY_DIR@/lib@MOBILITYDB_LIB_NAME@.so"
+
+# The tests of the live position store run in their own instance, which
+# preloads MobilityDB, so that the other tests run without it
+LIVEDIR="${WORKDIR}/live"
+LIVEPSQL="${BIN_DIR}/psql -h ${LIVEDIR}/lock -e --set ON_ERROR_STOP=0 postgres"
+LIVECTL="${BIN_DIR}/pg_ctl -w -D ${LIVEDIR}/db -l ${WORKDIR}/log/postgres_live.log -o -k -o ${LIVEDIR}/lock -o -h -o ''"
+
+# Create the PostGIS and MobilityDB extensions with the psql command given
+# as first argument and log the output in the file given as second argument
+create_extensions() {
+  local psql=$1
+  local logfile=$2
+  {
+    echo "POSTGIS=${POSTGIS}"
+    echo "EXTFILE=${EXTFILE}"
+    echo "Creating PostGIS extension"
+    echo "CREATE EXTENSION postgis WITH VERSION '@POSTGIS_VERSION@';" | $psql 2>&1
+    $psql -c "SELECT postgis_full_version()" 2>&1
+    # After making a sudo make install the extension can be created with this command
+    #echo "CREATE EXTENSION mobilitydb;" | $psql 2>&1
+  } >> "${logfile}"
+
+  # this loads mobilitydb without a "make install"
+  $psql -f $EXTFILE 2>>"${logfile}" 1>/dev/null
+
+  # A printout to make sure the extension was created
+  $psql -c "SELECT mobilitydb_full_version()" >> "${logfile}" 2>&1
+
+  # capture error when creating the extension
+  ! grep -q ERROR "${logfile}"
+}
+
+# Run the test file given as second argument with the psql command given as
+# third argument and compare its output with the expected one
+compare_output() {
+  local TESTNAME=$1
+  local TESTFILE=$2
+  local psql=$3
+
+  if [ "${TESTFILE: -3}" == ".xz" ]; then
+    "${XZCAT}" "${TESTFILE}" | $psql 2>&1 | tee "${WORKDIR}"/out/"${TESTNAME}".out > /dev/null
+  else
+    $psql < "${TESTFILE}" 2>&1 | tee "${WORKDIR}"/out/"${TESTNAME}".out > /dev/null
+  fi
+
+  if [ -n "$TEST_GENERATE" ]; then
+    echo "TEST_GENERATE is on; assuming correct output"
+    cat "${WORKDIR}"/out/"${TESTNAME}".out > "$(dirname "${TESTFILE}")/../expected/$(basename "${TESTFILE}" .sql).out"
+    return 0
+  else
+    tmpactual=$(mktemp)
+    tmpexpected=$(mktemp)
+    # (1) Text of error messages may change across PostgreSQL/PostGIS/MobilityDB versions.
+    #     For this reason we remove the error message and keep the line with only 'ERROR'
+    # (2) Depending on PostgreSQL/PostGIS version, we remove the lines starting with
+    #     the following error messages:
+    #     * "WARNING:  cache reference leak:"
+    #     * "CONTEXT:  SQL function"
+    sed -e's/^ERROR:.*/ERROR/' -e'/^WARNING:  cache reference leak:.*/d' -e'/^CONTEXT:  SQL function/d' "${WORKDIR}"/out/"${TESTNAME}".out >> "$tmpactual"
+    sed -e's/^ERROR:.*/ERROR/' "$(dirname "${TESTFILE}")/../expected/$(basename "${TESTFILE}" .sql).out" >> "$tmpexpected"
+    echo
+    echo "Differences"
+    echo "==========="
+    echo
+    diff -urdN "$tmpactual" "$tmpexpected" 2>&1 | tee "${WORKDIR}"/out/"${TESTNAME}".diff
+    [ -s "${WORKDIR}"/out/"${TESTNAME}".diff ] && return 1 || return 0
+  fi
+}
 
 case ${CMD} in
 setup)
@@ -37,7 +106,6 @@ setup)
   echo "POSTGIS = ${POSTGIS}" >> "${WORKDIR}/log/initdb.log"
 
   {
-    echo "shared_preload_libraries = '${POSTGIS}'"
     echo "max_locks_per_transaction = 128"
     echo "timezone = 'UTC'"
     echo "parallel_tuple_cost = 100"
@@ -66,24 +134,7 @@ create_ext)
     sleep 2
   fi
 
-  {
-    echo "POSTGIS=${POSTGIS}"
-    echo "EXTFILE=${EXTFILE}"
-    echo "Creating PostGIS extension"
-    echo "CREATE EXTENSION postgis WITH VERSION '@POSTGIS_VERSION@';" | $PSQL 2>&1
-    $PSQL -c "SELECT postgis_full_version()" 2>&1
-    # After making a sudo make install the extension can be created with this command
-    #echo "CREATE EXTENSION mobilitydb;" | $PSQL 2>&1
-  } >> "${WORKDIR}/log/create_ext.log"
-
-  # this loads mobilitydb without a "make install"
-  $PSQL -f $EXTFILE 2>"${WORKDIR}"/log/create_ext.log  1>/dev/null
-
-  # A printout to make sure the extension was created
-  $PSQL -c "SELECT mobilitydb_full_version()" >> "${WORKDIR}/log/create_ext.log" 2>&1
-
-  # capture error when creating the extension
-  if grep -q ERROR "${WORKDIR}/log/create_ext.log"; then exit 1; else exit 0; fi
+  if create_extensions "$PSQL" "${WORKDIR}/log/create_ext.log"; then exit 0; else exit 1; fi
 
   ;;
 
@@ -107,34 +158,34 @@ run_compare)
     fi
   done
 
-  if [ "${TESTFILE: -3}" == ".xz" ]; then
-    "${XZCAT}" "${TESTFILE}" | $PSQL 2>&1 | tee "${WORKDIR}"/out/"${TESTNAME}".out > /dev/null
-  else
-    $PSQL < "${TESTFILE}" 2>&1 | tee "${WORKDIR}"/out/"${TESTNAME}".out > /dev/null
+  if compare_output "${TESTNAME}" "${TESTFILE}" "$PSQL"; then exit 0; else exit 1; fi
+  ;;
+
+run_compare_live)
+  TESTNAME=$2
+  TESTFILE=$3
+
+  rm -rf "${LIVEDIR}"
+  mkdir -p "${LIVEDIR}"/db "${LIVEDIR}"/lock
+  "${BIN_DIR}/initdb" -D "${LIVEDIR}/db" > "${WORKDIR}/log/initdb_live.log" 2>&1
+  {
+    echo "shared_preload_libraries = '${POSTGIS},${MOBILITYDB}'"
+    echo "mobilitydb.live_capacity = 100"
+    echo "timezone = 'UTC'"
+  } >> "${LIVEDIR}/db/postgresql.conf"
+  if ! $LIVECTL start > "${WORKDIR}/log/pg_start_live.log" 2>&1; then
+    echo "Failed to start PostgreSQL" >> "${WORKDIR}/out/${TESTNAME}.out"
+    exit 1
   fi
 
-  if [ -n "$TEST_GENERATE" ]; then
-    echo "TEST_GENERATE is on; assuming correct output"
-    cat "${WORKDIR}"/out/"${TESTNAME}".out > "$(dirname "${TESTFILE}")/../expected/$(basename "${TESTFILE}" .sql).out"
-    exit 0
-  else
-    tmpactual=$(mktemp)
-    tmpexpected=$(mktemp)
-    # (1) Text of error messages may change across PostgreSQL/PostGIS/MobilityDB versions.
-    #     For this reason we remove the error message and keep the line with only 'ERROR'
-    # (2) Depending on PostgreSQL/PostGIS version, we remove the lines starting with
-    #     the following error messages:
-    #     * "WARNING:  cache reference leak:"
-    #     * "CONTEXT:  SQL function"
-    sed -e's/^ERROR:.*/ERROR/' -e'/^WARNING:  cache reference leak:.*/d' -e'/^CONTEXT:  SQL function/d' "${WORKDIR}"/out/"${TESTNAME}".out >> "$tmpactual"
-    sed -e's/^ERROR:.*/ERROR/' "$(dirname "${TESTFILE}")/../expected/$(basename "${TESTFILE}" .sql).out" >> "$tmpexpected"
-    echo
-    echo "Differences"
-    echo "==========="
-    echo
-    diff -urdN "$tmpactual" "$tmpexpected" 2>&1 | tee "${WORKDIR}"/out/"${TESTNAME}".diff
-    [ -s "${WORKDIR}"/out/"${TESTNAME}".diff ] && exit 1 || exit 0
+  result=1
+  if create_extensions "$LIVEPSQL" "${WORKDIR}/log/create_ext_live.log" &&
+     compare_output "${TESTNAME}" "${TESTFILE}" "$LIVEPSQL"; then
+    result=0
   fi
+  $LIVECTL stop > /dev/null 2>&1
+  rm -rf "${LIVEDIR}"
+  exit ${result}
   ;;
 
 run_passfail)